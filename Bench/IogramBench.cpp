@@ -0,0 +1,740 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "IogramBench.h"
+
+#include "IoDataTree.h"
+#include "IoGraph.h"
+#include "IoInputSlot.h"
+#include "IoSerialization.h"
+#include "RegisterCoreComponents.h"
+#include "TriMesh.h"
+#include "TriMeshAABB.h"
+#include "TriMeshData.h"
+#include "Geomlib_MeshParse.h"
+#include "Geomlib_RemoveDuplicates.h"
+#include "Geomlib_TriMeshClosestPoint.h"
+#include "Geomlib_TriMeshRemesh.h"
+
+#include <Urho3D/AngelScript/Script.h>
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+#include <string.h>
+
+#include <Eigen/Core>
+#include "igl/copyleft/marching_cubes.h"
+
+using namespace Urho3D;
+
+URHO3D_DEFINE_APPLICATION_MAIN(IogramBench);
+
+namespace
+{
+	//min, median and mean of a list of timings in microseconds
+	JSONValue TimingStats(PODVector<long long> times)
+	{
+		JSONValue stats;
+		stats.Set("count", times.Size());
+		if (times.Empty())
+			return stats;
+
+		Sort(times.Begin(), times.End());
+		double sum = 0.0;
+		for (unsigned i = 0; i < times.Size(); ++i)
+			sum += (double)times[i];
+
+		stats.Set("min", (double)times[0]);
+		stats.Set("median", (double)times[times.Size() / 2]);
+		stats.Set("mean", sum / times.Size());
+		return stats;
+	}
+
+	//closed UV sphere of radius 1 with about 4 * n * n faces
+	TriMeshDataPtr MakeSphere(unsigned n)
+	{
+		unsigned rings = Max(n, 3u);
+		unsigned segments = 2 * rings;
+
+		TriMeshDataPtr data(new TriMeshData());
+		PODVector<float>& vertices = data->GetVertices();
+		PODVector<int>& faces = data->GetFaces();
+
+		vertices.Push(0.0f); vertices.Push(0.0f); vertices.Push(1.0f);
+		for (unsigned r = 1; r < rings; ++r)
+		{
+			float theta = 180.0f * r / rings;
+			for (unsigned s = 0; s < segments; ++s)
+			{
+				float phi = 360.0f * s / segments;
+				vertices.Push(Sin(theta) * Cos(phi));
+				vertices.Push(Sin(theta) * Sin(phi));
+				vertices.Push(Cos(theta));
+			}
+		}
+		vertices.Push(0.0f); vertices.Push(0.0f); vertices.Push(-1.0f);
+
+		int south = (int)(vertices.Size() / 3 - 1);
+		for (unsigned s = 0; s < segments; ++s)
+		{
+			int a = 1 + s;
+			int b = 1 + (s + 1) % segments;
+			faces.Push(0); faces.Push(a); faces.Push(b);
+		}
+		for (unsigned r = 1; r + 1 < rings; ++r)
+		{
+			int row = 1 + (r - 1) * segments;
+			int next = row + segments;
+			for (unsigned s = 0; s < segments; ++s)
+			{
+				int a = row + s;
+				int b = row + (s + 1) % segments;
+				int c = next + s;
+				int d = next + (s + 1) % segments;
+				faces.Push(a); faces.Push(c); faces.Push(d);
+				faces.Push(a); faces.Push(d); faces.Push(b);
+			}
+		}
+		int last = 1 + (rings - 2) * segments;
+		for (unsigned s = 0; s < segments; ++s)
+		{
+			int a = last + s;
+			int b = last + (s + 1) % segments;
+			faces.Push(south); faces.Push(b); faces.Push(a);
+		}
+
+		return data;
+	}
+
+	///////////////////////
+	// geometry kernels
+
+	struct MeshBench
+	{
+		Variant mesh;
+		ConstTriMeshDataPtr data;
+		VariantVector vertexList;
+		VariantVector faceList;
+		PODVector<Vector3> soup;
+		PODVector<Vector3> queries;
+		WorkQueue* queue;
+	};
+
+	void TriMeshMakeBench(void* data)
+	{
+		MeshBench* b = static_cast<MeshBench*>(data);
+		TriMesh_Make(b->vertexList, b->faceList);
+	}
+
+	void WeldVerticesBench(void* data)
+	{
+		MeshBench* b = static_cast<MeshBench*>(data);
+		PODVector<unsigned> remap;
+		PODVector<unsigned> representatives;
+		Geomlib::WeldVertices(&b->soup[0], b->soup.Size(), 0.0001f, remap, representatives);
+	}
+
+	void AABBBuildBench(void* data)
+	{
+		MeshBench* b = static_cast<MeshBench*>(data);
+		TriMeshAABB tree(*b->data);
+	}
+
+	void ClosestPointsBench(void* data)
+	{
+		MeshBench* b = static_cast<MeshBench*>(data);
+		PODVector<Vector3> points;
+		PODVector<int> indices;
+		PODVector<float> distances;
+		Geomlib::TriMeshClosestPoints(b->mesh, &b->queries[0], b->queries.Size(), points, indices, distances, b->queue);
+	}
+
+	void RemeshBench(void* data)
+	{
+		MeshBench* b = static_cast<MeshBench*>(data);
+		Geomlib::TriMesh_Remesh(b->mesh, 0.0f, 0.33f, 2);
+	}
+
+	struct MarchingCubesBenchData
+	{
+		unsigned res;
+		Eigen::VectorXf values;
+		Eigen::MatrixXf points;
+	};
+
+	void MarchingCubesBench(void* data)
+	{
+		MarchingCubesBenchData* b = static_cast<MarchingCubesBenchData*>(data);
+		Eigen::MatrixXf V;
+		Eigen::MatrixXi F;
+		igl::copyleft::marching_cubes(b->values, b->points, b->res, b->res, b->res, V, F);
+	}
+
+	///////////////////////
+	// readers
+
+	struct ReaderBench
+	{
+		PODVector<char> obj;
+		PODVector<char> ply;
+		PODVector<char> stl;
+		WorkQueue* queue;
+	};
+
+	void Append(PODVector<char>& buffer, const void* data, unsigned size)
+	{
+		unsigned offset = buffer.Size();
+		buffer.Resize(offset + size);
+		memcpy(&buffer[offset], data, size);
+	}
+
+	void Append(PODVector<char>& buffer, const String& text)
+	{
+		Append(buffer, text.CString(), text.Length());
+	}
+
+	void WriteOBJ(const TriMeshData& mesh, PODVector<char>& buffer)
+	{
+		for (unsigned i = 0; i < mesh.GetNumVertices(); ++i)
+		{
+			Vector3 v = mesh.GetVertex(i);
+			Append(buffer, "v " + String(v.x_) + " " + String(v.y_) + " " + String(v.z_) + "\n");
+		}
+		for (unsigned i = 0; i < mesh.GetNumFaces(); ++i)
+		{
+			Append(buffer, "f " + String(mesh.GetFaceIndex(3 * i) + 1) + " " + String(mesh.GetFaceIndex(3 * i + 1) + 1) + " " +
+				String(mesh.GetFaceIndex(3 * i + 2) + 1) + "\n");
+		}
+	}
+
+	//binary_little_endian, assuming a little endian host
+	void WritePLY(const TriMeshData& mesh, PODVector<char>& buffer)
+	{
+		Append(buffer, "ply\nformat binary_little_endian 1.0\nelement vertex " + String(mesh.GetNumVertices()) +
+			"\nproperty float x\nproperty float y\nproperty float z\nelement face " + String(mesh.GetNumFaces()) +
+			"\nproperty list uchar int vertex_indices\nend_header\n");
+		Append(buffer, mesh.GetVertexData(), mesh.GetVertices().Size() * sizeof(float));
+		for (unsigned i = 0; i < mesh.GetNumFaces(); ++i)
+		{
+			unsigned char count = 3;
+			Append(buffer, &count, 1);
+			Append(buffer, mesh.GetFaceData() + 3 * i, 3 * sizeof(int));
+		}
+	}
+
+	void WriteSTL(const TriMeshData& mesh, PODVector<char>& buffer)
+	{
+		char header[80] = { 0 };
+		Append(buffer, header, sizeof(header));
+		unsigned numFaces = mesh.GetNumFaces();
+		Append(buffer, &numFaces, 4);
+		for (unsigned i = 0; i < numFaces; ++i)
+		{
+			Vector3 a = mesh.GetVertex(mesh.GetFaceIndex(3 * i));
+			Vector3 b = mesh.GetVertex(mesh.GetFaceIndex(3 * i + 1));
+			Vector3 c = mesh.GetVertex(mesh.GetFaceIndex(3 * i + 2));
+			Vector3 n = (b - a).CrossProduct(c - a).Normalized();
+			unsigned short attributes = 0;
+			Append(buffer, n.Data(), 12);
+			Append(buffer, a.Data(), 12);
+			Append(buffer, b.Data(), 12);
+			Append(buffer, c.Data(), 12);
+			Append(buffer, &attributes, 2);
+		}
+	}
+
+	void ParseOBJBench(void* data)
+	{
+		ReaderBench* b = static_cast<ReaderBench*>(data);
+		TriMeshData mesh;
+		Geomlib::ParseOBJ(&b->obj[0], b->obj.Size(), mesh, b->queue);
+	}
+
+	void ParsePLYBench(void* data)
+	{
+		ReaderBench* b = static_cast<ReaderBench*>(data);
+		TriMeshData mesh;
+		Geomlib::ParsePLY(&b->ply[0], b->ply.Size(), mesh);
+	}
+
+	void ParseSTLBench(void* data)
+	{
+		ReaderBench* b = static_cast<ReaderBench*>(data);
+		TriMeshData mesh;
+		Geomlib::ParseSTL(&b->stl[0], b->stl.Size(), mesh);
+	}
+
+	///////////////////////
+	// data trees
+
+	struct DataTreeBench
+	{
+		Context* context;
+		unsigned numItems;
+		SharedPtr<IoDataTree> tree;
+		float sum;
+	};
+
+	//100 items per branch, in branches {0;0}, {0;1}, ...
+	void DataTreeAddBench(void* data)
+	{
+		DataTreeBench* b = static_cast<DataTreeBench*>(data);
+		IoDataTree tree(b->context);
+		Vector<int> path(2);
+		path[0] = 0;
+		for (unsigned i = 0; i < b->numItems; ++i)
+		{
+			path[1] = (int)(i / 100);
+			tree.Add(path, Variant((float)i));
+		}
+	}
+
+	void DataTreeReadBench(void* data)
+	{
+		DataTreeBench* b = static_cast<DataTreeBench*>(data);
+		float sum = 0.0f;
+		for (int i = 0; i < b->tree->GetNumBranches(); ++i)
+		{
+			for (unsigned j = 0; j < b->tree->GetNumItemsInBranch(i); ++j)
+				sum += b->tree->GetBranchItem(i, j).GetFloat();
+		}
+		b->sum = sum;
+	}
+
+	void DataTreeFlattenBench(void* data)
+	{
+		DataTreeBench* b = static_cast<DataTreeBench*>(data);
+		b->tree->Flatten();
+	}
+
+	void DataTreeGraftBench(void* data)
+	{
+		DataTreeBench* b = static_cast<DataTreeBench*>(data);
+		b->tree->Graft();
+	}
+
+	///////////////////////
+	// synthetic graphs
+
+	// n Maths_Addition components in a binary tree: input X of component i > 0 is the sum of
+	// component (i - 1) / 2, input Y is left to its default. The graph is log2(n) deep and n / 2 wide,
+	// and setting Y of a leaf dirties that leaf only.
+	void BuildSyntheticGraph(IoGraph& graph, unsigned n)
+	{
+		graph.Clear();
+		for (unsigned i = 0; i < n; ++i)
+		{
+			SharedPtr<IoComponentBase> component = DynamicCast<IoComponentBase>(graph.GetContext()->CreateObject("Maths_Addition"));
+			component->ID = "synthetic_" + String(i);
+			component->type = "Maths_Addition";
+			component->EnableSolve();
+			graph.AddNewComponent(component);
+		}
+		for (unsigned i = 1; i < n; ++i)
+			graph.AddConnection((int)(i - 1) / 2, 0, (int)i, 0);
+	}
+
+	struct GraphBench
+	{
+		SharedPtr<IoGraph> graph;
+		unsigned numComponents;
+		float leafValue;
+	};
+
+	void GraphBuildBench(void* data)
+	{
+		GraphBench* b = static_cast<GraphBench*>(data);
+		BuildSyntheticGraph(*b->graph, b->numComponents);
+	}
+
+	//every component, as on the first solve after loading
+	void GraphSolveBench(void* data)
+	{
+		GraphBench* b = static_cast<GraphBench*>(data);
+		b->graph->SetIncrementalSolve(false);
+		b->graph->TopoSolveGraph();
+		b->graph->SetIncrementalSolve(true);
+	}
+
+	//one changed input, as when a slider is dragged
+	void GraphResolveBench(void* data)
+	{
+		GraphBench* b = static_cast<GraphBench*>(data);
+		b->leafValue += 1.0f;
+		IoDataTree tree(b->graph->GetContext(), Variant(b->leafValue));
+		b->graph->SetInputIoDataTree(b->numComponents - 1, 1, tree);
+		b->graph->TopoSolveGraph();
+	}
+
+	///////////////////////
+	// binary graph files
+
+	struct SerializationBench
+	{
+		SharedPtr<IoGraph> graph;
+		SharedPtr<IoGraph> loaded;
+		String path;
+	};
+
+	void SaveBinaryBench(void* data)
+	{
+		SerializationBench* b = static_cast<SerializationBench*>(data);
+		IoSerialization::SaveGraphBinary(*b->graph, b->path);
+	}
+
+	void LoadBinaryBench(void* data)
+	{
+		SerializationBench* b = static_cast<SerializationBench*>(data);
+		b->loaded->Clear();
+		IoSerialization::LoadGraph(*b->loaded, b->path);
+	}
+
+	bool SameBuffers(const PODVector<float>& a, const PODVector<float>& b)
+	{
+		return a.Size() == b.Size() && (a.Empty() || memcmp(&a[0], &b[0], a.Size() * sizeof(float)) == 0);
+	}
+
+	bool SameMesh(const Variant& a, const Variant& b)
+	{
+		ConstTriMeshDataPtr dataA = TriMesh_GetData(a);
+		ConstTriMeshDataPtr dataB = TriMesh_GetData(b);
+		if (!dataA || !dataB)
+			return false;
+
+		const PODVector<int>& facesA = dataA->GetFaces();
+		const PODVector<int>& facesB = dataB->GetFaces();
+		return SameBuffers(dataA->GetVertices(), dataB->GetVertices()) &&
+			SameBuffers(dataA->GetNormals(), dataB->GetNormals()) &&
+			facesA.Size() == facesB.Size() && (facesA.Empty() || memcmp(&facesA[0], &facesB[0], facesA.Size() * sizeof(int)) == 0);
+	}
+}
+
+IogramBench::IogramBench(Context* context) :
+	Application(context),
+	repeat_(5),
+	failed_(false)
+{
+	context->RegisterSubsystem(new Script(context));
+}
+
+void IogramBench::Setup()
+{
+	const Vector<String>& args = GetArguments();
+	for (unsigned i = 0; i + 1 < args.Size(); ++i)
+	{
+		if (args[i] == "-output")
+			outputPath_ = args[i + 1];
+		else if (args[i] == "-repeat")
+			repeat_ = Max(ToInt(args[i + 1]), 1);
+		else if (args[i] == "-filter")
+			filter_ = args[i + 1];
+		else if (args[i] == "-graphs")
+			graphDir_ = args[i + 1];
+	}
+
+	//no window, no renderer, no sound and no resources
+	engineParameters_["Headless"] = true;
+	engineParameters_["Sound"] = false;
+	engineParameters_["LogName"] = GetSubsystem<FileSystem>()->GetProgramDir() + GetTypeName() + ".log";
+	engineParameters_[EP_RESOURCE_PATHS] = "";
+	engineParameters_[EP_RESOURCE_PACKAGES] = "";
+	engineParameters_[EP_AUTOLOAD_PATHS] = "";
+}
+
+void IogramBench::Start()
+{
+	RegisterCoreComponents(context_);
+	IoSerialization::SetContext(context_);
+
+	RunMeshBenches();
+	RunReaderBenches();
+	RunDataTreeBenches();
+	RunGraphBenches();
+	RunSerializationBenches();
+
+	exitCode_ = WriteReport() && !failed_ ? EXIT_SUCCESS : EXIT_FAILURE;
+	engine_->Exit();
+}
+
+bool IogramBench::IsSelected(const String& name) const
+{
+	return filter_.Empty() || name.Contains(filter_);
+}
+
+void IogramBench::Run(const String& name, unsigned size, BenchFunction func, void* data)
+{
+	if (!IsSelected(name))
+		return;
+
+	PODVector<long long> times;
+	for (int r = 0; r < repeat_; ++r)
+	{
+		HiresTimer timer;
+		func(data);
+		times.Push(timer.GetUSec(false));
+	}
+
+	JSONValue result;
+	result.Set("name", name);
+	result.Set("size", size);
+	result.Set("time", TimingStats(times));
+	results_.Push(result);
+
+	PrintLine(name + " " + String(size) + ": median " + String(result.Get("time").Get("median").GetDouble() / 1000.0) + " ms");
+}
+
+void IogramBench::RunMeshBenches()
+{
+	static const unsigned resolutions[] = { 32, 128 };
+	for (unsigned r = 0; r < 2; ++r)
+	{
+		MeshBench b;
+		TriMeshDataPtr sphere = MakeSphere(resolutions[r]);
+		b.mesh = TriMesh_Make(sphere);
+		b.data = TriMesh_GetData(b.mesh);
+		b.vertexList = TriMesh_GetVertexList(b.mesh);
+		b.faceList = TriMesh_GetFaceList(b.mesh);
+		b.queue = GetSubsystem<WorkQueue>();
+
+		unsigned numFaces = b.data->GetNumFaces();
+		for (unsigned i = 0; i < 3 * numFaces; ++i)
+			b.soup.Push(b.data->GetVertex(b.data->GetFaceIndex(i)));
+
+		SetRandomSeed(1);
+		for (unsigned i = 0; i < numFaces; ++i)
+			b.queries.Push(Vector3(Random(-2.0f, 2.0f), Random(-2.0f, 2.0f), Random(-2.0f, 2.0f)));
+		//the tree is kept with the mesh, build it before timing the queries
+		b.data->GetAABB();
+
+		Run("TriMesh_Make", numFaces, TriMeshMakeBench, &b);
+		Run("WeldVertices", numFaces, WeldVerticesBench, &b);
+		Run("TriMeshAABB", numFaces, AABBBuildBench, &b);
+		Run("TriMeshClosestPoints", numFaces, ClosestPointsBench, &b);
+		Run("TriMesh_Remesh", numFaces, RemeshBench, &b);
+	}
+
+	static const unsigned grids[] = { 32, 96 };
+	for (unsigned g = 0; g < 2; ++g)
+	{
+		if (!IsSelected("MarchingCubes"))
+			break;
+
+		//signed distance to a unit sphere, sampled on a grid over [-1.5, 1.5]^3; x runs fastest
+		MarchingCubesBenchData b;
+		b.res = grids[g];
+		unsigned numPoints = b.res * b.res * b.res;
+		b.values.resize(numPoints);
+		b.points.resize(numPoints, 3);
+		for (unsigned z = 0; z < b.res; ++z)
+		{
+			for (unsigned y = 0; y < b.res; ++y)
+			{
+				for (unsigned x = 0; x < b.res; ++x)
+				{
+					unsigned i = x + b.res * (y + b.res * z);
+					Vector3 p = Vector3((float)x, (float)y, (float)z) * (3.0f / (b.res - 1)) - Vector3::ONE * 1.5f;
+					b.points.row(i) = Eigen::RowVector3f(p.x_, p.y_, p.z_);
+					b.values(i) = p.Length() - 1.0f;
+				}
+			}
+		}
+		Run("MarchingCubes", numPoints, MarchingCubesBench, &b);
+	}
+}
+
+void IogramBench::RunReaderBenches()
+{
+	if (!IsSelected("ParseOBJ") && !IsSelected("ParsePLY") && !IsSelected("ParseSTL"))
+		return;
+
+	static const unsigned resolutions[] = { 32, 256 };
+	for (unsigned r = 0; r < 2; ++r)
+	{
+		ReaderBench b;
+		TriMeshDataPtr sphere = MakeSphere(resolutions[r]);
+		WriteOBJ(*sphere, b.obj);
+		WritePLY(*sphere, b.ply);
+		WriteSTL(*sphere, b.stl);
+		b.queue = GetSubsystem<WorkQueue>();
+
+		unsigned numFaces = sphere->GetNumFaces();
+		Run("ParseOBJ", numFaces, ParseOBJBench, &b);
+		Run("ParsePLY", numFaces, ParsePLYBench, &b);
+		Run("ParseSTL", numFaces, ParseSTLBench, &b);
+	}
+}
+
+void IogramBench::RunDataTreeBenches()
+{
+	static const unsigned sizes[] = { 1000, 100000 };
+	for (unsigned s = 0; s < 2; ++s)
+	{
+		DataTreeBench b;
+		b.context = context_;
+		b.numItems = sizes[s];
+		b.tree = new IoDataTree(context_);
+		Vector<int> path(2);
+		path[0] = 0;
+		for (unsigned i = 0; i < b.numItems; ++i)
+		{
+			path[1] = (int)(i / 100);
+			b.tree->Add(path, Variant((float)i));
+		}
+
+		Run("IoDataTree_Add", b.numItems, DataTreeAddBench, &b);
+		Run("IoDataTree_Read", b.numItems, DataTreeReadBench, &b);
+		Run("IoDataTree_Flatten", b.numItems, DataTreeFlattenBench, &b);
+		Run("IoDataTree_Graft", b.numItems, DataTreeGraftBench, &b);
+	}
+}
+
+void IogramBench::RunGraphBenches()
+{
+	if (!IsSelected("Graph_") && graphDir_.Empty())
+		return;
+
+	static const unsigned sizes[] = { 10, 100, 1000, 10000 };
+	for (unsigned s = 0; s < 4; ++s)
+	{
+		GraphBench b;
+		b.graph = new IoGraph(context_);
+		b.numComponents = sizes[s];
+		b.leafValue = 0.0f;
+
+		Run("Graph_Build", b.numComponents, GraphBuildBench, &b);
+		BuildSyntheticGraph(*b.graph, b.numComponents);
+		Run("Graph_Solve", b.numComponents, GraphSolveBench, &b);
+		b.graph->TopoSolveGraph();
+		Run("Graph_Resolve", b.numComponents, GraphResolveBench, &b);
+
+		b.graph->SetParallelSolve(true);
+		Run("Graph_ParallelSolve", b.numComponents, GraphSolveBench, &b);
+
+		if (!graphDir_.Empty())
+		{
+			GetSubsystem<FileSystem>()->CreateDir(graphDir_);
+			IoSerialization::SaveGraph(*b.graph, graphDir_ + "/synthetic_" + String(b.numComponents) + ".graph");
+		}
+	}
+}
+
+void IogramBench::RunSerializationBenches()
+{
+	if (!IsSelected("Graph_SaveBinary") && !IsSelected("Graph_LoadBinary"))
+		return;
+
+	String path = GetSubsystem<FileSystem>()->GetCurrentDir() + "BenchMesh.graph";
+	if (!CheckMeshRoundTrip(path))
+	{
+		URHO3D_LOGERROR("IogramBench::RunSerializationBenches --- mesh changed in a binary graph round trip");
+		failed_ = true;
+		return;
+	}
+
+	static const unsigned resolutions[] = { 32, 256 };
+	for (unsigned r = 0; r < 2; ++r)
+	{
+		//the mesh is an unlinked input, stored in the file with the graph
+		SerializationBench b;
+		b.graph = new IoGraph(context_);
+		b.loaded = new IoGraph(context_);
+		b.path = path;
+		BuildSyntheticGraph(*b.graph, 1);
+		Variant mesh = TriMesh_Make(MakeSphere(resolutions[r]));
+		b.graph->SetInputIoDataTree(0, 1, IoDataTree(context_, mesh));
+
+		unsigned numFaces = TriMesh_GetData(mesh)->GetNumFaces();
+		Run("Graph_SaveBinary", numFaces, SaveBinaryBench, &b);
+		Run("Graph_LoadBinary", numFaces, LoadBinaryBench, &b);
+	}
+
+	GetSubsystem<FileSystem>()->Delete(path);
+}
+
+bool IogramBench::CheckMeshRoundTrip(const String& path)
+{
+	//a mesh with labels, and a list holding a mesh and a number
+	Variant mesh = TriMesh_Make(MakeSphere(8));
+	VariantMap labelled = mesh.GetVariantMap();
+	VariantVector labels;
+	for (unsigned i = 0; i < TriMesh_GetData(mesh)->GetNumVertices(); ++i)
+		labels.Push((int)(i % 3));
+	labelled["labels"] = labels;
+
+	Vector<Variant> items;
+	items.Push(mesh);
+	items.Push(1.5f);
+
+	SharedPtr<IoGraph> graph(new IoGraph(context_));
+	BuildSyntheticGraph(*graph, 2);
+	graph->SetInputIoDataTree(0, 1, IoDataTree(context_, Variant(labelled)));
+	graph->SetInputIoDataTree(1, 1, IoDataTree(context_, items));
+	IoSerialization::SaveGraphBinary(*graph, path);
+
+	SharedPtr<IoGraph> loaded(new IoGraph(context_));
+	IoSerialization::LoadGraph(*loaded, path);
+	if (loaded->GetDummyNodeCount() != 2)
+		return false;
+
+	const IoDataTree& labelledTree = loaded->GetComponent(0)->inputSlots_[1]->GetIoDataTree();
+	const IoDataTree& itemsTree = loaded->GetComponent(1)->inputSlots_[1]->GetIoDataTree();
+	if (labelledTree.GetNumItems() != 1 || itemsTree.GetNumItems() != 2)
+		return false;
+
+	const Variant& labelledBack = labelledTree.GetBranchItem(0, 0);
+	if (!SameMesh(labelled, labelledBack))
+		return false;
+	VariantMap::ConstIterator it = labelledBack.GetVariantMap().Find("labels");
+	if (it == labelledBack.GetVariantMap().End() || it->second_ != labelled["labels"])
+		return false;
+
+	return SameMesh(mesh, itemsTree.GetBranchItem(0, 0)) && itemsTree.GetBranchItem(0, 1) == Variant(1.5f);
+}
+
+bool IogramBench::WriteReport()
+{
+	if (outputPath_.Empty())
+		return true;
+
+	//times are in microseconds
+	SharedPtr<JSONFile> json(new JSONFile(context_));
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	json->GetRoot().Set("threads", queue ? queue->GetNumThreads() : 0);
+	json->GetRoot().Set("repeat", repeat_);
+	json->GetRoot().Set("benchmarks", results_);
+
+	if (!json->SaveFile(outputPath_))
+	{
+		URHO3D_LOGERROR("IogramBench::WriteReport --- could not write " + outputPath_);
+		return false;
+	}
+
+	return true;
+}
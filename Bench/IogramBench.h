@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Engine/Application.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Resource/JSONValue.h>
+
+// Headless micro-benchmarks of the geometry kernels and the graph solver:
+//   Bench [-output <json file>] [-repeat <n>] [-filter <substring>] [-graphs <dir>]
+// Every benchmark is run n times (default 5) at a few input sizes, and the min/median/mean time in
+// microseconds of each is logged and, with -output, written as JSON:
+//   { "threads": <worker threads>, "repeat": <n>,
+//     "benchmarks": [ { "name": <kernel>, "size": <faces, items or components>, "time": { "count", "min", "median", "mean" } } ] }
+// -filter runs only the benchmarks whose name contains the substring.
+// The binary graph benchmarks first check that a graph holding a mesh reads back unchanged, and the
+// exit status is 1 if it does not.
+// -graphs also saves the synthetic graphs of 10 to 10000 components used by the graph benchmarks as
+// <dir>/synthetic_<n>.graph, for timing with Player -batch <graph> -repeat <n> -timings <file>.
+// The "bench" build target runs it with -output bench.json in the build directory.
+class IogramBench : public Urho3D::Application {
+	URHO3D_OBJECT(IogramBench, Urho3D::Application)
+public:
+	IogramBench(Urho3D::Context* context);
+	virtual void Setup();
+	virtual void Start();
+
+	typedef void(*BenchFunction)(void* data);
+
+	// times func(data) repeat_ times and adds the result to the report
+	void Run(const Urho3D::String& name, unsigned size, BenchFunction func, void* data);
+	// false if -filter excludes the benchmark, so that its inputs need not be built
+	bool IsSelected(const Urho3D::String& name) const;
+
+private:
+	void RunMeshBenches();
+	void RunReaderBenches();
+	void RunDataTreeBenches();
+	void RunGraphBenches();
+	void RunSerializationBenches();
+	bool CheckMeshRoundTrip(const Urho3D::String& path);
+	bool WriteReport();
+
+	Urho3D::String outputPath_;
+	Urho3D::String filter_;
+	Urho3D::String graphDir_;
+	int repeat_;
+	bool failed_;
+	Urho3D::JSONArray results_;
+};
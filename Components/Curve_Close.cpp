@@ -36,6 +36,7 @@ Curve_Close::Curve_Close(Context* context) :
 	SetName("CurveLength");
 	SetFullName("Curve Length");
 	SetDescription("Calculates the length of a curve.");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -47,6 +47,7 @@ Curve_HelixSpiral::Curve_HelixSpiral(Context* context) : IoComponentBase(context
     SetDescription("Construct a helix or spiral polyline");
     SetGroup(IoComponentGroup::CURVE);
     SetSubgroup("Primitive");
+    SetPure(true);
     
     inputSlots_[0]->SetName("lower_r");
     inputSlots_[0]->SetVariableName("r_L");
@@ -38,6 +38,7 @@ Curve_LineSegment::Curve_LineSegment(Context* context) :
 	SetDescription("Construct a line segment from start and end vertices");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("StartVertex");
 	inputSlots_[0]->SetVariableName("A");
@@ -173,6 +173,7 @@ Curve_MakeKnot::Curve_MakeKnot(Context* context) : IoComponentBase(context, 2, 1
 	SetDescription("Converts a polyline into a knot");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
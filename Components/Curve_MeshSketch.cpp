@@ -37,6 +37,7 @@ Curve_MeshSketch::Curve_MeshSketch(Context* context) :
 	SetName("MeshSketch");
 	SetFullName("Mesh Sketch");
 	SetDescription("Sketch on a Mesh");
+	SetMainThreadOnly(true);
 
 	
 	AddInputSlot(
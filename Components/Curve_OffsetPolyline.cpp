@@ -38,6 +38,7 @@ Curve_OffsetPolyline::Curve_OffsetPolyline(Context* context) :
 	SetDescription("Offsets a polyline by offsetting its vertices");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
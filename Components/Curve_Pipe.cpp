@@ -42,6 +42,7 @@ Curve_Pipe::Curve_Pipe(Context* context) :
 	SetName("Pipe");
 	SetFullName("Pipe a polyline");
 	SetDescription("Construct a polygon with n sides");
+	SetPure(true);
 
 	AddInputSlot(
 		"Curve",
@@ -43,6 +43,7 @@ Curve_Polygon::Curve_Polygon(Context* context) :
 	SetDescription("Construct a polygon with n sides");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Number of sides");
 	inputSlots_[0]->SetVariableName("N");
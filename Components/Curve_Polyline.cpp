@@ -38,6 +38,7 @@ Curve_Polyline::Curve_Polyline(Context* context) :
 	SetDescription("Construct a polyline from a vertex list");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Vertices");
 	inputSlots_[0]->SetVariableName("V");
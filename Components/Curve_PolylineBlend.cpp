@@ -38,6 +38,7 @@ Curve_PolylineBlend::Curve_PolylineBlend(Context* context) : IoComponentBase(con
 	SetDescription("Lofts a collection of polylines into a mesh");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P1");
@@ -39,6 +39,7 @@ Curve_PolylineDivide::Curve_PolylineDivide(Context* context) :
 	SetDescription("Divide polyline into equal parts");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -39,6 +39,7 @@ Curve_PolylineEvaluate::Curve_PolylineEvaluate(Context* context) :
 	SetDescription("Evaluate point on polyline from parameter");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -38,6 +38,7 @@ Curve_PolylineLoft::Curve_PolylineLoft(Context* context) : IoComponentBase(conte
 	SetDescription("Perform loft operation on a list of polylines");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("PolylineList");
 	inputSlots_[0]->SetVariableName("L");
@@ -38,6 +38,7 @@ Curve_PolylineRefine::Curve_PolylineRefine(Context* context) :
 	SetDescription("Refine polyline based on list of parameters");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -38,6 +38,7 @@ Curve_PolylineRevolve::Curve_PolylineRevolve(Context* context) : IoComponentBase
 	SetDescription("Creates a surface of revolution from a polyline and an axis");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Section");
 	inputSlots_[0]->SetVariableName("S");
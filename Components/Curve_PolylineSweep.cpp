@@ -38,6 +38,7 @@ Curve_PolylineSweep::Curve_PolylineSweep(Context* context) : IoComponentBase(con
     SetDescription("Sweeps a section curve along one or two rail curves");
     SetGroup(IoComponentGroup::CURVE);
     SetSubgroup("Operators");
+    SetPure(true);
     
     inputSlots_[0]->SetName("Section");
     inputSlots_[0]->SetVariableName("S");
@@ -36,6 +36,7 @@ Curve_Rebuild::Curve_Rebuild(Context* context) :
 	SetName("RefinePolyline");
 	SetFullName("Refine Polyline");
 	SetDescription("Refine polyline based on list of parameters");
+	SetPure(true);
 
 	AddInputSlot(
 		"Curve",
@@ -39,6 +39,7 @@ Curve_SelfIntersections::Curve_SelfIntersections(Context* context) : IoComponent
 	SetDescription("Finds Self Intersections of a Planar Polyline");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -44,6 +44,7 @@ Curve_SketchPlane::Curve_SketchPlane(Context* context) :
 	SetName("SketchPlane");
 	SetFullName("Sketch Plane");
 	SetDescription("Create a sketch and position it in 3D.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Curves",
@@ -39,6 +39,7 @@ Curve_SmoothPolyline::Curve_SmoothPolyline(Context* context) :
 	SetDescription("Smooth polyline via subdivision");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
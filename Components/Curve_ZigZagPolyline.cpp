@@ -47,6 +47,7 @@ Curve_ZigZagPolyline::Curve_ZigZagPolyline(Context* context) : IoComponentBase(c
 	SetDescription("Construct a zig zag polyline");
 	SetGroup(IoComponentGroup::CURVE);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("XScale");
 	inputSlots_[0]->SetVariableName("XS");
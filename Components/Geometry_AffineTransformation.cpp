@@ -44,6 +44,7 @@ Geometry_AffineTransformation::Geometry_AffineTransformation(Urho3D::Context* co
 	SetDescription("Apply spatial transformation to geometric object");
 	SetGroup(IoComponentGroup::TRANSFORM);
 	SetSubgroup("Geometry");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Geometry");
 	inputSlots_[0]->SetVariableName("G");
@@ -88,7 +89,6 @@ void Geometry_AffineTransformation::SolveInstance(
 	Variant inGeom = inSolveInstance[0];
 	VariantVector vertexList;
 	if (TriMesh_Verify(inGeom)) {
-		vertexList = TriMesh_GetVertexList(inGeom);
 		is_tri_mesh = true;
 	}
 	else if (Polyline_Verify(inGeom)) {
@@ -116,7 +116,17 @@ void Geometry_AffineTransformation::SolveInstance(
 
 	Variant geomOut;
 
-	if (is_tri_mesh || is_polyline) {
+	if (is_tri_mesh) {
+
+		// transform the packed vertex buffer directly, keeping any face labels
+		VariantMap geomMap = TriMesh_ApplyTransform(inGeom, transform).GetVariantMap();
+		VariantVector labelList = TriMesh_GetLabelList(inGeom);
+		if (!labelList.Empty()) {
+			geomMap["labels"] = labelList;
+		}
+		geomOut = geomMap;
+	}
+	else if (is_polyline) {
 
 		VariantMap geomMap = inGeom.GetVariantMap();
 		VariantVector newVertexList;
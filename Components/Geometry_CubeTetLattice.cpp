@@ -196,6 +196,7 @@ Geometry_CubeTetLattice::Geometry_CubeTetLattice(Urho3D::Context* context) : IoC
 	SetName("CubeTetLattice");
 	SetFullName("CubeTetLattice");
 	SetDescription("Creates a 48 point cube-tet lattice.");
+	SetPure(true);
 
 	AddInputSlot(
 		"Centers",
@@ -107,6 +107,7 @@ Geometry_FillWithShape::Geometry_FillWithShape(Urho3D::Context* context) : IoCom
 	SetName("ProjectOnto");
 	SetFullName("ProjectOnto");
 	SetDescription("Projects geometry on to other geometry");
+	SetPure(true);
 
 	AddInputSlot(
 		"Source",
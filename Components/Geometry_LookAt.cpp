@@ -36,6 +36,7 @@ Geometry_LookAt::Geometry_LookAt(Urho3D::Context* context) : IoComponentBase(con
 	SetName("ConstructRotation");
 	SetFullName("Construct Rotation Quaternion");
 	SetDescription("Construct a rotation quaternion from axis and angle");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("TargetPoint");
 	inputSlots_[0]->SetVariableName("P");
@@ -39,6 +39,7 @@ Geometry_PlaneTransform::Geometry_PlaneTransform(Urho3D::Context* context) : IoC
     SetDescription("Construct Transform from Point and Normal");
     SetGroup(IoComponentGroup::TRANSFORM);
     SetSubgroup("Matrix");
+    SetPure(true);
     
     Variant y_unit = Vector3(0.0f, 1.0f, 0.0f);
     Variant default_rot = Matrix3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
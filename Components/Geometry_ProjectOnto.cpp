@@ -41,6 +41,7 @@ Geometry_ProjectOnto::Geometry_ProjectOnto(Urho3D::Context* context) : IoCompone
 	SetName("ProjectOnto");
 	SetFullName("ProjectOnto");
 	SetDescription("Projects geometry on to other geometry");
+	SetPure(true);
 
 	AddInputSlot(
 		"Source",
@@ -38,6 +38,7 @@ Geometry_ReadDXF::Geometry_ReadDXF(Urho3D::Context* context) : IoComponentBase(c
 	SetName("ReadDXF");
 	SetFullName("Read DXF");
 	SetDescription("Reads a DXF file. Supports Meshes, Polylines, and Points.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Path",
@@ -43,6 +43,7 @@ Geometry_ReadTET::Geometry_ReadTET(Context* context) : IoComponentBase(context,
 	SetName("ReadOBJ");
 	SetFullName("ReadOBJ");
 	SetDescription("Read TriMesh from OBJ file");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("File");
 	inputSlots_[0]->SetVariableName("File");
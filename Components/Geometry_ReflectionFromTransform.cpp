@@ -39,6 +39,7 @@ Geometry_ReflectionFromTransform::Geometry_ReflectionFromTransform(Urho3D::Conte
     SetDescription("Construct a reflection transformation from plane");
     SetGroup(IoComponentGroup::TRANSFORM);
     SetSubgroup("Matrix");
+    SetPure(true);
     
     Variant y_unit = Vector3(0.0f, 1.0f, 0.0f);
     Variant default_rot = Matrix3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
@@ -38,6 +38,7 @@ Geometry_Rotation::Geometry_Rotation(Urho3D::Context* context) : IoComponentBase
 	SetDescription("Construct a rotation quaternion from axis and angle");
 	SetGroup(IoComponentGroup::TRANSFORM);
 	SetSubgroup("Matrix");
+	SetPure(true);
 
 	Variant y_unit = Vector3(0.0f, 1.0f, 0.0f);
 	Variant default_rot = Matrix3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
@@ -38,6 +38,7 @@ Geometry_WriteDXF::Geometry_WriteDXF(Urho3D::Context* context) : IoComponentBase
 	SetName("WriteDXF");
 	SetFullName("Write DXF");
 	SetDescription("Writes a DXF file. Supports Meshes, Polylines, and Points.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Path",
@@ -154,7 +155,7 @@ void Geometry_WriteDXF::SolveInstance(
 
 		//only support triangle meshes right now
 		if (TriMesh_Verify((*mMap))) {
-			dWriter->SetMesh((*mMap)["vertices"].GetVariantVector(), (*mMap)["faces"].GetVariantVector(), layer);
+			dWriter->SetMesh(TriMesh_GetVertexList(meshes[i]), TriMesh_GetFaceList(meshes[i]), layer);
 		}
 		else if (NMesh_Verify((*mMap))) {
 			Variant triMesh = NMesh_ConvertToTriMesh(*mMap);
@@ -133,6 +133,7 @@ Graphics_CreateMaterial::Graphics_CreateMaterial(Urho3D::Context* context) : IoC
 	SetName("CreateMaterial");
 	SetFullName("Create Material");
 	SetDescription("Create a material from parameters");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Technique",
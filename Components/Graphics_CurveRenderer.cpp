@@ -36,6 +36,7 @@ Graphics_CurveRenderer::Graphics_CurveRenderer(Urho3D::Context* context) : IoCom
 	SetName("Curve Renderer");
 	SetFullName("Curve Renderer");
 	SetDescription("Curve Renderer");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Curve",
@@ -35,6 +35,7 @@ Graphics_CurveToModel::Graphics_CurveToModel(Urho3D::Context* context) : IoCompo
 	SetName("CurveToModel");
 	SetFullName("Curve To Model");
 	SetDescription("Converts a curve to a model on disk with a pointer to the model");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -41,6 +41,7 @@ Graphics_Grid::Graphics_Grid(Urho3D::Context* context) : IoComponentBase(context
 	SetName("Sun");
 	SetFullName("Sun");
 	SetDescription("Create a directional Sun light");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Transform",
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Graphics_InstancedMeshRenderer.h"
+#include "Geomlib_ConstructTransform.h"
+#include "TriMesh.h"
+
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/StaticModelGroup.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+String Graphics_InstancedMeshRenderer::iconTexture = "Textures/Icons/Scene_MeshRenderer.png";
+
+Graphics_InstancedMeshRenderer::Graphics_InstancedMeshRenderer(Urho3D::Context* context) : IoComponentBase(context, 5, 2)
+{
+	SetName("InstancedMeshRenderer");
+	SetFullName("InstancedMeshRenderer");
+	SetDescription("Renders copies of one mesh at many transforms with hardware instancing.");
+	SetMainThreadOnly(true);
+
+	inputSlots_[0]->SetName("Mesh");
+	inputSlots_[0]->SetVariableName("M");
+	inputSlots_[0]->SetDescription("Mesh to repeat");
+	inputSlots_[0]->SetVariantType(VariantType::VAR_VARIANTMAP);
+	inputSlots_[0]->SetDataAccess(DataAccess::ITEM);
+
+	inputSlots_[1]->SetName("Transforms");
+	inputSlots_[1]->SetVariableName("T");
+	inputSlots_[1]->SetDescription("Transform of each copy (matrix, or point to translate to)");
+	inputSlots_[1]->SetVariantType(VariantType::VAR_MATRIX3X4);
+	inputSlots_[1]->SetDataAccess(DataAccess::LIST);
+
+	inputSlots_[2]->SetName("Material");
+	inputSlots_[2]->SetVariableName("MT");
+	inputSlots_[2]->SetDescription("Path to material.");
+	inputSlots_[2]->SetVariantType(VariantType::VAR_STRING);
+	inputSlots_[2]->SetDataAccess(DataAccess::ITEM);
+
+	inputSlots_[3]->SetName("SplitVertices");
+	inputSlots_[3]->SetVariableName("S");
+	inputSlots_[3]->SetDescription("Split the vertices for flat shading");
+	inputSlots_[3]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[3]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[3]->SetDefaultValue(true);
+	inputSlots_[3]->DefaultSet();
+
+	inputSlots_[4]->SetName("Colors");
+	inputSlots_[4]->SetVariableName("C");
+	inputSlots_[4]->SetDescription("Color of each copy, repeated if shorter than the transform list");
+	inputSlots_[4]->SetVariantType(VariantType::VAR_COLOR);
+	inputSlots_[4]->SetDataAccess(DataAccess::LIST);
+	inputSlots_[4]->SetDefaultValue(Color::WHITE);
+	inputSlots_[4]->DefaultSet();
+
+	outputSlots_[0]->SetName("NodeID");
+	outputSlots_[0]->SetVariableName("ID");
+	outputSlots_[0]->SetDescription("ID of the node holding all copies");
+	outputSlots_[0]->SetVariantType(VariantType::VAR_INT);
+	outputSlots_[0]->SetDataAccess(DataAccess::ITEM);
+
+	outputSlots_[1]->SetName("ModelName");
+	outputSlots_[1]->SetVariableName("ModelName");
+	outputSlots_[1]->SetDescription("Name of the shared model");
+	outputSlots_[1]->SetVariantType(VariantType::VAR_STRING);
+	outputSlots_[1]->SetDataAccess(DataAccess::ITEM);
+}
+
+Graphics_InstancedMeshRenderer::~Graphics_InstancedMeshRenderer()
+{
+	PreLocalSolve();
+}
+
+void Graphics_InstancedMeshRenderer::PreLocalSolve()
+{
+	//delete old nodes
+	Scene* scene = (Scene*)GetGlobalVar("Scene").GetPtr();
+	if (scene)
+	{
+		for (unsigned i = 0; i < trackedItems.Size(); i++)
+		{
+			Node* oldNode = scene->GetNode(trackedItems[i]);
+			if (oldNode)
+			{
+				oldNode->Remove();
+			}
+		}
+	}
+	trackedItems.Clear();
+
+	//release resources
+	ResourceCache* rc = GetSubsystem<ResourceCache>();
+	for (unsigned i = 0; i < trackedResources.Size(); i++)
+	{
+		const String& resourcePath = trackedResources[i];
+		if (resourcePath.Contains("tmp/models/"))
+			rc->ReleaseResource<Model>(resourcePath);
+		if (resourcePath.Contains("tmp/materials/"))
+			rc->ReleaseResource<Material>(resourcePath);
+	}
+	trackedResources.Clear();
+}
+
+void Graphics_InstancedMeshRenderer::SolveInstance(
+	const Vector<Variant>& inSolveInstance,
+	Vector<Variant>& outSolveInstance
+)
+{
+	if (!TriMesh_Verify(inSolveInstance[0]))
+	{
+		URHO3D_LOGERROR("InstancedMeshRenderer --- invalid Mesh input");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	VariantVector transforms = inSolveInstance[1].GetVariantVector();
+	if (transforms.Empty() || transforms[0].GetType() == VAR_NONE)
+	{
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	VariantVector colors = inSolveInstance[4].GetVariantVector();
+	if (colors.Empty() || colors[0].GetType() != VAR_COLOR)
+	{
+		colors.Clear();
+		colors.Push(Color::WHITE);
+	}
+
+	String matPath = inSolveInstance[2].GetString();
+	if (inSolveInstance[2].GetType() == VAR_PTR)
+	{
+		Material* inMat = (Material*)inSolveInstance[2].GetPtr();
+		if (inMat)
+		{
+			matPath = inMat->GetName();
+		}
+	}
+
+	//adjust defaults so that alpha behaves correctly
+	if (matPath.Empty())
+	{
+		bool alpha = false;
+		for (unsigned i = 0; i < colors.Size(); ++i)
+		{
+			if (colors[i].GetColor().a_ < 1.0f)
+			{
+				alpha = true;
+				break;
+			}
+		}
+		matPath = alpha ? normalAlphaMat : normalMat;
+	}
+
+	Scene* scene = (Scene*)GetGlobalVar("Scene").GetPtr();
+	ResourceCache* rc = GetSubsystem<ResourceCache>();
+	Material* mat = rc->GetResource<Material>(matPath);
+	if (!scene || !mat)
+	{
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	// one model shared by every copy; the copies only differ in transform and material color
+	SharedPtr<Model> model(TriMesh_GetRenderMesh(inSolveInstance[0], GetContext(), VariantVector(), inSolveInstance[3].GetBool()));
+	if (!model)
+	{
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	Node* rootNode = scene->CreateChild("InstancedMeshPreviewNode");
+	trackedItems.Push(rootNode->GetID());
+
+	model->SetName("tmp/models/generated_instanced_model_" + String(rootNode->GetID()));
+	rc->AddManualResource(model);
+	trackedResources.Push(model->GetName());
+
+	Color existingColor = mat->GetShaderParameter("MatDiffColor").GetColor();
+
+	// one StaticModelGroup per distinct color: each group is a single instanced batch
+	HashMap<unsigned, StaticModelGroup*> groups;
+	for (unsigned i = 0; i < transforms.Size(); ++i)
+	{
+		Color col = colors[i % colors.Size()].GetColor();
+		unsigned key = col.ToUInt();
+
+		StaticModelGroup* group;
+		HashMap<unsigned, StaticModelGroup*>::Iterator it = groups.Find(key);
+		if (it != groups.End())
+		{
+			group = it->second_;
+		}
+		else
+		{
+			Node* groupNode = rootNode->CreateChild("InstanceGroup", LOCAL);
+			group = groupNode->CreateComponent<StaticModelGroup>(LOCAL);
+
+			SharedPtr<Material> cloneMat = mat->Clone();
+			cloneMat->SetName("tmp/materials/generated_instanced_mat_" + String(group->GetID()));
+			cloneMat->SetShaderParameter("MatDiffColor", existingColor.MultiplyComponents(col));
+			rc->AddManualResource(cloneMat);
+			trackedResources.Push(cloneMat->GetName());
+
+			group->SetModel(model);
+			group->SetMaterial(cloneMat);
+			group->SetCastShadows(true);
+			group->SetShadowDistance(100.0f);
+			groups[key] = group;
+		}
+
+		// instance nodes carry nothing but their transform
+		Matrix3x4 xform = Geomlib::ConstructTransform(transforms[i]);
+		Node* instanceNode = group->GetNode()->CreateChild(String::EMPTY, LOCAL);
+		instanceNode->SetTransform(xform.Translation(), xform.Rotation(), xform.Scale());
+		group->AddInstanceNode(instanceNode);
+	}
+
+	outSolveInstance[0] = rootNode->GetID();
+	outSolveInstance[1] = model->GetName();
+}
@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "IoComponentBase.h"
+#include <Urho3D/Graphics/Model.h>
+
+// Draws one mesh at every transform of a list. The copies are grouped by color into
+// StaticModelGroups that share a single Model, so Urho3D renders each group with hardware
+// instancing instead of one draw call (and one Model and Node) per copy.
+class URHO3D_API Graphics_InstancedMeshRenderer : public IoComponentBase {
+
+	URHO3D_OBJECT(Graphics_InstancedMeshRenderer, IoComponentBase)
+
+public:
+	Graphics_InstancedMeshRenderer(Urho3D::Context* context);
+	~Graphics_InstancedMeshRenderer();
+
+	static Urho3D::String iconTexture;
+
+	virtual void PreLocalSolve();
+
+	void SolveInstance(
+		const Urho3D::Vector<Urho3D::Variant>& inSolveInstance,
+		Urho3D::Vector<Urho3D::Variant>& outSolveInstance
+		);
+
+	Urho3D::String normalMat = "Materials/BasicPBR.xml";
+	Urho3D::String normalAlphaMat = "Materials/BasicPBRAlpha.xml";
+
+	Urho3D::Vector<int> trackedItems;
+	Urho3D::Vector<Urho3D::String> trackedResources;
+
+};
@@ -42,6 +42,7 @@ Graphics_LayersToImage::Graphics_LayersToImage(Context* context) : IoComponentBa
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Layers",
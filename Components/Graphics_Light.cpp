@@ -38,6 +38,7 @@ Graphics_Light::Graphics_Light(Urho3D::Context* context) : IoComponentBase(conte
 	SetName("Sun");
 	SetFullName("Sun");
 	SetDescription("Create a directional Sun light");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Transform",
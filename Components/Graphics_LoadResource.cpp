@@ -35,6 +35,7 @@ Graphics_LoadResource::Graphics_LoadResource(Urho3D::Context* context) : IoCompo
 	SetDescription("Loads a resource from a path");
 	SetGroup(IoComponentGroup::DISPLAY);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Path");
 	inputSlots_[0]->SetVariableName("P");
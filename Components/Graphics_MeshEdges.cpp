@@ -51,6 +51,7 @@ Graphics_MeshEdges::Graphics_MeshEdges(Urho3D::Context* context) : IoComponentBa
 	SetName("MeshRenderer");
 	SetFullName("MeshRenderer");
 	SetDescription("Converts a mesh to a viewable object in the scene.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Mesh",
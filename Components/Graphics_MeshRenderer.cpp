@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 //
 
+#include <cstring>
 #include <iostream>
 
 #include "Graphics_MeshRenderer.h"
@@ -29,9 +30,13 @@
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
 #include <Urho3D/Graphics/StaticModel.h>
 #include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
 #include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Scene/Scene.h>
 
 using namespace Urho3D;
 
@@ -42,6 +47,7 @@ Graphics_MeshRenderer::Graphics_MeshRenderer(Urho3D::Context* context) : IoCompo
 	SetName("MeshRenderer");
 	SetFullName("MeshRenderer");
 	SetDescription("Converts a mesh to a viewable object in the scene.");;
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -92,39 +98,26 @@ Graphics_MeshRenderer::Graphics_MeshRenderer(Urho3D::Context* context) : IoCompo
 
 Graphics_MeshRenderer::~Graphics_MeshRenderer()
 {
-
+	for (unsigned i = 0; i < proxies_.Size(); ++i)
+	{
+		ReleaseProxy(proxies_[i]);
+	}
 }
 
 void Graphics_MeshRenderer::PreLocalSolve()
 {
-	//delete old nodes
-	Scene* scene = (Scene*)GetGlobalVar("Scene").GetPtr();
-	if (scene)
-	{
-		for (int i = 0; i < trackedItems.Size(); i++)
-		{
-			Node* oldNode = scene->GetNode(trackedItems[i]);
-			if (oldNode)
-			{
-				oldNode->Remove();
-			}
-
-		}
-
-		trackedItems.Clear();
-	}
+	// proxies are handed out to the solve instances in order and the unused ones removed in PostLocalSolve,
+	// so an item that keeps its topology between solves keeps its node, model and buffers
+	numProxiesUsed_ = 0;
+}
 
-	//release resource
-	ResourceCache* rc = GetSubsystem<ResourceCache>();
-	for (int i = 0; i < trackedResources.Size(); i++)
+void Graphics_MeshRenderer::PostLocalSolve()
+{
+	for (unsigned i = numProxiesUsed_; i < proxies_.Size(); ++i)
 	{
-		String resourcePath = trackedResources[i];
-		if(resourcePath.Contains("tmp/models/"))
-			rc->ReleaseResource<Model>(trackedResources[i]);
-		if (resourcePath.Contains("tmp/materials/"))
-			rc->ReleaseResource<Material>(trackedResources[i]);
+		ReleaseProxy(proxies_[i]);
 	}
-
+	proxies_.Resize(numProxiesUsed_);
 }
 
 void Graphics_MeshRenderer::SolveInstance(
@@ -179,7 +172,6 @@ void Graphics_MeshRenderer::SolveInstance(
             if (nodeId == -1)
                 SetAllOutputsNull(outSolveInstance);
         
-            trackedItems.Push(nodeId);
             outSolveInstance[0] = nodeId;
             outSolveInstance[1] = model_pointer.GetPtr();
 			outSolveInstance[2] = model_name;
@@ -193,7 +185,6 @@ void Graphics_MeshRenderer::SolveInstance(
             if (nodeId == -1)
                 SetAllOutputsNull(outSolveInstance);
             
-            trackedItems.Push(nodeId);
             outSolveInstance[0] = nodeId;
             outSolveInstance[1] = model_pointer.GetPtr();
 	    outSolveInstance[2] = model_name;
@@ -215,147 +206,67 @@ int Graphics_MeshRenderer::TriMesh_Render(Urho3D::Variant trimesh,
                                           Urho3D::Variant& model_pointer,
 					  Urho3D::String& model_name)
 {
-    
-    Vector<VertexData> vbd;
-    Vector<Vector3> tmpVerts;
-    Vector<int> tmpFaces;
-    
-    VariantVector verts = TriMesh_GetVertexList(trimesh);
-    VariantVector faces = TriMesh_GetFaceList(trimesh);
-    VariantVector normals;
-    
+    ConstTriMeshDataPtr data = TriMesh_GetData(trimesh);
+    if (!data)
+        return -1;
+
+    unsigned numVerts = data->GetNumVertices();
+    unsigned numIndices = 3 * data->GetNumFaces();
+    const int* faces = data->GetFaceData();
+
+    PODVector<VertexData> vbd;
+    PODVector<int> indices;
+    BoundingBox box;
+
     if (flatShaded)
     {
-        normals = TriMesh_ComputeFaceNormals(trimesh, true);
-        tmpFaces.Resize(faces.Size());
-        tmpVerts.Resize(faces.Size());
-        vbd.Resize(faces.Size());
-        
-        unsigned int vCol = Urho3D::Color::WHITE.ToUInt();
-        
+        vbd.Resize(numIndices);
+        indices.Resize(numIndices);
+
         //render with duplicate verts for flat face shading
-        for (unsigned i = 0; i < faces.Size(); i++)
+        for (unsigned i = 0; i < numIndices; i += 3)
         {
-            int fId = faces[i].GetInt();
-            int normId = (int)floor((float)i / 3.0f);
-			Vector3 n = normals[normId].GetVector3();
-			Color vCol = Color(n.x_, n.y_, n.z_, 1.0f);
-			vCol = 0.5f * (vCol + Color::WHITE);
-            //unsigned int col = vCols[normId%numColors].GetColor().ToUInt();
-            if (fId < (int)verts.Size())
+            Vector3 v0 = data->GetVertex(faces[i]);
+            Vector3 n = (data->GetVertex(faces[i + 1]) - v0).CrossProduct(data->GetVertex(faces[i + 2]) - v0).Normalized();
+            Color vCol = Color(n.x_, n.y_, n.z_, 1.0f);
+            vCol = 0.5f * (vCol + Color::WHITE);
+            unsigned col = vCol.ToUInt();
+
+            for (unsigned j = i; j < i + 3; ++j)
             {
-                vbd[i].position = verts[fId].GetVector3();
-				vbd[i].normal = n;
-				vbd[i].color = vCol.ToUInt();
-                tmpVerts[i] = vbd[i].position;
+                vbd[j].position = data->GetVertex(faces[j]);
+                vbd[j].normal = n;
+                vbd[j].color = col;
+                indices[j] = j;
+                box.Merge(vbd[j].position);
             }
-            
-            tmpFaces[i] = i;
-            
         }
     }
     else
     {
-        normals = TriMesh_ComputeVertexNormals(trimesh, true);
-        tmpFaces.Resize(faces.Size());
-        tmpVerts.Resize(verts.Size());
-        vbd.Resize(verts.Size());
-        unsigned int vCol = Color::WHITE.ToUInt();
-        
-        for (unsigned i = 0; i < verts.Size(); i++)
-        {
-			Vector3 n = normals[i].GetVector3();
-			Color vCol = Color(n.x_, n.y_, n.z_, 1.0f);
-			vCol = 0.5f * (vCol + Color::WHITE);
-			
-			vbd[i].position = verts[i].GetVector3();
-			vbd[i].normal = n;
-			vbd[i].color = vCol.ToUInt();
-            tmpVerts[i] = verts[i].GetVector3();
-        }
-        
-        for (unsigned i = 0; i < faces.Size(); i++)
+        VariantVector normals;
+        if (!data->HasNormals())
+            normals = TriMesh_ComputeVertexNormals(trimesh, true);
+
+        vbd.Resize(numVerts);
+        for (unsigned i = 0; i < numVerts; i++)
         {
-            tmpFaces[i] = faces[i].GetInt();
+            Vector3 n = normals.Empty() ? data->GetNormal(i).Normalized() : normals[i].GetVector3();
+            Color vCol = Color(n.x_, n.y_, n.z_, 1.0f);
+            vCol = 0.5f * (vCol + Color::WHITE);
+
+            vbd[i].position = data->GetVertex(i);
+            vbd[i].normal = n;
+            vbd[i].color = vCol.ToUInt();
+            box.Merge(vbd[i].position);
         }
-    }
-    
-    SharedPtr<VertexBuffer> vb(new VertexBuffer(context));
-    SharedPtr<IndexBuffer> ib(new IndexBuffer(context));
-    
-    // Shadowed buffer needed for raycasts to work, and so that data can be automatically restored on device loss
-    vb->SetShadowed(true);
-    vb->SetSize(vbd.Size(), Urho3D::MASK_POSITION | Urho3D::MASK_NORMAL | Urho3D::MASK_COLOR);
-    vb->SetData((void*)&vbd[0]);
-    
-    ib->SetShadowed(true);
-    ib->SetSize(tmpFaces.Size(), true);
-    ib->SetData(&tmpFaces[0]);
-    
-    Geometry* geom = new Geometry(context);
-    geom->SetNumVertexBuffers(1);
-    geom->SetVertexBuffer(0, vb);
-    geom->SetIndexBuffer(ib);
-    geom->SetDrawRange(Urho3D::TRIANGLE_LIST, 0, faces.Size());
-    
-    SharedPtr<Model> model(new Model(context));
-    model->SetNumGeometries(1);
-    model->SetGeometry(0, 0, geom);
-    model->SetBoundingBox(BoundingBox(&tmpVerts[0], tmpVerts.Size()));
-    model->SetGeometryCenter(0, Vector3::ZERO);
-    
-    Vector<SharedPtr<VertexBuffer>> allVBuffers;
-    Vector<SharedPtr<IndexBuffer>> allIBuffers;
-    
-    allVBuffers.Push(vb);
-    allIBuffers.Push(ib);
-    
-    PODVector<unsigned int> morphStarts;
-    PODVector<unsigned int> morphRanges;
-    
-    model->SetVertexBuffers(allVBuffers, morphStarts, morphRanges);
-    model->SetIndexBuffers(allIBuffers);
 
-    //create a new node
-    Scene* scene = (Scene*)GetGlobalVar("Scene").GetPtr();
-    Material* mat = GetSubsystem<ResourceCache>()->GetResource<Material>(material_path);
-    if (!scene || !mat)
-    {
-        //SetAllOutputsNull(outSolveInstance);
-        return -1;
+        indices.Resize(numIndices);
+        if (numIndices)
+            memcpy(&indices[0], faces, numIndices * sizeof(int));
     }
-    
-    Node* mNode = scene->CreateChild("MeshPreviewNode");
-    StaticModel* sm = mNode->CreateComponent<StaticModel>();
-    int smID = sm->GetID();
-    
-    SharedPtr<Material> cloneMat = mat->Clone();
-    cloneMat->SetName("tmp/materials/generated_mat_" + String(smID));
-	Color specColor = cloneMat->GetShaderParameter("MatSpecColor").GetColor();
-	Color existingColor = cloneMat->GetShaderParameter("MatDiffColor").GetColor();
-	Color blendColor = existingColor.MultiplyComponents(mainColor);
-    cloneMat->SetShaderParameter("MatDiffColor", blendColor);
-    model->SetName("tmp/models/generated_model_" + String(smID));
-    
-    //add these to the resource cache
-    ResourceCache* rc = GetSubsystem<ResourceCache>();
-    bool res = rc->AddManualResource(model);
-    res = rc->AddManualResource(cloneMat);
-    trackedResources.Push(cloneMat->GetName());
-    trackedResources.Push(model->GetName());
-    
-    sm->SetModel(model);
-    //sm->SetMaterial(cloneMat);
-    sm->SetMaterial(cloneMat);
-	sm->SetCastShadows(true);
-	sm->SetShadowDistance(100.0f);
-    
-    model_pointer = Variant(sm);
-    
-	std::cout << "model->GetName().CString() = " << model->GetName().CString() << std::endl;
-	model_name = model->GetName();
 
-    return mNode->GetID();
+    return UpdateProxy(vbd, indices, box, material_path, mainColor, model_pointer, model_name);
 }
 
 int Graphics_MeshRenderer::NMesh_Render(Urho3D::Variant nMesh,
@@ -367,9 +278,9 @@ int Graphics_MeshRenderer::NMesh_Render(Urho3D::Variant nMesh,
 					  Urho3D::String& model_name)
 {
     
-    Vector<VertexData> vbd;
-    Vector<Vector3> tmpVerts;
-    Vector<int> tmpFaces;
+    PODVector<VertexData> vbd;
+    PODVector<int> tmpFaces;
+    BoundingBox box;
 
     VariantVector normals;
     VariantVector ngonTriList;
@@ -405,11 +316,8 @@ int Graphics_MeshRenderer::NMesh_Render(Urho3D::Variant nMesh,
     {
         normals = TriMesh_ComputeFaceNormals(unifiedMesh, true);
         tmpFaces.Resize(numb_tris);
-        tmpVerts.Resize(numb_tris);
         vbd.Resize(numb_tris);
         
-        unsigned int vCol = Urho3D::Color::WHITE.ToUInt();
-        
         //render with duplicate verts for flat face shading
         // assign every triangle from a single ngon face to one normal.
         int faceCounter = 0;
@@ -430,7 +338,7 @@ int Graphics_MeshRenderer::NMesh_Render(Urho3D::Variant nMesh,
                     vbd[ID].position = verts[fId].GetVector3();
 					vbd[ID].normal = n;
                     vbd[ID].color = vCol.ToUInt();
-                    tmpVerts[ID] = vbd[ID].position;
+                    box.Merge(vbd[ID].position);
                 }
                 tmpFaces[ID] = ID;
             }
@@ -444,76 +352,135 @@ int Graphics_MeshRenderer::NMesh_Render(Urho3D::Variant nMesh,
         return TriMesh_Render(unifiedMesh, context, material_path, flatShaded, mainColor, model_pointer, path_to_resource_ref);
     }
     
-    SharedPtr<VertexBuffer> vb(new VertexBuffer(context));
-    SharedPtr<IndexBuffer> ib(new IndexBuffer(context));
-    
-    // Shadowed buffer needed for raycasts to work, and so that data can be automatically restored on device loss
-    vb->SetShadowed(true);
-    vb->SetSize(vbd.Size(), Urho3D::MASK_POSITION | Urho3D::MASK_NORMAL | Urho3D::MASK_COLOR);
-    vb->SetData((void*)&vbd[0]);
-    
-    ib->SetShadowed(true);
-    ib->SetSize(tmpFaces.Size(), true);
-    ib->SetData(&tmpFaces[0]);
-    
-    Geometry* geom = new Geometry(context);
-    geom->SetNumVertexBuffers(1);
-    geom->SetVertexBuffer(0, vb);
-    geom->SetIndexBuffer(ib);
-    geom->SetDrawRange(Urho3D::TRIANGLE_LIST, 0, numb_tris);
-    
-    SharedPtr<Model> model(new Model(context));
-    model->SetNumGeometries(1);
-    model->SetGeometry(0, 0, geom);
-    model->SetBoundingBox(BoundingBox(&tmpVerts[0], tmpVerts.Size()));
-    model->SetGeometryCenter(0, Vector3::ZERO);
-    
-    Vector<SharedPtr<VertexBuffer>> allVBuffers;
-    Vector<SharedPtr<IndexBuffer>> allIBuffers;
-    
-    allVBuffers.Push(vb);
-    allIBuffers.Push(ib);
-    
-    PODVector<unsigned int> morphStarts;
-    PODVector<unsigned int> morphRanges;
-    
-    model->SetVertexBuffers(allVBuffers, morphStarts, morphRanges);
-    model->SetIndexBuffers(allIBuffers);
-    
-    //create a new node
+    return UpdateProxy(vbd, tmpFaces, box, material_path, mainColor, model_pointer, model_name);
+}
+
+int Graphics_MeshRenderer::UpdateProxy(const PODVector<VertexData>& vbd,
+                                       const PODVector<int>& indices,
+                                       const BoundingBox& box,
+                                       const String& material_path,
+                                       const Color& mainColor,
+                                       Variant& model_pointer,
+                                       String& model_name)
+{
     Scene* scene = (Scene*)GetGlobalVar("Scene").GetPtr();
-    Material* mat = GetSubsystem<ResourceCache>()->GetResource<Material>(material_path);
-    if (!scene || !mat)
+    ResourceCache* rc = GetSubsystem<ResourceCache>();
+    Material* mat = rc->GetResource<Material>(material_path);
+    if (!scene || !mat || vbd.Empty() || indices.Empty())
     {
-        //SetAllOutputsNull(outSolveInstance);
         return -1;
     }
-    
-    Node* mNode = scene->CreateChild("MeshPreviewNode");
-    StaticModel* sm = mNode->CreateComponent<StaticModel>();
-    int smID = sm->GetID();
-    
-	SharedPtr<Material> cloneMat = mat->Clone();
-	cloneMat->SetName("tmp/materials/generated_mat_" + String(smID));
-	Color existingColor = cloneMat->GetShaderParameter("MatDiffColor").GetColor();
-	Color blendColor = existingColor.MultiplyComponents(mainColor);
-	cloneMat->SetShaderParameter("MatDiffColor", blendColor);
-	model->SetName("tmp/models/generated_model_" + String(smID));
-
-	//add these to the resource cache
-	ResourceCache* rc = GetSubsystem<ResourceCache>();
-	bool res = rc->AddManualResource(model);
-	res = rc->AddManualResource(cloneMat);
-	trackedResources.Push(cloneMat->GetName());
-	trackedResources.Push(model->GetName());
-    
-    sm->SetModel(model);
-    sm->SetMaterial(cloneMat);
-    //sm->SetMaterial(mat);
-    
-    model_pointer = Variant(sm);
-    model_name = model->GetName();
-    return mNode->GetID();
-}
 
+    if (numProxiesUsed_ == proxies_.Size())
+        proxies_.Resize(numProxiesUsed_ + 1);
+    MeshRenderProxy& proxy = proxies_[numProxiesUsed_++];
+
+    // the node may have been removed from the scene by something else, or the scene replaced
+    if (proxy.node && proxy.node->GetScene() != scene)
+        ReleaseProxy(proxy);
 
+    Context* context = GetContext();
+    if (!proxy.node)
+    {
+        proxy.node = scene->CreateChild("MeshPreviewNode");
+        StaticModel* sm = proxy.node->CreateComponent<StaticModel>();
+        sm->SetCastShadows(true);
+        sm->SetShadowDistance(100.0f);
+        proxy.staticModel = sm;
+
+        // Shadowed buffers needed for raycasts to work, and so that data can be automatically restored on device loss
+        proxy.vertexBuffer = new VertexBuffer(context);
+        proxy.vertexBuffer->SetShadowed(true);
+        proxy.indexBuffer = new IndexBuffer(context);
+        proxy.indexBuffer->SetShadowed(true);
+
+        proxy.geometry = new Geometry(context);
+        proxy.geometry->SetNumVertexBuffers(1);
+        proxy.geometry->SetVertexBuffer(0, proxy.vertexBuffer);
+        proxy.geometry->SetIndexBuffer(proxy.indexBuffer);
+
+        proxy.model = new Model(context);
+        proxy.model->SetNumGeometries(1);
+        proxy.model->SetGeometry(0, 0, proxy.geometry);
+        proxy.model->SetGeometryCenter(0, Vector3::ZERO);
+
+        Vector<SharedPtr<VertexBuffer>> allVBuffers;
+        Vector<SharedPtr<IndexBuffer>> allIBuffers;
+        allVBuffers.Push(proxy.vertexBuffer);
+        allIBuffers.Push(proxy.indexBuffer);
+        PODVector<unsigned int> morphStarts;
+        PODVector<unsigned int> morphRanges;
+        proxy.model->SetVertexBuffers(allVBuffers, morphStarts, morphRanges);
+        proxy.model->SetIndexBuffers(allIBuffers);
+        proxy.model->SetName("tmp/models/generated_model_" + String(sm->GetID()));
+        rc->AddManualResource(proxy.model);
+    }
+
+    VertexBuffer* vb = proxy.vertexBuffer;
+    IndexBuffer* ib = proxy.indexBuffer;
+    unsigned elementMask = Urho3D::MASK_POSITION | Urho3D::MASK_NORMAL | Urho3D::MASK_COLOR;
+
+    bool topologyChanged = vb->GetVertexCount() != vbd.Size() ||
+        ib->GetIndexCount() != indices.Size() ||
+        memcmp(ib->GetShadowData(), &indices[0], indices.Size() * sizeof(int)) != 0;
+
+    if (topologyChanged)
+    {
+        vb->SetSize(vbd.Size(), elementMask, vb->IsDynamic());
+        ib->SetSize(indices.Size(), true);
+        ib->SetData(&indices[0]);
+    }
+    else if (!vb->IsDynamic())
+    {
+        // same topology as the last solve, so the item is being animated: move the vertices
+        // to a dynamic buffer once, after which every solve only rewrites the vertex data
+        vb->SetSize(vbd.Size(), elementMask, true);
+    }
+    vb->SetData((void*)&vbd[0]);
+
+    if (topologyChanged)
+        proxy.geometry->SetDrawRange(Urho3D::TRIANGLE_LIST, 0, indices.Size());
+
+    if (topologyChanged || box.min_ != proxy.model->GetBoundingBox().min_ || box.max_ != proxy.model->GetBoundingBox().max_)
+    {
+        proxy.model->SetBoundingBox(box);
+        // StaticModel copies the geometries and bounds when the model is assigned, and
+        // re-reads them when the model reports a reload; the materials are kept
+        if (proxy.staticModel->GetModel() == proxy.model)
+            proxy.model->SendEvent(E_RELOADFINISHED);
+        else
+            proxy.staticModel->SetModel(proxy.model);
+    }
+
+    if (proxy.sourceMaterial.Get() != mat || proxy.color != mainColor || !proxy.material)
+    {
+        SharedPtr<Material> cloneMat = mat->Clone();
+        cloneMat->SetName("tmp/materials/generated_mat_" + String(proxy.staticModel->GetID()));
+        Color existingColor = cloneMat->GetShaderParameter("MatDiffColor").GetColor();
+        Color blendColor = existingColor.MultiplyComponents(mainColor);
+        cloneMat->SetShaderParameter("MatDiffColor", blendColor);
+        rc->AddManualResource(cloneMat);
+
+        proxy.staticModel->SetMaterial(cloneMat);
+        proxy.material = cloneMat;
+        proxy.sourceMaterial = mat;
+        proxy.color = mainColor;
+    }
+
+    model_pointer = Variant(proxy.staticModel.Get());
+    model_name = proxy.model->GetName();
+    return proxy.node->GetID();
+}
+
+void Graphics_MeshRenderer::ReleaseProxy(MeshRenderProxy& proxy)
+{
+    ResourceCache* rc = GetSubsystem<ResourceCache>();
+    if (proxy.model)
+        rc->ReleaseResource<Model>(proxy.model->GetName(), true);
+    if (proxy.material)
+        rc->ReleaseResource<Material>(proxy.material->GetName(), true);
+    if (proxy.node)
+        proxy.node->Remove();
+
+    proxy = MeshRenderProxy();
+}
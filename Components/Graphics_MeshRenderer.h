@@ -23,7 +23,13 @@
 #pragma once
 
 #include "IoComponentBase.h"
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/Material.h>
 #include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/Scene/Node.h>
 
 //vertex data types
 struct VertexData
@@ -33,6 +39,22 @@ struct VertexData
 	unsigned color;
 };
 
+// Scene objects kept for one rendered item between solves. While the item keeps its topology
+// only the vertex buffer is rewritten; the node, model, index buffer and material persist.
+struct MeshRenderProxy
+{
+	Urho3D::SharedPtr<Urho3D::Node> node;
+	Urho3D::WeakPtr<Urho3D::StaticModel> staticModel;
+	Urho3D::SharedPtr<Urho3D::Model> model;
+	Urho3D::SharedPtr<Urho3D::Geometry> geometry;
+	Urho3D::SharedPtr<Urho3D::VertexBuffer> vertexBuffer;
+	Urho3D::SharedPtr<Urho3D::IndexBuffer> indexBuffer;
+	Urho3D::SharedPtr<Urho3D::Material> material;
+	// the material the clone was made from, and the color blended into it
+	Urho3D::WeakPtr<Urho3D::Material> sourceMaterial;
+	Urho3D::Color color;
+};
+
 class URHO3D_API Graphics_MeshRenderer : public IoComponentBase {
 
 	URHO3D_OBJECT(Graphics_MeshRenderer, IoComponentBase)
@@ -44,6 +66,7 @@ public:
 	static Urho3D::String iconTexture;
 
 	virtual void PreLocalSolve();
+	virtual void PostLocalSolve();
 
 	void SolveInstance(
 		const Urho3D::Vector<Urho3D::Variant>& inSolveInstance,
@@ -71,8 +94,20 @@ public:
 	Urho3D::String normalMat = "Materials/BasicPBR.xml";
 	Urho3D::String normalAlphaMat = "Materials/BasicPBRAlpha.xml";
 
-	Urho3D::Vector<int> trackedItems;
-	Urho3D::Vector<Urho3D::String> trackedResources;
 	int autoNameCounter = 0;
 
+private:
+	// fills the next render proxy with the given vertex and index data, returns the node id or -1
+	int UpdateProxy(const Urho3D::PODVector<VertexData>& vbd,
+		const Urho3D::PODVector<int>& indices,
+		const Urho3D::BoundingBox& box,
+		const Urho3D::String& material_path,
+		const Urho3D::Color& mainColor,
+		Urho3D::Variant& model_pointer,
+		Urho3D::String& model_name);
+	void ReleaseProxy(MeshRenderProxy& proxy);
+
+	Urho3D::Vector<MeshRenderProxy> proxies_;
+	unsigned numProxiesUsed_ = 0;
+
 };
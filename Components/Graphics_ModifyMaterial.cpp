@@ -133,6 +133,7 @@ Graphics_ModifyMaterial::Graphics_ModifyMaterial(Urho3D::Context* context) : IoC
 	SetName("CreateMaterial");
 	SetFullName("Create Material");
 	SetDescription("Create a material from parameters");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Material",
@@ -39,6 +39,7 @@ Graphics_PointRenderer::Graphics_PointRenderer(Urho3D::Context* context) : IoCom
 	SetName("Display");
 	SetFullName("Geometry Display");
 	SetDescription("Displays geometry in the scene");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Points");
 	inputSlots_[0]->SetVariableName("P");
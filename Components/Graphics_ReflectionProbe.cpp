@@ -40,6 +40,7 @@ Graphics_ReflectionProbe::Graphics_ReflectionProbe(Urho3D::Context* context) : I
 	SetName("ReflectionProbe");
 	SetFullName("Reflection Probe");
 	SetDescription("Create a refleciton probe for environment maps.");
+	SetMainThreadOnly(true);
 
 	////////////////////////////////
 
@@ -41,6 +41,7 @@ Graphics_RenderLabeledMesh::Graphics_RenderLabeledMesh(Urho3D::Context* context)
 	SetName("LabeledMeshRenderer");
 	SetFullName("LabeledMeshRenderer");
 	SetDescription("Converts a labeled mesh to a viewable object in the scene.");;
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -40,6 +40,7 @@ Graphics_RenderTexture::Graphics_RenderTexture(Context* context) : IoComponentBa
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Camera",
@@ -41,6 +41,7 @@ Graphics_SampleTexture::Graphics_SampleTexture(Context* context) : IoComponentBa
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Image",
@@ -37,6 +37,7 @@ Graphics_SaveResource::Graphics_SaveResource(Urho3D::Context* context) : IoCompo
 	SetName("SaveResource");
 	SetFullName("Save Resource");
 	SetDescription("Saves a resource to a path");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Resource",
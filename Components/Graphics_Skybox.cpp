@@ -40,6 +40,7 @@ Graphics_Skybox::Graphics_Skybox(Context* context) : IoComponentBase(context, 0,
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"ColorA",
@@ -133,6 +133,7 @@ Graphics_StandardMaterial::Graphics_StandardMaterial(Urho3D::Context* context) :
 	SetName("CreateMaterial");
 	SetFullName("Create Material");
 	SetDescription("Create a material from parameters");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
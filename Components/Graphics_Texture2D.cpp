@@ -41,6 +41,7 @@ Graphics_Texture2D::Graphics_Texture2D(Context* context) : IoComponentBase(conte
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"DimX",
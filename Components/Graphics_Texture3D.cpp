@@ -42,6 +42,7 @@ Graphics_Texture3D::Graphics_Texture3D(Context* context) : IoComponentBase(conte
 	SetName("RenderTexture");
 	SetFullName("Render Camera to Texture");
 	SetDescription("Creates a texture that is filled by the given camera.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"DimX",
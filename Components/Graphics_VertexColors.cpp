@@ -44,6 +44,7 @@ Graphics_VertexColors::Graphics_VertexColors(Urho3D::Context* context) : IoCompo
 	SetName("CreateMaterial");
 	SetFullName("Create Material");
 	SetDescription("Create a material from parameters");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Drawable",
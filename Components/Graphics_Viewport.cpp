@@ -39,6 +39,7 @@ Graphics_Viewport::Graphics_Viewport(Context* context) : IoComponentBase(context
 	SetName("Viewport");
 	SetFullName("Create Viewport");
 	SetDescription("Creates a viewport for viewing geometry");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
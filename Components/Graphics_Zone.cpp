@@ -43,6 +43,7 @@ Graphics_Zone::Graphics_Zone(Urho3D::Context* context) : IoComponentBase(context
 	SetName("RenderSettings");
 	SetFullName("Base Render Settings");
 	SetDescription("Sets a few of the most important render settings.");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Zone Size");
 	inputSlots_[0]->SetVariableName("ZS");
@@ -42,6 +42,7 @@ Input_ButtonListener::Input_ButtonListener(Urho3D::Context* context) : IoCompone
 	SetDescription("Listens to button in scene");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Button Pointers");
 	inputSlots_[0]->SetVariableName("BP");
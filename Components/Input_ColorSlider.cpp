@@ -37,6 +37,7 @@ Input_ColorSlider::Input_ColorSlider(Urho3D::Context* context) : IoComponentBase
 	SetName("Color");
 	SetFullName("Color Selector");
 	SetDescription("Slider for selecting a Color");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Color",
@@ -33,6 +33,7 @@ Input_ColorWheel::Input_ColorWheel(Urho3D::Context* context) : IoComponentBase(c
 	SetDescription("...");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Intensity");
 	inputSlots_[0]->SetVariableName("");
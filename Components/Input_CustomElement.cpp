@@ -34,6 +34,7 @@ Input_CustomElement::Input_CustomElement(Urho3D::Context* context) : IoComponent
 	SetName("ScreenText");
 	SetFullName("Screen Text");
 	SetDescription("Adds some text to the screen UI");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"CustomType",
@@ -38,6 +38,7 @@ Input_EditGeometryListener::Input_EditGeometryListener(Urho3D::Context* context)
 	SetName("EditGeometryListener");
 	SetFullName("EditGeometryListener");
 	SetDescription("Listens for updates to editable geometry");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"NodeID",
@@ -38,6 +38,7 @@ Input_Float::Input_Float(Context* context) :
 	SetName("Float");
 	SetFullName("Float");
 	SetDescription("Creates or casts a float");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
@@ -39,6 +39,7 @@ Input_GamepadListener::Input_GamepadListener(Urho3D::Context* context) : IoCompo
 	SetDescription("Listens for gamepad input");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("On");
 	inputSlots_[0]->SetVariableName("On");
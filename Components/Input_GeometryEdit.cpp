@@ -50,6 +50,7 @@ Input_GeometryEdit::Input_GeometryEdit(Urho3D::Context* context) : IoComponentBa
 	SetName("GeometryEdit");
 	SetFullName("GeometryEdit");
 	SetDescription("Allows the user to manipulate geometry vertices.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Geometry",
@@ -214,7 +215,11 @@ void Input_GeometryEdit::HandleMouseMove(StringHash eventType, VariantMap& event
 		//retrieve original vertex position
 		Variant geom = currentHitResult.node_->GetVar("ReferenceGeometry");
 		VariantMap geomMap = geom.GetVariantMap();
-		VariantVector verts = geomMap["vertices"].GetVariantVector();
+		VariantVector verts;
+		if (TriMesh_Verify(geom))
+			verts = TriMesh_GetVertexList(geom);
+		else
+			verts = geomMap["vertices"].GetVariantVector();
 
 		//get the specific billboard
 		int bIndex = currentHitResult.subObject_;
@@ -293,7 +298,17 @@ void Input_GeometryEdit::HandleMouseMove(StringHash eventType, VariantMap& event
 
 		//update the reference geometry
 		verts[bIndex] = currVert + moveVec;
-		geomMap["vertices"] = verts;
+		if (TriMesh_Verify(geom))
+		{
+			// mesh vertices live in a shared buffer, so build a new mesh rather than editing in place
+			VariantMap movedMap = TriMesh_Make(verts, TriMesh_GetFaceList(geom)).GetVariantMap();
+			VariantVector labels = TriMesh_GetLabelList(geom);
+			if (!labels.Empty())
+				movedMap["labels"] = labels;
+			geomMap = movedMap;
+		}
+		else
+			geomMap["vertices"] = verts;
 		currentHitResult.node_->SetVar("ReferenceGeometry", geomMap);
 
 		VariantMap data;
@@ -40,6 +40,7 @@ Input_Inspect::Input_Inspect(Urho3D::Context* context) : IoComponentBase(context
 	SetDescription("Convert tree to string for inspection");
 	SetGroup(IoComponentGroup::PARAMS);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("TreeIn");
 	inputSlots_[0]->SetVariableName("");
@@ -40,6 +40,7 @@ Input_Int::Input_Int(Context* context) :
 	SetName("Integer");
 	SetFullName("Integer");
 	SetDescription("Creates or casts an integer");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
@@ -37,6 +37,7 @@ Input_KeyboardListener::Input_KeyboardListener(Urho3D::Context* context) : IoCom
 	SetName("KeyboardListener");
 	SetFullName("Keyboard Listener");
 	SetDescription("Listens for Key strokes");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("On");
 	inputSlots_[0]->SetVariableName("On");
@@ -36,6 +36,7 @@ Input_Label::Input_Label(Urho3D::Context* context) : IoComponentBase(context, 0,
 	SetName("Label");
 	SetFullName("Text Label");
 	SetDescription("Label for annotating graphs");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Name",
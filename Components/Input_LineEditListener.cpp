@@ -42,6 +42,7 @@ Input_LineEditListener::Input_LineEditListener(Urho3D::Context* context) : IoCom
 	SetDescription("Listens for line edit input");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("LineEdit Pointers");
 	inputSlots_[0]->SetVariableName("LE");
@@ -41,6 +41,7 @@ Input_MouseDownListener::Input_MouseDownListener(Urho3D::Context* context) : IoC
 	SetDescription("Listens for mouse down in scene");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("On");
 	inputSlots_[0]->SetVariableName("On");
@@ -42,6 +42,7 @@ Input_ObjectMove::Input_ObjectMove(Urho3D::Context* context) : IoComponentBase(c
 	SetName("ObjectMove");
 	SetFullName("ObjectMove");
 	SetDescription("Moves an object based on user interaction");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Constraints",
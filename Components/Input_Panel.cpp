@@ -36,6 +36,7 @@ Input_Panel::Input_Panel(Urho3D::Context* context) :
 	IoComponentBase(context, 1, 1),
 	editable_(true)
 {
+	SetMainThreadOnly(true);
 	SubscribeToEvent("OnSolveGraph", URHO3D_HANDLER(Input_Panel, HandleGraphSolve));
 }
 
@@ -33,6 +33,7 @@ Input_ScanDir::Input_ScanDir(Context* context) : IoComponentBase(context, 0, 0)
 	SetName("ScanDir");
 	SetFullName("ScanDir");
 	SetDescription("Scans a directory for files.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Path",
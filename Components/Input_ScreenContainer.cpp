@@ -38,6 +38,7 @@ Input_ScreenContainer::Input_ScreenContainer(Urho3D::Context* context) : IoCompo
 	SetName("ScreenContainer");
 	SetFullName("Screen Container");
 	SetDescription("A container for UI objects.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Name",
@@ -41,6 +41,7 @@ Input_ScreenLineEdit::Input_ScreenLineEdit(Urho3D::Context* context) : IoCompone
 	SetDescription("Adds a line edit to the user interface");
 	SetGroup(IoComponentGroup::USER);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Screen Coords");
 	inputSlots_[0]->SetVariableName("P");
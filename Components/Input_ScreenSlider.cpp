@@ -43,6 +43,7 @@ Input_ScreenSlider::Input_ScreenSlider(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Adds a slider to the user interface");
 	SetGroup(IoComponentGroup::USER);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Position",
@@ -40,6 +40,7 @@ Input_ScreenText::Input_ScreenText(Urho3D::Context* context) : IoComponentBase(c
 	SetName("ScreenText");
 	SetFullName("Screen Text");
 	SetDescription("Adds some text to the screen UI");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Position",
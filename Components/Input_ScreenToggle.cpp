@@ -41,6 +41,7 @@ Input_ScreenToggle::Input_ScreenToggle(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Adds a boolean toggle to the user interface");
 	SetGroup(IoComponentGroup::USER);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("P");
 	inputSlots_[0]->SetVariableName("P");
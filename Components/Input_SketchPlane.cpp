@@ -57,6 +57,7 @@ Input_SketchPlane::Input_SketchPlane(Context* context) :
 	SetName("SketchPlane");
 	SetFullName("Sketch Plane");
 	SetDescription("Create a sketch and position it in 3D.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Curves",
@@ -42,6 +42,7 @@ Input_Slider::Input_Slider(Urho3D::Context* context) : IoComponentBase(context,
 	SetDescription("An interactive numerical slider.");
 	SetGroup(IoComponentGroup::PARAMS);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("I");
 	inputSlots_[0]->SetVariableName("");
@@ -41,6 +41,7 @@ Input_SliderListener::Input_SliderListener(Urho3D::Context* context) : IoCompone
 	SetDescription("Listens for slider input");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 
 	inputSlots_[0]->SetName("Sliders");
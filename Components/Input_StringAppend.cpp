@@ -31,6 +31,7 @@ Input_StringAppend::Input_StringAppend(Context* context) : IoComponentBase(conte
 	SetName("StringAppend");
 	SetFullName("StringAppend");
 	SetDescription("Appends a string.");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
@@ -31,6 +31,7 @@ Input_StringReplace::Input_StringReplace(Context* context) : IoComponentBase(con
 	SetName("StringFormat");
 	SetFullName("StringFormat");
 	SetDescription("Appends or Creates a string with Formatting.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"String",
@@ -39,6 +39,7 @@ Input_Toggle::Input_Toggle(Urho3D::Context* context) : IoComponentBase(context,
 	SetDescription("Boolean Toggle input");
 	SetGroup(IoComponentGroup::PARAMS);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("");
 	inputSlots_[0]->SetVariableName("");
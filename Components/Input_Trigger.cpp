@@ -36,6 +36,7 @@ Input_Trigger::Input_Trigger(Context* context) :
 	SetDescription("Transmit IoDataTree at first input upon trigger at second input");
 	SetGroup(IoComponentGroup::TREE);
 	SetSubgroup("Operations");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("IoDataTree");
 	inputSlots_[0]->SetVariableName("In");
@@ -37,6 +37,7 @@ Input_Vector3::Input_Vector3(Urho3D::Context* context) : IoComponentBase(context
 	SetName("Vector3");
 	SetFullName("Vector3 Selector");
 	SetDescription("Slider for selecting a Vector3");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Default",
@@ -33,6 +33,7 @@ Interop_AsyncSystemCommand::Interop_AsyncSystemCommand(Context* context) :IoComp
 	SetName("AsyncSystemCommand");
 	SetFullName("Calls a program from the OS");
 	SetDescription("Calls several programs from the OS");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Executable",
@@ -42,6 +42,7 @@ Interop_JsonSchema::Interop_JsonSchema(Context* context) :IoComponentBase(contex
 	SetName("JsonSchema");
 	SetFullName("Create JSON Schema");
 	SetDescription("Creats a JSON Document from geometry data.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Geometry",
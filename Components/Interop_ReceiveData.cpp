@@ -46,6 +46,7 @@ Interop_ReceiveData::Interop_ReceiveData(Context* context) :
 	SetName("ExportViewData");
 	SetFullName("Export View Data");
 	SetDescription("Exports data from a view to be used in another view.");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
@@ -43,6 +43,7 @@ Interop_SendData::Interop_SendData(Context* context) :
 	SetName("ExportViewData");
 	SetFullName("Export View Data");
 	SetDescription("Exports data from a view to be used in another view.");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
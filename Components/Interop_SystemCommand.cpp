@@ -35,6 +35,7 @@ Interop_SystemCommand::Interop_SystemCommand(Context* context) :IoComponentBase(
 	SetName("SystemCommand");
 	SetFullName("Calls a program from the OS");
 	SetDescription("Calls a program from the OS");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Executable",
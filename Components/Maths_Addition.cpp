@@ -36,6 +36,7 @@ Maths_Addition::Maths_Addition(Urho3D::Context* context) : IoComponentBase(conte
 	SetName("X + Y");
 	SetFullName("Addition");
 	SetDescription("Mathematical addition");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("X");
 	inputSlots_[0]->SetVariableName("X");
@@ -41,6 +41,7 @@ Maths_ConstructTransform::Maths_ConstructTransform(Urho3D::Context* context) : I
 	SetDescription("Construct transform from position, scale, and rotation");
 	SetGroup(IoComponentGroup::TRANSFORM);
 	SetSubgroup("Matrix");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Position");
 	inputSlots_[0]->SetVariableName("P");
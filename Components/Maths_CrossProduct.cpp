@@ -37,6 +37,7 @@ Maths_CrossProduct::Maths_CrossProduct(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Computes the cross product of two vectors");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	Variant default_vec = Vector3(0.0f, 0.0f, 0.0f);
 
@@ -37,6 +37,7 @@ Maths_Division::Maths_Division(Context* context) : IoComponentBase(context, 2, 1
 	SetDescription("Mathematical division");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("X");
 	inputSlots_[0]->SetVariableName("X");
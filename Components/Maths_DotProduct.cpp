@@ -37,6 +37,7 @@ Maths_DotProduct::Maths_DotProduct(Urho3D::Context* context) : IoComponentBase(c
 	SetDescription("Computes the dot product of two vectors");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	Variant default_vec = Vector3(0.0f, 0.0f, 0.0f);
 
@@ -25,6 +25,7 @@
 #include "Urho3D/AngelScript/Addons.h"
 #include "Urho3D/AngelScript/APITemplates.h"
 #include "Urho3D/AngelScript/Script.h";
+#include "Urho3D/Container/HashMap.h"
 
 using namespace Urho3D;
 
@@ -38,6 +39,9 @@ Maths_EvalFunction::Maths_EvalFunction(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Evaluates a basic math function.");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetMainThreadOnly(true);
+	// SolveInstances compiles the function once for all instances; not pure, as the compiled function and the script fallback are shared
+	SetBatchSolve(true);
 
 	inputSlots_[0]->SetName("First Arg");
 	inputSlots_[0]->SetVariableName("X");
@@ -102,4 +106,73 @@ void Maths_EvalFunction::SolveInstance(
 	float result = script_system->GetGlobalVar(ID).GetFloat();
 	//export the result
 	outSolveInstance[0] = result;
+}
+
+void Maths_EvalFunction::SolveInstances(
+	const Vector<Vector<Variant> >& inSolveInstances,
+	Vector<Vector<Variant> >& outSolveInstances
+	)
+{
+	unsigned numInstances = inSolveInstances.Size();
+	outSolveInstances.Resize(numInstances);
+	for (unsigned i = 0; i < numInstances; ++i) {
+		outSolveInstances[i].Resize(outputSlots_.Size());
+	}
+
+	//group the instances by function definition, usually there is only one
+	HashMap<String, PODVector<unsigned> > groups;
+	for (unsigned i = 0; i < numInstances; ++i) {
+		groups[inSolveInstances[i][3].GetString()].Push(i);
+	}
+
+	//the arguments were substituted case-insensitively by the script version, so lower case names are accepted too
+	Vector<String> names;
+	names.Push("X");
+	names.Push("Y");
+	names.Push("Z");
+	names.Push("x");
+	names.Push("y");
+	names.Push("z");
+	PODVector<IoExpressionType> types(names.Size());
+	for (unsigned i = 0; i < types.Size(); ++i) {
+		types[i] = EXPR_FLOAT;
+	}
+
+	for (HashMap<String, PODVector<unsigned> >::ConstIterator it = groups.Begin(); it != groups.End(); ++it) {
+		const String& function = it->first_;
+		const PODVector<unsigned>& rows = it->second_;
+
+		if (!compiledFunction_.IsCompiledFor(function, names, types)) {
+			String error;
+			compiledFunction_.Compile(function, names, types, error);
+		}
+
+		IoExpressionType resultType = compiledFunction_.GetResultType();
+		if (resultType != EXPR_INT && resultType != EXPR_FLOAT) {
+			for (unsigned j = 0; j < rows.Size(); ++j) {
+				SolveInstance(inSolveInstances[rows[j]], outSolveInstances[rows[j]]);
+			}
+			continue;
+		}
+
+		//X, Y and Z for the rows of this group, interleaved
+		PODVector<float> args(3 * rows.Size());
+		for (unsigned j = 0; j < rows.Size(); ++j) {
+			for (unsigned k = 0; k < 3; ++k) {
+				args[3 * j + k] = inSolveInstances[rows[j]][k].GetFloat();
+			}
+		}
+
+		PODVector<IoExpressionColumn> columns(names.Size());
+		for (unsigned k = 0; k < columns.Size(); ++k) {
+			columns[k].data = &args[k % 3];
+			columns[k].stride = 3;
+		}
+
+		PODVector<float> results(rows.Size());
+		compiledFunction_.Evaluate(columns, rows.Size(), &results[0]);
+		for (unsigned j = 0; j < rows.Size(); ++j) {
+			outSolveInstances[rows[j]][0] = results[j];
+		}
+	}
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "IoComponentBase.h"
+#include "IoExpression.h"
 
 class URHO3D_API Maths_EvalFunction : public IoComponentBase {
 
@@ -38,5 +39,15 @@ public:
 		Urho3D::Vector<Urho3D::Variant>& outSolveInstance
 		);
 
+	// evaluates the instances sharing a function definition in one pass of the compiled function;
+	// definitions the compiled expression does not understand go through the script engine in SolveInstance
+	void SolveInstances(
+		const Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& inSolveInstances,
+		Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& outSolveInstances
+		);
+
+private:
+	// the function definition last compiled
+	IoExpression compiledFunction_;
 
 };
\ No newline at end of file
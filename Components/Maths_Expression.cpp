@@ -38,6 +38,9 @@ Maths_Expression::Maths_Expression(Urho3D::Context* context) : IoComponentBase(c
 	SetName("Expression");
 	SetFullName("Evaluate Expression");
 	SetDescription("Evaluates a basic Expression.");
+	SetMainThreadOnly(true);
+	// SolveInstances compiles the expression once for all instances; not pure, as the compiled expression and the script fallback are shared
+	SetBatchSolve(true);
 
 	AddInputSlot(
 		"X",
@@ -170,6 +173,99 @@ void Maths_Expression::SolveInstance(
 
 }
 
+void Maths_Expression::SolveInstances(
+	const Vector<Vector<Variant> >& inSolveInstances,
+	Vector<Vector<Variant> >& outSolveInstances
+	)
+{
+	unsigned numInstances = inSolveInstances.Size();
+	outSolveInstances.Resize(numInstances);
+	for (unsigned i = 0; i < numInstances; ++i) {
+		outSolveInstances[i].Resize(outputSlots_.Size());
+	}
+
+	if (numInstances == 0) {
+		return;
+	}
+
+	//the compiled expression is typed: every instance needs the input types of the first one
+	Vector<String> names;
+	PODVector<IoExpressionType> types;
+	bool compilable = !expression_.Empty();
+	for (unsigned i = 0; compilable && i < inputSlots_.Size(); ++i) {
+		names.Push(inputSlots_[i]->GetVariableName());
+		types.Push(IoExpression::FromVariantType(inSolveInstances[0][i].GetType()));
+		compilable = types[i] != EXPR_NONE;
+		for (unsigned j = 1; compilable && j < numInstances; ++j) {
+			compilable = inSolveInstances[j][i].GetType() == inSolveInstances[0][i].GetType();
+		}
+	}
+
+	if (compilable && !compiledExpression_.IsCompiledFor(expression_, names, types)) {
+		String error;
+		compiledExpression_.Compile(expression_, names, types, error);
+	}
+
+	if (!compilable || !compiledExpression_.IsCompiled()) {
+		for (unsigned i = 0; i < numInstances; ++i) {
+			SolveInstance(inSolveInstances[i], outSolveInstances[i]);
+		}
+		return;
+	}
+
+	//gather the inputs into columns
+	Vector<PODVector<float> > data(inputSlots_.Size());
+	PODVector<IoExpressionColumn> columns(inputSlots_.Size());
+	for (unsigned i = 0; i < inputSlots_.Size(); ++i) {
+		if (types[i] == EXPR_VECTOR3) {
+			data[i].Resize(3 * numInstances);
+			for (unsigned j = 0; j < numInstances; ++j) {
+				const Vector3& v = inSolveInstances[j][i].GetVector3();
+				data[i][3 * j] = v.x_;
+				data[i][3 * j + 1] = v.y_;
+				data[i][3 * j + 2] = v.z_;
+			}
+			columns[i].stride = 3;
+		}
+		else {
+			data[i].Resize(numInstances);
+			for (unsigned j = 0; j < numInstances; ++j) {
+				const Variant& value = inSolveInstances[j][i];
+				if (types[i] == EXPR_INT) {
+					data[i][j] = (float)value.GetInt();
+				}
+				else if (types[i] == EXPR_BOOL) {
+					data[i][j] = value.GetBool() ? 1.0f : 0.0f;
+				}
+				else {
+					data[i][j] = value.GetFloat();
+				}
+			}
+			columns[i].stride = 1;
+		}
+		columns[i].data = &data[i][0];
+	}
+
+	IoExpressionType resultType = compiledExpression_.GetResultType();
+	PODVector<float> results((resultType == EXPR_VECTOR3 ? 3 : 1) * numInstances);
+	compiledExpression_.Evaluate(columns, numInstances, &results[0]);
+
+	for (unsigned j = 0; j < numInstances; ++j) {
+		if (resultType == EXPR_VECTOR3) {
+			outSolveInstances[j][0] = Vector3(&results[3 * j]);
+		}
+		else if (resultType == EXPR_INT) {
+			outSolveInstances[j][0] = (int)results[j];
+		}
+		else if (resultType == EXPR_BOOL) {
+			outSolveInstances[j][0] = results[j] != 0.0f;
+		}
+		else {
+			outSolveInstances[j][0] = results[j];
+		}
+	}
+}
+
 void Maths_Expression::HandleLineEdit(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData)
 {
 	using namespace TextFinished;
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "IoComponentBase.h"
+#include "IoExpression.h"
 
 #include <Urho3D/UI/UIElement.h>
 #include <Urho3D/UI/LineEdit.h>
@@ -41,9 +42,18 @@ public:
 		Urho3D::Vector<Urho3D::Variant>& outSolveInstance
 		);
 
+	// evaluates all instances in one pass of the compiled expression when they share their input types;
+	// anything the compiled expression does not understand goes through the script engine in SolveInstance
+	void SolveInstances(
+		const Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& inSolveInstances,
+		Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& outSolveInstances
+		);
+
 	virtual void HandleCustomInterface(Urho3D::UIElement* customElement);
 	Urho3D::LineEdit* expressionEdit_;
 	Urho3D::String expression_;
+	// expression_ compiled for the variable names and types last seen
+	IoExpression compiledExpression_;
 
 	void HandleLineEdit(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
 	void HandleInputsChanged(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
@@ -37,6 +37,7 @@ Maths_GreaterThan::Maths_GreaterThan(Urho3D::Context* context) : IoComponentBase
 	SetDescription("Tests if input B is greater than input A");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("firstNumber");
 	inputSlots_[0]->SetVariableName("A");
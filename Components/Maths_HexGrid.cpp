@@ -38,6 +38,7 @@ Maths_HexGrid::Maths_HexGrid(Urho3D::Context* context) : IoComponentBase(context
 	SetDescription("Generates a planar hexagonal grid");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("transform");
 	inputSlots_[0]->SetVariableName("T");
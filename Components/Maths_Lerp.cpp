@@ -34,6 +34,7 @@ Maths_Lerp::Maths_Lerp(Urho3D::Context* context) : IoComponentBase(context, 3, 1
 	SetDescription("Linear interpolation between two values");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("");
+	SetPure(true);
 
 
 	inputSlots_[0]->SetName("From");
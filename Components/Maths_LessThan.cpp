@@ -37,6 +37,7 @@ Maths_LessThan::Maths_LessThan(Urho3D::Context* context) : IoComponentBase(conte
 	SetDescription("Tests if input B is less than input A");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("firstNumber");
 	inputSlots_[0]->SetVariableName("A");
@@ -37,6 +37,7 @@ Maths_MassAddition::Maths_MassAddition(Context* context) : IoComponentBase(conte
 	SetDescription("Sums a list of numbers");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("List");
 	inputSlots_[0]->SetVariableName("L");
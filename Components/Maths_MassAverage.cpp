@@ -37,6 +37,7 @@ Maths_MassAverage::Maths_MassAverage(Context* context) : IoComponentBase(context
 	SetDescription("Average of list of numbers");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("List");
 	inputSlots_[0]->SetVariableName("L");
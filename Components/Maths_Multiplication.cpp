@@ -37,6 +37,7 @@ Maths_Multiplication::Maths_Multiplication(Context* context) : IoComponentBase(c
 	SetDescription("Mathematical multiplication");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("X");
 	inputSlots_[0]->SetVariableName("X");
@@ -37,6 +37,7 @@ Maths_RandomValue::Maths_RandomValue(Urho3D::Context* context) : IoComponentBase
 	SetDescription("Generates a random float between min and max");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Min");
 	inputSlots_[0]->SetVariableName("min");
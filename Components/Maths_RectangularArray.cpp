@@ -37,6 +37,7 @@ Maths_RectangularArray::Maths_RectangularArray(Urho3D::Context* context) : IoCom
 	SetDescription("Generates a 3D rectangular array of cells from transform, number of cells and cell size");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("transform");
 	inputSlots_[0]->SetVariableName("T");
@@ -39,6 +39,7 @@ Maths_RectangularGrid::Maths_RectangularGrid(Urho3D::Context* context) : IoCompo
 	SetDescription("Generates a planar rectangular grid from transform, number of cells and cell size");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("transform");
 	inputSlots_[0]->SetVariableName("T");
@@ -43,6 +43,7 @@ Maths_RhodoArray3D::Maths_RhodoArray3D(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Generates 3D array of lattice points from rhombic dodecahedral tiling");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("transform");
 	inputSlots_[0]->SetVariableName("T");
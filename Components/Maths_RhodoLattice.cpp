@@ -42,6 +42,7 @@ Maths_RhodoLattice::Maths_RhodoLattice(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Generates 3D lattice from rhombic dodecahedral tiling");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("transform");
 	inputSlots_[0]->SetVariableName("T");
@@ -37,6 +37,7 @@ Maths_Subtraction::Maths_Subtraction(Context* context) : IoComponentBase(context
 	SetDescription("Mathematical subtraction");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("X");
 	inputSlots_[0]->SetVariableName("X");
@@ -37,6 +37,7 @@ Maths_UnitizeVector::Maths_UnitizeVector(Urho3D::Context* context) : IoComponent
 	SetDescription("Computes a unit vector from a vector");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	Variant default_vec = Vector3(0.0f, 0.0f, 0.0f);
 
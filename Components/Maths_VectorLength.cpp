@@ -37,6 +37,7 @@ Maths_VectorLength::Maths_VectorLength(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Computes the length of a vector");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	Variant default_vec = Vector3(0.0f, 0.0f, 0.0f);
 
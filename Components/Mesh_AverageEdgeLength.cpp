@@ -38,6 +38,7 @@ Mesh_AverageEdgeLength::Mesh_AverageEdgeLength(Context* context) : IoComponentBa
 	SetDescription("Compute average edge length for TriMesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshIn");
 	inputSlots_[0]->SetVariableName("M");
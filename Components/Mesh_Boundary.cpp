@@ -48,6 +48,7 @@ Mesh_Boundary::Mesh_Boundary(Context* context) : IoComponentBase(context, 1, 1)
 	SetDescription("Compute boundary of a mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
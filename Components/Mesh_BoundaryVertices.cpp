@@ -40,6 +40,7 @@ Mesh_BoundaryVertices::Mesh_BoundaryVertices(Context* context) : IoComponentBase
 	SetDescription("Computes Mesh Topology Data for a given vertex");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Analysis");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
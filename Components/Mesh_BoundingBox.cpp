@@ -37,6 +37,7 @@ Mesh_BoundingBox::Mesh_BoundingBox(Context* context) : IoComponentBase(context,
 	SetDescription("Construct TriMesh bounding box for another TriMesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
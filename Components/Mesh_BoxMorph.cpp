@@ -37,6 +37,7 @@ Mesh_BoxMorph::Mesh_BoxMorph(Urho3D::Context* context) : IoComponentBase(context
 	SetName("BoxMorph");
 	SetFullName("Mesh Modeler");
 	SetDescription("Mesh modeling through bounding box morph");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -38,13 +38,14 @@ using namespace Urho3D;
 
 String Mesh_CleanMesh::iconTexture = "Textures/Icons/Mesh_CleanMesh.png";
 
-Mesh_CleanMesh::Mesh_CleanMesh(Context* context) : IoComponentBase(context, 1, 2)
+Mesh_CleanMesh::Mesh_CleanMesh(Context* context) : IoComponentBase(context, 2, 2)
 {
 	SetName("CleanMeshVertices");
 	SetFullName("Cull Unused Vertices");
-	SetDescription("Cull unused vertices from trimesh");
+	SetDescription("Weld coincident vertices and cull unused vertices from trimesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -52,6 +53,14 @@ Mesh_CleanMesh::Mesh_CleanMesh(Context* context) : IoComponentBase(context, 1, 2
 	inputSlots_[0]->SetVariantType(VariantType::VAR_VARIANTMAP);
 	inputSlots_[0]->SetDataAccess(DataAccess::ITEM);
 
+	inputSlots_[1]->SetName("Tolerance");
+	inputSlots_[1]->SetVariableName("T");
+	inputSlots_[1]->SetDescription("Vertices within this distance of each other in every coordinate are welded, negative to skip welding");
+	inputSlots_[1]->SetVariantType(VariantType::VAR_FLOAT);
+	inputSlots_[1]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[1]->SetDefaultValue(-1.0f);
+	inputSlots_[1]->DefaultSet();
+
 	outputSlots_[0]->SetName("Mesh");
 	outputSlots_[0]->SetVariableName("M");
 	outputSlots_[0]->SetDescription("Mesh after removing unused vertices");
@@ -60,7 +69,7 @@ Mesh_CleanMesh::Mesh_CleanMesh(Context* context) : IoComponentBase(context, 1, 2
 
 	outputSlots_[1]->SetName("NumRemoved");
 	outputSlots_[1]->SetVariableName("N");
-	outputSlots_[1]->SetDescription("Number of vertices removed");
+	outputSlots_[1]->SetDescription("Number of vertices welded or removed");
 	outputSlots_[1]->SetVariantType(VariantType::VAR_INT);
 	outputSlots_[1]->SetDataAccess(DataAccess::ITEM);
 }
@@ -84,9 +93,24 @@ void Mesh_CleanMesh::SolveInstance(
 		return;
 	}
 
+	// Verify input slot 1
+	float tolerance = inSolveInstance[1].GetFloat();
+
 	///////////////////
 	// COMPONENT'S WORK
 
+	int num_welded = 0;
+	if (tolerance >= 0.0f) {
+		int num_vertices = TriMesh_GetData(inMesh)->GetNumVertices();
+		inMesh = TriMesh_WeldVertices(inMesh, tolerance);
+		if (!TriMesh_Verify(inMesh)) {
+			URHO3D_LOGWARNING("Welding collapsed every face of M");
+			SetAllOutputsNull(outSolveInstance);
+			return;
+		}
+		num_welded = num_vertices - TriMesh_GetData(inMesh)->GetNumVertices();
+	}
+
 	Eigen::MatrixXf V, NV;
 	Eigen::MatrixXi F, NF;
 	bool loadSuccess = IglMeshToMatrices(inMesh, V, F);
@@ -99,7 +123,7 @@ void Mesh_CleanMesh::SolveInstance(
 	Eigen::VectorXi _1;
 	igl::remove_unreferenced(V, F, NV, NF, _1);
 	Variant out_mesh = TriMesh_Make(NV, NF);
-	int num_removed = V.rows() - NV.rows();
+	int num_removed = num_welded + V.rows() - NV.rows();
 
 	/////////////////
 	// ASSIGN OUTPUTS
@@ -43,6 +43,7 @@ Mesh_ClosestPoint::Mesh_ClosestPoint(Context* context) :
 	SetDescription("Find point on Mesh closest to query point");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Analysis");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
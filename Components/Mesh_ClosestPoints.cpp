@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Mesh_ClosestPoints.h"
+
+#include <assert.h>
+
+#include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include "Geomlib_TriMeshClosestPoint.h"
+#include "TriMesh.h"
+
+using namespace Urho3D;
+
+String Mesh_ClosestPoints::iconTexture = "Textures/Icons/Mesh_ClosestPoint.png";
+
+Mesh_ClosestPoints::Mesh_ClosestPoints(Context* context) :
+	IoComponentBase(context, 2, 3)
+{
+	SetName("MeshClosestPoints");
+	SetFullName("Closest Points to Mesh");
+	SetDescription("Find points on Mesh closest to a list of query points");
+	SetGroup(IoComponentGroup::MESH);
+	SetSubgroup("Analysis");
+	SetPure(true);
+
+	inputSlots_[0]->SetName("Mesh");
+	inputSlots_[0]->SetVariableName("M");
+	inputSlots_[0]->SetDescription("Mesh to search");
+	inputSlots_[0]->SetVariantType(VariantType::VAR_VARIANTMAP);
+	inputSlots_[0]->SetDataAccess(DataAccess::ITEM);
+
+	inputSlots_[1]->SetName("Query Points");
+	inputSlots_[1]->SetVariableName("Q");
+	inputSlots_[1]->SetDescription("Points to search from");
+	inputSlots_[1]->SetVariantType(VariantType::VAR_VECTOR3);
+	inputSlots_[1]->SetDataAccess(DataAccess::LIST);
+
+	outputSlots_[0]->SetName("Points");
+	outputSlots_[0]->SetVariableName("P");
+	outputSlots_[0]->SetDescription("Points on mesh closest to query points");
+	outputSlots_[0]->SetVariantType(VariantType::VAR_VECTOR3);
+	outputSlots_[0]->SetDataAccess(DataAccess::LIST);
+
+	outputSlots_[1]->SetName("Indices");
+	outputSlots_[1]->SetVariableName("I");
+	outputSlots_[1]->SetDescription("Indices of closest faces");
+	outputSlots_[1]->SetVariantType(VariantType::VAR_INT);
+	outputSlots_[1]->SetDataAccess(DataAccess::LIST);
+
+	outputSlots_[2]->SetName("Distances");
+	outputSlots_[2]->SetVariableName("D");
+	outputSlots_[2]->SetDescription("Distances from query points to mesh");
+	outputSlots_[2]->SetVariantType(VariantType::VAR_FLOAT);
+	outputSlots_[2]->SetDataAccess(DataAccess::LIST);
+}
+
+void Mesh_ClosestPoints::SolveInstance(
+	const Vector<Variant>& inSolveInstance,
+	Vector<Variant>& outSolveInstance
+)
+{
+	assert(inSolveInstance.Size() == inputSlots_.Size());
+
+	const Variant& inMesh = inSolveInstance[0];
+	if (!TriMesh_Verify(inMesh)) {
+		URHO3D_LOGWARNING("M must be a valid mesh.");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	if (inSolveInstance[1].GetType() != VariantType::VAR_VARIANTVECTOR) {
+		URHO3D_LOGWARNING("Q must be a list of Vector3's.");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+	const VariantVector& queryList = inSolveInstance[1].GetVariantVector();
+
+	PODVector<Vector3> queries(queryList.Size());
+	for (unsigned i = 0; i < queryList.Size(); ++i) {
+		if (queryList[i].GetType() != VariantType::VAR_VECTOR3) {
+			URHO3D_LOGWARNING("Q must be a list of Vector3's only.");
+			SetAllOutputsNull(outSolveInstance);
+			return;
+		}
+		queries[i] = queryList[i].GetVector3();
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	PODVector<Vector3> points;
+	PODVector<int> indices;
+	PODVector<float> distances;
+	bool success = Geomlib::TriMeshClosestPoints(inMesh, queries.Empty() ? 0 : &queries[0], queries.Size(),
+		points, indices, distances, GetSubsystem<WorkQueue>());
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	if (!success) {
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	VariantVector pointList(points.Size());
+	VariantVector indexList(indices.Size());
+	VariantVector distanceList(distances.Size());
+	for (unsigned i = 0; i < points.Size(); ++i) {
+		pointList[i] = points[i];
+		indexList[i] = indices[i];
+		distanceList[i] = distances[i];
+	}
+
+	outSolveInstance[0] = pointList;
+	outSolveInstance[1] = indexList;
+	outSolveInstance[2] = distanceList;
+}
\ No newline at end of file
@@ -46,6 +46,7 @@ Mesh_CollapseShortEdges::Mesh_CollapseShortEdges(Context* context) : IoComponent
 	SetDescription("Collapse edges shorter than (1 - tol) * avg");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("TriMesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -38,6 +38,7 @@ Mesh_ComputeAdjacencyData::Mesh_ComputeAdjacencyData(Context* context) : IoCompo
     SetDescription("Computes Mesh Topology Data (manifold trimeshes only!)");
     SetGroup(IoComponentGroup::MESH);
     SetSubgroup("Operators");
+    SetPure(true);
     
     inputSlots_[0]->SetName("Mesh");
     inputSlots_[0]->SetVariableName("M");
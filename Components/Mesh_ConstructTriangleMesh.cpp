@@ -41,6 +41,7 @@ Mesh_ConstructTriangleMesh::Mesh_ConstructTriangleMesh(Context* context) :
 	SetDescription("Construct a mesh from vertex and face lists");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Vertices");
 	inputSlots_[0]->SetVariableName("V");
@@ -81,22 +82,8 @@ void Mesh_ConstructTriangleMesh::SolveInstance(
 	Variant normals = inSolveInstance[2];
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
-	HashMap<StringHash, Variant> meshMap;
-	meshMap["vertices"] = vertices;
-	meshMap["faces"] = faces;
-
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	IglMeshToMatrices(meshMap, V, F);
-
-	if (normals.GetType() == VAR_VARIANTVECTOR && normals.GetVariantVector().Size() >= 3)
-		meshMap["normals"] = normals;
-	else
-		meshMap["normals"] = IglComputeVertexNormals(V, F);
-
 	Variant outMesh = TriMesh_Make(vertices, faces);
 
-	//Variant outMesh(meshMap);
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
 	outSolveInstance[0] = outMesh;
@@ -48,6 +48,7 @@ Mesh_CubeMesh::Mesh_CubeMesh(Context* context) : IoComponentBase(context, 1, 1)
 	SetDescription("Construct a cube mesh from scale");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Side");
 	inputSlots_[0]->SetVariableName("Side");
@@ -47,6 +47,7 @@ Mesh_Cylinder::Mesh_Cylinder(Context* context) : IoComponentBase(context, 4, 1)
     SetDescription("Construct a Cylinder mesh from radii");
     SetGroup(IoComponentGroup::MESH);
     SetSubgroup("Primitive");
+    SetPure(true);
     
     inputSlots_[0]->SetName("LowerRadius");
     inputSlots_[0]->SetVariableName("L");
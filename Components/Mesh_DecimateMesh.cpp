@@ -48,6 +48,7 @@ Mesh_DecimateMesh::Mesh_DecimateMesh(Context* context) : IoComponentBase(context
 	SetDescription("Perform decimation on triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
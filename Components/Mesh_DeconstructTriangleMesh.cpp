@@ -34,6 +34,7 @@ Mesh_DeconstructTriangleMesh::Mesh_DeconstructTriangleMesh(Context* context) :Io
 	SetDescription("Deconstructs a triangle mesh into vertices, faces, and normals");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -84,6 +85,23 @@ void Mesh_DeconstructTriangleMesh::SolveInstance(
 		return;
 	}
 
+	if (TriMesh_Verify(inSolveInstance[0]))
+	{
+		VariantVector faces = TriMesh_GetFaceList(inSolveInstance[0]);
+		VariantVector faceCounts;
+		for (unsigned i = 0; i < faces.Size() / 3; i++)
+		{
+			faceCounts.Push(3);
+		}
+
+		outSolveInstance[0] = TriMesh_GetVertexList(inSolveInstance[0]);
+		outSolveInstance[1] = faces;
+		outSolveInstance[2] = TriMesh_GetNormalList(inSolveInstance[0]);
+		outSolveInstance[3] = faceCounts;
+		outSolveInstance[4] = TriMesh_ComputeFaceNormals(inSolveInstance[0], true);
+		return;
+	}
+
 	VariantMap mData = inSolveInstance[0].GetVariantMap();
 
 	if (mData.Keys().Contains("vertices") && mData.Keys().Contains("faces") && mData.Keys().Contains("normals"))
@@ -45,6 +45,7 @@ Mesh_ExtrudePolyline::Mesh_ExtrudePolyline(Context* context) : IoComponentBase(c
 	SetDescription("Extrudes a polyline along a vector");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polyline");
 	inputSlots_[0]->SetVariableName("P");
@@ -40,6 +40,7 @@ Mesh_FacePolylines::Mesh_FacePolylines(Context* context) : IoComponentBase(conte
 	SetName("FacePolylines");
 	SetFullName("Face Polylines");
 	SetDescription("Returns the face polylines from a mesh");
+	SetPure(true);
 
 	AddInputSlot(
 		"Mesh",
@@ -59,6 +59,7 @@ Mesh_FieldRemesh::Mesh_FieldRemesh(Context* context) : IoComponentBase(context,
 	SetName("FieldRemesh");
 	SetFullName("FieldRemesh");
 	SetDescription("Remeshes in a really clever and fast way (https://github.com/wjakob/instant-meshes)");
+	SetPure(true);
 
 	AddInputSlot(
 		"Mesh",
@@ -47,6 +47,7 @@ Mesh_FillPolygon::Mesh_FillPolygon(Context* context) : IoComponentBase(context,
 	SetDescription("Triangulates a polygon");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Polygon");
 	inputSlots_[0]->SetVariableName("P");
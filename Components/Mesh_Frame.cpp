@@ -46,6 +46,7 @@ Mesh_Frame::Mesh_Frame(Context* context) : IoComponentBase(context, 2, 1)
 	SetDescription("Creates an inset frame mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
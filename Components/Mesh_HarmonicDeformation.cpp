@@ -22,22 +22,137 @@
 
 #include "Mesh_HarmonicDeformation.h"
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/IO/Log.h>
 #include <algorithm>
 #include "TriMesh.h"
 
 #pragma warning(push, 0)
-#include <igl/colon.h>
 #include <igl/harmonic.h>
-#include <igl/readOBJ.h>
-#include <igl/readDMAT.h>
+#include <igl/min_quad_with_fixed.h>
 #pragma warning(pop)
 
 using namespace Urho3D;
 
 String Mesh_HarmonicDeformation::iconTexture = "";
 
+//factorized k-harmonic system, together with what it was built from
+struct HarmonicFactorization
+{
+	ConstTriMeshDataPtr mesh;
+	Eigen::VectorXi handles;
+	int power;
+	igl::min_quad_with_fixed_data<double> data;
+};
+
 //geom manipulations
 namespace {
+
+//one displacement set read from a solve instance
+struct HarmonicInstance
+{
+	ConstTriMeshDataPtr mesh;
+	Eigen::VectorXi handles;
+	Eigen::MatrixXd displacements;
+	int power;
+};
+
+bool ReadInstance(const Vector<Variant>& inSolveInstance, HarmonicInstance& instance)
+{
+	VariantVector dispVecs = inSolveInstance[1].GetVariantVector();
+	VariantVector dispIdx = inSolveInstance[2].GetVariantVector();
+
+	instance.mesh = TriMesh_GetData(inSolveInstance[0]);
+	if (!instance.mesh) {
+		URHO3D_LOGWARNING("M1 must be a TriMesh!");
+		return false;
+	}
+
+	if (dispVecs.Empty() ||
+		dispIdx.Empty())
+	{
+		return false;
+	}
+
+	if (dispVecs.Size() != dispIdx.Size())
+	{
+		return false;
+	}
+
+	//check that we don't have the default variant lists
+	if (dispVecs[0].GetType() == VAR_NONE ||
+		dispIdx[0].GetType() == VAR_NONE)
+	{
+		return false;
+	}
+
+	instance.power = inSolveInstance[3].GetInt();
+	if (instance.power < 1)
+	{
+		URHO3D_LOGWARNING("Harmonic exponent must be at least 1!");
+		return false;
+	}
+
+	//create the handle and displacement vectors
+	int numVecs = dispVecs.Size();
+	int numVertices = instance.mesh->GetNumVertices();
+	instance.handles.resize(numVecs);
+	instance.displacements.resize(numVecs, 3);
+	for (int i = 0; i < numVecs; i++)
+	{
+		int idx = dispIdx[i].GetInt();
+		if (idx < 0 || idx >= numVertices)
+		{
+			URHO3D_LOGERROR("Provide an out of range index!");
+			return false;
+		}
+
+		Vector3 v = dispVecs[i].GetVector3();
+		instance.displacements.row(i) = Eigen::RowVector3d(v.x_, v.y_, v.z_);
+		instance.handles[i] = idx;
+	}
+
+	return true;
+}
+
+//the cotangent and mass matrices depend on the vertex positions as well as on the faces
+bool SameGeometry(const ConstTriMeshDataPtr& a, const ConstTriMeshDataPtr& b)
+{
+	return a == b ||
+		(a->GetVertices() == b->GetVertices() && a->GetFaces() == b->GetFaces());
+}
+
+bool SameSystem(const ConstTriMeshDataPtr& mesh, const Eigen::VectorXi& handles, int power, const HarmonicInstance& instance)
+{
+	return power == instance.power &&
+		handles.size() == instance.handles.size() &&
+		handles == instance.handles &&
+		SameGeometry(mesh, instance.mesh);
+}
+
+void SetOutputs(const ConstTriMeshDataPtr& mesh, const Eigen::MatrixXd& D, int firstCol, Vector<Variant>& outSolveInstance)
+{
+	unsigned numVertices = mesh->GetNumVertices();
+	const PODVector<float>& verts = mesh->GetVertices();
+
+	VariantVector vecsOut;
+	vecsOut.Resize(numVertices);
+	PODVector<float> deformed(verts.Size());
+	for (unsigned i = 0; i < numVertices; i++)
+	{
+		Vector3 dV = Vector3(D(i, firstCol), D(i, firstCol + 1), D(i, firstCol + 2));
+		vecsOut[i] = dV;
+
+		for (unsigned k = 0; k < 3; k++)
+		{
+			deformed[3 * i + k] = verts[3 * i + k] + dV.Data()[k];
+		}
+	}
+
+	outSolveInstance[0] = vecsOut;
+	outSolveInstance[1] = TriMesh_Make(TriMeshDataPtr(
+		new TriMeshData(deformed.Buffer(), numVertices, mesh->GetFaceData(), mesh->GetNumFaces())));
+}
+
 };
 
 Mesh_HarmonicDeformation::Mesh_HarmonicDeformation(Context* context) : IoComponentBase(context, 0, 0)
@@ -46,6 +161,9 @@ Mesh_HarmonicDeformation::Mesh_HarmonicDeformation(Context* context) : IoCompone
 	SetFullName("Harmonic Deformation");
 	SetDescription("Given some displacement vectors, the harmonic deformation field is calculated");
 
+	// SolveInstances shares the factorization between instances; not pure, as it keeps factorization_ between solves
+	SetBatchSolve(true);
+
 	AddInputSlot(
 		"Mesh",
 		"M",
@@ -104,93 +222,88 @@ void Mesh_HarmonicDeformation::SolveInstance(
 	Vector<Variant>& outSolveInstance
 )
 {
-	//get data
-	Variant mesh = inSolveInstance[0];
-	VariantVector dispVecs = inSolveInstance[1].GetVariantVector();
-	VariantVector dispIdx = inSolveInstance[2].GetVariantVector();
-	int power = inSolveInstance[3].GetInt();
-
-	//checks
-	if (!TriMesh_Verify(mesh)) {
-		URHO3D_LOGWARNING("M1 must be a TriMesh!");
-		SetAllOutputsNull(outSolveInstance);
-		return;
-	}
+	Vector<Vector<Variant> > inSolveInstances;
+	inSolveInstances.Push(inSolveInstance);
+	Vector<Vector<Variant> > outSolveInstances;
+	SolveInstances(inSolveInstances, outSolveInstances);
+	outSolveInstance = outSolveInstances[0];
+}
 
-	if (dispVecs.Empty() ||
-		dispIdx.Empty())
-	{
-		SetAllOutputsNull(outSolveInstance);
-		return;
+void Mesh_HarmonicDeformation::SolveInstances(
+	const Vector<Vector<Variant> >& inSolveInstances,
+	Vector<Vector<Variant> >& outSolveInstances
+)
+{
+	unsigned numInstances = inSolveInstances.Size();
+	outSolveInstances.Resize(numInstances);
+	for (unsigned i = 0; i < numInstances; ++i) {
+		outSolveInstances[i].Resize(outputSlots_.Size());
 	}
 
+	//group the instances by mesh, handles and exponent, usually there is only one group
+	Vector<HarmonicInstance> instances(numInstances);
+	Vector<PODVector<unsigned> > groups;
+	for (unsigned i = 0; i < numInstances; ++i) {
+		if (!ReadInstance(inSolveInstances[i], instances[i])) {
+			SetAllOutputsNull(outSolveInstances[i]);
+			continue;
+		}
 
-	if (dispVecs.Size() != dispIdx.Size())
-	{
-		SetAllOutputsNull(outSolveInstance);
-		return;
-	}
-
-	//check that we don't have the default variant lists
-	if (dispVecs[0].GetType() == VAR_NONE ||
-		dispIdx[0].GetType() == VAR_NONE)
-	{
-		SetAllOutputsNull(outSolveInstance);
-		return;
+		unsigned g = 0;
+		for (; g < groups.Size(); ++g) {
+			const HarmonicInstance& first = instances[groups[g][0]];
+			if (SameSystem(first.mesh, first.handles, first.power, instances[i])) {
+				break;
+			}
+		}
+		if (g == groups.Size()) {
+			groups.Push(PODVector<unsigned>());
+		}
+		groups[g].Push(i);
 	}
 
-	//init matrices
-	Eigen::MatrixXd V;
-	Eigen::MatrixXi F;
-	Eigen::VectorXi b;
-	Eigen::MatrixXd D_bc;
-	Eigen::MatrixXd D;
-
-	//TriMeshToMatrices(mesh, V, F);
-	TriMeshToDoubleMatrices(mesh, V, F);
+	for (unsigned g = 0; g < groups.Size(); ++g) {
+		const PODVector<unsigned>& rows = groups[g];
+		const HarmonicInstance& first = instances[rows[0]];
 
-	//collect the disp vecs and indices
-	int numVecs = Min(dispVecs.Size(), dispIdx.Size());
-	b.resize(numVecs);
-	D_bc.resize(numVecs, 3);
+		//factorize only when the system differs from the one solved last time
+		if (!factorization_ || !SameSystem(factorization_->mesh, factorization_->handles, factorization_->power, first)) {
+			factorization_.reset();
 
-	//create the handle and displacement vectors
-	for (int i = 0; i < numVecs; i++)
-	{
-		int idx = dispIdx[i].GetInt();
-		if (idx > V.rows())
-		{
-			URHO3D_LOGERROR("Provide an out of range index!");
-			SetAllOutputsNull(outSolveInstance);
-			return;
-		}
+			Eigen::MatrixXd V;
+			Eigen::MatrixXi F;
+			first.mesh->ToDoubleMatrices(V, F);
 
-		Vector3 v = dispVecs[i].GetVector3();
-		D_bc.row(i) = Eigen::RowVector3d(v.x_, v.y_, v.z_);
-		b[i] = idx;
-	}
+			Eigen::SparseMatrix<double> Q;
+			igl::harmonic(V, F, first.power, Q);
 
-	//finally, proceed with calculation
-	igl::harmonic(V, F, b, D_bc, power, D);
+			std::shared_ptr<HarmonicFactorization> factorization = std::make_shared<HarmonicFactorization>();
+			if (!igl::min_quad_with_fixed_precompute(Q, first.handles, Eigen::SparseMatrix<double>(), true, factorization->data)) {
+				URHO3D_LOGERROR("HarmonicDeformation: could not factorize the harmonic system!");
+				for (unsigned j = 0; j < rows.Size(); ++j) {
+					SetAllOutputsNull(outSolveInstances[rows[j]]);
+				}
+				continue;
+			}
 
-	int dRows = D.rows();
-	int dCols = D.cols();
+			factorization->mesh = first.mesh;
+			factorization->handles = first.handles;
+			factorization->power = first.power;
+			factorization_ = factorization;
+		}
 
-	VariantVector vecsOut;
-	VariantVector verts = TriMesh_GetVertexList(mesh);
-	VariantVector faces = TriMesh_GetFaceList(mesh);
+		//stack the xyz columns of every displacement set and back substitute them together
+		Eigen::MatrixXd Y(first.handles.size(), 3 * rows.Size());
+		for (unsigned j = 0; j < rows.Size(); ++j) {
+			Y.middleCols(3 * j, 3) = instances[rows[j]].displacements;
+		}
 
-	for (int i = 0; i < D.rows(); i++)
-	{
-		Eigen::RowVector3d v = D.row(i);
-		Vector3 dV = Vector3(v.x(), v.y(), v.z());
-		vecsOut.Push(dV);
+		Eigen::VectorXd B = Eigen::VectorXd::Zero(first.mesh->GetNumVertices());
+		Eigen::MatrixXd D;
+		igl::min_quad_with_fixed_solve(factorization_->data, B, Y, Eigen::VectorXd(), D);
 
-		Vector3 orgVert = verts[i].GetVector3();
-		verts[i] = orgVert + dV;
+		for (unsigned j = 0; j < rows.Size(); ++j) {
+			SetOutputs(instances[rows[j]].mesh, D, 3 * j, outSolveInstances[rows[j]]);
+		}
 	}
-
-	outSolveInstance[0] = vecsOut;
-	outSolveInstance[1] = TriMesh_Make(verts, faces);
-	return;
-}
\ No newline at end of file
+}
@@ -22,8 +22,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "IoComponentBase.h"
 
+struct HarmonicFactorization;
+
 class URHO3D_API Mesh_HarmonicDeformation : public IoComponentBase {
 	URHO3D_OBJECT(Mesh_HarmonicDeformation, IoComponentBase)
 public:
@@ -34,5 +38,16 @@ public:
 		Urho3D::Vector<Urho3D::Variant>& outSolveInstance
 	);
 
+	// solves the instances sharing a mesh, handle set and exponent with one factorization,
+	// back substituting all their displacement sets together
+	void SolveInstances(
+		const Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& inSolveInstances,
+		Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& outSolveInstances
+	);
+
 	static Urho3D::String iconTexture;
+
+private:
+	// the k-harmonic system last factorized, reused while the mesh, handles and exponent stay the same
+	std::shared_ptr<HarmonicFactorization> factorization_;
 };
\ No newline at end of file
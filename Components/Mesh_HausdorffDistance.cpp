@@ -38,6 +38,7 @@ Mesh_HausdorffDistance::Mesh_HausdorffDistance(Context* context) : IoComponentBa
 	SetDescription("Compute Hausdorff distance between TriMeshes");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh1");
 	inputSlots_[0]->SetVariableName("M1");
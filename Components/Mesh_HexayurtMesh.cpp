@@ -47,6 +47,7 @@ Mesh_HexayurtMesh::Mesh_HexayurtMesh(Context* context) : IoComponentBase(context
 	SetDescription("Construct a hexayurt mesh from scale");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Width");
 	inputSlots_[0]->SetVariableName("W");
@@ -47,6 +47,7 @@ Mesh_Icosahedron::Mesh_Icosahedron(Context* context) : IoComponentBase(context,
 	SetDescription("Construct an icosahedron mesh from scale");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 //	inputSlots_[0]->SetName("Transformation");
 //	inputSlots_[0]->SetVariableName("T");
@@ -46,6 +46,7 @@ Mesh_JoinMeshes::Mesh_JoinMeshes(Context* context) : IoComponentBase(context, 2,
 	SetDescription("Join meshes in a list into a single mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshList");
 	inputSlots_[0]->SetVariableName("ML");
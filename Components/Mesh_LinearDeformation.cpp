@@ -37,6 +37,7 @@ Mesh_LinearDeformation::Mesh_LinearDeformation(Urho3D::Context* context) : IoCom
 	SetName("LinearDeformation");
 	SetFullName("Mesh Modeler");
 	SetDescription("Mesh modeling through Linear deformation");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
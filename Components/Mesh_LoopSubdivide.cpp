@@ -45,6 +45,7 @@ Mesh_LoopSubdivide::Mesh_LoopSubdivide(Context* context) : IoComponentBase(conte
 	SetDescription("Perform loop subdivision on triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -47,6 +47,7 @@ Mesh_MarchingCubes::Mesh_MarchingCubes(Context* context) : IoComponentBase(conte
 	SetName("MarchingCubes");
 	SetFullName("MarchingCubes");
 	SetDescription("Create a mesh from a grid of values");
+	SetPure(true);
 
 	AddInputSlot(
 		"Points",
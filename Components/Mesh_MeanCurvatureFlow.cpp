@@ -27,6 +27,7 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Container/Vector.h>
 #include <Urho3D/Container/Str.h>
 
@@ -98,7 +99,7 @@ void Mesh_MeanCurvatureFlow::SolveInstance(
 	// COMPONENT'S WORK
 
 	Variant meshOut;
-	bool success = Geomlib::TriMesh_MeanCurvatureFlow(meshIn, num_steps, meshOut);
+	bool success = Geomlib::TriMesh_MeanCurvatureFlow(meshIn, num_steps, meshOut, GetSubsystem<WorkQueue>());
 	if (!success) {
 		URHO3D_LOGWARNING("MeanCurvatureFlow --- failed on TriMesh");
 		SetAllOutputsNull(outSolveInstance);
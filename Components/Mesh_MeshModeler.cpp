@@ -39,6 +39,7 @@ Mesh_MeshModeler::Mesh_MeshModeler(Urho3D::Context* context) : IoComponentBase(c
     SetDescription("Mesh modeling through harmonic deformation");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
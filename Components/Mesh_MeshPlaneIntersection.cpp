@@ -45,6 +45,7 @@ Mesh_MeshPlaneIntersection::Mesh_MeshPlaneIntersection(Context* context) : IoCom
 	SetDescription("Intersect triangle mesh with plane");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -45,6 +45,7 @@ Mesh_Offset::Mesh_Offset(Context* context) : IoComponentBase(context, 2, 1)
 	SetDescription("Perform offset operation on a triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
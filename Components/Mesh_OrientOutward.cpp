@@ -37,6 +37,7 @@ Mesh_OrientOutward::Mesh_OrientOutward(Context* context) : IoComponentBase(conte
 	SetName("OrientOutward");
 	SetFullName("OrientOutward");
 	SetDescription("...");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshIn");
 	inputSlots_[0]->SetVariableName("M");
@@ -38,6 +38,7 @@ Mesh_PerVertexEval::Mesh_PerVertexEval(Urho3D::Context* context) : IoComponentBa
 	SetDescription("Evaluates function on vertices of TriMesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -79,6 +80,50 @@ void Mesh_PerVertexEval::SolveInstance(
 	}
 	String function = inSolveInstance[1].GetString();
 
+	// the coordinates were substituted case-insensitively by the script version, so lower case names are accepted too
+	Vector<String> names;
+	names.Push("X");
+	names.Push("Y");
+	names.Push("Z");
+	names.Push("x");
+	names.Push("y");
+	names.Push("z");
+	PODVector<IoExpressionType> types(names.Size());
+	for (unsigned i = 0; i < types.Size(); ++i) {
+		types[i] = EXPR_FLOAT;
+	}
+
+	if (!compiledFunction_.IsCompiledFor(function, names, types)) {
+		String error;
+		compiledFunction_.Compile(function, names, types, error);
+	}
+
+	IoExpressionType resultType = compiledFunction_.GetResultType();
+	if (resultType == EXPR_INT || resultType == EXPR_FLOAT) {
+		// evaluate straight over the vertex array
+		ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+		unsigned numVertices = data->GetNumVertices();
+
+		PODVector<IoExpressionColumn> columns(names.Size());
+		for (unsigned k = 0; k < columns.Size(); ++k) {
+			columns[k].data = data->GetVertexData() + k % 3;
+			columns[k].stride = 3;
+		}
+
+		PODVector<float> results(numVertices);
+		if (numVertices > 0) {
+			compiledFunction_.Evaluate(columns, numVertices, &results[0]);
+		}
+
+		VariantVector per_vertex_float_values(numVertices);
+		for (unsigned i = 0; i < numVertices; ++i) {
+			per_vertex_float_values[i] = results[i];
+		}
+		outSolveInstance[0] = per_vertex_float_values;
+		return;
+	}
+
+	// fall back on the script engine for functions the compiled expression does not understand
 	VariantVector vertex_list = TriMesh_GetVertexList(tri_mesh);
 	VariantVector per_vertex_float_values;
 	for (int i = 0; i < vertex_list.Size(); ++i) {
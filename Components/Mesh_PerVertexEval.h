@@ -23,6 +23,7 @@
 #pragma once
 
 #include "IoComponentBase.h"
+#include "IoExpression.h"
 
 class URHO3D_API Mesh_PerVertexEval : public IoComponentBase {
 	URHO3D_OBJECT(Mesh_PerVertexEval, IoComponentBase)
@@ -40,4 +41,8 @@ public:
 	void DeleteOutputSlot(int index) = delete;
 
 	static Urho3D::String iconTexture;
+
+private:
+	// the function definition last compiled
+	IoExpression compiledFunction_;
 };
\ No newline at end of file
@@ -87,6 +87,7 @@ Mesh_Pipe::Mesh_Pipe(Context* context) :
 	SetName("Polygon");
 	SetFullName("Construct Polygon");
 	SetDescription("Construct a polygon with n sides");
+	SetPure(true);
 
 	AddInputSlot(
 		"Curve",
@@ -46,6 +46,7 @@ Mesh_Plane::Mesh_Plane(Context* context) : IoComponentBase(context, 1, 3)
 	SetDescription("Construct a plane mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Height");
 	inputSlots_[0]->SetVariableName("Height");
@@ -26,6 +26,7 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Container/Vector.h>
 #include <Urho3D/Container/Str.h>
@@ -43,6 +44,7 @@ Mesh_ReadOBJ::Mesh_ReadOBJ(Context* context) : IoComponentBase(context, 2, 1)
 	SetName("ReadOBJ");
 	SetFullName("ReadOBJ");
 	SetDescription("Read TriMesh from OBJ file");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("File");
 	inputSlots_[0]->SetVariableName("File");
@@ -76,24 +78,28 @@ void Mesh_ReadOBJ::SolveInstance(
 		SetAllOutputsNull(outSolveInstance);
 		return;
 	}
-	SharedPtr<FileSystem> fs(GetSubsystem<FileSystem>());
-	bool cached = false;
-	SharedPtr<File> obj_file = GetSubsystem<ResourceCache>()->GetFile(filename);
-	if (obj_file) {
-		cached = true;
+	// files on disk are memory-mapped; only files inside packages are read through the cache
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	String path = cache->GetResourceFileName(filename);
+	SharedPtr<File> obj_file;
+	if (path.Empty()) {
+		obj_file = cache->GetFile(filename, false);
+		path = filename;
 	}
 
 	bool yup = inSolveInstance[1].GetBool();
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	Geomlib::MeshParseLog log = { "Mesh_ReadOBJ", 0 };
 
 	Variant tri_mesh;
 
 	bool success;
-	if (cached) {
+	if (obj_file) {
 		URHO3D_LOGINFO("Mesh_ReadOBJ --- attempting to read OBJ file from cache");
-		success = Geomlib::ReadOBJ(obj_file, tri_mesh, yup);
+		success = Geomlib::ReadOBJ(obj_file, tri_mesh, yup, queue, Geomlib::LogMeshParseProgress, &log);
 	}
 	else {
-		success = Geomlib::ReadOBJ(filename, tri_mesh, yup);
+		success = Geomlib::ReadOBJ(path, tri_mesh, yup, queue, Geomlib::LogMeshParseProgress, &log);
 	}
 
 	if (!success) {
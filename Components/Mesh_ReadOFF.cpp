@@ -43,6 +43,7 @@ Mesh_ReadOFF::Mesh_ReadOFF(Context* context) : IoComponentBase(context, 2, 1)
 	SetName("ReadOFF");
 	SetFullName("ReadOFF");
 	SetDescription("Read TriMesh from OFF file");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("File");
 	inputSlots_[0]->SetVariableName("File");
@@ -46,6 +46,7 @@ Mesh_ReadPLY::Mesh_ReadPLY(Context* context) : IoComponentBase(context, 2, 1)
 	SetName("ReadPLY");
 	SetFullName("ReadPLY");
 	SetDescription("Read TriMesh from PLY file");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("File");
 	inputSlots_[0]->SetVariableName("File");
@@ -80,35 +81,27 @@ void Mesh_ReadPLY::SolveInstance(
 		return;
 	}
 
-	SharedPtr<FileSystem> fs(GetSubsystem<FileSystem>());
-	bool cached = false;
-	SharedPtr<File> ply_file = GetSubsystem<ResourceCache>()->GetFile(filename);
-	if (ply_file) {
-		cached = true;
+	// files on disk are memory-mapped; only files inside packages are read through the cache
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	String path = cache->GetResourceFileName(filename);
+	SharedPtr<File> ply_file;
+	if (path.Empty()) {
+		ply_file = cache->GetFile(filename, false);
+		path = filename;
 	}
-	bool cached_ok = false;
-#ifdef WIN32
-	cached_ok = true;
-#endif
-#ifdef __APPLE__
-	std::cout << "__APPLE__ is defined!" << std::endl;
-	cached_ok = true;
-#endif
 
 	bool yup = inSolveInstance[1].GetBool();
+	Geomlib::MeshParseLog log = { "Mesh_ReadPLY", 0 };
 
 	Variant tri_mesh;
 
 	bool success;
-	if (cached && cached_ok) {
+	if (ply_file) {
 		URHO3D_LOGINFO("Mesh_ReadPLY --- attempting to read PLY file from cache");
-		success = Geomlib::ReadPLY(ply_file, tri_mesh, yup);
-		if (success) {
-			URHO3D_LOGINFO("Mesh_ReadPLY --- partial success reading PLY from cache");
-		}
+		success = Geomlib::ReadPLY(ply_file, tri_mesh, yup, Geomlib::LogMeshParseProgress, &log);
 	}
 	else {
-		success = Geomlib::ReadPLY(filename, tri_mesh, yup);
+		success = Geomlib::ReadPLY(path, tri_mesh, yup, Geomlib::LogMeshParseProgress, &log);
 	}
 
 	if (!success) {
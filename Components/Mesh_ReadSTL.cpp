@@ -34,7 +34,7 @@
 #include <Urho3D/Container/Str.h>
 #include <Urho3D/Resource/ResourceCache.h>
 
-#include "igl/readSTL.h"
+#include "Geomlib_MeshParse.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
@@ -46,6 +46,7 @@ Mesh_ReadSTL::Mesh_ReadSTL(Context* context) : IoComponentBase(context, 2, 1)
 	SetName("ReadPLY");
 	SetFullName("ReadPLY");
 	SetDescription("Read TriMesh from PLY file");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("File");
 	inputSlots_[0]->SetVariableName("File");
@@ -80,17 +81,33 @@ void Mesh_ReadSTL::SolveInstance(
 		return;
 	}
 
-	String resPath = GetSubsystem<ResourceCache>()->GetResourceFileName(filename);
+	// files on disk are memory-mapped; only files inside packages are read through the cache
+	ResourceCache* cache = GetSubsystem<ResourceCache>();
+	String resPath = cache->GetResourceFileName(filename);
 
-	bool yup = inSolveInstance[1].GetBool();
+	Geomlib::MappedFile file;
+	bool opened;
+	if (!resPath.Empty()) {
+		opened = file.Open(resPath);
+	}
+	else {
+		SharedPtr<File> stl_file = cache->GetFile(filename, false);
+		opened = stl_file ? file.Open(stl_file) : file.Open(filename);
+	}
 
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	Eigen::MatrixXf N;
+	bool yup = inSolveInstance[1].GetBool();
+	Geomlib::MeshParseLog log = { "Mesh_ReadSTL", 0 };
 
-	bool res = igl::readSTL(resPath.CString(), V, F, N);
+	TriMeshDataPtr data(new TriMeshData());
+	if (!opened || !Geomlib::ParseSTL(file.GetData(), file.GetSize(), *data, Geomlib::LogMeshParseProgress, &log)) {
+		URHO3D_LOGERROR("Mesh_ReadSTL --- could not read " + filename);
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
 
-	Variant tri_mesh = TriMesh_Make(V, F);
+	if (yup) {
+		Geomlib::ConvertToYUp(*data);
+	}
 
-	outSolveInstance[0] = tri_mesh;
+	outSolveInstance[0] = TriMesh_Make(data);
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ Mesh_SaveMesh::Mesh_SaveMesh(Context* context) :IoComponentBase(context, 0, 0)
 	SetName("SaveMesh");
 	SetFullName("Save Mesh");
 	SetDescription("Saves a mesh in a variety of formats");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Mesh",
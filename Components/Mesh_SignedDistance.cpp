@@ -34,8 +34,8 @@
 #include <Urho3D/Container/Str.h>
 #include <Urho3D/Resource/ResourceCache.h>
 
-#include "igl/signed_distance.h"
 #include "TriMesh.h"
+#include "TriMeshAABB.h"
 
 using namespace Urho3D;
 
@@ -46,6 +46,7 @@ Mesh_SignedDistance::Mesh_SignedDistance(Context* context) : IoComponentBase(con
 	SetName("MarchingCubes");
 	SetFullName("MarchingCubes");
 	SetDescription("Create a mesh from a grid of values");
+	SetPure(true);
 
 	AddInputSlot(
 		"Points",
@@ -97,33 +98,17 @@ void Mesh_SignedDistance::SolveInstance(
 		return;
 	}
 
-	Eigen::MatrixXd iPts(pts.Size(), 3);
-	for (int i = 0; i < pts.Size(); i++)
-	{
-		Vector3 v = pts[i].GetVector3();
-		Eigen::RowVector3d rv(v.x_, v.y_, v.z_);
-		iPts.row(i) = rv;
-	}
-
-	Eigen::MatrixXd V;
-	Eigen::MatrixXi F;
-
-	TriMeshToDoubleMatrices(mesh, V, F);
-
-	Eigen::VectorXd S;
-	Eigen::VectorXi I;
-	Eigen::MatrixXd C;
-	Eigen::MatrixXd N;
-
-	igl::signed_distance(iPts, V, F, igl::SignedDistanceType::SIGNED_DISTANCE_TYPE_DEFAULT, S, I, C, N);
+	// the tree is cached with the mesh, so re-solving with new points does not rebuild it
+	TriMeshAABBPtr tree = TriMesh_GetData(mesh)->GetAABB();
 
-	VariantVector dOut;
-	VariantVector ptsOut;
-	for (int i = 0; i < S.rows(); i++)
+	VariantVector dOut(pts.Size());
+	VariantVector ptsOut(pts.Size());
+	for (unsigned i = 0; i < pts.Size(); i++)
 	{
-		dOut.Push( (float)S(i));
-		Vector3 cp(C.row(i).x(), C.row(i).y(), C.row(i).z());
-		ptsOut.Push(cp);
+		int face = -1;
+		Vector3 cp;
+		dOut[i] = tree->SignedDistance(pts[i].GetVector3(), face, cp);
+		ptsOut[i] = cp;
 	}
 
 	outSolveInstance[0] = dOut;
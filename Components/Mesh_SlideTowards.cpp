@@ -46,6 +46,7 @@ Mesh_SlideTowards::Mesh_SlideTowards(Context* context) : IoComponentBase(context
 	SetName("SlideTowards");
 	SetFullName("SlideTowards");
 	SetDescription("Slide mesh towards another");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("SlidingMesh");
 	inputSlots_[0]->SetVariableName("SlidingMesh");
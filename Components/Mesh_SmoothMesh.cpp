@@ -47,6 +47,7 @@ Mesh_SmoothMesh::Mesh_SmoothMesh(Context* context) : IoComponentBase(context, 3,
 	SetDescription("Perform smoothing on triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
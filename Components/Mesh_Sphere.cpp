@@ -47,6 +47,7 @@ Mesh_Sphere::Mesh_Sphere(Context* context) : IoComponentBase(context, 1, 1)
 	SetDescription("Construct a sphere mesh from scale");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
     inputSlots_[0]->SetName("Radius");
     inputSlots_[0]->SetVariableName("R");
@@ -46,6 +46,7 @@ Mesh_SplitLongEdges::Mesh_SplitLongEdges(Context* context) : IoComponentBase(con
 	SetDescription("Split edges longer than (1 + tol) * avg");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("TriMesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -45,6 +45,7 @@ Mesh_SubdivideMesh::Mesh_SubdivideMesh(Context* context) : IoComponentBase(conte
 	SetDescription("Perform subdivision on triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -48,6 +48,7 @@ Mesh_SuperEllipsoid::Mesh_SuperEllipsoid(Context* context) : IoComponentBase(con
     SetDescription("Construct an ellipsoid mesh from params");
     SetGroup(IoComponentGroup::MESH);
     SetSubgroup("Primitive");
+    SetPure(true);
     
     inputSlots_[0]->SetName("X");
     inputSlots_[0]->SetVariableName("X");
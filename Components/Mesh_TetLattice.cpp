@@ -35,6 +35,7 @@ Mesh_TetLattice::Mesh_TetLattice(Context* context) : IoComponentBase(context, 0,
 	SetName("Tetrahedralize");
 	SetFullName("Tetrahedralize Mesh");
 	SetDescription("Create a tetrahedralization of a mesh");
+	SetPure(true);
 
 	AddInputSlot(
 		"Mesh",
@@ -35,6 +35,7 @@ Mesh_Tetrahedralize::Mesh_Tetrahedralize(Context* context) : IoComponentBase(con
 	SetName("Tetrahedralize");
 	SetFullName("Tetrahedralize Mesh");
 	SetDescription("Create a tetrahedralization of a mesh");
+	SetPure(true);
 
 	AddInputSlot(
 		"Mesh",
@@ -45,6 +45,7 @@ Mesh_Thicken::Mesh_Thicken(Context* context) : IoComponentBase(context, 2, 1)
 	SetDescription("Perform thickening operation on a triangle mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -40,6 +40,7 @@ Mesh_ToYUp::Mesh_ToYUp(Context* context) : IoComponentBase(context, 1, 1)
 	SetName("ToYUp");
 	SetFullName("ToYUp");
 	SetDescription("Convert mesh from Z-Up to Y-Up coordinates");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshIn");
 	inputSlots_[0]->SetVariableName("MeshIn");
@@ -40,6 +40,7 @@ Mesh_ToZUp::Mesh_ToZUp(Context* context) : IoComponentBase(context, 1, 1)
 	SetName("ToZUp");
 	SetFullName("ToZUp");
 	SetDescription("Convert mesh from Y-Up to Z-Up coordinates");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshIn");
 	inputSlots_[0]->SetVariableName("MeshIn");
@@ -47,6 +47,7 @@ Mesh_Torus::Mesh_Torus(Context* context) : IoComponentBase(context, 5, 2)
 	SetDescription("Construct a torus mesh from radii");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Primitive");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("OuterRadius");
 	inputSlots_[0]->SetVariableName("O");
@@ -48,6 +48,7 @@ Mesh_TriMeshVolume::Mesh_TriMeshVolume(Context* context) : IoComponentBase(conte
 	SetDescription("Compute volume of TriMesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -34,6 +34,7 @@ Mesh_TriangulateNMesh::Mesh_TriangulateNMesh(Context* context) : IoComponentBase
 	SetName("TriangulateNMesh");
 	SetFullName("Triangulate NMesh");
 	SetDescription("Triangulates a quad or N-mesh");
+	SetPure(true);
 
 	AddInputSlot(
 		"Mesh",
@@ -37,6 +37,7 @@ Mesh_UnifyNormals::Mesh_UnifyNormals(Context* context) : IoComponentBase(context
 	SetDescription("Unify TriMesh normals to consistent orientation");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("MeshIn");
 	inputSlots_[0]->SetVariableName("M");
@@ -28,11 +28,11 @@
 #include <Urho3D/Math/Plane.h>
 
 #include "TriMesh.h"
+#include "TriMeshAABB.h"
 #include "Polyline.h"
 #include "Geomlib_ConstructTransform.h"
 #include "igl/ray_mesh_intersect.h"
 #include "igl/voxel_grid.h"
-#include "igl/signed_distance.h"
 #include "igl/AABB.h"
 #include "igl/copyleft/marching_cubes.h"
 
@@ -47,6 +47,7 @@ Mesh_Voxelize::Mesh_Voxelize(Urho3D::Context* context) : IoComponentBase(context
 	SetName("ProjectOnto");
 	SetFullName("ProjectOnto");
 	SetDescription("Projects geometry on to other geometry");
+	SetPure(true);
 
 	AddInputSlot(
 		"Source",
@@ -154,18 +155,16 @@ void Mesh_Voxelize::SolveInstance(
 	Eigen::AlignedBox3d bb(Eigen::RowVector3d(min.x_, min.y_, min.z_), Eigen::RowVector3d(max.x_, max.y_, max.z_));
 	igl::voxel_grid(bb, numCells + 1, 1, vg, res);
 
-	//create sdf
-	Eigen::MatrixXd V;
-	Eigen::MatrixXi F;
-
-	TriMeshToDoubleMatrices(inSolveInstance[0], V, F);
-
-	Eigen::VectorXd S;
-	Eigen::VectorXi I;
-	Eigen::MatrixXd C;
-	Eigen::MatrixXd N;
-
-	igl::signed_distance(vg, V, F, igl::SignedDistanceType::SIGNED_DISTANCE_TYPE_DEFAULT, S, I, C, N);
+	//create sdf through the mesh's cached tree, which instances solved on other threads may query at the same time;
+	//the sign comes from the winding number, as with igl::signed_distance, but without igl's static cache
+	TriMeshAABBPtr tree = TriMesh_GetData(inSolveInstance[0])->GetAABB();
+	Eigen::VectorXd S(vg.rows());
+	for (int i = 0; i < vg.rows(); ++i)
+	{
+		int face;
+		Vector3 cp;
+		S[i] = tree->SignedDistance(Vector3((float)vg(i, 0), (float)vg(i, 1), (float)vg(i, 2)), face, cp);
+	}
 
 	VariantVector in;
 	VariantVector out;
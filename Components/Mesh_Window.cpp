@@ -46,6 +46,7 @@ Mesh_Window::Mesh_Window(Context* context) : IoComponentBase(context, 2, 1)
 	SetDescription("Creates a set of windows from a mesh");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Mesh");
 	inputSlots_[0]->SetVariableName("M");
@@ -26,10 +26,13 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Container/Vector.h>
 #include <Urho3D/Container/Str.h>
 
+#include "IoGraph.h"
+#include "Geomlib_MeshWrite.h"
 #include "Geomlib_WriteOFF.h"
 #include "TriMesh.h"
 
@@ -37,11 +40,13 @@ using namespace Urho3D;
 
 String Mesh_WriteOFF::iconTexture = "Textures/Icons/Mesh_WriteOFF.png";
 
-Mesh_WriteOFF::Mesh_WriteOFF(Context* context) : IoComponentBase(context, 3, 1)
+Mesh_WriteOFF::Mesh_WriteOFF(Context* context) : IoComponentBase(context, 4, 1), waitingForWrite_(false)
 {
 	SetName("WriteOFF");
 	SetFullName("WriteOFF");
 	SetDescription("Write TriMesh to OFF file");
+	SetMainThreadOnly(true);
+	SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(Mesh_WriteOFF, HandleWorkItemCompleted));
 
 	inputSlots_[0]->SetName("FileName");
 	inputSlots_[0]->SetVariableName("FileName");
@@ -63,6 +68,14 @@ Mesh_WriteOFF::Mesh_WriteOFF(Context* context) : IoComponentBase(context, 3, 1)
 	inputSlots_[2]->SetDefaultValue(false);
 	inputSlots_[2]->DefaultSet();
 
+	inputSlots_[3]->SetName("Background");
+	inputSlots_[3]->SetVariableName("B");
+	inputSlots_[3]->SetDescription("Write the file on a worker thread without waiting for it; SavedName is output once the file is written");
+	inputSlots_[3]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[3]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[3]->SetDefaultValue(false);
+	inputSlots_[3]->DefaultSet();
+
 	outputSlots_[0]->SetName("SavedName");
 	outputSlots_[0]->SetVariableName("SavedName");
 	outputSlots_[0]->SetDescription("SavedName");
@@ -97,8 +110,26 @@ void Mesh_WriteOFF::SolveInstance(
 		return;
 	}
 	bool zup = inSolveInstance[2].GetBool();
+	bool background = inSolveInstance[3].GetBool();
 
-	bool success = Geomlib::WriteOFF(filename, tri_mesh, zup);
+	bool success;
+	if (background) {
+		// the mesh data is immutable and shared, so the job can hold on to it
+		ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+		Geomlib::MeshWriteStatus status = Geomlib::GetMeshWriteStatus(filename, data.get(), Geomlib::MESH_OFF, zup);
+		if (status == Geomlib::MESH_WRITE_NONE)
+			status = Geomlib::WriteMeshInBackground(GetSubsystem<WorkQueue>(), data, filename, Geomlib::MESH_OFF, zup);
+		if (status == Geomlib::MESH_WRITE_PENDING) {
+			// the file does not exist yet, HandleWorkItemCompleted solves again once it does
+			waitingForWrite_ = true;
+			outSolveInstance[0] = Variant();
+			return;
+		}
+		success = status == Geomlib::MESH_WRITE_DONE;
+	}
+	else {
+		success = Geomlib::WriteOFF(filename, tri_mesh, zup);
+	}
 	if (!success) {
 		URHO3D_LOGERROR("Mesh_WriteOFF --- Geomlib::WriteOFF failed");
 		SetAllOutputsNull(outSolveInstance);
@@ -106,4 +137,15 @@ void Mesh_WriteOFF::SolveInstance(
 	}
 
 	outSolveInstance[0] = filename;
-}
\ No newline at end of file
+}
+
+void Mesh_WriteOFF::HandleWorkItemCompleted(StringHash eventType, VariantMap& eventData)
+{
+	if (!waitingForWrite_)
+		return;
+
+	waitingForWrite_ = false;
+	solvedFlag_ = 0;
+	MarkDirty();
+	GetSubsystem<IoGraph>()->QuickTopoSolveGraph();
+}
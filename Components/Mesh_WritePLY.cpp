@@ -26,10 +26,13 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Container/Vector.h>
 #include <Urho3D/Container/Str.h>
 
+#include "IoGraph.h"
+#include "Geomlib_MeshWrite.h"
 #include "Geomlib_WritePLY.h"
 #include "TriMesh.h"
 
@@ -37,11 +40,13 @@ using namespace Urho3D;
 
 String Mesh_WritePLY::iconTexture = "Textures/Icons/Mesh_WritePLY.png";
 
-Mesh_WritePLY::Mesh_WritePLY(Context* context) : IoComponentBase(context, 3, 1)
+Mesh_WritePLY::Mesh_WritePLY(Context* context) : IoComponentBase(context, 5, 1), waitingForWrite_(false)
 {
 	SetName("WritePLY");
 	SetFullName("WritePLY");
 	SetDescription("Write TriMesh to PLY file");
+	SetMainThreadOnly(true);
+	SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(Mesh_WritePLY, HandleWorkItemCompleted));
 
 	inputSlots_[0]->SetName("FileName");
 	inputSlots_[0]->SetVariableName("FileName");
@@ -63,6 +68,22 @@ Mesh_WritePLY::Mesh_WritePLY(Context* context) : IoComponentBase(context, 3, 1)
 	inputSlots_[2]->SetDefaultValue(false);
 	inputSlots_[2]->DefaultSet();
 
+	inputSlots_[3]->SetName("Background");
+	inputSlots_[3]->SetVariableName("B");
+	inputSlots_[3]->SetDescription("Write the file on a worker thread without waiting for it; SavedName is output once the file is written");
+	inputSlots_[3]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[3]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[3]->SetDefaultValue(false);
+	inputSlots_[3]->DefaultSet();
+
+	inputSlots_[4]->SetName("Binary");
+	inputSlots_[4]->SetVariableName("Bin");
+	inputSlots_[4]->SetDescription("Write binary instead of ascii PLY");
+	inputSlots_[4]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[4]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[4]->SetDefaultValue(false);
+	inputSlots_[4]->DefaultSet();
+
 	outputSlots_[0]->SetName("SavedName");
 	outputSlots_[0]->SetVariableName("SavedName");
 	outputSlots_[0]->SetDescription("SavedName");
@@ -97,8 +118,28 @@ void Mesh_WritePLY::SolveInstance(
 		return;
 	}
 	bool zup = inSolveInstance[2].GetBool();
+	bool background = inSolveInstance[3].GetBool();
+	bool binary = inSolveInstance[4].GetBool();
 
-	bool success = Geomlib::WritePLY(filename, tri_mesh, zup);
+	bool success;
+	if (background) {
+		// the mesh data is immutable and shared, so the job can hold on to it
+		Geomlib::MeshWriteFormat format = binary ? Geomlib::MESH_PLY_BINARY : Geomlib::MESH_PLY_ASCII;
+		ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+		Geomlib::MeshWriteStatus status = Geomlib::GetMeshWriteStatus(filename, data.get(), format, zup);
+		if (status == Geomlib::MESH_WRITE_NONE)
+			status = Geomlib::WriteMeshInBackground(GetSubsystem<WorkQueue>(), data, filename, format, zup);
+		if (status == Geomlib::MESH_WRITE_PENDING) {
+			// the file does not exist yet, HandleWorkItemCompleted solves again once it does
+			waitingForWrite_ = true;
+			outSolveInstance[0] = Variant();
+			return;
+		}
+		success = status == Geomlib::MESH_WRITE_DONE;
+	}
+	else {
+		success = Geomlib::WritePLY(filename, tri_mesh, zup, binary);
+	}
 	if (!success) {
 		URHO3D_LOGERROR("Mesh_WritePLY --- Geomlib::WritePLY failed");
 		SetAllOutputsNull(outSolveInstance);
@@ -106,4 +147,15 @@ void Mesh_WritePLY::SolveInstance(
 	}
 
 	outSolveInstance[0] = filename;
-}
\ No newline at end of file
+}
+
+void Mesh_WritePLY::HandleWorkItemCompleted(StringHash eventType, VariantMap& eventData)
+{
+	if (!waitingForWrite_)
+		return;
+
+	waitingForWrite_ = false;
+	solvedFlag_ = 0;
+	MarkDirty();
+	GetSubsystem<IoGraph>()->QuickTopoSolveGraph();
+}
@@ -39,4 +39,10 @@ public:
 	void DeleteOutputSlot(int index) = delete;
 
 	static Urho3D::String iconTexture;
+
+private:
+	// re-solves after a background write finishes, so SavedName is only output for written files
+	void HandleWorkItemCompleted(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
+
+	bool waitingForWrite_;
 };
\ No newline at end of file
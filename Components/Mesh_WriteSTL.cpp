@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Mesh_WriteSTL.h"
+
+#include <assert.h>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Container/Str.h>
+
+#include "IoGraph.h"
+#include "Geomlib_MeshWrite.h"
+#include "TriMesh.h"
+
+using namespace Urho3D;
+
+String Mesh_WriteSTL::iconTexture = "Textures/Icons/Mesh_WriteSTL.png";
+
+Mesh_WriteSTL::Mesh_WriteSTL(Context* context) : IoComponentBase(context, 5, 1), waitingForWrite_(false)
+{
+	SetName("WriteSTL");
+	SetFullName("WriteSTL");
+	SetDescription("Write TriMesh to STL file");
+	SetMainThreadOnly(true);
+	SubscribeToEvent(E_WORKITEMCOMPLETED, URHO3D_HANDLER(Mesh_WriteSTL, HandleWorkItemCompleted));
+
+	inputSlots_[0]->SetName("FileName");
+	inputSlots_[0]->SetVariableName("FileName");
+	inputSlots_[0]->SetDescription("FileName");
+	inputSlots_[0]->SetVariantType(VariantType::VAR_STRING);
+	inputSlots_[0]->SetDataAccess(DataAccess::ITEM);
+
+	inputSlots_[1]->SetName("Mesh");
+	inputSlots_[1]->SetVariableName("M");
+	inputSlots_[1]->SetDescription("Mesh");
+	inputSlots_[1]->SetVariantType(VariantType::VAR_VARIANTMAP);
+	inputSlots_[1]->SetDataAccess(DataAccess::ITEM);
+
+	inputSlots_[2]->SetName("ToZUp");
+	inputSlots_[2]->SetVariableName("ToZUp");
+	inputSlots_[2]->SetDescription("Transform coords to Z Up");
+	inputSlots_[2]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[2]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[2]->SetDefaultValue(false);
+	inputSlots_[2]->DefaultSet();
+
+	inputSlots_[3]->SetName("Background");
+	inputSlots_[3]->SetVariableName("B");
+	inputSlots_[3]->SetDescription("Write the file on a worker thread without waiting for it; SavedName is output once the file is written");
+	inputSlots_[3]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[3]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[3]->SetDefaultValue(false);
+	inputSlots_[3]->DefaultSet();
+
+	inputSlots_[4]->SetName("Binary");
+	inputSlots_[4]->SetVariableName("Bin");
+	inputSlots_[4]->SetDescription("Write binary instead of ascii STL");
+	inputSlots_[4]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[4]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[4]->SetDefaultValue(true);
+	inputSlots_[4]->DefaultSet();
+
+	outputSlots_[0]->SetName("SavedName");
+	outputSlots_[0]->SetVariableName("SavedName");
+	outputSlots_[0]->SetDescription("SavedName");
+	outputSlots_[0]->SetVariantType(VariantType::VAR_STRING);
+	outputSlots_[0]->SetDataAccess(DataAccess::ITEM);
+}
+
+void Mesh_WriteSTL::SolveInstance(
+	const Vector<Variant>& inSolveInstance,
+	Vector<Variant>& outSolveInstance
+)
+{
+	String filename = inSolveInstance[0].GetString();
+	if (filename.Empty()) {
+		URHO3D_LOGERROR("Mesh_WriteSTL --- invalid FileName");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+	int len = filename.Length();
+	if (
+		len < 4 ||
+		filename.Substring(len - 4) != String(".stl")
+		)
+	{
+		filename += ".stl";
+	}
+
+	Variant tri_mesh = inSolveInstance[1];
+	if (!TriMesh_Verify(tri_mesh)) {
+		URHO3D_LOGERROR("Mesh_WriteSTL --- invalid Mesh input");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+	bool zup = inSolveInstance[2].GetBool();
+	bool background = inSolveInstance[3].GetBool();
+	bool binary = inSolveInstance[4].GetBool();
+
+	Geomlib::MeshWriteFormat format = binary ? Geomlib::MESH_STL_BINARY : Geomlib::MESH_STL_ASCII;
+	bool success;
+	if (background) {
+		// the mesh data is immutable and shared, so the job can hold on to it
+		ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+		Geomlib::MeshWriteStatus status = Geomlib::GetMeshWriteStatus(filename, data.get(), format, zup);
+		if (status == Geomlib::MESH_WRITE_NONE)
+			status = Geomlib::WriteMeshInBackground(GetSubsystem<WorkQueue>(), data, filename, format, zup);
+		if (status == Geomlib::MESH_WRITE_PENDING) {
+			// the file does not exist yet, HandleWorkItemCompleted solves again once it does
+			waitingForWrite_ = true;
+			outSolveInstance[0] = Variant();
+			return;
+		}
+		success = status == Geomlib::MESH_WRITE_DONE;
+	}
+	else {
+		ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+		success = data && Geomlib::WriteMesh(*data, filename, format, zup);
+	}
+	if (!success) {
+		URHO3D_LOGERROR("Mesh_WriteSTL --- could not write " + filename);
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	outSolveInstance[0] = filename;
+}
+
+void Mesh_WriteSTL::HandleWorkItemCompleted(StringHash eventType, VariantMap& eventData)
+{
+	if (!waitingForWrite_)
+		return;
+
+	waitingForWrite_ = false;
+	solvedFlag_ = 0;
+	MarkDirty();
+	GetSubsystem<IoGraph>()->QuickTopoSolveGraph();
+}
@@ -316,12 +316,11 @@ void ModelBoxMorph::HandleMouseUp(Urho3D::StringHash eventType, Urho3D::VariantM
 		Vector<Vector3> morphed_verts;
 		DoBoxMorph(morphed_verts, geomOut);
         
-        // preserve any other keys in baseGeometry by setting verts and faces
+        // preserve any other keys in baseGeometry by copying the morphed mesh keys over it
         VariantMap baseMap = baseGeometry_.GetVariantMap();
-        VariantVector rev_verts = TriMesh_GetVertexList(geomOut);
-        VariantVector rev_faces = TriMesh_GetFaceList(geomOut);
-        baseMap["vertices"] = Variant(rev_verts);
-        baseMap["faces"] = Variant(rev_faces);
+        const VariantMap& revMap = geomOut.GetVariantMap();
+        for (VariantMap::ConstIterator it = revMap.Begin(); it != revMap.End(); ++it)
+            baseMap[it->first_] = it->second_;
         
 		baseGeometry_ = Variant(baseMap);
 
@@ -37,6 +37,7 @@ Physics_ApplyForce::Physics_ApplyForce(Urho3D::Context* context) : IoComponentBa
 	SetName("ApplyForce");
 	SetFullName("Apply Force");
 	SetDescription("Apply a force (vector with magnitude) to a rigid body");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("RigidBody");
 	inputSlots_[0]->SetVariableName("R");
@@ -41,6 +41,7 @@ Physics_CollisionShape::Physics_CollisionShape(Urho3D::Context* context) : IoCom
 	SetName("CollisionShape");
 	SetFullName("Collision Shape");
 	SetDescription("Construct a collision shape form a mesh or model");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Node ID");
 	inputSlots_[0]->SetVariableName("ID");
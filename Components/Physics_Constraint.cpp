@@ -57,6 +57,7 @@ Physics_Constraint::Physics_Constraint(Urho3D::Context* context) : IoComponentBa
 	SetName("PhysicsConstraint");
 	SetFullName("Physics Constraint");
 	SetDescription("Construct a constraint between a rigidbody and an optional second one.");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Body A");
 	inputSlots_[0]->SetVariableName("A");
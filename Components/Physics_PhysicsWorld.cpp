@@ -35,6 +35,7 @@ Physics_PhysicsWorld::Physics_PhysicsWorld(Urho3D::Context* context) : IoCompone
 	SetDescription("Initializes physics world");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("PHYSICS");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Step");
 	inputSlots_[0]->SetVariableName("Go");
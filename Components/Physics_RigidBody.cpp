@@ -38,6 +38,7 @@ Physics_RigidBody::Physics_RigidBody(Urho3D::Context* context) : IoComponentBase
 	SetDescription("Adds rigid body behaviour to a node");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("PHYSICS");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Node ID");
 	inputSlots_[0]->SetVariableName("ID");
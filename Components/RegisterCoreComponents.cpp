@@ -22,6 +22,8 @@
 
 #include "RegisterCoreComponents.h"
 #include "ComponentRegistration.h"
+#include "TriMeshData.h"
+#include "TriMeshSerialization.h"
 
 ///////////////////////////////////////// COMPONENT REGISTRATION ///////////////////////////////////////////////////////
 
@@ -121,6 +123,7 @@ you must include it here and follow the registration pattern in RegisterComponen
 #include "Graphics_Zone.h"
 #include "Graphics_Viewport.h"
 #include "Graphics_MeshRenderer.h"
+#include "Graphics_InstancedMeshRenderer.h"
 #include "Graphics_PointRenderer.h"
 #include "Graphics_CurveToModel.h"
 #include "Graphics_CurveRenderer.h"
@@ -187,6 +190,7 @@ you must include it here and follow the registration pattern in RegisterComponen
 #include "Mesh_DeconstructTriangleMesh.h"
 #include "Mesh_ConstructTriangleMesh.h"
 #include "Mesh_ClosestPoint.h"
+#include "Mesh_ClosestPoints.h"
 #include "Mesh_HexayurtMesh.h"
 #include "Mesh_CubeMesh.h"
 #include "Mesh_Icosahedron.h"
@@ -207,6 +211,7 @@ you must include it here and follow the registration pattern in RegisterComponen
 #include "Mesh_WriteOBJ.h"
 #include "Mesh_WriteOFF.h"
 #include "Mesh_WritePLY.h"
+#include "Mesh_WriteSTL.h"
 #include "Mesh_ReadSTL.h"
 #include "Mesh_SignedDistance.h"
 #include "Curve_ZigZagPolyline.h"
@@ -237,6 +242,7 @@ you must include it here and follow the registration pattern in RegisterComponen
 #include "Maths_Expression.h"
 #include "Input_ColorWheel.h"
 #include "Vector_ClosestPoint.h"
+#include "Vector_ClosestPoints.h"
 #include "Vector_Distance.h"
 #include "Vector_ColorRGBA.h"
 #include "Vector_BestFitPlane.h"
@@ -324,6 +330,9 @@ using namespace Urho3D;
 
 void RegisterCoreComponents(Context* context)
 {
+	// binary graph files keep meshes as raw blocks, and data tree profiles count their size
+	TriMesh_RegisterSerialization();
+	TriMesh_RegisterMemoryUse();
 
 	context->RegisterFactory<Widget_Base>();
 	context->RegisterFactory<Widget_OptionSlider>();
@@ -431,6 +440,7 @@ void RegisterCoreComponents(Context* context)
 	RegisterIogramType<Graphics_Zone>(context);
 	RegisterIogramType<Graphics_Viewport>(context);
 	RegisterIogramType<Graphics_MeshRenderer>(context);
+	RegisterIogramType<Graphics_InstancedMeshRenderer>(context);
 	RegisterIogramType<Graphics_PointRenderer>(context);
 	RegisterIogramType<Graphics_MeshEdges>(context);
 	RegisterIogramType<Graphics_CurveToModel>(context);
@@ -499,6 +509,7 @@ void RegisterCoreComponents(Context* context)
 	RegisterIogramType<Mesh_DeconstructTriangleMesh>(context);
 	RegisterIogramType<Mesh_ConstructTriangleMesh>(context);
 	RegisterIogramType<Mesh_ClosestPoint>(context);
+	RegisterIogramType<Mesh_ClosestPoints>(context);
 	RegisterIogramType<Mesh_HexayurtMesh>(context);
 	RegisterIogramType<Mesh_CubeMesh>(context);
 	RegisterIogramType<Mesh_Icosahedron>(context);
@@ -545,6 +556,7 @@ void RegisterCoreComponents(Context* context)
 	RegisterIogramType<Maths_Expression>(context);
 	//RegisterIogramType<Input_ColorWheel>(context);
 	RegisterIogramType<Vector_ClosestPoint>(context);
+	RegisterIogramType<Vector_ClosestPoints>(context);
 	RegisterIogramType<Vector_Distance>(context);
 	RegisterIogramType<Vector_ColorRGBA>(context);
 	RegisterIogramType<Vector_ColorPalette>(context);
@@ -596,6 +608,7 @@ void RegisterCoreComponents(Context* context)
 	RegisterIogramType<Mesh_WriteOFF>(context);
 	RegisterIogramType<Mesh_WriteOBJ>(context);
 	RegisterIogramType<Mesh_WritePLY>(context);
+	RegisterIogramType<Mesh_WriteSTL>(context);
 	RegisterIogramType<Mesh_Remesh>(context);
 	RegisterIogramType<Mesh_SlideTowards>(context);
 	RegisterIogramType<Mesh_LinearDeformation>(context);
@@ -33,6 +33,7 @@ Scene_AddComponent::Scene_AddComponent(Context* context) : IoComponentBase(conte
 	SetName("AddComponent");
 	SetFullName("Add Component");
 	SetDescription("Adds a native component to a scene node.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -38,6 +38,7 @@ Scene_AddNode::Scene_AddNode(Urho3D::Context* context) : IoComponentBase(context
 	SetDescription("Adds a node with optional name and parent");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Transform");
 	inputSlots_[0]->SetVariableName("T");
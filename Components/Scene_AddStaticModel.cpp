@@ -39,6 +39,7 @@ Scene_AddStaticModel::Scene_AddStaticModel(Urho3D::Context* context) : IoCompone
 	SetDescription("Adds a static model");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("NodeID");
 	inputSlots_[0]->SetVariableName("ID");
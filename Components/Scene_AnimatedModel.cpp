@@ -37,6 +37,7 @@ Scene_AnimatedModel::Scene_AnimatedModel(Urho3D::Context* context) : IoComponent
 	SetName("Add Static Model");
 	SetFullName("Add Static Model To Scene");
 	SetDescription("Adds a static model");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("NodeID");
 	inputSlots_[0]->SetVariableName("ID");
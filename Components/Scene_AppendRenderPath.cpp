@@ -34,6 +34,7 @@ Scene_AppendRenderPath::Scene_AppendRenderPath(Urho3D::Context* context) : IoCom
 	SetName("RenderPath");
 	SetFullName("Render Path");
 	SetDescription("Appends a render path item to a viewport.");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("RenderPath");
 	inputSlots_[0]->SetVariableName("RP");
@@ -36,6 +36,7 @@ Scene_CloneNode::Scene_CloneNode(Urho3D::Context* context) : IoComponentBase(con
 	SetName("Clone Node");
 	SetFullName("Clones a node and all of its components.");
 	SetDescription("Clones a node");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"NodeID",
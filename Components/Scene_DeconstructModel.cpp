@@ -133,6 +133,7 @@ Scene_DeconstructModel::Scene_DeconstructModel(Urho3D::Context* context) : IoCom
 	SetDescription("Deconstructs a static model into vertices, faces and normals");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Model");
 	inputSlots_[0]->SetVariableName("M");
@@ -36,6 +36,7 @@ Scene_DeconstructTransform::Scene_DeconstructTransform(Context* context) :
 	SetName("DeconstructTransform");
 	SetFullName("Deconstruct Transform");
 	SetDescription("Deconstruct a transform into position, rotation, and scale");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Transform",
@@ -41,6 +41,7 @@ Scene_Display::Scene_Display(Urho3D::Context* context) : IoComponentBase(context
 	SetName("Display");
 	SetFullName("Geometry Display");
 	SetDescription("Displays geometry in the scene");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Geometry");
 	inputSlots_[0]->SetVariableName("G");
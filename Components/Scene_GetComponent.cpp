@@ -32,6 +32,7 @@ Scene_GetComponent::Scene_GetComponent(Urho3D::Context* context):IoComponentBase
 	SetName("GetComponent");
 	SetFullName("Get Component");
 	SetDescription("Gets a reference to a component from Node ID");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -37,6 +37,7 @@ Scene_GetGlobalVar::Scene_GetGlobalVar(Context* context) :
 	SetName("GetGlobalVar");
 	SetFullName("Get Global Variant");
 	SetDescription("Gets a global variant by name (key)");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"VarName",
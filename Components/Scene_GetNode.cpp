@@ -41,6 +41,7 @@ Scene_GetNode::Scene_GetNode(Context* context) :
 	SetDescription("Finds a Node");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("Primitive");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"NodeID",
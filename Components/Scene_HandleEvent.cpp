@@ -35,6 +35,7 @@ Scene_HandleEvent::Scene_HandleEvent(Context* context) :
 	SetName("HandleEvent");
 	SetFullName("Handle Event");
 	SetDescription("Receive an Event");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("EventName");
 	inputSlots_[0]->SetVariableName("E");
@@ -36,6 +36,7 @@ Scene_LoadScene::Scene_LoadScene(Urho3D::Context* context) :IoComponentBase(cont
 	SetName("LoadScene");
 	SetFullName("Load Scene");
 	SetDescription("Loads a Scene resource file from XML or JSON");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"ScenePath",
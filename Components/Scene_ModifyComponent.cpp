@@ -34,6 +34,7 @@ Scene_ModifyComponent::Scene_ModifyComponent(Context* context) : IoComponentBase
 	SetName("ModifyComponent");
 	SetFullName("Modify Component");
 	SetDescription("Modifies the properties of a native component.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -38,6 +38,7 @@ Scene_ModifyNode::Scene_ModifyNode(Context* context) :
 	SetDescription("Modifies basic properties of a Node");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("Primitive");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("ID");
 	inputSlots_[0]->SetVariableName("ID");
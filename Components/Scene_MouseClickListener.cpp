@@ -41,6 +41,7 @@ Scene_MouseClickListener::Scene_MouseClickListener(Urho3D::Context* context) : I
 	SetDescription("Listens for mouse clickkinput");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("On");
 	inputSlots_[0]->SetVariableName("On");
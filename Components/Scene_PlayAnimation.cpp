@@ -37,6 +37,7 @@ Scene_PlayAnimation::Scene_PlayAnimation(Urho3D::Context* context) : IoComponent
 	SetName("PlayAnimation");
 	SetFullName("Play animation");
 	SetDescription("Play an animation");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("NodeID");
 	inputSlots_[0]->SetVariableName("ID");
@@ -35,6 +35,7 @@ Scene_Raycast::Scene_Raycast(Urho3D::Context* context) : IoComponentBase(context
 	SetDescription("Listens for screen raycasts, returns hit information");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 
 	inputSlots_[0]->SetName("StartPoint");
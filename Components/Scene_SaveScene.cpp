@@ -33,6 +33,7 @@ Scene_SaveScene::Scene_SaveScene(Urho3D::Context* context) :IoComponentBase(cont
 	SetName("SaveScene");
 	SetFullName("Save Scene");
 	SetDescription("Saves current Scene resource file from XML or JSON");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"ScenePath",
@@ -37,6 +37,7 @@ Scene_ScreenBloom::Scene_ScreenBloom(Urho3D::Context* context) : IoComponentBase
 	SetDescription("Adds intensity-controlled screen bloom effect");
 	SetGroup(IoComponentGroup::DISPLAY);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Intensity");
 	inputSlots_[0]->SetVariableName("I");
@@ -39,6 +39,7 @@ Scene_ScreenPointToRay::Scene_ScreenPointToRay(Urho3D::Context* context) : IoCom
 	SetDescription("Given a screen point, returns a ray in world coordinates");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("INPUT");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("ScreenPoint");
 	inputSlots_[0]->SetVariableName("SP");
@@ -44,6 +44,7 @@ Scene_ScriptInstance::Scene_ScriptInstance(Urho3D::Context* context) : IoCompone
 	SetDescription("Executes a script from file");
 	SetGroup(IoComponentGroup::MATHS);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("ScriptFile");
 	inputSlots_[0]->SetVariableName("SC");
@@ -45,6 +45,7 @@ Scene_SelectGeometry::Scene_SelectGeometry(Urho3D::Context* context) : IoCompone
 	SetDescription("Returns selected geometry");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("On");
 	inputSlots_[0]->SetVariableName("On");
@@ -34,6 +34,7 @@ Scene_SendEvent::Scene_SendEvent(Context* context) :
 	SetName("SendEvent");
 	SetFullName("Send Event");
 	SetDescription("Define and send an event");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("EventName");
 	inputSlots_[0]->SetVariableName("E");
@@ -39,6 +39,7 @@ Scene_SetGlobalVar::Scene_SetGlobalVar(Context* context) :
 	SetName("SetGlobalVar");
 	SetFullName("Set Global Variant");
 	SetDescription("Sets a global variant by name (key)");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Key",
@@ -37,6 +37,7 @@ Scene_Text3D::Scene_Text3D(Context* context) : IoComponentBase(context, 0, 0)
 	SetName("Text3D");
 	SetFullName("Text3D");
 	SetDescription("Creates a 3D text node at given position and scale");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Text",
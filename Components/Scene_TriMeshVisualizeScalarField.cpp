@@ -46,6 +46,7 @@ Scene_TriMeshVisualizeScalarField::Scene_TriMeshVisualizeScalarField(Urho3D::Con
 	SetName("TriMeshVisualizeScalarField");
 	SetFullName("TriMesh Visualize Scalar Field");
 	SetDescription("Visualize scalar field on a TriMesh");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("TriMesh");
 	inputSlots_[0]->SetVariableName("M");
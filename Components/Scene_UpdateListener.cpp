@@ -37,6 +37,7 @@ Scene_UpdateListener::Scene_UpdateListener(Urho3D::Context* context) : IoCompone
 	SetDescription("Listens for scene updates");
 	SetGroup(IoComponentGroup::SCENE);
 	SetSubgroup("");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Mute");
 	inputSlots_[0]->SetVariableName("M");
@@ -38,6 +38,7 @@ Sets_ExportViewData::Sets_ExportViewData(Context* context) :
 	SetName("ExportViewData");
 	SetFullName("Export View Data");
 	SetDescription("Exports data from a view to be used in another view.");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
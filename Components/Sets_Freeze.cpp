@@ -43,6 +43,7 @@ freeze_(false)
 	SetName("Freeze");
 	SetFullName("Data Freeze");
 	SetDescription("Writes all incoming data to a file. Then, if enabled, reads that data back. Good for saving states.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Data",
@@ -36,6 +36,7 @@ Sets_ImportViewData::Sets_ImportViewData(Context* context) :
 	SetName("ImportViewData");
 	SetFullName("Import View Data");
 	SetDescription("Imports data from a view to be used in this view.");
+	SetMainThreadOnly(true);
 
 
 	AddInputSlot(
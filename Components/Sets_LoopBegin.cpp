@@ -24,7 +24,9 @@
 
 #include <assert.h>
 
+#include <Urho3D/Core/Timer.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/IO/Log.h>
 
 #include <Urho3D/Scene/SceneEvents.h>
 #include <Urho3D/Scene/Scene.h>
@@ -35,11 +37,19 @@ using namespace Urho3D;
 
 String Sets_LoopBegin::iconTexture = "Textures/Icons/Sets_LoopBegin.png";
 
-Sets_LoopBegin::Sets_LoopBegin(Urho3D::Context* context) : IoComponentBase(context, 0, 0)
+Sets_LoopBegin::Sets_LoopBegin(Urho3D::Context* context) : IoComponentBase(context, 0, 0),
+	numSteps(0),
+	currentIndex(0),
+	synchronous(false),
+	timeBudget(0.0f),
+	stopRequested(false),
+	runPending(false),
+	bodyOrderVersion(0)
 {
 	SetName("ForLoopBegin");
 	SetFullName("For Loop Begin");
 	SetDescription("Entry point for a For Loop");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Name",
@@ -67,6 +77,24 @@ Sets_LoopBegin::Sets_LoopBegin(Urho3D::Context* context) : IoComponentBase(conte
 		ITEM
 	);
 
+	AddInputSlot(
+		"Synchronous",
+		"S",
+		"Run all steps within one solve instead of one step per frame.",
+		VAR_BOOL,
+		ITEM,
+		false
+	);
+
+	AddInputSlot(
+		"Time Budget",
+		"T",
+		"Milliseconds a synchronous loop may run for per frame. 0 for no limit",
+		VAR_FLOAT,
+		ITEM,
+		0.0f
+	);
+
 	AddOutputSlot(
 		"Index",
 		"I",
@@ -91,15 +119,30 @@ void Sets_LoopBegin::SolveInstance(
 {
 	String loopName = inSolveInstance[0].GetString();
 	int userSteps = inSolveInstance[1].GetInt();
+	bool userSynchronous = inSolveInstance[3].GetBool();
+	timeBudget = inSolveInstance[4].GetFloat();
 
 	//reset behaviour
-	if (userSteps != numSteps || loopName != loopID)
+	if (userSteps != numSteps || loopName != loopID || userSynchronous != synchronous)
 	{
 		numSteps = userSteps;
 		loopID = loopName;
+		synchronous = userSynchronous;
 		currentIndex = 0;
+		stopRequested = false;
 		trackedData = inSolveInstance[2];
-		SubscribeToEvent(E_SCENEUPDATE, URHO3D_HANDLER(Sets_LoopBegin, HandleUpdate));
+		if (synchronous)
+		{
+			//the remaining steps run once the rest of this solve is done
+			runPending = true;
+			UnsubscribeFromEvent(E_SCENEUPDATE);
+			SubscribeToEvent("OnSolveGraph", URHO3D_HANDLER(Sets_LoopBegin, HandleGraphSolved));
+		}
+		else
+		{
+			runPending = false;
+			SubscribeToEvent(E_SCENEUPDATE, URHO3D_HANDLER(Sets_LoopBegin, HandleUpdate));
+		}
 		outSolveInstance[0] = currentIndex;
 		outSolveInstance[1] = trackedData;
 	}
@@ -111,9 +154,149 @@ void Sets_LoopBegin::SolveInstance(
 	}
 }
 
+void Sets_LoopBegin::StopLoop()
+{
+	stopRequested = true;
+	runPending = false;
+	UnsubscribeFromEvent(E_SCENEUPDATE);
+}
+
+void Sets_LoopBegin::HandleGraphSolved(StringHash eventType, VariantMap& eventData)
+{
+	if (!runPending)
+	{
+		return;
+	}
+
+	runPending = false;
+	RunSynchronously(timeBudget);
+}
+
+bool Sets_LoopBegin::UpdateBodyOrder()
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+	unsigned version = graph->GetTopologicalOrderVersion();
+	if (version == bodyOrderVersion && !bodyOrder.Empty())
+	{
+		return true;
+	}
+
+	bodyOrder.Clear();
+	bodyOrderVersion = version;
+
+	int beginIndex = graph->GetComponentIndex(this);
+	if (beginIndex < 0)
+	{
+		return false;
+	}
+
+	//the loop end is the Sets_LoopEnd whose LoopStart input is linked to this
+	Vector<SharedPtr<IoComponentBase> > components = graph->GetAllComponents();
+	for (unsigned i = 0; i < components.Size(); ++i)
+	{
+		if (components[i]->GetTypeName() != "Sets_LoopEnd" || components[i]->GetIncomingLink(0).first_.Get() != this)
+		{
+			continue;
+		}
+		bodyOrder = graph->GetSubgraphOrder(beginIndex, i);
+		break;
+	}
+
+	return !bodyOrder.Empty();
+}
+
+void Sets_LoopBegin::RunSynchronously(float budgetMs)
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+	if (!UpdateBodyOrder())
+	{
+		URHO3D_LOGWARNING("Sets_LoopBegin --- synchronous loop needs a Loop End connected to it");
+		return;
+	}
+
+	HiresTimer timer;
+	while (currentIndex < numSteps && !stopRequested)
+	{
+		//bodyOrder starts with this component, which moves on to the next index when solved
+		graph->SolveComponents(bodyOrder);
+
+		VariantMap data;
+		data["loop"] = loopID;
+		data["index"] = currentIndex;
+		data["steps"] = numSteps;
+		SendEvent("OnLoopIteration", data);
+
+		if (budgetMs > 0.0f && timer.GetUSec(false) > (long long)(budgetMs * 1000.0f))
+		{
+			break;
+		}
+	}
+
+	if (currentIndex < numSteps && !stopRequested)
+	{
+		//out of time; carry on next frame
+		SubscribeToEvent(E_SCENEUPDATE, URHO3D_HANDLER(Sets_LoopBegin, HandleUpdate));
+		return;
+	}
+
+	UnsubscribeFromEvent(E_SCENEUPDATE);
+
+	//the components downstream of the loop have only seen its first step
+	MarkDownstreamDirty();
+	graph->QuickTopoSolveGraph();
+}
+
+void Sets_LoopBegin::MarkDownstreamDirty()
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+	unsigned numComponents = graph->GetAllComponents().Size();
+
+	Vector<bool> inBody(numComponents);
+	Vector<bool> marked(numComponents);
+	for (unsigned i = 0; i < numComponents; ++i)
+	{
+		inBody[i] = false;
+		marked[i] = false;
+	}
+	for (unsigned i = 0; i < bodyOrder.Size(); ++i)
+	{
+		inBody[bodyOrder[i]] = true;
+	}
+
+	//walk down from the body; SolveComponents solved it outside of a graph solve, so nothing below it is flagged
+	Vector<unsigned> stack;
+	for (unsigned i = 0; i < bodyOrder.Size(); ++i)
+	{
+		stack.Push(bodyOrder[i]);
+	}
+	while (!stack.Empty())
+	{
+		unsigned index = stack.Back();
+		stack.Pop();
+
+		Vector<unsigned> children = graph->GetDownstreamComponentIndices(index);
+		for (unsigned i = 0; i < children.Size(); ++i)
+		{
+			unsigned child = children[i];
+			if (inBody[child] || marked[child])
+			{
+				continue;
+			}
+			marked[child] = true;
+			graph->GetComponent(child)->MarkDirty();
+			stack.Push(child);
+		}
+	}
+}
+
 void Sets_LoopBegin::HandleUpdate(StringHash eventType, VariantMap& eventData)
 {
-	
+	if (synchronous)
+	{
+		RunSynchronously(timeBudget);
+		return;
+	}
+
 	//only update if this condition is met
 	if (currentIndex < numSteps)
 	{
@@ -41,7 +41,30 @@ public:
 	Urho3D::String loopID;
 	Urho3D::Variant trackedData;
 
+	// synchronous loops run all their iterations right after the graph solve that started them,
+	// re-solving only the components between this and its Sets_LoopEnd
+	bool synchronous;
+	// milliseconds a synchronous loop may run for before yielding to the next frame; 0 for no limit
+	float timeBudget;
+	bool stopRequested;
+	bool runPending;
+
+	// components from this to the connected Sets_LoopEnd, cached for IoGraph::GetTopologicalOrderVersion
+	Urho3D::Vector<int> bodyOrder;
+	unsigned bodyOrderVersion;
+
 	static Urho3D::String iconTexture;
 
+	// stops the loop after the current iteration; called by Sets_LoopEnd
+	void StopLoop();
+
 	void HandleUpdate(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
+	void HandleGraphSolved(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
+
+private:
+	bool UpdateBodyOrder();
+	// runs iterations until the loop is done or budgetMs have passed (0 for no limit)
+	void RunSynchronously(float budgetMs);
+	// flags everything downstream of the body, but outside of it, to be solved again
+	void MarkDownstreamDirty();
 };
\ No newline at end of file
@@ -37,6 +37,7 @@ Sets_LoopEnd::Sets_LoopEnd(Urho3D::Context* context) : IoComponentBase(context,
 	SetName("LoopEnd");
 	SetFullName("Loop End");
 	SetDescription("Ends a loop or transmits data back to start.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"LoopStart",
@@ -96,9 +97,7 @@ void Sets_LoopEnd::SolveInstance(
 			bool stop = inSolveInstance[1].GetBool();
 			if (stop)
 			{
-				//need a good way to stop
-				loopBegin->UnsubscribeFromEvent(E_SCENEUPDATE);
-				//loopBegin->currentIndex = loopBegin->numSteps;
+				loopBegin->StopLoop();
 			}
 			else {
 				//transmit the data backwards!! Here be dragons.
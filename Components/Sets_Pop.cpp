@@ -38,6 +38,7 @@ Sets_Pop::Sets_Pop(Urho3D::Context* context) : IoComponentBase(context, 0, 0)
 	SetName("DataRecorder");
 	SetFullName("Data Recorder");
 	SetDescription("Records generic data and outputs to list.");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"List",
@@ -24,6 +24,7 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -32,11 +33,14 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/Container/Vector.h>
 #include <Urho3D/Container/Str.h>
+#include <Urho3D/Scene/SceneEvents.h>
 
 #include "ShapeOp_API.h"
 #include "ShapeOp_IogramWrapper.h"
 #include "ShapeOp_Solver.h"
 
+#include "Geomlib_RemoveDuplicates.h"
+#include "IoGraph.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
@@ -105,8 +109,6 @@ namespace {
 		float eps
 	)
 	{
-		float epsSquared = eps * eps;
-
 		if (vertices.Size() <= 1) {
 			URHO3D_LOGWARNING("WeldVertices-- - vertices.Size() <= 1, nothing to process");
 			welded_vertices = vertices;
@@ -114,34 +116,29 @@ namespace {
 			return;
 		}
 
-		std::vector<int> vertexDuplicates_(vertices.Size());
+		// each vertex goes to the earliest vertex closer than eps, which may itself have gone to an
+		// even earlier one; the welded vertices are these targets, in order of index
+		PODVector<unsigned> vertexDuplicates;
+		Geomlib::FindEarliestNeighbours(vertices.Buffer(), vertices.Size(), eps, vertexDuplicates);
 
-		for (int i = 0; i < (int)vertices.Size(); ++i) {
-			vertexDuplicates_[i] = i; // Assume not a duplicate
-			for (int j = 0; j < i; ++j) {
-				if ((vertices[j] - vertices[i]).LengthSquared() < epsSquared) {
-					vertexDuplicates_[i] = j;
-					break;
-				}
-			}
+		PODVector<int> uniqueIndex(vertices.Size());
+		for (unsigned i = 0; i < vertices.Size(); ++i) {
+			uniqueIndex[i] = -1;
 		}
-
-		std::vector<int> vertexUniques_ = vertexDuplicates_;
-		std::sort(vertexUniques_.begin(), vertexUniques_.end());
-		vertexUniques_.erase(std::unique(vertexUniques_.begin(), vertexUniques_.end()), vertexUniques_.end());
-
-		for (int i = 0; i < vertexUniques_.size(); ++i) {
-			int k = vertexUniques_[i];
-			welded_vertices.Push(vertices[k]);
+		for (unsigned i = 0; i < vertices.Size(); ++i) {
+			uniqueIndex[vertexDuplicates[i]] = 0;
 		}
-
-		for (int j = 0; j < (int)vertices.Size(); ++j) {
-			int orig_j = vertexDuplicates_[j];
-			int uniq_j = find(vertexUniques_.begin(), vertexUniques_.end(), orig_j) - vertexUniques_.begin();
-			new_indices.Push(uniq_j);
+		for (unsigned i = 0; i < vertices.Size(); ++i) {
+			if (uniqueIndex[i] == 0) {
+				uniqueIndex[i] = (int)welded_vertices.Size();
+				welded_vertices.Push(vertices[i]);
+			}
 		}
 
-		assert(new_indices.Size() == vertices.Size());
+		new_indices.Resize(vertices.Size());
+		for (unsigned i = 0; i < vertices.Size(); ++i) {
+			new_indices[i] = uniqueIndex[vertexDuplicates[i]];
+		}
 	}
 
 	void UpdateConstraintsAfterWelding(
@@ -234,33 +231,50 @@ namespace {
 		std::vector<MeshTrackingData>& tracked_meshes
 	)
 	{
+		if (unverified_meshes.Empty()) {
+			return;
+		}
+
+		// sort the raw vertices once, so that each mesh vertex finds its first exact match
+		// by binary search instead of a scan over every raw vertex
+		std::vector<int> sorted((size_t)raw_vertices.Size());
+		for (unsigned k = 0; k < raw_vertices.Size(); ++k) {
+			sorted[k] = (int)k;
+		}
+		std::sort(sorted.begin(), sorted.end(),
+			[&](int a, int b) {
+				const Vector3& v = raw_vertices[a];
+				const Vector3& w = raw_vertices[b];
+				if (v.x_ != w.x_) return v.x_ < w.x_;
+				if (v.y_ != w.y_) return v.y_ < w.y_;
+				if (v.z_ != w.z_) return v.z_ < w.z_;
+				return a < b;
+			});
+
 		for (int i = 0; i < unverified_meshes.Size(); ++i) {
 			if (TriMesh_Verify(unverified_meshes[i])) {
 				MeshTrackingData mtd;
 				mtd.mesh = unverified_meshes[i];
-				VariantMap* var_map = unverified_meshes[i].GetVariantMapPtr();
-				VariantVector* vertex_list = (*var_map)["vertices"].GetVariantVectorPtr();
-				for (unsigned j = 0; j < vertex_list->Size(); ++j) {
-					Vector3 v = (*vertex_list)[j].GetVector3();
-					bool found = false;
-					for (unsigned k = 0; k < raw_vertices.Size(); ++k) {
-						Vector3 w = raw_vertices[k];
-						if (
-							v.x_ == w.x_ &&
-							v.y_ == w.y_ &&
-							v.z_ == w.z_
-							)
-						{
-							found = true;
-							mtd.raw_indices.push_back(k);
-							break;
-						}
+				ConstTriMeshDataPtr data = TriMesh_GetData(unverified_meshes[i]);
+				unsigned num_vertices = data->GetNumVertices();
+				for (unsigned j = 0; j < num_vertices; ++j) {
+					Vector3 v = data->GetVertex(j);
+					// first entry not less than (v, -1), i.e., the lowest raw index with coordinates v if there is one
+					std::vector<int>::iterator it = std::lower_bound(sorted.begin(), sorted.end(), -1,
+						[&](int a, int) {
+							const Vector3& w = raw_vertices[a];
+							if (w.x_ != v.x_) return w.x_ < v.x_;
+							if (w.y_ != v.y_) return w.y_ < v.y_;
+							return w.z_ < v.z_;
+						});
+					if (it != sorted.end() && raw_vertices[*it] == v) {
+						mtd.raw_indices.push_back(*it);
 					}
-					if (!found) {
+					else {
 						std::cout << "FAILED to find exact match for tracked mesh vertex in raw_vertices" << std::endl;
 					}
 				}
-				if ((unsigned)mtd.raw_indices.size() == vertex_list->Size()) {
+				if ((unsigned)mtd.raw_indices.size() == num_vertices) {
 					// found a match for every vertex, so we can track this mesh
 					tracked_meshes.push_back(mtd);
 				}
@@ -297,13 +311,14 @@ namespace {
 
 String ShapeOp_Solve::iconTexture = "Textures/Icons/DefaultIcon.png";
 
-ShapeOp_Solve::ShapeOp_Solve(Context* context) : IoComponentBase(context, 10, 2)
+ShapeOp_Solve::ShapeOp_Solve(Context* context) : IoComponentBase(context, 11, 2)
 {
 	SetName("ShapeOpSolve");
 	SetFullName("ShapeOp Solve");
 	SetDescription("...");
 	SetGroup(IoComponentGroup::MESH);
 	SetSubgroup("Operators");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("Constraint List");
 	inputSlots_[0]->SetVariableName("CL");
@@ -365,7 +380,7 @@ ShapeOp_Solve::ShapeOp_Solve(Context* context) : IoComponentBase(context, 10, 2)
 
 	inputSlots_[8]->SetName("ResetPts");
 	inputSlots_[8]->SetVariableName("ResetPts");
-	inputSlots_[8]->SetDescription("Reset points");
+	inputSlots_[8]->SetDescription("Start this solve from the input points instead of the last solved points");
 	inputSlots_[8]->SetVariantType(VariantType::VAR_BOOL);
 	inputSlots_[8]->SetDataAccess(DataAccess::ITEM);
 	inputSlots_[8]->SetDefaultValue(Variant(false));
@@ -373,12 +388,20 @@ ShapeOp_Solve::ShapeOp_Solve(Context* context) : IoComponentBase(context, 10, 2)
 
 	inputSlots_[9]->SetName("Restart");
 	inputSlots_[9]->SetVariableName("Restart");
-	inputSlots_[9]->SetDescription("Restart");
+	inputSlots_[9]->SetDescription("Start every solve from the input points at rest; turn off to keep form-finding from the last solve");
 	inputSlots_[9]->SetVariantType(VariantType::VAR_BOOL);
 	inputSlots_[9]->SetDataAccess(DataAccess::ITEM);
 	inputSlots_[9]->SetDefaultValue(Variant(true));
 	inputSlots_[9]->DefaultSet();
 
+	inputSlots_[10]->SetName("Step");
+	inputSlots_[10]->SetVariableName("Step");
+	inputSlots_[10]->SetDescription("Keep iterating every frame while Restart is off");
+	inputSlots_[10]->SetVariantType(VariantType::VAR_BOOL);
+	inputSlots_[10]->SetDataAccess(DataAccess::ITEM);
+	inputSlots_[10]->SetDefaultValue(Variant(false));
+	inputSlots_[10]->DefaultSet();
+
 	outputSlots_[0]->SetName("Points");
 	outputSlots_[0]->SetVariableName("Pts");
 	outputSlots_[0]->SetDescription("Point list output");
@@ -390,6 +413,83 @@ ShapeOp_Solve::ShapeOp_Solve(Context* context) : IoComponentBase(context, 10, 2)
 	outputSlots_[1]->SetDescription("Mesh list output");
 	outputSlots_[1]->SetVariantType(VariantType::VAR_VARIANTMAP);
 	outputSlots_[1]->SetDataAccess(DataAccess::LIST);
+
+	SubscribeToEvent(E_SCENEUPDATE, URHO3D_HANDLER(ShapeOp_Solve, HandleSceneUpdate));
+}
+
+ShapeOp_Solve::~ShapeOp_Solve()
+{
+	ReleaseSession();
+}
+
+void ShapeOp_Solve::ReleaseSession()
+{
+	if (op) {
+		shapeop_delete(op);
+		op = NULL;
+	}
+	m_nb_points = -1;
+	m_constraint_types.Clear();
+	m_constraint_sizes.Clear();
+	m_constraint_ids.Clear();
+	m_weights.Clear();
+	m_raw_vertices.Clear();
+	m_welded_vertices.Clear();
+	m_input_points.clear();
+	m_new_indices.Clear();
+	m_tracked_meshes.clear();
+	m_tracked_input.Clear();
+	m_gravity_force_id = -1;
+}
+
+bool ShapeOp_Solve::SessionMatches(
+	const VariantVector& constraints,
+	const Vector<Vector3>& welded_vertices,
+	const Vector<int>& new_indices
+) const
+{
+	if (!op || constraints.Size() != m_constraint_types.Size() || new_indices != m_new_indices) {
+		return false;
+	}
+
+	// The session is kept when every constraint has the same type and vertex count, the vertices weld
+	// to the same points, and every point used by a constraint other than Closeness is where it was:
+	// the rest shapes of the constraints and the system matrix are then what a new session would set
+	// up. A Closeness vertex that moves out of the point it was welded to changes the welding, and so
+	// rebuilds the session.
+	int raw_index = 0;
+	for (unsigned i = 0; i < constraints.Size(); ++i) {
+
+		String constraint_type = ShapeOpConstraint_constraintType(constraints[i]);
+		const VariantVector& shapeop_vertices = constraints[i].GetVariantMap()["vertices"]->GetVariantVector();
+		if (constraint_type != m_constraint_types[i] || (int)shapeop_vertices.Size() != m_constraint_sizes[i]) {
+			return false;
+		}
+
+		bool is_target = constraint_type == "Closeness";
+		for (unsigned j = 0; j < shapeop_vertices.Size(); ++j) {
+			int point = new_indices[raw_index];
+			if (!is_target && welded_vertices[point] != m_welded_vertices[point]) {
+				return false;
+			}
+			++raw_index;
+		}
+	}
+
+	return true;
+}
+
+void ShapeOp_Solve::SetInputPoints(const Vector<Vector3>& welded_vertices)
+{
+	m_welded_vertices = welded_vertices;
+	m_input_points.clear();
+	for (int i = 0; i < (int)welded_vertices.Size(); ++i) {
+		Vector3 v = welded_vertices[i];
+		m_input_points.push_back((double)v.x_);
+		m_input_points.push_back((double)v.y_);
+		m_input_points.push_back((double)v.z_);
+	}
+	m_nb_points = (int)(m_input_points.size() / 3);
 }
 
 void ShapeOp_Solve::SolveInstance(
@@ -397,7 +497,9 @@ void ShapeOp_Solve::SolveInstance(
 	Vector<Variant>& outSolveInstance
 )
 {
-	bool reinitialize = inSolveInstance[9].GetBool();
+	bool restart = inSolveInstance[9].GetBool();
+	bool reset_points = restart || inSolveInstance[8].GetBool();
+	m_stepping = false;
 
 	///////////////////////////////////////////////////////////////////////////////
 	// I. EXTRACT AND VERIFY INPUTS
@@ -413,10 +515,8 @@ void ShapeOp_Solve::SolveInstance(
 
 	// get gravity
 	Variant g_var = inSolveInstance[2];
-	bool add_gravity = false;
-	Vector3 g_vec;
+	Vector3 g_vec = Vector3::ZERO;
 	if (g_var.GetType() == VAR_VECTOR3) {
-		add_gravity = true;
 		g_vec = g_var.GetVector3();
 	}
 
@@ -446,11 +546,11 @@ void ShapeOp_Solve::SolveInstance(
 		URHO3D_LOGWARNING("ShapeOp_Solve --- no valid constraints found at ConstraintList");
 		return;
 	}
-	URHO3D_LOGINFO("ShapeOp_Solve --- found valid constraints, beginning vertex processing....");
 
-	// Collect points as raw_vertices, weld nearby ones, update constraint metadata
 	Vector<Vector3> raw_vertices;
 	SetUpRawVertices(constraints, raw_vertices);
+
+	// Collect points as raw_vertices, weld nearby ones; the welding also decides whether the session is kept
 	Vector<Vector3> welded_vertices;
 	Vector<int> new_indices;
 	WeldVertices(raw_vertices, welded_vertices, new_indices, 0.001f);
@@ -460,71 +560,135 @@ void ShapeOp_Solve::SolveInstance(
 		return;
 	}
 
-	m_new_indices = new_indices;
-	UpdateConstraintsAfterWelding(constraints, new_indices);
-
-	VariantVector unverified_meshes = inSolveInstance[7].GetVariantVector();
-	std::vector<MeshTrackingData> tracked_meshes;
-	SetUpMeshTrackingData(unverified_meshes, raw_vertices, tracked_meshes);
-	m_tracked_meshes = tracked_meshes;
+	double gravity_force[3] = { (double)g_vec.x_, (double)g_vec.y_, (double)g_vec.z_ };
 
 	///////////////////////////////////////////////////////////////////////////////
 	// II. ShapeOp API calls
 	///////////////////////////////////////////////////////////////////////////////
 
-	// 1) Create the solver with #shapeop_create
+	if (SessionMatches(constraints, welded_vertices, new_indices)) {
 
-	ShapeOpSolver* op = shapeop_create();
-	//ShapeOpSolver* op = shapeop_create();
+		// Same layout and rest geometry as the solver already holds: update what changed in place.
+		// Targets, forces and damping don't enter the system matrix; weights, mass and timestep
+		// do, so those re-factorize the existing constraints, but nothing is added again.
+		bool reinitialize = mass != m_mass || timestep != m_timestep;
 
-	// 2) Set the vertices with #shapeop_setPoints
+		UpdateConstraintsAfterWelding(constraints, m_new_indices);
 
-	std::vector<double> pts_in;
-	for (int i = 0; i < (int)welded_vertices.Size(); ++i) {
-		Vector3 v = welded_vertices[i];
-		pts_in.push_back((double)v.x_);
-		pts_in.push_back((double)v.y_);
-		pts_in.push_back((double)v.z_);
-	}
+		int raw_index = 0;
+		for (unsigned i = 0; i < constraints.Size(); ++i) {
 
-	int nb_points = (int)(pts_in.size() / 3);
-	m_nb_points = nb_points;
-	shapeop_setPoints(op, pts_in.data(), nb_points);
+			double weight = ShapeOpConstraint_weight(constraints[i]);
+			if (weight != m_weights[i]) {
+				shapeop_setConstraintWeight(op, m_constraint_ids[i], weight);
+				m_weights[i] = weight;
+				reinitialize = true;
+			}
 
-	// 3A) Setup the constraints with #shapeop_addConstraint and #shapeop_editConstraint
+			// a new session would take the target from the welded point, as it is added
+			int point = m_new_indices[raw_index];
+			if (m_constraint_types[i] == "Closeness" && welded_vertices[point] != m_welded_vertices[point]) {
+				Vector3 v = welded_vertices[point];
+				double target[3] = { (double)v.x_, (double)v.y_, (double)v.z_ };
+				shapeop_editConstraint(op, "Closeness", m_constraint_ids[i], target, 3);
+			}
+			raw_index += m_constraint_sizes[i];
 
-	// all ids are captured here so their data won't go out of scope after added to the solver
-	// since they must be added as array ptr/size combos
-	std::vector<std::vector<int> > all_ids;
-	for (unsigned i = 0; i < constraints.Size(); ++i) {
+			if (ShapeOpConstraint_NeedsEdit(constraints[i])) {
+				ShapeOpConstraint_SetConstraintId(constraints[i], m_constraint_ids[i]);
+			}
+		}
+
+		shapeop_editGravityForce(op, m_gravity_force_id, gravity_force);
+		if (damping != m_damping) {
+			shapeop_setDamping(op, damping);
+			m_damping = damping;
+		}
 
-		Variant constraint = constraints[i];
-		std::vector<int> ids;
-		int val = GetConstraintIds(constraint, ids);
-		all_ids.push_back(ids);
+		// moved Closeness vertices move the points a restart begins from
+		SetInputPoints(welded_vertices);
+		if (raw_vertices != m_raw_vertices) {
+			m_raw_vertices = raw_vertices;
+			m_tracked_meshes.clear();
+		}
+
+		if (reset_points) {
+			shapeop_setPoints(op, m_input_points.data(), m_nb_points);
+		}
+		if (reinitialize) {
+			shapeop_initDynamic(op, mass, damping, timestep);
+			m_mass = mass;
+			m_timestep = timestep;
+		}
+		else if (reset_points) {
+			shapeop_resetVelocities(op);
+		}
 	}
+	else {
 
-	assert((unsigned)all_ids.size() == constraints.Size());
+		ReleaseSession();
+		URHO3D_LOGINFO("ShapeOp_Solve --- found valid constraints, beginning vertex processing....");
 
-	int count = 0;
-	for (unsigned i = 0; i < constraints.Size(); ++i) {
+		// update constraint metadata
+		m_new_indices = new_indices;
+		UpdateConstraintsAfterWelding(constraints, new_indices);
 
-		Variant constraint = constraints[i];
-		int nb_ids = (int)all_ids[i].size();
+		// 1) Create the solver with #shapeop_create
 
-		int constraint_id = shapeop_addConstraint(
-			op,
-			ShapeOpConstraint_constraintType(constraint).CString(),
-			all_ids[i].data(),
-			nb_ids,
-			ShapeOpConstraint_weight(constraint)
-		);
-		if (ShapeOpConstraint_NeedsEdit(constraints[i])) {
-			ShapeOpConstraint_SetConstraintId(constraints[i], constraint_id);
+		op = shapeop_create();
+
+		// 2) Set the vertices with #shapeop_setPoints
+
+		SetInputPoints(welded_vertices);
+		shapeop_setPoints(op, m_input_points.data(), m_nb_points);
+
+		// 3A) Setup the constraints with #shapeop_addConstraint
+
+		int count = 0;
+		for (unsigned i = 0; i < constraints.Size(); ++i) {
+
+			Variant constraint = constraints[i];
+			std::vector<int> ids;
+			GetConstraintIds(constraint, ids);
+
+			String constraint_type = ShapeOpConstraint_constraintType(constraint);
+			double weight = ShapeOpConstraint_weight(constraint);
+			int constraint_id = shapeop_addConstraint(
+				op,
+				constraint_type.CString(),
+				ids.data(),
+				(int)ids.size(),
+				weight
+			);
+			if (ShapeOpConstraint_NeedsEdit(constraints[i])) {
+				ShapeOpConstraint_SetConstraintId(constraints[i], constraint_id);
+			}
+
+			m_constraint_types.Push(constraint_type);
+			m_constraint_sizes.Push((int)constraint.GetVariantMap()["vertices"]->GetVariantVector().Size());
+			m_constraint_ids.Push(constraint_id);
+			m_weights.Push(weight);
+			count++;
 		}
-		count++;
+		m_raw_vertices = raw_vertices;
+
+		URHO3D_LOGINFO("ShapeOp_Solve --- " + String(count) + " Constraints added");
+
+		// 3B) Setup the forces with #shapeop_addGravityForce
+		// (always added, so that a later change of gravity is an edit rather than a new session)
+
+		m_gravity_force_id = shapeop_addGravityForce(op, gravity_force);
+
+		// 4) Initialize the solver with #shapeop_initDynamic
+
+		shapeop_initDynamic(op, mass, damping, timestep);
+		m_mass = mass;
+		m_damping = damping;
+		m_timestep = timestep;
 	}
 
+	// 3C) Edit constraint parameters with #shapeop_editConstraint; these never touch the factorization
+
 	std::vector<ConstraintEditData> all_edit_data;
 	for (unsigned i = 0; i < constraints.Size(); ++i) {
 
@@ -537,24 +701,7 @@ void ShapeOp_Solve::SolveInstance(
 		}
 	}
 
-	URHO3D_LOGINFO("ShapeOp_Solve --- " + String(count) + " Constraints added");
-
-	// 3B) Setup the forces with #shapeop_addVertexForce
-
-	// ... not sure if we're still adding forces to individual vertices
-
-	double gravity_force[3] = { (double)g_vec.x_, (double)g_vec.y_, (double)g_vec.z_ };
-	if (add_gravity) {
-		shapeop_addGravityForce(op, gravity_force);
-		URHO3D_LOGINFO("ShapeOp_Solve --- Gravity force added");
-	}
-
-	// 4) Initialize the solver with #shapeop_init or #shapeop_initDynamic
-
-	//shapeop_init(op);
-	shapeop_initDynamic(op, mass, damping, timestep);
-
-	// 5) Optimize with #shapeop_solve
+	// 5) Optimize with #shapeop_solve, starting from wherever the solver's points are
 
 	URHO3D_LOGINFO("ShapeOp_Solve --- solver starting for " + String(iterations) + " iterations....");
 	shapeop_solve(op, iterations);
@@ -562,71 +709,42 @@ void ShapeOp_Solve::SolveInstance(
 
 	// 6) Get back the vertices with #shapeop_getPoints
 
-	std::vector<double> pts_out(3 * nb_points);
-	shapeop_getPoints(op, pts_out.data(), nb_points);
-
-	// 7) Delete the solver with #shapeop_delete
-	shapeop_delete(op);
-
-	//shapeop_delete(op);
-	//op = NULL;
+	std::vector<double> pts_out(3 * m_nb_points);
+	shapeop_getPoints(op, pts_out.data(), m_nb_points);
 
 	///////////////////////////////////////////////////////////////////////////////
 	// III. Prepare and assign outputs
 	///////////////////////////////////////////////////////////////////////////////
 
 	VariantVector points;
-	for (int i = 0; i < 3 * nb_points; i += 3) {
+	for (int i = 0; i < 3 * m_nb_points; i += 3) {
 		Vector3 pt((float)pts_out[i], (float)pts_out[i + 1], (float)pts_out[i + 2]);
 		points.Push(pt);
 	}
 
+	// tracking only depends on the meshes and the raw vertices of the session
+	VariantVector unverified_meshes = inSolveInstance[7].GetVariantVector();
+	if (m_tracked_meshes.empty() || unverified_meshes != m_tracked_input) {
+		m_tracked_meshes.clear();
+		SetUpMeshTrackingData(unverified_meshes, m_raw_vertices, m_tracked_meshes);
+		m_tracked_input = unverified_meshes;
+	}
+
 	VariantVector meshes_out;
-	UpdateTrackedMeshes(tracked_meshes, new_indices, points, meshes_out);
+	UpdateTrackedMeshes(m_tracked_meshes, m_new_indices, points, meshes_out);
 
 	outSolveInstance[0] = points;
 	outSolveInstance[1] = meshes_out;
-	//}
-	//else if (op != NULL) {
 
-	//	//make double sure that some constraints have been created
-	//	if (m_nb_points == -1)
-	//	{
-	//		SetAllOutputsNull(outSolveInstance);
-	//		return;
-	//	}
-
-	//	assert(op);
-	//	assert(m_nb_points != -1);
-
-	//	URHO3D_LOGINFO("ShapeOp_Solve --- continuing solver for " + String(m_iterations) + " iterations....");
-	//	shapeop_solve(op, m_iterations);
-	//	URHO3D_LOGINFO("ShapeOp_Sovle --- solver finished");
-
-	//	// 6) Get back the vertices with #shapeop_getPoints
-
-	//	std::vector<double> pts_out(3 * m_nb_points);
-	//	shapeop_getPoints(op, pts_out.data(), m_nb_points);
-
-	//	// 7) Delete the solver with #shapeop_delete
-
-	//	//shapeop_delete(op);
-	//	//op = NULL;
-
-	//	///////////////////////////////////////////////////////////////////////////////
-	//	// III. Prepare and assign outputs
-	//	///////////////////////////////////////////////////////////////////////////////
-
-	//	VariantVector points;
-	//	for (int i = 0; i < 3 * m_nb_points; i += 3) {
-	//		Vector3 pt((float)pts_out[i], (float)pts_out[i + 1], (float)pts_out[i + 2]);
-	//		points.Push(pt);
-	//	}
-
-	//	VariantVector meshes_out;
-	//	UpdateTrackedMeshes(m_tracked_meshes, m_new_indices, points, meshes_out);
+	m_stepping = !restart && inSolveInstance[10].GetBool();
+}
 
-	//	outSolveInstance[0] = points;
-	//	outSolveInstance[1] = meshes_out;
-	//}
-}
\ No newline at end of file
+void ShapeOp_Solve::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+{
+	// each re-solve continues from the last solved points (Restart is off), so the
+	// form-finding advances by Iterations steps per frame
+	if (m_stepping && op) {
+		solvedFlag_ = 0;
+		GetSubsystem<IoGraph>()->QuickTopoSolveGraph();
+	}
+}
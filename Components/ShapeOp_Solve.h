@@ -40,6 +40,7 @@ class URHO3D_API ShapeOp_Solve : public IoComponentBase {
 	URHO3D_OBJECT(ShapeOp_Solve, IoComponentBase)
 public:
 	ShapeOp_Solve(Urho3D::Context* context);
+	~ShapeOp_Solve();
 
 	void SolveInstance(
 		const Urho3D::Vector<Urho3D::Variant>& inSolveInstance,
@@ -53,11 +54,37 @@ public:
 
 	static Urho3D::String iconTexture;
 
-	// state parameters
+	// Solver session, kept between solves while the constraint layout and rest geometry stay the same
+	// (see SessionMatches), so that changes of weights, targets or forces don't weld and add everything
+	// again, and the solve can continue from the last solved points.
+	// There is one session per component; several solve instances will each rebuild it in turn.
 	ShapeOpSolver* op = NULL;
 	int m_iterations = 10;
 	int m_nb_points = -1;
 	std::vector<MeshTrackingData> m_tracked_meshes;
+	Urho3D::VariantVector m_tracked_input;
 	Urho3D::Vector<int> m_new_indices;
+	Urho3D::Vector<Urho3D::String> m_constraint_types;
+	Urho3D::Vector<int> m_constraint_sizes;
+	Urho3D::Vector<int> m_constraint_ids;
+	Urho3D::Vector<double> m_weights;
+	Urho3D::Vector<Urho3D::Vector3> m_raw_vertices;
+	Urho3D::Vector<Urho3D::Vector3> m_welded_vertices;
+	std::vector<double> m_input_points;
+	int m_gravity_force_id = -1;
+	double m_mass = 1.0;
+	double m_damping = 1.0;
+	double m_timestep = 1.0;
+	bool m_stepping = false;
+
+private:
+	void ReleaseSession();
+	bool SessionMatches(
+		const Urho3D::VariantVector& constraints,
+		const Urho3D::Vector<Urho3D::Vector3>& welded_vertices,
+		const Urho3D::Vector<int>& new_indices
+	) const;
+	void SetInputPoints(const Urho3D::Vector<Urho3D::Vector3>& welded_vertices);
+	void HandleSceneUpdate(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
 
 };
\ No newline at end of file
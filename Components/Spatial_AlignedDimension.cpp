@@ -40,6 +40,7 @@ Spatial_AlignedDimension::Spatial_AlignedDimension(Context* context) : IoCompone
 	SetName("AddComponent");
 	SetFullName("Add Component");
 	SetDescription("Adds a native component to a scene node.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -46,6 +46,7 @@ Spatial_CrowdAgent::Spatial_CrowdAgent(Context* context) : IoComponentBase(conte
 	SetName("CrowdManager");
 	SetFullName("Crowd Manager");
 	SetDescription("Adds a crowd manager to scene root.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -41,6 +41,7 @@ Spatial_CrowdManager::Spatial_CrowdManager(Context* context) : IoComponentBase(c
 	SetName("CrowdManager");
 	SetFullName("Crowd Manager");
 	SetDescription("Adds a crowd manager to scene root.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
@@ -41,6 +41,7 @@ Spatial_NavigationMesh::Spatial_NavigationMesh(Context* context) : IoComponentBa
 	SetName("AddComponent");
 	SetFullName("Add Component");
 	SetDescription("Adds a native component to a scene node.");
+	SetMainThreadOnly(true);
 
 	//set up the slots
 	AddInputSlot(
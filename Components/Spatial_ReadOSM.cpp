@@ -42,6 +42,7 @@ Spatial_ReadOSM::Spatial_ReadOSM(Context* context) : IoComponentBase(context, 3,
 	SetName("ReadOSM");
 	SetFullName("Read OSM File");
 	SetDescription("Reads an OSM file");
+	SetMainThreadOnly(true);
 	//SetGroup(IoComponentGroup::VECTOR);
 	//SetSubgroup("Point");
 
@@ -43,6 +43,7 @@ Spatial_Sun::Spatial_Sun(Urho3D::Context* context) : IoComponentBase(context, 0,
 	SetName("Sun");
 	SetFullName("Sun");
 	SetDescription("Create a directional Sun light");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"Latitude",
@@ -43,6 +43,7 @@ Spatial_Terrain::Spatial_Terrain(Urho3D::Context* context) : IoComponentBase(con
 	SetName("Terrain");
 	SetFullName("Terrain Object");
 	SetDescription("Terrain Object");
+	SetMainThreadOnly(true);
 
 	AddInputSlot(
 		"ImageFile",
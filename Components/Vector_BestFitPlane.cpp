@@ -44,6 +44,7 @@ Vector_BestFitPlane::Vector_BestFitPlane(Context* context) : IoComponentBase(con
 	SetDescription("Compute the least-squares plane of best fit");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Operators");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Geometry");
 	inputSlots_[0]->SetVariableName("G");
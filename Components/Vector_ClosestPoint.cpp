@@ -39,6 +39,7 @@ Vector_ClosestPoint::Vector_ClosestPoint(Context* context) : IoComponentBase(con
 	SetDescription("Which point in list is closest");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Point");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Point");
 	inputSlots_[0]->SetVariableName("P");
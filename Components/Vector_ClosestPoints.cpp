@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Vector_ClosestPoints.h"
+
+#include <assert.h>
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include "Geomlib_ClosestPoint.h"
+
+using namespace Urho3D;
+
+String Vector_ClosestPoints::iconTexture = "Textures/Icons/Vector_ClosestPoint.png";
+
+namespace {
+
+bool ExtractVector3List(const Variant& var, PODVector<Vector3>& points)
+{
+	if (var.GetType() != VariantType::VAR_VARIANTVECTOR) {
+		return false;
+	}
+
+	const VariantVector& list = var.GetVariantVector();
+	points.Resize(list.Size());
+	for (unsigned i = 0; i < list.Size(); ++i) {
+		if (list[i].GetType() != VariantType::VAR_VECTOR3) {
+			return false;
+		}
+		points[i] = list[i].GetVector3();
+	}
+
+	return true;
+}
+
+}
+
+Vector_ClosestPoints::Vector_ClosestPoints(Context* context) : IoComponentBase(context, 2, 3)
+{
+	SetName("ClosePoints");
+	SetFullName("Closest Points");
+	SetDescription("Which point in list is closest, for each of a list of query points");
+	SetGroup(IoComponentGroup::VECTOR);
+	SetSubgroup("Point");
+	SetPure(true);
+
+	inputSlots_[0]->SetName("Points");
+	inputSlots_[0]->SetVariableName("P");
+	inputSlots_[0]->SetDescription("Query points");
+	inputSlots_[0]->SetVariantType(VariantType::VAR_VECTOR3);
+	inputSlots_[0]->SetDataAccess(DataAccess::LIST);
+	inputSlots_[0]->SetDefaultValue(Vector3(0.0f, 0.0f, 0.0f));
+	inputSlots_[0]->DefaultSet();
+
+	inputSlots_[1]->SetName("Point List");
+	inputSlots_[1]->SetVariableName("L");
+	inputSlots_[1]->SetDescription("List of points");
+	inputSlots_[1]->SetVariantType(VariantType::VAR_VECTOR3);
+	inputSlots_[1]->SetDataAccess(DataAccess::LIST);
+	inputSlots_[1]->SetDefaultValue(Vector3(0.0f, 0.0f, 0.0f));
+	inputSlots_[1]->DefaultSet();
+
+	outputSlots_[0]->SetName("Closest Points");
+	outputSlots_[0]->SetVariableName("C");
+	outputSlots_[0]->SetDescription("Closest point in list to each of P");
+	outputSlots_[0]->SetVariantType(VariantType::VAR_VECTOR3);
+	outputSlots_[0]->SetDataAccess(DataAccess::LIST);
+
+	outputSlots_[1]->SetName("Indices");
+	outputSlots_[1]->SetVariableName("I");
+	outputSlots_[1]->SetDescription("Index into L of closest point to each of P");
+	outputSlots_[1]->SetVariantType(VariantType::VAR_INT);
+	outputSlots_[1]->SetDataAccess(DataAccess::LIST);
+
+	outputSlots_[2]->SetName("Distances");
+	outputSlots_[2]->SetVariableName("D");
+	outputSlots_[2]->SetDescription("Distance to closest point for each of P");
+	outputSlots_[2]->SetVariantType(VariantType::VAR_FLOAT);
+	outputSlots_[2]->SetDataAccess(DataAccess::LIST);
+}
+
+void Vector_ClosestPoints::SolveInstance(
+	const Vector<Variant>& inSolveInstance,
+	Vector<Variant>& outSolveInstance
+)
+{
+	assert(inSolveInstance.Size() == inputSlots_.Size());
+
+	///////////////////
+	// EXTRACT & VERIFY
+
+	PODVector<Vector3> queries;
+	if (!ExtractVector3List(inSolveInstance[0], queries)) {
+		URHO3D_LOGWARNING("P must be a list of Vector3's only");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	PODVector<Vector3> cloud;
+	if (!ExtractVector3List(inSolveInstance[1], cloud)) {
+		URHO3D_LOGWARNING("L must be a list of Vector3's only");
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	////////////////////
+	// COMPONENT'S WORK
+
+	PODVector<int> indices;
+	PODVector<float> distances;
+	bool success = Geomlib::PointCloudClosestPoints(
+		cloud.Empty() ? 0 : &cloud[0], cloud.Size(),
+		queries.Empty() ? 0 : &queries[0], queries.Size(),
+		indices, distances, GetSubsystem<WorkQueue>()
+	);
+	if (!success) {
+		// null point list
+		SetAllOutputsNull(outSolveInstance);
+		return;
+	}
+
+	/////////////////
+	// ASSIGN OUTPUTS
+
+	VariantVector closestList(indices.Size());
+	VariantVector indexList(indices.Size());
+	VariantVector distanceList(distances.Size());
+	for (unsigned i = 0; i < indices.Size(); ++i) {
+		closestList[i] = cloud[indices[i]];
+		indexList[i] = indices[i];
+		distanceList[i] = distances[i];
+	}
+
+	outSolveInstance[0] = closestList;
+	outSolveInstance[1] = indexList;
+	outSolveInstance[2] = distanceList;
+}
\ No newline at end of file
@@ -39,6 +39,7 @@ Vector_ColorPalette::Vector_ColorPalette(Context* context) : IoComponentBase(con
 	SetDescription("Which point in list is closest");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Point");
+	SetMainThreadOnly(true);
 
 	inputSlots_[0]->SetName("StartColor");
 	inputSlots_[0]->SetVariableName("C");
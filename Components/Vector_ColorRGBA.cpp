@@ -35,6 +35,7 @@ Vector_ColorRGBA::Vector_ColorRGBA(Urho3D::Context* context) : IoComponentBase(c
 	SetDescription("Construct a color from RGBA values");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Vector");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("R");
 	inputSlots_[0]->SetVariableName("R");
@@ -40,6 +40,7 @@ Vector_ConstructVector::Vector_ConstructVector(Urho3D::Context* context) : IoCom
 	SetDescription("Construct a vector from xyz-coordinates");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Vector");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("X");
 	inputSlots_[0]->SetVariableName("X");
@@ -39,6 +39,7 @@ Vector_DeconstructVector::Vector_DeconstructVector(Context* context) :
 	SetDescription("Deconstruct a vector into its components");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Vector");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Vector");
 	inputSlots_[0]->SetVariableName("V");
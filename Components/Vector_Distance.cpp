@@ -39,6 +39,7 @@ Vector_Distance::Vector_Distance(Context* context) :
 	SetDescription("Compute distance between vectors");
 	SetGroup(IoComponentGroup::VECTOR);
 	SetSubgroup("Vector");
+	SetPure(true);
 
 	inputSlots_[0]->SetName("Vector");
 	inputSlots_[0]->SetVariableName("V");
@@ -46,6 +46,7 @@ Vector_Grid3D::Vector_Grid3D(Context* context) : IoComponentBase(context, 0, 0)
 	SetName("Grid3D");
 	SetFullName("Grid3D");
 	SetDescription("Create a mesh from a grid of values");
+	SetPure(true);
 
 	AddInputSlot(
 		"Lower",
@@ -26,12 +26,16 @@
 #include <iostream>
 #include <vector>
 
+#include <Urho3D/Core/Thread.h>
 #include <Urho3D/Core/Variant.h>
+#include <Urho3D/Core/WorkQueue.h>
 
 #include "IndexUtilities.h"
 #include "IoDataTree.h"
+#include "IoGraph.h"
 #include "IoInputSlot.h"
 #include "IoOutputSlot.h"
+#include "IoParallelFor.h"
 #include "NetworkUtilities.h"
 
 #include <Urho3D/UI/Button.h>
@@ -141,13 +145,14 @@ Urho3D::VariantType IoComponentBase::GetOutputSlotVariantType(int index) const
 	return outputSlots_[index]->GetVariantType();
 }
 
-void IoComponentBase::InputHardSet(int inputIndex, IoDataTree ioDataTree)
+void IoComponentBase::InputHardSet(int inputIndex, const IoDataTree& ioDataTree)
 {
 	assert(IndexInRange(inputIndex, GetNumInputs()));
 
 	inputSlots_[inputIndex]->HardSet(ioDataTree);
 
 	solvedFlag_ = 0;
+	dirtyFlag_ = 1;
 }
 
 ///////////////
@@ -306,8 +311,60 @@ void IoComponentBase::SolveInstance(
 	}
 }
 
+namespace
+{
+	struct SolveInstancesJob
+	{
+		IoComponentBase* component;
+		const Vector<Vector<Variant> >* in;
+		Vector<Vector<Variant> >* out;
+	};
+
+	void SolveInstancesRange(void* data, unsigned begin, unsigned end)
+	{
+		const SolveInstancesJob* job = static_cast<const SolveInstancesJob*>(data);
+		for (unsigned i = begin; i < end; ++i) {
+			job->component->SolveInstance((*job->in)[i], (*job->out)[i]);
+		}
+	}
+}
+
+void IoComponentBase::SolveInstances(
+	const Vector<Vector<Variant> >& inSolveInstances,
+	Vector<Vector<Variant> >& outSolveInstances
+)
+{
+	unsigned numInstances = inSolveInstances.Size();
+	outSolveInstances.Resize(numInstances);
+	for (unsigned i = 0; i < numInstances; ++i) {
+		outSolveInstances[i].Resize(outputSlots_.Size());
+	}
+
+	SolveInstancesJob job;
+	job.component = this;
+	job.in = &inSolveInstances;
+	job.out = &outSolveInstances;
+
+	// only pure components may have their instances spread over the worker threads; IoParallelFor
+	// falls back to one range when this component is itself being solved on a worker
+	// (see IoGraph::SetParallelSolve) or the main thread is already inside WorkQueue::Complete
+	if (!IsPure()) {
+		SolveInstancesRange(&job, 0, numInstances);
+		return;
+	}
+
+	// the main thread runs some of the ranges itself, alongside the workers
+	IoGraph::BeginParallelSolve();
+	IoParallelFor(GetSubsystem<WorkQueue>(), numInstances, SolveInstancesRange, &job, 2);
+	IoGraph::EndParallelSolve();
+	if (Thread::IsMainThread() && !IoGraph::IsSolvingInParallel()) {
+		SendDeferredEvents();
+	}
+}
+
 int IoComponentBase::LocalSolve()
 {
+	numSolveInstances_ = 0;
 
 	PreLocalSolve();
 
@@ -321,13 +378,16 @@ int IoComponentBase::LocalSolve()
 		}
 	}
 
+	int ret;
 	if (tree_access_required) {
 		URHO3D_LOGWARNING("IoComponentBase::LocalSolve --- TREE access is alpha!");
-		int ret = NewLocalSolve();
-		return ret;
+		ret = NewLocalSolve();
+	}
+	else {
+		ret = OldLocalSolve();
 	}
 
-	int ret = OldLocalSolve();
+	PostLocalSolve();
 	return ret;
 }
 
@@ -353,10 +413,8 @@ int IoComponentBase::NewLocalSolve()
 
 		if (inputSlots_[i]->GetDataAccess() == DataAccess::TREE) {
 
-			SharedPtr<IoDataTree> treePtr_ = SharedPtr<IoDataTree>(new IoDataTree(inputSlots_[i]->GetIoDataTree()));
-			VariantMap vm = treePtr_->ToVariantMap();
-			Variant var(vm);
-			Vector<StringHash> keys = vm.Keys();
+			// TREE access components receive the whole tree as a single VariantMap item
+			Variant var(inputSlots_[i]->GetIoDataTreePtr()->ToVariantMap());
 
 			SharedPtr<IoDataTree> treePtr(new IoDataTree(GetContext(), var));
 			inputIoDataTrees.Push(treePtr);
@@ -392,6 +450,12 @@ int IoComponentBase::NewLocalSolve()
 		currentPaths.Push(inputIoDataTrees[i]->Begin());
 	}
 
+	// for pure and batch-solve components, the instances are gathered first and solved together (see SolveInstances)
+	const bool batched = IsPure() || IsBatchSolve();
+	Vector<Vector<Variant> > batchedInstances;
+	Vector<Vector<int> > batchedPaths;
+	Vector<unsigned> batchedPathIndices;
+
 	// loop one time for every branch in the highest branch count IoDataTree
 	for (unsigned i = 0; i < maxNumBranches; ++i) {
 
@@ -424,6 +488,9 @@ int IoComponentBase::NewLocalSolve()
 		}
 
 		Vector<int> outputPath = inputIoDataTrees[maxBranchIndex]->GetCurrentBranch();
+		if (batched) {
+			batchedPaths.Push(outputPath);
+		}
 
 		// loop one time for every "Arg" available from the highest arg count
 		for (unsigned j = 0; j < maxNumArgs; ++j) {
@@ -440,8 +507,16 @@ int IoComponentBase::NewLocalSolve()
 				}
 				inSolveInstance.Push(arg);
 			}
+
+			if (batched) {
+				batchedInstances.Push(inSolveInstance);
+				batchedPathIndices.Push(batchedPaths.Size() - 1);
+				continue;
+			}
+
 			Vector<Variant> outSolveInstance(outputSlots_.Size());
 			SolveInstance(inSolveInstance, outSolveInstance);
+			++numSolveInstances_;
 
 			for (unsigned k = 0; k < outputSlots_.Size(); ++k) {
 				outputIoDataTrees[k]->Add(outputPath, outSolveInstance[k]);
@@ -462,6 +537,19 @@ int IoComponentBase::NewLocalSolve()
 		}
 	}
 
+	if (!batchedInstances.Empty()) {
+		Vector<Vector<Variant> > batchedOutputs;
+		SolveInstances(batchedInstances, batchedOutputs);
+		numSolveInstances_ += batchedInstances.Size();
+
+		// added in the order the instances were gathered, so the output trees are the same as for a sequential solve
+		for (unsigned i = 0; i < batchedOutputs.Size(); ++i) {
+			for (unsigned k = 0; k < outputSlots_.Size(); ++k) {
+				outputIoDataTrees[k]->Add(batchedPaths[batchedPathIndices[i]], batchedOutputs[i][k]);
+			}
+		}
+	}
+
 	for (unsigned i = 0; i < outputSlots_.Size(); ++i) {
 		if (outputSlots_[i]->GetDataAccess() == DataAccess::LIST) {
 			//std::cout << "... outputIoDataTree[" << i << "]->OneToManyGraft()";
@@ -535,6 +623,12 @@ int IoComponentBase::OldLocalSolve()
 		currentPaths.Push(inputIoDataTrees[i]->Begin());
 	}
 
+	// for pure and batch-solve components, the instances are gathered first and solved together (see SolveInstances)
+	const bool batched = IsPure() || IsBatchSolve();
+	Vector<Vector<Variant> > batchedInstances;
+	Vector<Vector<int> > batchedPaths;
+	Vector<unsigned> batchedPathIndices;
+
 	// loop one time for every branch in the highest branch count IoDataTree
 	for (unsigned i = 0; i < maxNumBranches; ++i) {
 
@@ -552,6 +646,9 @@ int IoComponentBase::OldLocalSolve()
 		}
 
 		Vector<int> outputPath = inputIoDataTrees[maxBranchIndex]->GetCurrentBranch();
+		if (batched) {
+			batchedPaths.Push(outputPath);
+		}
 
 		// loop one time for every "Arg" available from the highest arg count
 		for (unsigned j = 0; j < maxNumArgs; ++j) {
@@ -562,8 +659,16 @@ int IoComponentBase::OldLocalSolve()
 				inputIoDataTrees[k]->GetNextItem(arg, inputSlots_[k]->GetDataAccess());
 				inSolveInstance.Push(arg);
 			}
+
+			if (batched) {
+				batchedInstances.Push(inSolveInstance);
+				batchedPathIndices.Push(batchedPaths.Size() - 1);
+				continue;
+			}
+
 			Vector<Variant> outSolveInstance(outputSlots_.Size());
 			SolveInstance(inSolveInstance, outSolveInstance);
+			++numSolveInstances_;
 
 			for (unsigned k = 0; k < outputSlots_.Size(); ++k) {
 				outputIoDataTrees[k]->Add(outputPath, outSolveInstance[k]);
@@ -584,6 +689,19 @@ int IoComponentBase::OldLocalSolve()
 		}
 	}
 
+	if (!batchedInstances.Empty()) {
+		Vector<Vector<Variant> > batchedOutputs;
+		SolveInstances(batchedInstances, batchedOutputs);
+		numSolveInstances_ += batchedInstances.Size();
+
+		// added in the order the instances were gathered, so the output trees are the same as for a sequential solve
+		for (unsigned i = 0; i < batchedOutputs.Size(); ++i) {
+			for (unsigned k = 0; k < outputSlots_.Size(); ++k) {
+				outputIoDataTrees[k]->Add(batchedPaths[batchedPathIndices[i]], batchedOutputs[i][k]);
+			}
+		}
+	}
+
 	for (unsigned i = 0; i < outputSlots_.Size(); ++i) {
 		if (outputSlots_[i]->GetDataAccess() == DataAccess::LIST) {
 			//std::cout << "... outputIoDataTree[" << i << "]->OneToManyGraft()";
@@ -612,7 +730,7 @@ void IoComponentBase::ClearOutputs()
 
 	VariantMap data;
 	data["component"] = this;
-	SendEvent("OutputsCleared", data);
+	SendSolveEvent("OutputsCleared", data);
 
 	solvedFlag_ = 0;
 }
@@ -840,7 +958,14 @@ Pair<SharedPtr<IoComponentBase>, int> IoComponentBase::GetOutgoingLink(int outpu
 }
 
 
-IoDataTree IoComponentBase::GetOutputIoDataTree(unsigned index)
+const IoDataTree& IoComponentBase::GetInputIoDataTree(unsigned index) const
+{
+	assert(IndexInRange(index, GetNumInputs()));
+
+	return inputSlots_[index]->GetIoDataTree();
+}
+
+const IoDataTree& IoComponentBase::GetOutputIoDataTree(unsigned index) const
 {
 	assert(IndexInRange(index, GetNumOutputs()));
 
@@ -960,7 +1085,33 @@ void IoComponentBase::SetAllOutputsNull(Urho3D::Vector<Urho3D::Variant>& outSolv
 		outSolveInstance[i] = Variant();
 	}
 
-	SendEvent("GraphNodeError");
+	VariantMap data;
+	SendSolveEvent("GraphNodeError", data);
+}
+
+void IoComponentBase::SendSolveEvent(StringHash eventType, VariantMap& eventData)
+{
+	// handlers run on the main thread, and only once no other component is being solved
+	if (Thread::IsMainThread() && !IoGraph::IsSolvingInParallel()) {
+		SendEvent(eventType, eventData);
+	}
+	else {
+		MutexLock lock(deferredEventsMutex_);
+		deferredEvents_.Push(MakePair(eventType, eventData));
+	}
+}
+
+void IoComponentBase::SendDeferredEvents()
+{
+	// swap out first, in case a handler solves the graph again
+	Vector<Pair<StringHash, VariantMap> > events;
+	{
+		MutexLock lock(deferredEventsMutex_);
+		events.Swap(deferredEvents_);
+	}
+	for (unsigned i = 0; i < events.Size(); ++i) {
+		SendEvent(events[i].first_, events[i].second_);
+	}
 }
 
 bool IoComponentBase::SetGenericData(String key, Variant data)
@@ -27,6 +27,7 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/Mutex.h>
 
 #include <Urho3D/UI/UIElement.h>
 #include <Urho3D/Scene/Scene.h>
@@ -67,15 +68,20 @@ public:
 	virtual int LocalSolve();
 	virtual void ClearOutputs();
 	virtual void PreLocalSolve() {};
+	// called once all instances of a LocalSolve have been solved (or the solve was abandoned)
+	virtual void PostLocalSolve() {};
 	virtual void SolveInstance(
 		const Urho3D::Vector<Urho3D::Variant>& inSolveInstance,
 		Urho3D::Vector<Urho3D::Variant>& outSolveInstance
 	);
 	bool IsSolved() const { return solvedFlag_ == 1; }
+	// number of instances solved by the last LocalSolve
+	unsigned GetNumSolveInstances() const { return numSolveInstances_; }
 
-	void InputHardSet(int inputIndex, IoDataTree ioDataTree);
+	void InputHardSet(int inputIndex, const IoDataTree& ioDataTree);
 
-	IoDataTree GetOutputIoDataTree(unsigned index);
+	const IoDataTree& GetInputIoDataTree(unsigned index) const;
+	const IoDataTree& GetOutputIoDataTree(unsigned index) const;
 
 	///slot manipulation
 	void AddInputSlot();
@@ -162,10 +168,30 @@ public:
 	bool IsPreviewEnabled() const { return previewEnabled_ == 1; }
 
 	// Flags for topological ordering-based solve methods
-	void EnableSolve() { solveEnabled_ = 1; solvedFlag_ = 0; }
+	void EnableSolve() { solveEnabled_ = 1; solvedFlag_ = 0; dirtyFlag_ = 1; }
 	void DisableSolve() { solveEnabled_ = 0; solvedFlag_ = 0; }
 	bool IsSolveEnabled() const { return solveEnabled_ == 1; }
 
+	// Flags for incremental solving (see IoGraph::IncrementalSolveGraph)
+	void MarkDirty() { dirtyFlag_ = 1; }
+	void ClearDirty() { dirtyFlag_ = 0; }
+	bool IsDirty() const { return dirtyFlag_ == 1; }
+
+	// Flags for parallel solving (see IoGraph::SetParallelSolve)
+	void SetMainThreadOnly(bool mainThreadOnly) { mainThreadOnly_ = mainThreadOnly ? 1 : 0; }
+	bool IsMainThreadOnly() const { return mainThreadOnly_ == 1; }
+	// sends the events raised while this component was solved on a worker thread or during a parallel solve
+	void SendDeferredEvents();
+
+	// Flags for data-parallel solving: the SolveInstance of a pure component depends only on its arguments
+	// and touches no member or global state, so LocalSolve may run many instances at once
+	void SetPure(bool pure) { pure_ = pure ? 1 : 0; }
+	bool IsPure() const { return pure_ == 1; }
+	// Flags for batch solving: LocalSolve gathers all instances and hands them to SolveInstances in one call,
+	// without making any promise about SolveInstance (e.g. components that keep caches between instances)
+	void SetBatchSolve(bool batchSolve) { batchSolve_ = batchSolve ? 1 : 0; }
+	bool IsBatchSolve() const { return batchSolve_ == 1; }
+
 	//base functions for handling custom ui
 	virtual Urho3D::String GetNodeStyle();
 	virtual void HandleCustomInterface(Urho3D::UIElement* customElement);
@@ -198,6 +224,17 @@ protected: // protected so derived objects can access
 	bool IsInputValid(unsigned inputIndex, const Urho3D::Variant& inputValue) const;
 	bool IsAllInputValid(const Urho3D::Vector<Urho3D::Variant>& inSolveInstance) const;
 	void SetAllOutputsNull(Urho3D::Vector<Urho3D::Variant>& outSolveInstance);
+	// SendEvent for use during LocalSolve: events can only be sent from the main thread,
+	// so on a worker thread, or while other components are being solved, the event is queued until SendDeferredEvents
+	void SendSolveEvent(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
+	// Calls SolveInstance for every entry of inSolveInstances. For pure components the calls are
+	// spread over the WorkQueue threads; outSolveInstances is filled in the same order either way.
+	// Components that can solve all their instances at once more cheaply may override this; unless
+	// they are pure, they must also SetBatchSolve(true) so that LocalSolve calls it with every instance.
+	virtual void SolveInstances(
+		const Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& inSolveInstances,
+		Urho3D::Vector<Urho3D::Vector<Urho3D::Variant> >& outSolveInstances
+	);
 
 	int solvedFlag_;
 	/*
@@ -226,6 +263,26 @@ protected: // protected so derived objects can access
 	// 1: Flags this component as OK to solve.
 	int solveEnabled_ = 1;
 
+	// 1: Flags that the inputs of this component have changed since IoGraph last solved it.
+	// 0: Flags that re-solving this component would reproduce its current outputs.
+	int dirtyFlag_ = 1;
+
+	// 1: Flags this component as touching the scene, UI or other engine state, so it is always solved on the main thread.
+	// 0: Flags this component as OK to solve on a WorkQueue thread.
+	int mainThreadOnly_ = 0;
+	Urho3D::Vector<Urho3D::Pair<Urho3D::StringHash, Urho3D::VariantMap> > deferredEvents_;
+	Urho3D::Mutex deferredEventsMutex_;
+
+	// 1: Flags SolveInstance as safe to call concurrently for different instances (see SetPure).
+	// 0: Flags SolveInstance as to be called for one instance at a time.
+	int pure_ = 0;
+
+	// 1: Flags that LocalSolve should pass all instances to SolveInstances at once (see SetBatchSolve).
+	// 0: Flags that instances are solved as they are gathered, unless the component is pure.
+	int batchSolve_ = 0;
+
+	unsigned numSolveInstances_ = 0;
+
 	/* later metadata */
 	Urho3D::String name_ = "";
 	Urho3D::String fullName_ = "";
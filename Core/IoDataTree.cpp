@@ -31,8 +31,40 @@
 
 using namespace Urho3D;
 
+namespace {
+
+// lexicographic order on paths, a path sorts before all of its descendants
+int ComparePathValues(const int* lhs, unsigned lhsSize, const int* rhs, unsigned rhsSize)
+{
+	unsigned n = Min(lhsSize, rhsSize);
+	for (unsigned i = 0; i < n; ++i) {
+		if (lhs[i] != rhs[i])
+			return lhs[i] < rhs[i] ? -1 : 1;
+	}
+
+	if (lhsSize == rhsSize)
+		return 0;
+
+	return lhsSize < rhsSize ? -1 : 1;
+}
+
+// all empty trees share one storage, so constructing them does not allocate
+const std::shared_ptr<IoBranchStorage>& GetEmptyStorage()
+{
+	static const std::shared_ptr<IoBranchStorage> emptyStorage = std::make_shared<IoBranchStorage>();
+	return emptyStorage;
+}
+
+}
+
+IoDataTree::IoDataTree(Context* context) :
+	Object(context),
+	storage_(GetEmptyStorage())
+{
+}
+
 IoDataTree::IoDataTree(Context* context, Urho3D::Variant item) :
-	Object(context)
+	IoDataTree(context)
 {
 	Vector<int> path;
 	path.Push(0);
@@ -40,7 +72,7 @@ IoDataTree::IoDataTree(Context* context, Urho3D::Variant item) :
 }
 
 IoDataTree::IoDataTree(Context* context, Urho3D::Vector<Urho3D::Variant> items) :
-	Object(context)
+	IoDataTree(context)
 {
 	Vector<int> path;
 	path.Push(0);
@@ -49,51 +81,249 @@ IoDataTree::IoDataTree(Context* context, Urho3D::Vector<Urho3D::Variant> items)
 
 IoDataTree::~IoDataTree()
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		delete it->second_;
-	}
 }
 
-IoDataTree::IoDataTree(const IoDataTree& original) : IoDataTree(original.GetContext())
+// copying only shares the storage; it is duplicated by the first modification of either tree
+IoDataTree::IoDataTree(const IoDataTree& original) :
+	Object(original.GetContext()),
+	storage_(original.storage_)
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-	for (it = original.branches_.Begin(); it != original.branches_.End(); ++it) {
-		String pathString = it->first_;
-		Vector<int> path = PathFromUniqueString(pathString);
-
-		Vector<Variant> data = it->second_->data;
-
-		branches_[pathString] = new IoBranch(path);
-		branches_[pathString]->data = data;
-	}
 }
 
 IoDataTree& IoDataTree::operator=(const IoDataTree& rhs)
 {
 	if (this != &rhs) {
-		HashMap<String, IoBranch*>::ConstIterator it;
-		for (it = branches_.Begin(); it != branches_.End(); ++it) {
-			delete it->second_;
-		}
-
-		branches_.Clear();
+		storage_ = rhs.storage_;
+		branchIterator_ = 0;
 		lastItemIndex_ = 0; // ?
 		branchOverflow_ = false;
 		itemOverflow_ = false;
+	}
+	return *this;
+}
+
+IoBranchStorage& IoDataTree::GetWritableStorage()
+{
+	if (storage_.use_count() > 1) {
+		storage_ = std::make_shared<IoBranchStorage>(*storage_);
+	}
 
-		HashMap<String, IoBranch*>::ConstIterator rhsIt;
-		for (rhsIt = rhs.branches_.Begin(); rhsIt != rhs.branches_.End(); ++rhsIt) {
-			String pathString = rhsIt->first_;
-			Vector<int> path = PathFromUniqueString(pathString);
+	return *storage_;
+}
 
-			Vector<Variant> data = rhsIt->second_->data;
+// Returns the index of the branch at path, or -1 if there is none.
+int IoDataTree::FindBranchIndex(const int* path, unsigned pathSize) const
+{
+	const IoBranchStorage& storage = *storage_;
+	unsigned numBranches = storage.GetNumBranches();
+	if (numBranches == 0)
+		return -1;
 
-			branches_[pathString] = new IoBranch(path);
-			branches_[pathString]->data = data;
-		}
+	// trees are mostly filled one branch at a time, so try the newest branch first
+	unsigned last = numBranches - 1;
+	const int* lastPath = storage.pathValues.Buffer() + storage.pathOffsets[last];
+	unsigned lastSize = storage.pathOffsets[last + 1] - storage.pathOffsets[last];
+	if (ComparePathValues(path, pathSize, lastPath, lastSize) == 0)
+		return (int)last;
+
+	unsigned lo = 0;
+	unsigned hi = numBranches;
+	while (lo < hi) {
+		unsigned mid = (lo + hi) / 2;
+		unsigned b = storage.sortedBranches[mid];
+		const int* midPath = storage.pathValues.Buffer() + storage.pathOffsets[b];
+		unsigned midSize = storage.pathOffsets[b + 1] - storage.pathOffsets[b];
+		int cmp = ComparePathValues(midPath, midSize, path, pathSize);
+		if (cmp == 0)
+			return (int)b;
+		else if (cmp < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
-	return *this;
+
+	return -1;
+}
+
+unsigned IoDataTree::FindOrAddBranch(const Vector<int>& path)
+{
+	int found = FindBranchIndex(path.Buffer(), path.Size());
+	if (found >= 0)
+		return (unsigned)found;
+
+	//branch doesn't exist, so create it at the end and record its place in the sorted order
+	IoBranchStorage& storage = GetWritableStorage();
+	unsigned b = storage.GetNumBranches();
+
+	for (unsigned i = 0; i < path.Size(); ++i)
+		storage.pathValues.Push(path[i]);
+	storage.pathOffsets.Push(storage.pathValues.Size());
+	storage.itemOffsets.Push(storage.items.Size());
+
+	unsigned lo = 0;
+	unsigned hi = b;
+	while (lo < hi) {
+		unsigned mid = (lo + hi) / 2;
+		unsigned other = storage.sortedBranches[mid];
+		const int* otherPath = storage.pathValues.Buffer() + storage.pathOffsets[other];
+		unsigned otherSize = storage.pathOffsets[other + 1] - storage.pathOffsets[other];
+		if (ComparePathValues(otherPath, otherSize, path.Buffer(), path.Size()) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	storage.sortedBranches.Insert(lo, b);
+
+	return b;
+}
+
+void IoDataTree::InsertItems(unsigned branch, const Variant* items, unsigned numItems)
+{
+	if (numItems == 0)
+		return;
+
+	IoBranchStorage& storage = GetWritableStorage();
+	unsigned end = storage.itemOffsets[branch + 1];
+	if (end == storage.items.Size()) {
+		for (unsigned i = 0; i < numItems; ++i)
+			storage.items.Push(items[i]);
+	}
+	else {
+		storage.items.Insert(end, Vector<Variant>(items, numItems));
+	}
+
+	for (unsigned b = branch + 1; b < storage.itemOffsets.Size(); ++b)
+		storage.itemOffsets[b] += numItems;
+}
+
+void IoDataTree::EraseBranch(unsigned branch)
+{
+	IoBranchStorage& storage = GetWritableStorage();
+
+	unsigned pathBegin = storage.pathOffsets[branch];
+	unsigned pathSize = storage.pathOffsets[branch + 1] - pathBegin;
+	unsigned itemBegin = storage.itemOffsets[branch];
+	unsigned numItems = storage.itemOffsets[branch + 1] - itemBegin;
+
+	storage.pathValues.Erase(pathBegin, pathSize);
+	storage.pathOffsets.Erase(branch);
+	storage.items.Erase(itemBegin, numItems);
+	storage.itemOffsets.Erase(branch);
+	for (unsigned b = branch; b < storage.pathOffsets.Size(); ++b) {
+		storage.pathOffsets[b] -= pathSize;
+		storage.itemOffsets[b] -= numItems;
+	}
+
+	storage.sortedBranches.Remove(branch);
+	for (unsigned i = 0; i < storage.sortedBranches.Size(); ++i) {
+		if (storage.sortedBranches[i] > branch)
+			--storage.sortedBranches[i];
+	}
+
+	if (branchIterator_ > 0 && branchIterator_ >= storage.GetNumBranches())
+		branchIterator_ = storage.GetNumBranches() - 1;
+}
+
+int IoDataTree::FindBranch(const Vector<int>& path) const
+{
+	return FindBranchIndex(path.Buffer(), path.Size());
+}
+
+Vector<int> IoDataTree::GetBranchPath(unsigned branch) const
+{
+	const IoBranchStorage& storage = *storage_;
+	assert(branch < storage.GetNumBranches());
+
+	unsigned begin = storage.pathOffsets[branch];
+	unsigned end = storage.pathOffsets[branch + 1];
+	Vector<int> path(end - begin);
+	for (unsigned i = begin; i < end; ++i)
+		path[i - begin] = storage.pathValues[i];
+
+	return path;
+}
+
+unsigned IoDataTree::GetNumItemsInBranch(unsigned branch) const
+{
+	assert(branch < storage_->GetNumBranches());
+	return storage_->itemOffsets[branch + 1] - storage_->itemOffsets[branch];
+}
+
+const Variant& IoDataTree::GetBranchItem(unsigned branch, unsigned index) const
+{
+	assert(index < GetNumItemsInBranch(branch));
+	return storage_->items[storage_->itemOffsets[branch] + index];
+}
+
+namespace {
+
+IoDataTree::CustomMemoryUse customMemoryUse = 0;
+
+// heap memory held by a variant beyond sizeof(Variant); custom values are counted by the registered callback
+unsigned VariantHeapUse(const Variant& var)
+{
+	switch (var.GetType()) {
+	case VAR_STRING:
+		return var.GetString().Capacity();
+	case VAR_BUFFER:
+		return var.GetBuffer().Size();
+	case VAR_VARIANTVECTOR: {
+		const VariantVector& vec = var.GetVariantVector();
+		unsigned bytes = vec.Size() * sizeof(Variant);
+		for (unsigned i = 0; i < vec.Size(); ++i)
+			bytes += VariantHeapUse(vec[i]);
+		return bytes;
+	}
+	case VAR_STRINGVECTOR: {
+		const StringVector& vec = var.GetStringVector();
+		unsigned bytes = vec.Size() * sizeof(String);
+		for (unsigned i = 0; i < vec.Size(); ++i)
+			bytes += vec[i].Capacity();
+		return bytes;
+	}
+	case VAR_VARIANTMAP: {
+		const VariantMap& map = var.GetVariantMap();
+		unsigned bytes = 0;
+		for (VariantMap::ConstIterator it = map.Begin(); it != map.End(); ++it)
+			bytes += sizeof(StringHash) + sizeof(Variant) + VariantHeapUse(it->second_);
+		return bytes;
+	}
+	case VAR_CUSTOM_HEAP:
+	case VAR_CUSTOM_STACK:
+		return customMemoryUse ? customMemoryUse(var) : 0;
+	default:
+		return 0;
+	}
+}
+
+}
+
+void IoDataTree::SetCustomMemoryUse(CustomMemoryUse func)
+{
+	customMemoryUse = func;
+}
+
+unsigned IoDataTree::GetMemoryUse() const
+{
+	const IoBranchStorage& storage = *storage_;
+	unsigned bytes = storage.items.Size() * sizeof(Variant);
+	for (unsigned i = 0; i < storage.items.Size(); ++i)
+		bytes += VariantHeapUse(storage.items[i]);
+	return bytes;
+}
+
+bool IoDataTree::HasSameContent(const IoDataTree& other) const
+{
+	if (storage_ == other.storage_)
+		return true;
+
+	const IoBranchStorage& lhs = *storage_;
+	const IoBranchStorage& rhs = *other.storage_;
+	return
+		lhs.pathOffsets == rhs.pathOffsets &&
+		lhs.itemOffsets == rhs.itemOffsets &&
+		lhs.pathValues == rhs.pathValues &&
+		lhs.items == rhs.items;
 }
 
 String IoDataTree::PathToUniqueString(Vector<int> path) const
@@ -122,81 +352,50 @@ Vector<int> IoDataTree::PathFromUniqueString(String pathString) const
 
 void IoDataTree::Add(Vector<int> path, Variant item)
 {
-	//check that this path exists
-	String pathString = PathToUniqueString(path);
-	IoBranch* branchId = branches_[pathString];
-	if (branchId == NULL)
-	{
-		//branch doesn't exist, so create it and add it to the map
-		IoBranch* newBranch = new IoBranch(path);
-		branches_[pathString] = newBranch;
-	}
+	//find or create the branch, then add the data
+	unsigned branch = FindOrAddBranch(path);
+	InsertItems(branch, &item, 1);
 
-	//add the data
-	branches_[pathString]->data.Push(item);
-	
 	//reset iterators
-	Begin();
+	branchIterator_ = 0;
+	lastItemIndex_ = 0;
+	branchOverflow_ = false;
+	itemOverflow_ = false;
 }
 
 void IoDataTree::GetItem(Variant& item, Vector<int> path, int index) const
 {
-	String pathString = PathToUniqueString(path);
-	IoBranch** branchPtr = branches_[pathString];
-
-	IoBranch* branch = NULL;
-
-	if (branchPtr != NULL) {
-		branch = *branchPtr;
-	}
-
-	if (branch != NULL)
+	int branch = FindBranch(path);
+	if (branch >= 0)
 	{
-		if (index < (int)branch->data.Size())
+		if (index < (int)GetNumItemsInBranch(branch))
 		{
-			item = branch->data[index];
+			item = GetBranchItem(branch, index);
 		}
 	}
 }
 
 void IoDataTree::Add(Vector<int> path, VariantVector list)
 {
-	//check that this path exists
-	String pathString = PathToUniqueString(path);
-	IoBranch* branchId = branches_[pathString];
-	if (branchId == NULL)
-	{
-		//branch doesn't exist, so create it and add it to the map
-		IoBranch* newBranch = new IoBranch(path);
-		branches_[pathString] = newBranch;
-	}
-
-	//add the data
-	for (unsigned i = 0; i < list.Size(); i++)
-	{
-		branches_[pathString]->data.Push(list[i]);
-	}
+	//find or create the branch, then add the data
+	unsigned branch = FindOrAddBranch(path);
+	InsertItems(branch, list.Buffer(), list.Size());
 
 	//reset iterators
-	Begin();
+	branchIterator_ = 0;
+	lastItemIndex_ = 0;
+	branchOverflow_ = false;
+	itemOverflow_ = false;
 }
 
 unsigned IoDataTree::GetNumItemsAtBranch(Vector<int> path, DataAccess accessType) const
 {
-	/*
-	IoBranch** branchPtr = branches_[PathToUniqueString(path)];
-	IoBranch* branch = NULL;
-	if (branchPtr != NULL) {
-		branch = *branchPtr;
-	}
-	*/
-
 	if (accessType == DataAccess::ITEM) {
-		if (branches_[PathToUniqueString(path)])
-			return (*(branches_[PathToUniqueString(path)]))->data.Size();
+		int branch = FindBranch(path);
+		if (branch >= 0)
+			return GetNumItemsInBranch(branch);
 		else
 			return 1;
-		//return branch->data.Size();
 	}
 	else {
 		return 1; // change to 0 if LocalSolve is ready to handle this
@@ -213,22 +412,9 @@ unsigned IoDataTree::GetNumItemsAtBranch(Vector<int> path, DataAccess accessType
 // without crashing. Hopefully!
 void IoDataTree::LookupType(Variant& dataOut, DataAccess accessType) const
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		if (it->second_) {
-			IoBranch* currentBranch = it->second_;
-			if (currentBranch == NULL) {
-				dataOut = Variant();
-				return;
-			}
-			else {
-				VariantVector dat = currentBranch->data;
-				if (dat.Size() > 0) {
-					dataOut = dat[0];
-					return;
-				}
-			}
-		}
+	if (storage_->items.Size() > 0) {
+		dataOut = storage_->items[0];
+		return;
 	}
 
 	dataOut = Variant();
@@ -237,38 +423,40 @@ void IoDataTree::LookupType(Variant& dataOut, DataAccess accessType) const
 
 void IoDataTree::GetNextItem(Variant& dataOut, DataAccess accessType)
 {
-	IoBranch* currentBranch = branchIterator_->second_;
-	if(currentBranch == NULL)
+	if (IsEmptyTree())
 	{
 		return;
 	}
 
+	unsigned numItems = GetNumItemsInBranch(branchIterator_);
+
 	if (accessType == DataAccess::ITEM)
 	{
-		if (currentBranch->data.Size() == 0) {
+		if (numItems == 0) {
 			dataOut = Variant();
 			itemOverflow_ = true;
 			lastItemIndex_ = 0;
 			return;
 		}
 
-		assert((int)currentBranch->data.Size() > lastItemIndex_); //WRONG! Triggers error on empty VariantVector...
-		
+		assert((int)numItems > lastItemIndex_);
+
 		//first try to continue returning the next item on current branch index
-		dataOut = currentBranch->data[lastItemIndex_];
+		dataOut = GetBranchItem(branchIterator_, lastItemIndex_);
 		lastItemIndex_++;
 
-		if (lastItemIndex_ > (int)currentBranch->data.Size() - 1)
+		if (lastItemIndex_ > (int)numItems - 1)
 		{
 			itemOverflow_ = true;
 		}
 
-		lastItemIndex_ = Urho3D::Min(currentBranch->data.Size() - 1, lastItemIndex_);
+		lastItemIndex_ = Urho3D::Min((int)numItems - 1, lastItemIndex_);
 	}
 
 	if (accessType == DataAccess::LIST)
 	{
-		dataOut = currentBranch->data;
+		const Variant* begin = storage_->items.Buffer() + storage_->itemOffsets[branchIterator_];
+		dataOut = VariantVector(begin, numItems);
 		itemOverflow_ = true;
 		lastItemIndex_ = 0;
 	}
@@ -277,30 +465,23 @@ void IoDataTree::GetNextItem(Variant& dataOut, DataAccess accessType)
 
 String IoDataTree::ToString(bool truncate) const
 {
-	/*
-	if (IsEmptyTree()) {
-		return String("");
-	}
-	*/
-
-	HashMap<String, IoBranch*>::ConstIterator itr = branches_.Begin();
 	String out;
-	int branchCounter = 0;
-	for (; itr != branches_.End(); itr++)
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b)
 	{
-		if (truncate && branchCounter > 5)
+		if (truncate && b > 5)
 			return out;
 
-		String path = itr->first_;
-		String itemCount = String(itr->second_->data.Size());
+		String path = PathToUniqueString(GetBranchPath(b));
+		String itemCount = String(GetNumItemsInBranch(b));
 		out += "Branch: " + path + ", N = " + itemCount + "\n";
-		int numItems = itr->second_->data.Size();
+		int numItems = GetNumItemsInBranch(b);
 		if (truncate)
 			numItems = Min(numItems, 3);
 
 		for(int i = 0; i < numItems; i++)
 		{
-			Variant var = itr->second_->data[i];
+			const Variant& var = GetBranchItem(b, i);
             String type = var.GetTypeName();
             if (var.GetType() == VAR_VARIANTMAP){
                 VariantMap var_map = var.GetVariantMap();
@@ -311,12 +492,10 @@ String IoDataTree::ToString(bool truncate) const
 			out += "    " + var.ToString() + ", type: " + type + "\n";
 		}
 
-		if (truncate && itr->second_->data.Size() > 3)
+		if (truncate && GetNumItemsInBranch(b) > 3)
 		{
 			out += "....and so on\n";
 		}
-
-		branchCounter++;
 	}
 
 	return out;
@@ -324,14 +503,13 @@ String IoDataTree::ToString(bool truncate) const
 
 Urho3D::VariantMap IoDataTree::ToVariantMap() const
 {
-	HashMap<String, IoBranch*>::ConstIterator itr = branches_.Begin();
 	VariantMap vm;
 
-	for (; itr != branches_.End(); itr++) {
-
-		String path = itr->first_;
-		VariantVector data = itr->second_->data;
-		vm[path.CString()] = Variant(data);
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		String path = PathToUniqueString(GetBranchPath(b));
+		const Variant* begin = storage_->items.Buffer() + storage_->itemOffsets[b];
+		vm[path.CString()] = Variant(VariantVector(begin, GetNumItemsInBranch(b)));
 	}
 
 	return vm;
@@ -339,31 +517,18 @@ Urho3D::VariantMap IoDataTree::ToVariantMap() const
 
 Urho3D::Vector<Urho3D::String> IoDataTree::GetContent()
 {
-	HashMap<String, IoBranch*>::ConstIterator itr = branches_.Begin();
 	Vector<String> contents;
-	int branchCounter = 0;
-	for (; itr != branches_.End(); itr++)
-	{		
-		String path = itr->first_;
-		String itemCount = String(itr->second_->data.Size());
-		int numItems = itr->second_->data.Size();
-
-		for (int i = 0; i < numItems; i++)
+	const Vector<Variant>& items = storage_->items;
+	for (unsigned i = 0; i < items.Size(); ++i)
+	{
+		if (items[i].GetType() == VAR_NONE)
 		{
-			Variant var = itr->second_->data[i];
-			if (var.GetType() == VAR_NONE)
-			{
-
-			}
-			else
-			{
-				String strVal = var.ToString();
-				contents.Push(strVal);
-			}
 
 		}
-
-		branchCounter++;
+		else
+		{
+			contents.Push(items[i].ToString());
+		}
 	}
 
 	return contents;
@@ -375,11 +540,9 @@ Vector<Vector<int> > IoDataTree::FindChildPaths(Vector<int> path) const
 {
 	Vector<Vector<int> > childPaths;
 
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		Vector<int> curPath = GetBranchPath(b);
 
 		if (IsParentChildPathPair(path, curPath)) {
 			childPaths.Push(curPath);
@@ -401,21 +564,20 @@ Vector<int> IoDataTree::GetNextNewBranchPath(Vector<int> path) const
 		return copyPath;
 	}
 
-	//Sort(childPaths.Begin(), childPaths.End(), ComparePaths);
-	Sort(childPaths.Begin(), childPaths.End(), ComparePaths);
-	Vector<int> lastBranchFullPath = childPaths[childPaths.Size() - 1];
-	int lastBranchLastInt = lastBranchFullPath[lastBranchFullPath.Size() - 1];
+	// child paths only differ in their last index, so the last child is the one with the largest last index
+	int lastBranchLastInt = childPaths[0][path.Size()];
+	for (unsigned i = 1; i < childPaths.Size(); ++i) {
+		lastBranchLastInt = Max(lastBranchLastInt, childPaths[i][path.Size()]);
+	}
 	copyPath.Push(lastBranchLastInt + 1);
 	return copyPath;
 }
 
 bool IoDataTree::HasSiblings(Vector<int> path) const
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		Vector<int> curPath = GetBranchPath(b);
 
 		if (WitnessSiblings(path, curPath)) {
 			// curPath witnesses existence of a sibling for path
@@ -431,8 +593,8 @@ bool IoDataTree::CanBeDeleted(Vector<int> path) const
 {
 	bool hasData = false;
 
-	IoBranch* branchId = *branches_[PathToUniqueString(path)];
-	if (branchId != NULL && branchId->data.Size() > 0) {
+	int branch = FindBranch(path);
+	if (branch >= 0 && GetNumItemsInBranch(branch) > 0) {
 		hasData = true;
 	}
 
@@ -462,34 +624,24 @@ bool IoDataTree::Descendant(Vector<int> ancestor, Vector<int> descendant) const
 
 IoDataTree IoDataTree::Flatten() const
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	Vector<Variant> allVariants;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		allVariants.Push(it->second_->data);
-	}
-
 	Vector<int> path;
 	path.Push(0);
 
 	IoDataTree simplifiedTree(GetContext());
-	simplifiedTree.Add(path, allVariants);
+	simplifiedTree.Add(path, storage_->items);
 
 	return simplifiedTree;
 }
 
 IoDataTree IoDataTree::Graft() const
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-
 	IoDataTree graftedTree(GetContext());
 
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		Vector<Variant> vlist = it->second_->data;
-		unsigned numItems = vlist.Size();
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		unsigned numItems = GetNumItemsInBranch(b);
+		Vector<int> curPath = GetBranchPath(b);
+		const Variant* vlist = storage_->items.Buffer() + storage_->itemOffsets[b];
 		if (numItems > 1) {
 			Vector<int> nextBranch = GetNextNewBranchPath(curPath);
 			for (unsigned i = 0; i < numItems; ++i) {
@@ -498,7 +650,7 @@ IoDataTree IoDataTree::Graft() const
 			}
 		}
 		else {
-			graftedTree.Add(curPath, vlist);
+			graftedTree.Add(curPath, VariantVector(vlist, numItems));
 		}
 	}
 
@@ -507,12 +659,15 @@ IoDataTree IoDataTree::Graft() const
 
 IoDataTree IoDataTree::FlipMatrix() const
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
 	IoDataTree flippedTree(GetContext());
-	int numElements = branches_.Begin()->second_->data.Size();
-	for (it = branches_.Begin(); it != branches_.End(); ++it)
+	unsigned numBranches = storage_->GetNumBranches();
+	if (numBranches == 0)
+		return flippedTree;
+
+	unsigned numElements = GetNumItemsInBranch(0);
+	for (unsigned b = 0; b < numBranches; ++b)
 	{
-		if (it->second_->data.Size() != numElements)
+		if (GetNumItemsInBranch(b) != numElements)
 		{
 			return flippedTree;
 		}
@@ -522,12 +677,12 @@ IoDataTree IoDataTree::FlipMatrix() const
 	Vector<int> path;
 	path.Push(0);
 	path.Push(0);
-	for (int i = 0; i < numElements; i++)
+	for (unsigned i = 0; i < numElements; i++)
 	{
 		path[1] = i;
-		for (it = branches_.Begin(); it != branches_.End(); ++it)
+		for (unsigned b = 0; b < numBranches; ++b)
 		{
-			flippedTree.Add(path, it->second_->data[i]);
+			flippedTree.Add(path, GetBranchItem(b, i));
 		}
 	}
 
@@ -540,72 +695,59 @@ void IoDataTree::FillInMissingPaths(Vector<int> path)
 
 	for (unsigned i = path.Size() - 1; i > 0; --i) {
 		copyPath.Erase(i);
-		String copyPathString = PathToUniqueString(copyPath);
-		IoBranch* branch = branches_[copyPathString];
-		if (branch == NULL) {
-			IoBranch* newBranch = new IoBranch(copyPath);
-			branches_[copyPathString] = newBranch;
-		}
+		FindOrAddBranch(copyPath);
 	}
 }
 
 void IoDataTree::FillInAllMissingPaths()
 {
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
+	// branches added here are ancestors of existing ones, so they never need filling in themselves
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		Vector<int> curPath = GetBranchPath(b);
 		FillInMissingPaths(curPath);
 	}
 }
 
 void IoDataTree::ModifyPathInPlace(Vector<int> oldPath, Vector<int> newPath)
 {
-	String oldPathString = PathToUniqueString(oldPath);
-	IoBranch* oldBranchId = branches_[oldPathString];
-	if (oldBranchId == NULL) {
+	int oldBranch = FindBranch(oldPath);
+	if (oldBranch < 0) {
 		URHO3D_LOGERROR("ERROR: IoDataTree::ModifyPath --- path to modify does not exist");
 	}
-	assert(oldBranchId != NULL);
+	assert(oldBranch >= 0);
 
-	String newPathString = PathToUniqueString(newPath);
-	IoBranch* newBranchId = branches_[newPathString];
-	if (newBranchId != NULL) {
+	int newBranch = FindBranch(newPath);
+	if (newBranch >= 0) {
 		URHO3D_LOGERROR("ERROR: IoDataTree::ModifyPath --- new path already exists");
 	}
-	assert(newBranchId == NULL);
+	assert(newBranch < 0);
 
-	Vector<Variant> data = branches_[oldPathString]->data;
-	delete oldBranchId;
+	const Variant* begin = storage_->items.Buffer() + storage_->itemOffsets[oldBranch];
+	VariantVector data(begin, GetNumItemsInBranch(oldBranch));
 
-	branches_.Erase(branches_.Find(oldPathString));
-	newBranchId = new IoBranch(newPath);
-	newBranchId->data = data;
-
-	branches_[newPathString] = newBranchId;
+	// the modified branch moves to the end of the tree
+	EraseBranch(oldBranch);
+	newBranch = FindOrAddBranch(newPath);
+	InsertItems(newBranch, data.Buffer(), data.Size());
 }
 
 IoDataTree IoDataTree::DeleteZeroSiblingPath(Vector<int> zeroSiblingPath) const
 {
 	IoDataTree copyTree = *this;
 
-	IoBranch* thisBranch = copyTree.branches_[PathToUniqueString(zeroSiblingPath)];
-	if (thisBranch != NULL) {
-		assert(thisBranch->data.Size() == 0);
+	int thisBranch = copyTree.FindBranch(zeroSiblingPath);
+	if (thisBranch >= 0) {
+		assert(copyTree.GetNumItemsInBranch(thisBranch) == 0);
 		// there is data at this branch, we cannot eliminate and should not be trying to
+		copyTree.EraseBranch(thisBranch);
 	}
 
 	unsigned zeroSiblingIndex = zeroSiblingPath.Size() - 1;
 
-	delete thisBranch;
-	copyTree.branches_.Erase(copyTree.branches_.Find(PathToUniqueString(zeroSiblingPath)));
-
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
+		Vector<int> curPath = GetBranchPath(b);
 
 		if (Descendant(zeroSiblingPath, curPath)) {
 			assert(curPath[zeroSiblingIndex] == 0);
@@ -623,23 +765,21 @@ IoDataTree IoDataTree::Simplify() const
 	IoDataTree tmpTree = *this;
 	tmpTree.FillInAllMissingPaths();
 
-	HashMap<String, IoBranch*>::ConstIterator it;
-
 	bool done = false;
 
 	while (!done) {
 
 		done = true;
 
-		for (it = tmpTree.branches_.Begin(); it != tmpTree.branches_.End(); ++it) {
-			String curPathString = it->first_;
-			Vector<int> curPath = PathFromUniqueString(curPathString);
+		unsigned numBranches = tmpTree.storage_->GetNumBranches();
+		for (unsigned b = 0; b < numBranches; ++b) {
+			Vector<int> curPath = tmpTree.GetBranchPath(b);
 			if (tmpTree.CanBeDeleted(curPath)) {
 				// adjust curPath and all descendants accordingly
 				IoDataTree copyTmpTree = tmpTree.DeleteZeroSiblingPath(curPath);
 				tmpTree = copyTmpTree;
 				done = false;
-				break; // iterators invalidated!
+				break; // branch indices invalidated!
 			}
 		}
 
@@ -659,32 +799,27 @@ IoDataTree IoDataTree::OneToManyGraft() const
 {
 	IoDataTree graftedTree(GetContext());
 
-	HashMap<String, IoBranch*>::ConstIterator it;
-
-	for (it = branches_.Begin(); it != branches_.End(); ++it) {
+	unsigned numBranches = storage_->GetNumBranches();
+	for (unsigned b = 0; b < numBranches; ++b) {
 
 		// setup "curPath" and the "data" stored there
-		String curPathString = it->first_;
-		Vector<int> curPath = PathFromUniqueString(curPathString);
-		Vector<Variant> data = it->second_->data;
+		Vector<int> curPath = GetBranchPath(b);
+		unsigned numItems = GetNumItemsInBranch(b);
+		const Variant* data = storage_->items.Buffer() + storage_->itemOffsets[b];
 
-		if (data.Size() > 1) {
+		if (numItems > 1) {
 			Vector<int> basePath = GetNextNewBranchPath(curPath);
-			for (unsigned i = 0; i < data.Size(); ++i) {
+			for (unsigned i = 0; i < numItems; ++i) {
 				Vector<int> newPath = IncrementBranchPath(basePath, (int)i);
-				Variant variant = data[i];
-				Vector<Variant> newData = variant.GetVariantVector();
-				graftedTree.Add(newPath, newData);
+				graftedTree.Add(newPath, data[i].GetVariantVector());
 			}
 		}
-		else if (data.Size() == 1) {
+		else if (numItems == 1) {
 			if (data[0].GetType() == VariantType::VAR_VARIANTVECTOR) {
-
-				Vector<Variant> newData = data[0].GetVariantVector();
-				graftedTree.Add(curPath, newData);
+				graftedTree.Add(curPath, data[0].GetVariantVector());
 			}
 			else if (data[0].GetType() == VariantType::VAR_NONE) {
-				graftedTree.Add(curPath, data);
+				graftedTree.Add(curPath, data[0]);
 			}
 			else {
 				URHO3D_LOGERROR("Unexpected tree structure crashed one-to-many component!");
@@ -693,7 +828,7 @@ IoDataTree IoDataTree::OneToManyGraft() const
 		}
 		else {
 			// data is empty but still add the path, since the previous tree had the path
-			graftedTree.Add(curPath, data);
+			graftedTree.Add(curPath, VariantVector());
 		}
 	}
 
@@ -730,24 +865,24 @@ bool IoDataTree::IsParentChildPathPair(Vector<int> parentCandidate, Vector<int>
 
 Vector<int> IoDataTree::Begin()
 {
-	branchIterator_ = branches_.Begin();
+	branchIterator_ = 0;
 	lastItemIndex_ = 0;
 	branchOverflow_ = false;
 	itemOverflow_ = false;
-	return PathFromUniqueString(branchIterator_->first_);
+	return GetCurrentBranch();
 }
 
 Vector<int> IoDataTree::GetNextBranch()
 {
 	Vector<int> pathOut;
-	if (++branchIterator_ == branches_.End())
+	if (++branchIterator_ >= storage_->GetNumBranches())
 	{
 		branchOverflow_ = true;
 		--branchIterator_;
 	}
 	lastItemIndex_ = 0;
 	itemOverflow_ = false;
-	pathOut = PathFromUniqueString(branchIterator_->first_);
+	pathOut = GetCurrentBranch();
 
 
 	return pathOut;
@@ -755,7 +890,10 @@ Vector<int> IoDataTree::GetNextBranch()
 
 Vector<int> IoDataTree::GetCurrentBranch() const
 {
-	return PathFromUniqueString(branchIterator_->first_);
+	if (IsEmptyTree())
+		return Vector<int>();
+
+	return GetBranchPath(branchIterator_);
 }
 
 Vector<int> IoDataTree::IncrementBranchPath(Vector<int> path, int incSize) const
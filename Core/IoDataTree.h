@@ -26,6 +26,8 @@
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Core/Variant.h>
 
+#include <memory>
+
 ///determines the stride with which to iterate over the tree
 enum DataAccess
 {
@@ -34,18 +36,26 @@ enum DataAccess
 	TREE
 };
 
-///container for data at a specific address
-class IoBranch
+///flat storage for the branches of a tree, shared between copies of the tree until one of them is modified.
+///branches are numbered in the order they were created; branch b has
+///  path  pathValues[pathOffsets[b]] up to pathValues[pathOffsets[b + 1]]
+///  items items[itemOffsets[b]] up to items[itemOffsets[b + 1]]
+struct IoBranchStorage
 {
-public:
-	Urho3D::Vector<int> address;
-	Urho3D::Vector<Urho3D::Variant> data;
-
-public:
-	IoBranch(Urho3D::Vector<int> target)
+	Urho3D::PODVector<int> pathValues;
+	Urho3D::PODVector<unsigned> pathOffsets;
+	Urho3D::Vector<Urho3D::Variant> items;
+	Urho3D::PODVector<unsigned> itemOffsets;
+	//branch indices sorted by path, for lookup by binary search
+	Urho3D::PODVector<unsigned> sortedBranches;
+
+	IoBranchStorage()
 	{
-		address = target;
+		pathOffsets.Push(0);
+		itemOffsets.Push(0);
 	}
+
+	unsigned GetNumBranches() const { return sortedBranches.Size(); }
 };
 
 ///all slots receive and output a datatree
@@ -53,11 +63,11 @@ class URHO3D_API IoDataTree : public Urho3D::Object
 {
 	URHO3D_OBJECT(IoDataTree, Urho3D::Object)
 private:
-	//the branches
-	Urho3D::HashMap<Urho3D::String, IoBranch*> branches_;
+	//the branches; copies of this tree point at the same storage until one of them is modified
+	std::shared_ptr<IoBranchStorage> storage_;
 
 	//Not totally sure about this, but basically need custom iteration logic
-	Urho3D::HashMap<Urho3D::String, IoBranch*>::ConstIterator branchIterator_;
+	unsigned branchIterator_ = 0;
 	int lastItemIndex_ = 0;
 
 	//flags that track if iterator is in overflow mode
@@ -70,9 +80,16 @@ private:
 	void FillInAllMissingPaths();
 	void ModifyPathInPlace(Urho3D::Vector<int> oldPath, Urho3D::Vector<int> newPath);
 
+	// storage helpers
+	IoBranchStorage& GetWritableStorage();
+	int FindBranchIndex(const int* path, unsigned pathSize) const;
+	unsigned FindOrAddBranch(const Urho3D::Vector<int>& path);
+	void InsertItems(unsigned branch, const Urho3D::Variant* items, unsigned numItems);
+	void EraseBranch(unsigned branch);
+
 public:
 	// constructors, destructors, operator=
-	IoDataTree(Urho3D::Context* context) : Urho3D::Object(context) {};
+	IoDataTree(Urho3D::Context* context);
 	// convenience constructors, for tests
 	IoDataTree(Urho3D::Context* context, Urho3D::Variant item);
 	IoDataTree(Urho3D::Context* context, Urho3D::Vector<Urho3D::Variant> items);
@@ -116,13 +133,27 @@ public:
 	// Part of public interface: const operations with output depending on state
 	void GetItem(Urho3D::Variant& item, Urho3D::Vector<int> path, int index) const;
 	unsigned GetNumItemsAtBranch(Urho3D::Vector<int> path, DataAccess accessType) const;
-	int GetNumBranches() const { return branches_.Keys().Size(); };
+	int GetNumBranches() const { return (int)storage_->GetNumBranches(); };
+	// index-based access, branches are numbered in the order they were created
+	int FindBranch(const Urho3D::Vector<int>& path) const;
+	Urho3D::Vector<int> GetBranchPath(unsigned branch) const;
+	unsigned GetNumItemsInBranch(unsigned branch) const;
+	const Urho3D::Variant& GetBranchItem(unsigned branch, unsigned index) const;
 	Urho3D::Vector<int> GetCurrentBranch() const;
 	Urho3D::String ToString(bool truncate=false) const;
 	Urho3D::Vector<Urho3D::String> GetContent();
 	bool branchOverflow() const { return branchOverflow_; };
 	bool itemOverflow() const { return itemOverflow_; };
-	bool IsEmptyTree() const { return branches_.Size() == 0; }
+	bool IsEmptyTree() const { return storage_->GetNumBranches() == 0; }
+	unsigned GetNumItems() const { return storage_->items.Size(); }
+	// rough size in bytes of the items, for profiling. Storage shared with other trees is counted in full
+	unsigned GetMemoryUse() const;
+	// heap bytes held by a custom typed item, e.g. mesh data, or 0 for types it does not know;
+	// registered by the library that owns the types (see TriMesh_RegisterMemoryUse)
+	typedef unsigned(*CustomMemoryUse)(const Urho3D::Variant& var);
+	static void SetCustomMemoryUse(CustomMemoryUse func);
+	// true if both trees have the same branches, in the same order, holding equal items
+	bool HasSameContent(const IoDataTree& other) const;
 private:
 	// const operations with output depending on state
 	Urho3D::Vector<Urho3D::Vector<int> > FindChildPaths(Urho3D::Vector<int> path) const;
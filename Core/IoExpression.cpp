@@ -0,0 +1,854 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "IoExpression.h"
+
+#include <Urho3D/Math/MathDefs.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+using namespace Urho3D;
+
+namespace {
+
+// rows are evaluated this many at a time, so that the registers stay in cache
+const unsigned BLOCK_SIZE = 256;
+
+enum Op
+{
+	// dst = column a, component b
+	OP_INPUT,
+	// dst = constants[a]
+	OP_CONST,
+	// dst = f(a)
+	OP_COPY, OP_NEG, OP_TRUNC, OP_SIN, OP_COS, OP_TAN, OP_ASIN, OP_ACOS, OP_ATAN,
+	OP_SQRT, OP_ABS, OP_EXP, OP_LN, OP_FLOOR, OP_CEIL, OP_ROUND, OP_SIGN,
+	// dst = f(a, b)
+	OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_IDIV, OP_MOD, OP_POW, OP_MIN, OP_MAX, OP_ATAN2,
+	OP_LT, OP_LE, OP_GT, OP_GE, OP_EQ, OP_NE,
+	// dst = b > 0 ? a / b : a, for Normalized
+	OP_SAFEDIV,
+	// dst = f(a, b, c)
+	OP_CLAMP, OP_LERP, OP_SELECT
+};
+
+enum Token
+{
+	TOKEN_END,
+	TOKEN_NUMBER,
+	TOKEN_IDENT,
+	TOKEN_SYMBOL
+};
+
+// a value during compilation: a scalar lives in register reg, a Vector3 in reg, reg + 1 and reg + 2
+struct Operand
+{
+	IoExpressionType type;
+	unsigned reg;
+};
+
+bool IsScalar(const Operand& o)
+{
+	return o.type == EXPR_INT || o.type == EXPR_FLOAT;
+}
+
+// Recursive descent parser that emits the program as it goes.
+// Registers are written once, so operands may share them freely.
+class ExpressionCompiler
+{
+public:
+	ExpressionCompiler(
+		const String& source,
+		const Vector<String>& names,
+		const PODVector<IoExpressionType>& types,
+		PODVector<IoExpression::Instruction>& program,
+		PODVector<float>& constants
+	) :
+		source_(source),
+		names_(names),
+		types_(types),
+		program_(program),
+		constants_(constants),
+		numRegisters_(0),
+		pos_(0)
+	{
+	}
+
+	bool Run(Operand& result)
+	{
+		Next();
+		if (!ParseTernary(result)) {
+			return false;
+		}
+		// tolerate the statement terminator the script version needed
+		if (IsSymbol(";")) {
+			Next();
+		}
+		if (token_ != TOKEN_END) {
+			return Fail("unexpected '" + text_ + "'");
+		}
+		return true;
+	}
+
+	unsigned GetNumRegisters() const { return numRegisters_; }
+	const String& GetError() const { return error_; }
+
+private:
+	bool Fail(const String& message)
+	{
+		if (error_.Empty()) {
+			error_ = message + " at position " + String(tokenStart_);
+		}
+		return false;
+	}
+
+	void Next()
+	{
+		while (pos_ < source_.Length() && isspace((unsigned char)source_[pos_])) {
+			++pos_;
+		}
+		tokenStart_ = pos_;
+		text_.Clear();
+
+		if (pos_ >= source_.Length()) {
+			token_ = TOKEN_END;
+			return;
+		}
+
+		const char* s = source_.CString();
+		char c = s[pos_];
+		if (isdigit((unsigned char)c) || (c == '.' && isdigit((unsigned char)s[pos_ + 1]))) {
+			char* end = 0;
+			number_ = (float)strtod(s + pos_, &end);
+			unsigned endPos = (unsigned)(end - s);
+			numberIsInt_ = true;
+			for (unsigned i = pos_; i < endPos; ++i) {
+				if (s[i] == '.' || s[i] == 'e' || s[i] == 'E') {
+					numberIsInt_ = false;
+				}
+			}
+			if (endPos < source_.Length() && (s[endPos] == 'f' || s[endPos] == 'F')) {
+				numberIsInt_ = false;
+				++endPos;
+			}
+			token_ = TOKEN_NUMBER;
+			text_ = source_.Substring(pos_, endPos - pos_);
+			pos_ = endPos;
+			return;
+		}
+
+		if (isalpha((unsigned char)c) || c == '_') {
+			unsigned endPos = pos_;
+			while (endPos < source_.Length() && (isalnum((unsigned char)s[endPos]) || s[endPos] == '_')) {
+				++endPos;
+			}
+			token_ = TOKEN_IDENT;
+			text_ = source_.Substring(pos_, endPos - pos_);
+			pos_ = endPos;
+			return;
+		}
+
+		static const char* twoCharSymbols[] = { "<=", ">=", "==", "!=" };
+		for (unsigned i = 0; i < 4; ++i) {
+			if (c == twoCharSymbols[i][0] && s[pos_ + 1] == twoCharSymbols[i][1]) {
+				token_ = TOKEN_SYMBOL;
+				text_ = twoCharSymbols[i];
+				pos_ += 2;
+				return;
+			}
+		}
+
+		token_ = TOKEN_SYMBOL;
+		text_ = String(c);
+		++pos_;
+	}
+
+	bool IsSymbol(const char* symbol) const
+	{
+		return token_ == TOKEN_SYMBOL && text_ == symbol;
+	}
+
+	bool Expect(const char* symbol)
+	{
+		if (!IsSymbol(symbol)) {
+			return Fail("expected '" + String(symbol) + "'");
+		}
+		Next();
+		return true;
+	}
+
+	Operand NewOperand(IoExpressionType type)
+	{
+		Operand o;
+		o.type = type;
+		o.reg = numRegisters_;
+		numRegisters_ += type == EXPR_VECTOR3 ? 3 : 1;
+		return o;
+	}
+
+	void Emit(unsigned op, unsigned dst, unsigned a, unsigned b = 0, unsigned c = 0)
+	{
+		IoExpression::Instruction instruction = { op, dst, a, b, c };
+		program_.Push(instruction);
+	}
+
+	Operand EmitConstant(float value, IoExpressionType type)
+	{
+		Operand o = NewOperand(type);
+		constants_.Push(value);
+		Emit(OP_CONST, o.reg, constants_.Size() - 1);
+		return o;
+	}
+
+	Operand Component(const Operand& v, unsigned k) const
+	{
+		Operand o;
+		o.type = EXPR_FLOAT;
+		o.reg = v.reg + k;
+		return o;
+	}
+
+	Operand EmitScalar(unsigned op, IoExpressionType type, const Operand& a, const Operand& b = Operand(), const Operand& c = Operand())
+	{
+		Operand o = NewOperand(type);
+		Emit(op, o.reg, a.reg, b.reg, c.reg);
+		return o;
+	}
+
+	Operand EmitDot(const Operand& a, const Operand& b)
+	{
+		Operand x = EmitScalar(OP_MUL, EXPR_FLOAT, Component(a, 0), Component(b, 0));
+		Operand y = EmitScalar(OP_MUL, EXPR_FLOAT, Component(a, 1), Component(b, 1));
+		Operand z = EmitScalar(OP_MUL, EXPR_FLOAT, Component(a, 2), Component(b, 2));
+		return EmitScalar(OP_ADD, EXPR_FLOAT, EmitScalar(OP_ADD, EXPR_FLOAT, x, y), z);
+	}
+
+	Operand EmitCross(const Operand& a, const Operand& b)
+	{
+		Operand o = NewOperand(EXPR_VECTOR3);
+		for (unsigned k = 0; k < 3; ++k) {
+			unsigned i = (k + 1) % 3;
+			unsigned j = (k + 2) % 3;
+			Operand l = EmitScalar(OP_MUL, EXPR_FLOAT, Component(a, i), Component(b, j));
+			Operand r = EmitScalar(OP_MUL, EXPR_FLOAT, Component(a, j), Component(b, i));
+			Emit(OP_SUB, o.reg + k, l.reg, r.reg);
+		}
+		return o;
+	}
+
+	Operand EmitNormalized(const Operand& v)
+	{
+		Operand length = EmitScalar(OP_SQRT, EXPR_FLOAT, EmitDot(v, v));
+		Operand o = NewOperand(EXPR_VECTOR3);
+		for (unsigned k = 0; k < 3; ++k) {
+			Emit(OP_SAFEDIV, o.reg + k, v.reg + k, length.reg);
+		}
+		return o;
+	}
+
+	// arithmetic and comparison operators, with the operand types of the script version.
+	// l and r are copies, as result is usually one of them
+	bool EmitBinary(const String& symbol, Operand l, Operand r, Operand& result)
+	{
+		unsigned op;
+		bool comparison = false;
+		if (symbol == "+") op = OP_ADD;
+		else if (symbol == "-") op = OP_SUB;
+		else if (symbol == "*") op = OP_MUL;
+		else if (symbol == "/") op = OP_DIV;
+		else if (symbol == "%") op = OP_MOD;
+		else {
+			comparison = true;
+			if (symbol == "<") op = OP_LT;
+			else if (symbol == "<=") op = OP_LE;
+			else if (symbol == ">") op = OP_GT;
+			else if (symbol == ">=") op = OP_GE;
+			else if (symbol == "==") op = OP_EQ;
+			else op = OP_NE;
+		}
+
+		if (l.type == EXPR_BOOL || r.type == EXPR_BOOL) {
+			if (l.type != r.type || (op != OP_EQ && op != OP_NE)) {
+				return Fail("operator '" + symbol + "' does not take these operand types");
+			}
+			result = EmitScalar(op, EXPR_BOOL, l, r);
+			return true;
+		}
+
+		if (IsScalar(l) && IsScalar(r)) {
+			bool integer = l.type == EXPR_INT && r.type == EXPR_INT;
+			if (integer && op == OP_DIV) {
+				op = OP_IDIV;
+			}
+			result = EmitScalar(op, comparison ? EXPR_BOOL : integer ? EXPR_INT : EXPR_FLOAT, l, r);
+			return true;
+		}
+
+		if (comparison || op == OP_MOD) {
+			return Fail("operator '" + symbol + "' is not defined for Vector3");
+		}
+
+		if (l.type == EXPR_VECTOR3 && r.type == EXPR_VECTOR3) {
+			result = NewOperand(EXPR_VECTOR3);
+			for (unsigned k = 0; k < 3; ++k) {
+				Emit(op, result.reg + k, l.reg + k, r.reg + k);
+			}
+			return true;
+		}
+
+		// Vector3 * scalar, scalar * Vector3 and Vector3 / scalar
+		if ((op == OP_MUL || op == OP_DIV) && l.type == EXPR_VECTOR3) {
+			result = NewOperand(EXPR_VECTOR3);
+			for (unsigned k = 0; k < 3; ++k) {
+				Emit(op, result.reg + k, l.reg + k, r.reg);
+			}
+			return true;
+		}
+		if (op == OP_MUL && r.type == EXPR_VECTOR3) {
+			result = NewOperand(EXPR_VECTOR3);
+			for (unsigned k = 0; k < 3; ++k) {
+				Emit(op, result.reg + k, l.reg, r.reg + k);
+			}
+			return true;
+		}
+
+		return Fail("operator '" + symbol + "' does not take these operand types");
+	}
+
+	bool ParseTernary(Operand& result)
+	{
+		if (!ParseComparison(result)) {
+			return false;
+		}
+		if (!IsSymbol("?")) {
+			return true;
+		}
+		if (!IsScalar(result) && result.type != EXPR_BOOL) {
+			return Fail("condition of '?' must be a bool or a number");
+		}
+		Operand condition = result;
+		Next();
+
+		Operand a, b;
+		if (!ParseTernary(a) || !Expect(":") || !ParseTernary(b)) {
+			return false;
+		}
+
+		if (IsScalar(a) && IsScalar(b)) {
+			IoExpressionType type = a.type == EXPR_INT && b.type == EXPR_INT ? EXPR_INT : EXPR_FLOAT;
+			result = EmitScalar(OP_SELECT, type, condition, a, b);
+			return true;
+		}
+		if (a.type == EXPR_BOOL && b.type == EXPR_BOOL) {
+			result = EmitScalar(OP_SELECT, EXPR_BOOL, condition, a, b);
+			return true;
+		}
+		if (a.type == EXPR_VECTOR3 && b.type == EXPR_VECTOR3) {
+			result = NewOperand(EXPR_VECTOR3);
+			for (unsigned k = 0; k < 3; ++k) {
+				Emit(OP_SELECT, result.reg + k, condition.reg, a.reg + k, b.reg + k);
+			}
+			return true;
+		}
+		return Fail("both results of '?' must have the same type");
+	}
+
+	bool ParseComparison(Operand& result)
+	{
+		if (!ParseAdditive(result)) {
+			return false;
+		}
+		if (IsSymbol("<") || IsSymbol("<=") || IsSymbol(">") || IsSymbol(">=") || IsSymbol("==") || IsSymbol("!=")) {
+			String symbol = text_;
+			Next();
+			Operand r;
+			if (!ParseAdditive(r)) {
+				return false;
+			}
+			return EmitBinary(symbol, result, r, result);
+		}
+		return true;
+	}
+
+	bool ParseAdditive(Operand& result)
+	{
+		if (!ParseTerm(result)) {
+			return false;
+		}
+		while (IsSymbol("+") || IsSymbol("-")) {
+			String symbol = text_;
+			Next();
+			Operand r;
+			if (!ParseTerm(r) || !EmitBinary(symbol, result, r, result)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ParseTerm(Operand& result)
+	{
+		if (!ParseUnary(result)) {
+			return false;
+		}
+		while (IsSymbol("*") || IsSymbol("/") || IsSymbol("%")) {
+			String symbol = text_;
+			Next();
+			Operand r;
+			if (!ParseUnary(r) || !EmitBinary(symbol, result, r, result)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ParseUnary(Operand& result)
+	{
+		if (IsSymbol("+")) {
+			Next();
+			return ParseUnary(result);
+		}
+		if (IsSymbol("-")) {
+			Next();
+			Operand a;
+			if (!ParseUnary(a)) {
+				return false;
+			}
+			if (a.type == EXPR_BOOL) {
+				return Fail("operator '-' does not take a bool");
+			}
+			result = NewOperand(a.type);
+			for (unsigned k = 0; k < (a.type == EXPR_VECTOR3 ? 3u : 1u); ++k) {
+				Emit(OP_NEG, result.reg + k, a.reg + k);
+			}
+			return true;
+		}
+		return ParsePostfix(result);
+	}
+
+	bool ParseArguments(Vector<Operand>& args)
+	{
+		if (!Expect("(")) {
+			return false;
+		}
+		if (IsSymbol(")")) {
+			Next();
+			return true;
+		}
+		for (;;) {
+			Operand a;
+			if (!ParseTernary(a)) {
+				return false;
+			}
+			if (a.type == EXPR_BOOL) {
+				return Fail("bool arguments are not supported");
+			}
+			args.Push(a);
+			if (IsSymbol(")")) {
+				Next();
+				return true;
+			}
+			if (!Expect(",")) {
+				return false;
+			}
+		}
+	}
+
+	bool ParsePostfix(Operand& result)
+	{
+		if (!ParsePrimary(result)) {
+			return false;
+		}
+
+		while (IsSymbol(".")) {
+			Next();
+			if (token_ != TOKEN_IDENT) {
+				return Fail("expected member name");
+			}
+			if (result.type != EXPR_VECTOR3) {
+				return Fail("'" + text_ + "' is not a member of a number");
+			}
+			String member = text_;
+			Next();
+
+			Vector<Operand> args;
+			bool call = IsSymbol("(");
+			if (call && !ParseArguments(args)) {
+				return false;
+			}
+
+			unsigned numArgs = call ? args.Size() : 0;
+			bool vectorArg = numArgs == 1 && args[0].type == EXPR_VECTOR3;
+			if (!call && (member == "x" || member == "x_")) result = Component(result, 0);
+			else if (!call && (member == "y" || member == "y_")) result = Component(result, 1);
+			else if (!call && (member == "z" || member == "z_")) result = Component(result, 2);
+			else if ((!call && member == "length") || (call && numArgs == 0 && member == "Length")) {
+				result = EmitScalar(OP_SQRT, EXPR_FLOAT, EmitDot(result, result));
+			}
+			else if ((!call && member == "lengthSquared") || (call && numArgs == 0 && member == "LengthSquared")) {
+				result = EmitDot(result, result);
+			}
+			else if (call && numArgs == 0 && member == "Normalized") result = EmitNormalized(result);
+			else if (call && vectorArg && member == "DotProduct") result = EmitDot(result, args[0]);
+			else if (call && vectorArg && member == "CrossProduct") result = EmitCross(result, args[0]);
+			else {
+				return Fail("unknown Vector3 member '" + member + "'");
+			}
+		}
+		return true;
+	}
+
+	bool ParseFunction(const String& name, Operand& result)
+	{
+		Vector<Operand> args;
+		if (!ParseArguments(args)) {
+			return false;
+		}
+
+		if (name == "Vector3") {
+			if (args.Size() == 1 && args[0].type == EXPR_VECTOR3) {
+				result = args[0];
+				return true;
+			}
+			if (args.Size() != 3 || !IsScalar(args[0]) || !IsScalar(args[1]) || !IsScalar(args[2])) {
+				return Fail("Vector3 takes three numbers");
+			}
+			// the components must be consecutive registers
+			result = NewOperand(EXPR_VECTOR3);
+			for (unsigned k = 0; k < 3; ++k) {
+				Emit(OP_COPY, result.reg + k, args[k].reg);
+			}
+			return true;
+		}
+
+		for (unsigned i = 0; i < args.Size(); ++i) {
+			if (!IsScalar(args[i])) {
+				return Fail(name + " takes numbers only");
+			}
+		}
+
+		bool allInt = true;
+		for (unsigned i = 0; i < args.Size(); ++i) {
+			allInt = allInt && args[i].type == EXPR_INT;
+		}
+
+		static const struct { const char* name; unsigned op; } unary[] = {
+			{ "Sin", OP_SIN }, { "Cos", OP_COS }, { "Tan", OP_TAN },
+			{ "Asin", OP_ASIN }, { "Acos", OP_ACOS }, { "Atan", OP_ATAN },
+			{ "Sqrt", OP_SQRT }, { "Exp", OP_EXP }, { "Ln", OP_LN },
+			{ "Floor", OP_FLOOR }, { "Ceil", OP_CEIL }, { "Round", OP_ROUND }, { "Sign", OP_SIGN }
+		};
+		for (unsigned i = 0; i < sizeof(unary) / sizeof(unary[0]); ++i) {
+			if (name == unary[i].name) {
+				if (args.Size() != 1) {
+					return Fail(name + " takes one argument");
+				}
+				result = EmitScalar(unary[i].op, EXPR_FLOAT, args[0]);
+				return true;
+			}
+		}
+
+		if (name == "float" || name == "int" || name == "Abs") {
+			if (args.Size() != 1) {
+				return Fail(name + " takes one argument");
+			}
+			if (name == "float") {
+				result = args[0];
+				result.type = EXPR_FLOAT;
+			}
+			else if (name == "int") {
+				result = EmitScalar(OP_TRUNC, EXPR_INT, args[0]);
+			}
+			else {
+				result = EmitScalar(OP_ABS, args[0].type, args[0]);
+			}
+			return true;
+		}
+
+		if (name == "Pow" || name == "Atan2" || name == "Min" || name == "Max") {
+			if (args.Size() != 2) {
+				return Fail(name + " takes two arguments");
+			}
+			if (name == "Pow") result = EmitScalar(OP_POW, EXPR_FLOAT, args[0], args[1]);
+			else if (name == "Atan2") result = EmitScalar(OP_ATAN2, EXPR_FLOAT, args[0], args[1]);
+			else if (name == "Min") result = EmitScalar(OP_MIN, allInt ? EXPR_INT : EXPR_FLOAT, args[0], args[1]);
+			else result = EmitScalar(OP_MAX, allInt ? EXPR_INT : EXPR_FLOAT, args[0], args[1]);
+			return true;
+		}
+
+		if (name == "Clamp" || name == "Lerp") {
+			if (args.Size() != 3) {
+				return Fail(name + " takes three arguments");
+			}
+			if (name == "Clamp") result = EmitScalar(OP_CLAMP, allInt ? EXPR_INT : EXPR_FLOAT, args[0], args[1], args[2]);
+			else result = EmitScalar(OP_LERP, EXPR_FLOAT, args[0], args[1], args[2]);
+			return true;
+		}
+
+		return Fail("unknown function '" + name + "'");
+	}
+
+	bool ParsePrimary(Operand& result)
+	{
+		if (token_ == TOKEN_NUMBER) {
+			result = EmitConstant(number_, numberIsInt_ ? EXPR_INT : EXPR_FLOAT);
+			Next();
+			return true;
+		}
+
+		if (IsSymbol("(")) {
+			Next();
+			return ParseTernary(result) && Expect(")");
+		}
+
+		if (token_ != TOKEN_IDENT) {
+			return Fail(token_ == TOKEN_END ? String("unexpected end of expression") : "unexpected '" + text_ + "'");
+		}
+
+		String name = text_;
+		Next();
+
+		if (IsSymbol("(")) {
+			return ParseFunction(name, result);
+		}
+
+		for (unsigned i = 0; i < names_.Size(); ++i) {
+			if (names_[i] == name) {
+				IoExpressionType type = types_[i];
+				result = NewOperand(type);
+				for (unsigned k = 0; k < (type == EXPR_VECTOR3 ? 3u : 1u); ++k) {
+					Emit(OP_INPUT, result.reg + k, i, k);
+				}
+				return true;
+			}
+		}
+
+		static const struct { const char* name; float value; } namedConstants[] = {
+			{ "M_PI", M_PI }, { "M_HALF_PI", M_HALF_PI }, { "M_DEGTORAD", M_DEGTORAD },
+			{ "M_RADTODEG", M_RADTODEG }, { "M_EPSILON", M_EPSILON }
+		};
+		for (unsigned i = 0; i < sizeof(namedConstants) / sizeof(namedConstants[0]); ++i) {
+			if (name == namedConstants[i].name) {
+				result = EmitConstant(namedConstants[i].value, EXPR_FLOAT);
+				return true;
+			}
+		}
+		if (name == "true" || name == "false") {
+			result = EmitConstant(name == "true" ? 1.0f : 0.0f, EXPR_BOOL);
+			return true;
+		}
+
+		return Fail("unknown identifier '" + name + "'");
+	}
+
+	const String& source_;
+	const Vector<String>& names_;
+	const PODVector<IoExpressionType>& types_;
+	PODVector<IoExpression::Instruction>& program_;
+	PODVector<float>& constants_;
+	unsigned numRegisters_;
+
+	// tokenizer state
+	unsigned pos_;
+	unsigned tokenStart_ = 0;
+	Token token_ = TOKEN_END;
+	String text_;
+	float number_ = 0.0f;
+	bool numberIsInt_ = false;
+	String error_;
+};
+
+}
+
+IoExpression::IoExpression() :
+	numRegisters_(0),
+	resultRegister_(0),
+	resultType_(EXPR_NONE)
+{
+}
+
+bool IoExpression::Compile(
+	const String& source,
+	const Vector<String>& names,
+	const PODVector<IoExpressionType>& types,
+	String& error
+)
+{
+	source_ = source;
+	names_ = names;
+	types_ = types;
+
+	program_.Clear();
+	constants_.Clear();
+	numRegisters_ = 0;
+	resultRegister_ = 0;
+	resultType_ = EXPR_NONE;
+
+	if (names.Size() != types.Size()) {
+		error = "IoExpression::Compile --- names and types differ in size";
+		return false;
+	}
+
+	ExpressionCompiler compiler(source, names, types, program_, constants_);
+	Operand result;
+	if (!compiler.Run(result)) {
+		error = compiler.GetError();
+		program_.Clear();
+		constants_.Clear();
+		return false;
+	}
+
+	numRegisters_ = compiler.GetNumRegisters();
+	resultRegister_ = result.reg;
+	resultType_ = result.type;
+	return true;
+}
+
+bool IoExpression::IsCompiledFor(
+	const String& source,
+	const Vector<String>& names,
+	const PODVector<IoExpressionType>& types
+) const
+{
+	return source_ == source && names_ == names && types_ == types;
+}
+
+IoExpressionType IoExpression::FromVariantType(VariantType type)
+{
+	switch (type) {
+	case VAR_INT:
+		return EXPR_INT;
+	case VAR_FLOAT:
+		return EXPR_FLOAT;
+	case VAR_VECTOR3:
+		return EXPR_VECTOR3;
+	case VAR_BOOL:
+		return EXPR_BOOL;
+	default:
+		return EXPR_NONE;
+	}
+}
+
+void IoExpression::Evaluate(const PODVector<IoExpressionColumn>& columns, unsigned count, float* out) const
+{
+	if (!IsCompiled() || count == 0) {
+		return;
+	}
+	assert(columns.Size() == names_.Size());
+
+	PODVector<float> registers(numRegisters_ * BLOCK_SIZE);
+	float* reg = &registers[0];
+
+	for (unsigned begin = 0; begin < count; begin += BLOCK_SIZE) {
+		unsigned n = Min(BLOCK_SIZE, count - begin);
+
+		for (unsigned p = 0; p < program_.Size(); ++p) {
+			const Instruction& in = program_[p];
+			float* d = reg + in.dst * BLOCK_SIZE;
+			const float* a = reg + in.a * BLOCK_SIZE;
+			const float* b = reg + in.b * BLOCK_SIZE;
+			const float* c = reg + in.c * BLOCK_SIZE;
+
+// one loop per operation, so that each can be vectorized
+#define EXPR_LOOP(OP, EXPRESSION) case OP: for (unsigned i = 0; i < n; ++i) { d[i] = (EXPRESSION); } break;
+
+			switch (in.op) {
+			case OP_INPUT: {
+				const IoExpressionColumn& column = columns[in.a];
+				const float* src = column.data + (size_t)begin * column.stride + in.b;
+				for (unsigned i = 0; i < n; ++i) {
+					d[i] = src[(size_t)i * column.stride];
+				}
+				break;
+			}
+			case OP_CONST: {
+				float value = constants_[in.a];
+				for (unsigned i = 0; i < n; ++i) {
+					d[i] = value;
+				}
+				break;
+			}
+			EXPR_LOOP(OP_COPY, a[i])
+			EXPR_LOOP(OP_NEG, -a[i])
+			EXPR_LOOP(OP_TRUNC, (float)(int)a[i])
+			EXPR_LOOP(OP_SIN, sinf(a[i] * M_DEGTORAD))
+			EXPR_LOOP(OP_COS, cosf(a[i] * M_DEGTORAD))
+			EXPR_LOOP(OP_TAN, tanf(a[i] * M_DEGTORAD))
+			EXPR_LOOP(OP_ASIN, M_RADTODEG * asinf(Clamp(a[i], -1.0f, 1.0f)))
+			EXPR_LOOP(OP_ACOS, M_RADTODEG * acosf(Clamp(a[i], -1.0f, 1.0f)))
+			EXPR_LOOP(OP_ATAN, M_RADTODEG * atanf(a[i]))
+			EXPR_LOOP(OP_SQRT, sqrtf(a[i]))
+			EXPR_LOOP(OP_ABS, fabsf(a[i]))
+			EXPR_LOOP(OP_EXP, expf(a[i]))
+			EXPR_LOOP(OP_LN, logf(a[i]))
+			EXPR_LOOP(OP_FLOOR, floorf(a[i]))
+			EXPR_LOOP(OP_CEIL, ceilf(a[i]))
+			EXPR_LOOP(OP_ROUND, floorf(a[i] + 0.5f))
+			EXPR_LOOP(OP_SIGN, a[i] > 0.0f ? 1.0f : (a[i] < 0.0f ? -1.0f : 0.0f))
+			EXPR_LOOP(OP_ADD, a[i] + b[i])
+			EXPR_LOOP(OP_SUB, a[i] - b[i])
+			EXPR_LOOP(OP_MUL, a[i] * b[i])
+			EXPR_LOOP(OP_DIV, a[i] / b[i])
+			EXPR_LOOP(OP_IDIV, b[i] != 0.0f ? truncf(a[i] / b[i]) : 0.0f)
+			EXPR_LOOP(OP_MOD, b[i] != 0.0f ? fmodf(a[i], b[i]) : 0.0f)
+			EXPR_LOOP(OP_POW, powf(a[i], b[i]))
+			EXPR_LOOP(OP_MIN, a[i] < b[i] ? a[i] : b[i])
+			EXPR_LOOP(OP_MAX, a[i] > b[i] ? a[i] : b[i])
+			EXPR_LOOP(OP_ATAN2, M_RADTODEG * atan2f(a[i], b[i]))
+			EXPR_LOOP(OP_LT, a[i] < b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_LE, a[i] <= b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_GT, a[i] > b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_GE, a[i] >= b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_EQ, a[i] == b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_NE, a[i] != b[i] ? 1.0f : 0.0f)
+			EXPR_LOOP(OP_SAFEDIV, b[i] > 0.0f ? a[i] / b[i] : a[i])
+			EXPR_LOOP(OP_CLAMP, a[i] < b[i] ? b[i] : (a[i] > c[i] ? c[i] : a[i]))
+			EXPR_LOOP(OP_LERP, a[i] * (1.0f - c[i]) + b[i] * c[i])
+			EXPR_LOOP(OP_SELECT, a[i] != 0.0f ? b[i] : c[i])
+			default:
+				break;
+			}
+
+#undef EXPR_LOOP
+		}
+
+		if (resultType_ == EXPR_VECTOR3) {
+			const float* x = reg + resultRegister_ * BLOCK_SIZE;
+			const float* y = x + BLOCK_SIZE;
+			const float* z = y + BLOCK_SIZE;
+			float* dst = out + 3 * (size_t)begin;
+			for (unsigned i = 0; i < n; ++i) {
+				dst[3 * i] = x[i];
+				dst[3 * i + 1] = y[i];
+				dst[3 * i + 2] = z[i];
+			}
+		}
+		else {
+			const float* r = reg + resultRegister_ * BLOCK_SIZE;
+			for (unsigned i = 0; i < n; ++i) {
+				out[begin + i] = r[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Variant.h>
+
+///type of a value in an IoExpression
+enum IoExpressionType
+{
+	EXPR_NONE,
+	EXPR_INT,
+	EXPR_FLOAT,
+	EXPR_VECTOR3,
+	EXPR_BOOL
+};
+
+///one input column of an IoExpression evaluation:
+///row r of a scalar column is data[r * stride], of a Vector3 column data[r * stride] up to data[r * stride + 2].
+///stride 0 repeats the same value for every row.
+struct IoExpressionColumn
+{
+	const float* data;
+	unsigned stride;
+};
+
+///arithmetic expression that is parsed once into a flat program and then evaluated over whole columns of inputs.
+///understands the subset of the script expression syntax the Maths_Expression family of components is used with:
+///  literals, variables, + - * / %, unary -, < <= > >= == !=, ?:, parentheses, M_PI M_HALF_PI M_DEGTORAD M_RADTODEG M_EPSILON,
+///  true false,
+///  Sin Cos Tan Asin Acos Atan Atan2 (in degrees, like Urho3D), Sqrt Abs Pow Exp Ln Floor Ceil Round Sign Min Max Clamp Lerp,
+///  float(a), int(a), Vector3(x, y, z), v.x v.y v.z v.length v.lengthSquared,
+///  v.Length() v.LengthSquared() v.Normalized() v.DotProduct(u) v.CrossProduct(u).
+///int values are carried as floats and so are exact up to 2^24.
+///comparisons are bool, as in script; bool values only compare with == and != and select with ?:.
+class IoExpression
+{
+public:
+	IoExpression();
+
+	// Compiles source for the variables names, with the given types.
+	// Returns false and describes the problem in error if source is not understood.
+	bool Compile(
+		const Urho3D::String& source,
+		const Urho3D::Vector<Urho3D::String>& names,
+		const Urho3D::PODVector<IoExpressionType>& types,
+		Urho3D::String& error
+	);
+	// true if the last call to Compile was for these arguments, whether it succeeded or not
+	bool IsCompiledFor(
+		const Urho3D::String& source,
+		const Urho3D::Vector<Urho3D::String>& names,
+		const Urho3D::PODVector<IoExpressionType>& types
+	) const;
+	bool IsCompiled() const { return resultType_ != EXPR_NONE; }
+	IoExpressionType GetResultType() const { return resultType_; }
+
+	// EXPR_NONE for the variant types an expression cannot take
+	static IoExpressionType FromVariantType(Urho3D::VariantType type);
+
+	// Evaluates rows 0 up to count, with one entry of columns per variable, in the order passed to Compile.
+	// out receives count floats, or 3 * count (x, y, z interleaved) for an EXPR_VECTOR3 result.
+	// EXPR_BOOL results are 1 for true and 0 for false.
+	// Safe to call concurrently on the same expression.
+	void Evaluate(const Urho3D::PODVector<IoExpressionColumn>& columns, unsigned count, float* out) const;
+
+	struct Instruction
+	{
+		unsigned op;
+		unsigned dst;
+		unsigned a;
+		unsigned b;
+		unsigned c;
+	};
+
+private:
+	Urho3D::PODVector<Instruction> program_;
+	Urho3D::PODVector<float> constants_;
+	unsigned numRegisters_;
+	unsigned resultRegister_;
+	IoExpressionType resultType_;
+
+	Urho3D::String source_;
+	Urho3D::Vector<Urho3D::String> names_;
+	Urho3D::PODVector<IoExpressionType> types_;
+};
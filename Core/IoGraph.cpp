@@ -26,7 +26,13 @@
 #include <memory>
 #include <vector>
 
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+
 #include "IndexUtilities.h"
+#include "NetworkUtilities.h"
 
 using namespace Urho3D;
 
@@ -39,6 +45,57 @@ using namespace Urho3D;
 // top_nbr is a vector of ints representing vertex index. 
 // top_nbr[i] is the index of the vertex with topological sort number i
 bool  IoGraph::IsAcyclic(Vector<int>& top_nbr) const
+{
+	Vector<unsigned> offsets;
+	Vector<unsigned> children;
+	BuildAdjacency(offsets, children);
+
+	return TopologicalSort(offsets, children, top_nbr);
+}
+
+void IoGraph::BuildAdjacency(Vector<unsigned>& offsets, Vector<unsigned>& children) const
+{
+	unsigned n = components_.Size();
+
+	offsets.Resize(n + 1);
+	children.Clear();
+
+	// lastParent[c] == i + 1 once c has been recorded as a child of i, so that each child is listed once
+	Vector<unsigned> lastParent(n);
+	for (unsigned i = 0; i < n; ++i)
+		lastParent[i] = 0;
+
+	for (unsigned i = 0; i < n; ++i)
+	{
+		offsets[i] = children.Size();
+
+		const Vector<SharedPtr<IoOutputSlot> >& outputSlots = components_[i]->outputSlots_;
+		for (unsigned j = 0; j < outputSlots.Size(); ++j)
+		{
+			Vector<SharedPtr<IoInputSlot> > inSlots = outputSlots[j]->GetLinkedInputSlots();
+			for (unsigned k = 0; k < inSlots.Size(); ++k)
+			{
+				// null pointers are not children
+				if (inSlots[k].Null())
+					continue;
+
+				// neither are components that are not part of this graph
+				HashMap<IoComponentBase*, unsigned>::ConstIterator it = componentIndices_.Find(inSlots[k]->GetHomeComponent().Get());
+				if (it == componentIndices_.End())
+					continue;
+
+				unsigned idx = it->second_;
+				if (lastParent[idx] != i + 1) {
+					lastParent[idx] = i + 1;
+					children.Push(idx);
+				}
+			}
+		}
+	}
+	offsets[n] = children.Size();
+}
+
+bool IoGraph::TopologicalSort(const Vector<unsigned>& offsets, const Vector<unsigned>& children, Vector<int>& top_nbr) const
 {
 	// initialize the sorting index
 	int N = 0;
@@ -46,66 +103,41 @@ bool  IoGraph::IsAcyclic(Vector<int>& top_nbr) const
 
 	// in_degrees is a record of the in_degrees of the nodes
 	// we will modify this list, which is why we don't use built-in in-degree info.
-	Vector<int> in_degrees;
+	Vector<int> in_degrees(n);
 	for (int i = 0; i < n; ++i)
-	{
-		in_degrees.Push(components_[i]->ComputeUniqueInDegree());
-	//	std::cout << "component " << i << " has in degree " << in_degrees[i] << std::endl;
-	}
+		in_degrees[i] = 0;
+	for (unsigned j = 0; j < children.Size(); ++j)
+		++in_degrees[children[j]];
 
-	// roots is a list of roots at the current step, 
-	Vector<IoComponentBase*> roots;
+	// roots is a FIFO queue of the vertices whose in-degree has dropped to 0; its front is roots[head]
+	Vector<int> roots;
+	roots.Reserve(n);
+	unsigned head = 0;
 
 	// Add all root vertices to sorted list
 	for (int i = 0; i < n; ++i)
 	{
 		if (in_degrees[i] == 0)
-			roots.Push(components_[i].Get());
+			roots.Push(i);
 	}
 
-	while (!roots.Empty())
+	while (head < roots.Size())
 	{
 		// grab the first vertex in roots list
-		IoComponentBase* firstVert = roots[0];
-
-		// find its index
-		int vertID = -1;
-		for (int i = 0; i < (int)components_.Size(); ++i)
-		{
-			if (firstVert == components_[i].Get())
-				vertID = i;
-		}
+		int vertID = roots[head++];
 
 		// assign current topo_number to this vertex
-		top_nbr.Push(vertID); 
+		top_nbr.Push(vertID);
 		N += 1;
-		// then remove that vertex from the list
-		roots.Erase(roots.Begin());
 
-		// get children of the current root node:
-		Vector<SharedPtr<IoComponentBase> > children = firstVert->GetUniqueComponentsOut();
-	//	std::cout << "children of vertex " << vertID << " are: " << std::endl;
-		for (unsigned j = 0; j < children.Size(); ++j)
+		// deprecate the in-degree of its children, add to roots list
+		for (unsigned j = offsets[vertID]; j < offsets[vertID + 1]; ++j)
 		{
-			// null pointers are not children
-			if (children[j].Null())
-				continue;
-
-			// find indices of the children of the current root node: 
-			int idx = -1;
-			for (int i = 0; i < (int)components_.Size(); ++i)
-			{
-				if (children[j] == components_[i].Get())
-					idx = i;
-			}
-			//std::cout << idx << ", ";
-
-			// deprecate their in-degree, add to roots list
+			int idx = children[j];
 			in_degrees[idx] = in_degrees[idx] - 1;
 			if (in_degrees[idx] == 0)
-				roots.Push(children[j]);
+				roots.Push(idx);
 		}
-		//std::cout << std::endl;
 	}
 	if (N == n) {
 		// the graph contains no directed cycle
@@ -119,41 +151,330 @@ bool  IoGraph::IsAcyclic(Vector<int>& top_nbr) const
 
 
 
+bool IoGraph::UpdateTopologicalOrder()
+{
+	if (
+		topoOrderValid_ &&
+		topoOrderStamp_ == mGetConnectionStamp() &&
+		childOffsets_.Size() == components_.Size() + 1
+		) {
+		return topoOrderAcyclic_;
+	}
+
+	if (componentIndices_.Size() != components_.Size())
+		UpdateComponentIndices();
+
+	BuildAdjacency(childOffsets_, childIndices_);
+
+	Vector<int> top_number;
+	topoOrderAcyclic_ = TopologicalSort(childOffsets_, childIndices_, top_number);
+
+	// level of a component = number of links on its longest upstream path
+	Vector<unsigned> levels(components_.Size());
+	for (unsigned i = 0; i < components_.Size(); ++i)
+		levels[i] = 0;
+	unsigned numLevels = 0;
+	for (unsigned i = 0; i < top_number.Size(); ++i)
+	{
+		int id = top_number[i];
+		for (unsigned j = childOffsets_[id]; j < childOffsets_[id + 1]; ++j) {
+			unsigned child = childIndices_[j];
+			levels[child] = Max(levels[child], levels[id] + 1);
+		}
+		numLevels = Max(numLevels, levels[id] + 1);
+	}
+
+	// stable bucket sort of the topological order by level
+	topoLevelStarts_.Clear();
+	topoLevelStarts_.Resize(numLevels + 1);
+	for (unsigned k = 0; k <= numLevels; ++k)
+		topoLevelStarts_[k] = 0;
+	for (unsigned i = 0; i < top_number.Size(); ++i)
+		++topoLevelStarts_[levels[top_number[i]] + 1];
+	for (unsigned k = 0; k < numLevels; ++k)
+		topoLevelStarts_[k + 1] += topoLevelStarts_[k];
+
+	Vector<unsigned> next = topoLevelStarts_;
+	topoOrder_.Resize(top_number.Size());
+	for (unsigned i = 0; i < top_number.Size(); ++i)
+		topoOrder_[next[levels[top_number[i]]]++] = top_number[i];
+
+	topoOrderStamp_ = mGetConnectionStamp();
+	topoOrderValid_ = true;
+	++topoOrderVersion_;
+
+	return topoOrderAcyclic_;
+}
+
+void IoGraph::SolveComponentWork(const WorkItem* item, unsigned threadIndex)
+{
+	const SolveTask* task = static_cast<const SolveTask*>(item->aux_);
+	task->graph->SolveComponent(task->index, threadIndex);
+}
+
+void IoGraph::SolveComponent(int index, unsigned threadIndex)
+{
+	IoComponentBase* component = components_[index];
+	// components added by another component during the solve are not profiled
+	if (!profiling_ || index >= (int)componentProfiles_.Size()) {
+		component->LocalSolve();
+		return;
+	}
+
+	// each component has its own entry, so concurrent solves never write to the same profile
+	IoComponentProfile& profile = componentProfiles_[index];
+	profile.index = index;
+	profile.threadIndex = threadIndex;
+	profile.numInputItems = 0;
+	profile.inputBytes = 0;
+	for (int i = 0; i < component->GetNumInputs(); ++i) {
+		const IoDataTree& tree = component->GetInputIoDataTree(i);
+		profile.numInputItems += tree.GetNumItems();
+		profile.inputBytes += tree.GetMemoryUse();
+	}
+
+	profile.startUSec = profileTimer_.GetUSec(false);
+	component->LocalSolve();
+	profile.solveUSec = profileTimer_.GetUSec(false) - profile.startUSec;
+
+	profile.solved = component->IsSolved();
+	profile.numInstances = component->GetNumSolveInstances();
+	profile.numOutputItems = 0;
+	profile.outputBytes = 0;
+	for (int i = 0; i < component->GetNumOutputs(); ++i) {
+		const IoDataTree& tree = component->GetOutputIoDataTree(i);
+		profile.numOutputItems += tree.GetNumItems();
+		profile.outputBytes += tree.GetMemoryUse();
+	}
+}
+
+int IoGraph::parallelSolveDepth_ = 0;
+
+void IoGraph::BeginParallelSolve()
+{
+	if (Thread::IsMainThread())
+		++parallelSolveDepth_;
+}
+
+void IoGraph::EndParallelSolve()
+{
+	if (Thread::IsMainThread())
+		--parallelSolveDepth_;
+}
+
+void IoGraph::SolveIndependentComponents(const Vector<int>& indices)
+{
+	WorkQueue* queue = GetSubsystem<WorkQueue>();
+	bool useQueue = parallelSolve_ && queue && queue->GetNumThreads() > 0 && indices.Size() > 1;
+
+	if (profiling_) {
+		for (unsigned i = 0; i < indices.Size(); ++i)
+			profileOrder_.Push(indices[i]);
+	}
+
+	// the work items point into this, so it must not reallocate once they are queued
+	PODVector<SolveTask> tasks(indices.Size());
+	Vector<IoComponentBase*> offloaded;
+	Vector<int> onMainThread;
+	for (unsigned i = 0; i < indices.Size(); ++i)
+	{
+		IoComponentBase* component = components_[indices[i]];
+		component->ClearDirty();
+
+		if (useQueue && !component->IsMainThreadOnly()) {
+			tasks[i].graph = this;
+			tasks[i].index = indices[i];
+
+			SharedPtr<WorkItem> item = queue->GetFreeItem();
+			item->workFunction_ = SolveComponentWork;
+			item->aux_ = &tasks[i];
+			item->priority_ = M_MAX_UNSIGNED;
+			item->sendEvent_ = false;
+			queue->AddWorkItem(item);
+			offloaded.Push(component);
+		}
+		else {
+			onMainThread.Push(indices[i]);
+		}
+	}
+
+	if (!offloaded.Empty()) {
+		// Complete has the main thread run queued items as well, concurrently with the workers, so
+		// events are held back until all of them are done rather than sent from the main thread's items
+		BeginParallelSolve();
+		queue->Complete(M_MAX_UNSIGNED);
+		EndParallelSolve();
+		for (unsigned i = 0; i < offloaded.Size(); ++i) {
+			offloaded[i]->SendDeferredEvents();
+		}
+	}
+
+	// main thread components run once the workers are done, so that scene and UI event
+	// handlers never observe a component that is still being solved
+	for (unsigned i = 0; i < onMainThread.Size(); ++i) {
+		SolveComponent(onMainThread[i], 0);
+	}
+}
+
+void IoGraph::BeginProfile()
+{
+	profileOrder_.Clear();
+	if (!profiling_)
+		return;
+
+	componentProfiles_.Resize(components_.Size());
+	profileTimer_.Reset();
+}
+
+void IoGraph::EndProfile(VariantMap& eventData)
+{
+	if (!profiling_)
+		return;
+
+	profileSolveUSec_ = profileTimer_.GetUSec(false);
+
+	Vector<IoComponentProfile> solveProfile = GetSolveProfile();
+	VariantVector profile;
+	for (unsigned i = 0; i < solveProfile.Size(); ++i)
+	{
+		const IoComponentProfile& p = solveProfile[i];
+		VariantMap entry;
+		entry["index"] = p.index;
+		entry["start"] = (double)p.startUSec;
+		entry["time"] = (double)p.solveUSec;
+		entry["thread"] = p.threadIndex;
+		entry["instances"] = p.numInstances;
+		entry["inputItems"] = p.numInputItems;
+		entry["outputItems"] = p.numOutputItems;
+		entry["inputBytes"] = p.inputBytes;
+		entry["outputBytes"] = p.outputBytes;
+		entry["solved"] = p.solved;
+		profile.Push(entry);
+	}
+
+	eventData["solveTime"] = (double)profileSolveUSec_;
+	eventData["profile"] = profile;
+}
+
+Vector<IoComponentProfile> IoGraph::GetSolveProfile() const
+{
+	Vector<IoComponentProfile> profile;
+	for (unsigned i = 0; i < profileOrder_.Size(); ++i)
+	{
+		if (profileOrder_[i] < (int)componentProfiles_.Size())
+			profile.Push(componentProfiles_[profileOrder_[i]]);
+	}
+
+	return profile;
+}
+
+void IoGraph::ProfileToJSON(JSONValue& root, bool chromeTrace) const
+{
+	Vector<IoComponentProfile> profile = GetSolveProfile();
+
+	JSONArray events;
+	for (unsigned i = 0; i < profile.Size(); ++i)
+	{
+		const IoComponentProfile& p = profile[i];
+		String name = p.index < (int)components_.Size() ? components_[p.index]->GetName() : String::EMPTY;
+
+		JSONValue counts;
+		counts.Set("index", p.index);
+		counts.Set("instances", p.numInstances);
+		counts.Set("inputItems", p.numInputItems);
+		counts.Set("outputItems", p.numOutputItems);
+		counts.Set("inputBytes", p.inputBytes);
+		counts.Set("outputBytes", p.outputBytes);
+		counts.Set("solved", p.solved);
+
+		JSONValue event;
+		event.Set("name", name);
+		if (chromeTrace) {
+			// complete events, timestamps in microseconds; one trace row per solver thread
+			event.Set("ph", "X");
+			event.Set("ts", (double)p.startUSec);
+			event.Set("dur", (double)p.solveUSec);
+			event.Set("pid", 0);
+			event.Set("tid", p.threadIndex);
+			event.Set("args", counts);
+		}
+		else {
+			event.Set("start", (double)p.startUSec);
+			event.Set("time", (double)p.solveUSec);
+			event.Set("thread", p.threadIndex);
+			const JSONObject& fields = counts.GetObject();
+			for (JSONObject::ConstIterator it = fields.Begin(); it != fields.End(); ++it)
+				event.Set(it->first_, it->second_);
+		}
+		events.Push(event);
+	}
+
+	if (chromeTrace) {
+		root.Set("traceEvents", events);
+		root.Set("displayTimeUnit", "ms");
+	}
+	else {
+		root.Set("solveTime", (double)profileSolveUSec_);
+		root.Set("components", events);
+	}
+}
+
+bool IoGraph::SaveProfile(const String& path, bool chromeTrace) const
+{
+	SharedPtr<JSONFile> file(new JSONFile(GetContext()));
+	ProfileToJSON(file->GetRoot(), chromeTrace);
+	if (!file->SaveFile(path)) {
+		URHO3D_LOGERROR("IoGraph::SaveProfile: could not write " + path);
+		return false;
+	}
+
+	return true;
+}
+
 // alternate graph solver
 int IoGraph::TopoSolveGraph()
 {
 	int numSolved = 0;
 	VariantVector solvedIndices;
-	Vector<int> top_number;
-	bool goodToSolve = IsAcyclic(top_number);
+	BeginProfile();
 	// if it contains a cycle, return failure
-	if (!goodToSolve)
+	if (!UpdateTopologicalOrder())
 		return 0;
 
-	// walk through the nodes according to their topological sort index
-	for (unsigned i = 0; i < top_number.Size(); ++i)
+	// copied, since a component may edit the graph while it solves
+	Vector<int> top_number = topoOrder_;
+	Vector<unsigned> levelStarts = topoLevelStarts_;
+
+	// walk through the nodes level by level; the components within a level do not depend on each other
+	for (unsigned k = 0; k + 1 < levelStarts.Size(); ++k)
 	{
 		// Only tries to call LocalSolve if solve is enabled
-		if (components_[top_number[i]]->IsSolveEnabled()) {
-			components_[top_number[i]]->LocalSolve();
+		Vector<int> toSolve;
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i) {
+			if (components_[top_number[i]]->IsSolveEnabled())
+				toSolve.Push(top_number[i]);
+		}
+		SolveIndependentComponents(toSolve);
+
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i)
+		{
+			// Regardless of whether LocalSolve was called,
+			// checks component for input/output consistency
+			// (solveFlag == true if and only if solveFlag_ == 1).
 			bool solveFlag = components_[top_number[i]]->IsSolved();
 			if (solveFlag) {
-				solvedIndices.Push(top_number[i]);
+				++numSolved;
+				if (components_[top_number[i]]->IsSolveEnabled())
+					solvedIndices.Push(top_number[i]);
 			}
 		}
-		// Regardless of whether LocalSolve was called,
-		// checks component for input/output consistency
-		// (solveFlag == true if and only if solveFlag_ == 1).
-		bool solveFlag = components_[top_number[i]]->IsSolved();
-		if (solveFlag) {
-			++numSolved;
-		}
 	}
 
 	//send message that graph has been solved
 	VariantMap data;
 	data["graph"] = this;
 	data["indices"] = solvedIndices;
+	EndProfile(data);
 	SendEvent("OnSolveGraph", data);
 
 	if (numSolved == components_.Size()) {
@@ -166,33 +487,44 @@ int IoGraph::TopoSolveGraph()
 }
 
 // same as TopoSolve, but checks flags and only solves components flagged as unsolved.
+// In incremental mode (the default) this is IncrementalSolveGraph.
 int IoGraph::QuickTopoSolveGraph()
 {
+	if (incrementalSolve_)
+		return IncrementalSolveGraph();
+
 	int numSolved = 0;
 	VariantVector solvedIndices;
-	Vector<int> top_number;
-	bool goodToSolve = IsAcyclic(top_number);
+	BeginProfile();
 	// if it contains a cycle, return failure
-	if (!goodToSolve)
+	if (!UpdateTopologicalOrder())
 		return 0;
 
-	// walk through the nodes according to their topological sort index
-	for (unsigned i = 0; i < top_number.Size(); ++i)
+	Vector<int> top_number = topoOrder_;
+	Vector<unsigned> levelStarts = topoLevelStarts_;
+
+	// walk through the nodes level by level
+	for (unsigned k = 0; k + 1 < levelStarts.Size(); ++k)
 	{
 		// if the component is unsolved and solve is enabled, then solve
-		if (
-			!components_[top_number[i]]->IsSolved() &&
-			components_[top_number[i]]->IsSolveEnabled()
-			) {
-			int solveFlag = components_[top_number[i]]->LocalSolve();
-			if (solveFlag == 1) {
-				++numSolved;
-				solvedIndices.Push(top_number[i]);
+		Vector<int> toSolve;
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i) {
+			if (
+				!components_[top_number[i]]->IsSolved() &&
+				components_[top_number[i]]->IsSolveEnabled()
+				) {
+				toSolve.Push(top_number[i]);
 			}
 		}
-		// otherwise check if component has been solved at previous stage
-		else if (components_[top_number[i]]->IsSolved()) {
-			++numSolved;
+		SolveIndependentComponents(toSolve);
+
+		for (unsigned i = 0; i < toSolve.Size(); ++i) {
+			if (components_[toSolve[i]]->IsSolved())
+				solvedIndices.Push(toSolve[i]);
+		}
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i) {
+			if (components_[top_number[i]]->IsSolved())
+				++numSolved;
 		}
 	}
 
@@ -200,6 +532,7 @@ int IoGraph::QuickTopoSolveGraph()
 	VariantMap data;
 	data["graph"] = this;
 	data["indices"] = solvedIndices;
+	EndProfile(data);
 	SendEvent("OnSolveGraph", data);
 
 	if (numSolved == components_.Size()) 
@@ -208,6 +541,67 @@ int IoGraph::QuickTopoSolveGraph()
 		return 0;
 }
 
+// Re-solves only the components whose inputs changed since the previous solve, and what their new outputs reach.
+// A component is solved when it is flagged dirty (one of its input slots was set to a different tree) or when it
+// is enabled and unsolved: many paths only clear solvedFlag_ (slots added or removed, listeners reacting to UI
+// input), and components that failed last time are retried, as QuickTopoSolveGraph does.
+// Solving transmits the outputs, and an input slot only flags its component dirty when the tree it receives
+// differs from the one it holds, so a component whose outputs came out the same stops the propagation.
+int IoGraph::IncrementalSolveGraph()
+{
+	int numSolved = 0;
+	VariantVector solvedIndices;
+	BeginProfile();
+	// if it contains a cycle, return failure
+	if (!UpdateTopologicalOrder())
+		return 0;
+
+	Vector<int> top_number = topoOrder_;
+	Vector<unsigned> levelStarts = topoLevelStarts_;
+
+	// walk through the nodes level by level: the flags of a level are final once the levels above have solved
+	for (unsigned k = 0; k + 1 < levelStarts.Size(); ++k)
+	{
+		Vector<int> toSolve;
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i) {
+			IoComponentBase* component = components_[top_number[i]];
+			if (!component->IsSolveEnabled()) {
+				// nothing is solved, so nothing changes below it
+				component->ClearDirty();
+			}
+			else if (component->IsDirty() || !component->IsSolved()) {
+				toSolve.Push(top_number[i]);
+			}
+		}
+		SolveIndependentComponents(toSolve);
+
+		for (unsigned i = 0; i < toSolve.Size(); ++i) {
+			if (components_[toSolve[i]]->IsSolved())
+				solvedIndices.Push(toSolve[i]);
+		}
+
+		for (unsigned i = levelStarts[k]; i < levelStarts[k + 1]; ++i)
+		{
+			int id = top_number[i];
+			if (components_[id]->IsSolved()) {
+				++numSolved;
+			}
+		}
+	}
+
+	//send message that graph has been solved
+	VariantMap data;
+	data["graph"] = this;
+	data["indices"] = solvedIndices;
+	EndProfile(data);
+	SendEvent("OnSolveGraph", data);
+
+	if (numSolved == components_.Size())
+		return 1;
+	else
+		return 0;
+}
+
 
 //////////////////////////////////////////////////////////////////
 
@@ -217,7 +611,9 @@ void IoGraph::AddNewComponent()
 {
 	SharedPtr<IoComponentBase> nodePtr(new IoComponentBase(GetContext(), 2, 1)); // 2 inputs, 1 output by default (following Grasshopper)
 	components_.Push(nodePtr);
+	componentIndices_[nodePtr.Get()] = components_.Size() - 1;
 	rootFlags_.Push(true);
+	topoOrderValid_ = false;
 }
 
 // assumption is that this should be a newly constructed node, so all connections are deleted just in case it isn't
@@ -226,7 +622,9 @@ void IoGraph::AddNewComponent(SharedPtr<IoComponentBase> component)
 	//component->DisconnectAllChildren();
 	//component->DisconnectAllParents();
 	components_.Push(component);
+	componentIndices_[component.Get()] = components_.Size() - 1;
 	rootFlags_.Push(true);
+	topoOrderValid_ = false;
 }
 
 void IoGraph::AddConnection(
@@ -272,6 +670,11 @@ void IoGraph::DeleteComponent(int index)
 
 	components_.Erase(components_.Begin() + index);
 	rootFlags_.Erase(rootFlags_.Begin() + index);
+	topoOrderValid_ = false;
+
+	// every component after index has shifted down by one
+	UpdateComponentIndices();
+	idIndices_.Clear();
 
 	// ALERT: there may be new roots now. 
 	UpdateRoots();
@@ -284,7 +687,26 @@ void IoGraph::Clear()
 		components_[i]->UnsubscribeFromAllEvents();
 	}
 	components_.Clear();
+	componentIndices_.Clear();
+	idIndices_.Clear();
 	rootFlags_.Clear();
+	topoOrderValid_ = false;
+}
+
+void IoGraph::UpdateComponentIndices()
+{
+	componentIndices_.Clear();
+	for (unsigned i = 0; i < components_.Size(); ++i)
+		componentIndices_[components_[i].Get()] = i;
+}
+
+int IoGraph::GetComponentIndex(IoComponentBase* component) const
+{
+	HashMap<IoComponentBase*, unsigned>::ConstIterator it = componentIndices_.Find(component);
+	if (it == componentIndices_.End())
+		return -1;
+
+	return (int)it->second_;
 }
 
 void IoGraph::AddInputSlotToComponent(int component)
@@ -427,7 +849,7 @@ int IoGraph::SolveGraph()
 void IoGraph::SetInputIoDataTree(
 	int componentIndex,
 	int inputIndex,
-	IoDataTree ioDataTree
+	const IoDataTree& ioDataTree
 	)
 {
 	components_[componentIndex]->InputHardSet(inputIndex, ioDataTree);
@@ -469,11 +891,17 @@ SharedPtr<IoComponentBase> IoGraph::GetComponentPtr(int index)
 
 int IoGraph::GetComponentIndex(String ID)
 {
+	// IDs are public and may be reassigned, so the cached index is only a hint
+	HashMap<String, unsigned>::Iterator it = idIndices_.Find(ID);
+	if (it != idIndices_.End() && it->second_ < components_.Size() && components_[it->second_]->ID == ID)
+		return (int)it->second_;
+
 	for (int i = 0; i < (int)components_.Size(); i++)
 	{
 		if (components_[i]->ID == ID)
 		{
-			return i;;
+			idIndices_[ID] = i;
+			return i;
 		}
 	}
 
@@ -482,15 +910,7 @@ int IoGraph::GetComponentIndex(String ID)
 
 int IoGraph::GetComponent(String ID)
 {
-	for (int i = 0; i < (int)components_.Size(); i++)
-	{
-		if (components_[i]->ID == ID)
-		{
-			return i;
-		}
-	}
-
-	return -1;
+	return GetComponentIndex(ID);
 }
 
 
@@ -507,13 +927,9 @@ Vector<unsigned> IoGraph::GetDownstreamComponentIndices(unsigned i) const
 	// for each unique downstream component,
 	// look up what its index is in IoGraph::components_ and Push that index to downIndices
 	for (unsigned i = 0; i < downstreamComps.Size(); ++i) {
-		SharedPtr<IoComponentBase> downComp = downstreamComps[i];
-		for (unsigned j = 0; j < components_.Size(); ++j) {
-			if (downComp == components_[j]) {
-				downIndices.Push(j);
-				break;
-			}
-		}
+		HashMap<IoComponentBase*, unsigned>::ConstIterator it = componentIndices_.Find(downstreamComps[i].Get());
+		if (it != componentIndices_.End())
+			downIndices.Push(it->second_);
 	}
 
 	if (downIndices.Size() != downstreamComps.Size()) {
@@ -521,4 +937,68 @@ Vector<unsigned> IoGraph::GetDownstreamComponentIndices(unsigned i) const
 	}
 
 	return downIndices;
-}
\ No newline at end of file
+}
+
+Vector<int> IoGraph::GetSubgraphOrder(unsigned first, unsigned last)
+{
+	Vector<int> order;
+	if (!UpdateTopologicalOrder() || first >= components_.Size() || last >= components_.Size())
+		return order;
+
+	// walking the topological order forwards marks what first reaches,
+	// walking it backwards marks what reaches last
+	Vector<bool> fromFirst(components_.Size());
+	Vector<bool> toLast(components_.Size());
+	for (unsigned i = 0; i < components_.Size(); ++i)
+	{
+		fromFirst[i] = i == first;
+		toLast[i] = i == last;
+	}
+
+	for (unsigned i = 0; i < topoOrder_.Size(); ++i)
+	{
+		int id = topoOrder_[i];
+		if (!fromFirst[id])
+			continue;
+		for (unsigned j = childOffsets_[id]; j < childOffsets_[id + 1]; ++j)
+			fromFirst[childIndices_[j]] = true;
+	}
+
+	for (unsigned i = topoOrder_.Size(); i-- > 0;)
+	{
+		int id = topoOrder_[i];
+		for (unsigned j = childOffsets_[id]; j < childOffsets_[id + 1] && !toLast[id]; ++j)
+			toLast[id] = toLast[childIndices_[j]];
+	}
+
+	if (!fromFirst[last])
+		return order;
+
+	for (unsigned i = 0; i < topoOrder_.Size(); ++i)
+	{
+		int id = topoOrder_[i];
+		if (fromFirst[id] && toLast[id])
+			order.Push(id);
+	}
+
+	return order;
+}
+
+int IoGraph::SolveComponents(const Vector<int>& order)
+{
+	int numSolved = 0;
+	for (unsigned i = 0; i < order.Size(); ++i)
+	{
+		IoComponentBase* component = components_[order[i]];
+		if (!component->IsSolveEnabled())
+			continue;
+
+		component->ClearDirty();
+		component->LocalSolve();
+
+		if (component->IsSolved())
+			++numSolved;
+	}
+
+	return numSolved;
+}
@@ -26,8 +26,34 @@
 #include <memory>
 #include <vector>
 
+#include <Urho3D/Core/Timer.h>
+
 #include "IoComponentBase.h"
 
+namespace Urho3D
+{
+	class JSONValue;
+	struct WorkItem;
+}
+
+///what one component cost in one graph solve (see IoGraph::SetProfiling)
+struct IoComponentProfile
+{
+	int index;
+	// microseconds from the start of the graph solve to the start of LocalSolve, and its duration
+	long long startUSec;
+	long long solveUSec;
+	// 0 for the main thread, otherwise the index of the WorkQueue thread it was solved on
+	unsigned threadIndex;
+	unsigned numInstances;
+	unsigned numInputItems;
+	unsigned numOutputItems;
+	// see IoDataTree::GetMemoryUse
+	unsigned inputBytes;
+	unsigned outputBytes;
+	bool solved;
+};
+
 class URHO3D_API IoGraph : public Urho3D::Object
 {
 	URHO3D_OBJECT(IoGraph, Urho3D::Object)
@@ -36,10 +62,71 @@ private:
 	Urho3D::Vector<Urho3D::SharedPtr<IoComponentBase> > components_;
 	Urho3D::Vector<bool> rootFlags_;
 
-	
+	// index of each component in components_, kept up to date by AddNewComponent, DeleteComponent and Clear
+	Urho3D::HashMap<IoComponentBase*, unsigned> componentIndices_;
+	// index of each component by ID; IDs may be assigned after a component is added, so this is only a hint
+	mutable Urho3D::HashMap<Urho3D::String, unsigned> idIndices_;
+
+	// topological order and downstream indices, cached until the connectivity changes.
+	// topoOrder_ is sorted by level: topoOrder_[topoLevelStarts_[k]] up to topoOrder_[topoLevelStarts_[k + 1]]
+	// are the components whose longest upstream path has k links, so they never depend on each other.
+	Urho3D::Vector<int> topoOrder_;
+	Urho3D::Vector<unsigned> topoLevelStarts_;
+	// children of component i (unique) are childIndices_[childOffsets_[i]] up to childIndices_[childOffsets_[i + 1]]
+	Urho3D::Vector<unsigned> childOffsets_;
+	Urho3D::Vector<unsigned> childIndices_;
+	bool topoOrderValid_;
+	bool topoOrderAcyclic_;
+	unsigned topoOrderStamp_;
+	// incremented every time the cached order is rebuilt
+	unsigned topoOrderVersion_;
+
+	// when true, QuickTopoSolveGraph only re-solves components downstream of a change
+	bool incrementalSolve_;
+
+	// when true, independent components are solved concurrently on the WorkQueue threads
+	bool parallelSolve_;
+	// see IsSolvingInParallel; only the main thread changes or reads it
+	static int parallelSolveDepth_;
+
+	// when true, solves record an IoComponentProfile for every component they solve
+	bool profiling_;
+	Urho3D::HiresTimer profileTimer_;
+	long long profileSolveUSec_;
+	// indexed by component; only the entries listed in profileOrder_ belong to the last solve
+	Urho3D::Vector<IoComponentProfile> componentProfiles_;
+	Urho3D::Vector<int> profileOrder_;
+
+	void BeginProfile();
+	// adds the profile to the OnSolveGraph event data
+	void EndProfile(Urho3D::VariantMap& eventData);
+
+	// Solves components that do not depend on each other. Components not flagged main thread only
+	// are spread over the WorkQueue threads when parallel solving is enabled.
+	void SolveIndependentComponents(const Urho3D::Vector<int>& indices);
+	// LocalSolve of one component, profiled when profiling is enabled
+	void SolveComponent(int index, unsigned threadIndex);
+	struct SolveTask
+	{
+		IoGraph* graph;
+		int index;
+	};
+	static void SolveComponentWork(const Urho3D::WorkItem* item, unsigned threadIndex);
+
+	// Builds compressed child lists (see childOffsets_) in O(V + E).
+	void BuildAdjacency(Urho3D::Vector<unsigned>& offsets, Urho3D::Vector<unsigned>& children) const;
+	// Kahn's algorithm over compressed child lists, O(V + E).
+	bool TopologicalSort(
+		const Urho3D::Vector<unsigned>& offsets,
+		const Urho3D::Vector<unsigned>& children,
+		Urho3D::Vector<int>& top_nbr
+	) const;
+	void UpdateComponentIndices();
 
 public:
-	IoGraph(Urho3D::Context* context) : Urho3D::Object(context), components_(0), rootFlags_(0) {};
+	IoGraph(Urho3D::Context* context) : Urho3D::Object(context), components_(0), rootFlags_(0),
+		topoOrderValid_(false), topoOrderAcyclic_(false), topoOrderStamp_(0), topoOrderVersion_(0), incrementalSolve_(true), parallelSolve_(false),
+		profiling_(false), profileSolveUSec_(0) {};
 
 	//pointer to current scene
 	Urho3D::Scene* scene;
@@ -62,6 +149,7 @@ public:
 
 	Urho3D::SharedPtr<IoComponentBase> GetComponentPtr(int index);
 	int GetComponentIndex(Urho3D::String ID);
+	int GetComponentIndex(IoComponentBase* component) const;
 
 	void AddConnection(
 		int parentIndex,
@@ -80,7 +168,7 @@ public:
 	void SetInputIoDataTree(
 		int componentIndex,
 		int inputIndex,
-		IoDataTree ioDataTree
+		const IoDataTree& ioDataTree
 	);
 
 	unsigned GetOutputIoDataTree(
@@ -104,6 +192,46 @@ public:
 	int TopoSolveGraph();
 	int QuickTopoSolveGraph();
 	int QuickSolveGraph();
+	int IncrementalSolveGraph();
+
+	void SetIncrementalSolve(bool enable) { incrementalSolve_ = enable; }
+	bool GetIncrementalSolve() const { return incrementalSolve_; }
+	void SetParallelSolve(bool enable) { parallelSolve_ = enable; }
+	bool GetParallelSolve() const { return parallelSolve_; }
+	// True while the main thread is inside WorkQueue::Complete for a parallel solve. The main thread runs
+	// queued items there too, so components solved meanwhile defer their events like the workers do.
+	static bool IsSolvingInParallel() { return parallelSolveDepth_ > 0; }
+	// Brackets a WorkQueue::Complete that solves components; only counts on the main thread.
+	static void BeginParallelSolve();
+	static void EndParallelSolve();
+
+	// When enabled, TopoSolveGraph and QuickTopoSolveGraph time every component they solve and count
+	// its instances, items and bytes. The OnSolveGraph event then also carries "solveTime" (microseconds)
+	// and "profile", a list with one VariantMap per solved component.
+	void SetProfiling(bool enable) { profiling_ = enable; }
+	bool GetProfiling() const { return profiling_; }
+	// profiles of the components solved by the last profiled solve, in the order they were started
+	Urho3D::Vector<IoComponentProfile> GetSolveProfile() const;
+	long long GetSolveTime() const { return profileSolveUSec_; }
+	// writes the last profile as a report, or in the Chrome trace event format (chrome://tracing)
+	void ProfileToJSON(Urho3D::JSONValue& root, bool chromeTrace) const;
+	bool SaveProfile(const Urho3D::String& path, bool chromeTrace) const;
 
 	bool IsAcyclic(Urho3D::Vector<int>& top_nbr) const;
+
+	// Rebuilds the cached topological order if components or links changed since it was computed.
+	// Returns false if the graph contains a cycle.
+	bool UpdateTopologicalOrder();
+	void InvalidateTopologicalOrder() { topoOrderValid_ = false; }
+	const Urho3D::Vector<int>& GetTopologicalOrder() { UpdateTopologicalOrder(); return topoOrder_; }
+	// Changes whenever the cached order is rebuilt, i.e. whenever component indices or links may have changed.
+	// Lets callers cache orders and index lists derived from the graph.
+	unsigned GetTopologicalOrderVersion() { UpdateTopologicalOrder(); return topoOrderVersion_; }
+
+	// Indices of the components that are downstream of first and upstream of last, both included, in topological order.
+	// Empty if last is not downstream of first, or if the graph contains a cycle.
+	Urho3D::Vector<int> GetSubgraphOrder(unsigned first, unsigned last);
+	// Solves the components in order, one after the other, outside of a whole graph solve.
+	// order must be topologically sorted, e.g. by GetSubgraphOrder. Returns the number of components solved.
+	int SolveComponents(const Urho3D::Vector<int>& order);
 };
\ No newline at end of file
@@ -38,17 +38,23 @@ IoInputSlot::IoInputSlot(Urho3D::Context* context, Urho3D::SharedPtr<IoComponent
 {
 }
 
-void IoInputSlot::HardSet(IoDataTree ioDataTree)
+void IoInputSlot::HardSet(const IoDataTree& ioDataTree)
 {
 	::mDisconnect(Urho3D::SharedPtr<IoInputSlot>(this));
 	ioDataTree_ = ioDataTree;
 	homeComponent_->solvedFlag_ = 0;
+	homeComponent_->dirtyFlag_ = 1;
 }
 
-void IoInputSlot::SoftSet(IoDataTree ioDataTree)
+void IoInputSlot::SoftSet(const IoDataTree& ioDataTree)
 {
+	// the same data again leaves the component as it is, so that solves stop where outputs did not change
+	if (ioDataTree_.HasSameContent(ioDataTree))
+		return;
+
 	ioDataTree_ = ioDataTree;
 	homeComponent_->solvedFlag_ = 0;
+	homeComponent_->dirtyFlag_ = 1;
 }
 
 // Depends on defaultValue_ having been set (or uses default defaultValue_).
@@ -57,6 +63,7 @@ void IoInputSlot::DefaultSet()
 {
 	ioDataTree_ = IoDataTree(GetContext(), defaultValue_);
 	homeComponent_->solvedFlag_ = 0;
+	homeComponent_->dirtyFlag_ = 1;
 }
 
 void IoInputSlot::Lose()
@@ -64,6 +71,7 @@ void IoInputSlot::Lose()
 	::mDisconnect(Urho3D::SharedPtr<IoInputSlot>(this));
 	ioDataTree_ = IoDataTree(GetContext(), defaultValue_);
 	homeComponent_->solvedFlag_ = 0;
+	homeComponent_->dirtyFlag_ = 1;
 }
 
 IoDataTree* IoInputSlot::GetIoDataTreePtr()
@@ -82,13 +82,13 @@ public:
 	Urho3D::SharedPtr<IoComponentBase> const GetHomeComponent() { return homeComponent_; }
 	Urho3D::SharedPtr<IoOutputSlot> const GetLinkedOutputSlot() { return linkedOutputSlot_; }
 
-	void HardSet(IoDataTree ioDataTree);
-	void SoftSet(IoDataTree ioDataTree);
+	void HardSet(const IoDataTree& ioDataTree);
+	void SoftSet(const IoDataTree& ioDataTree);
 	void DefaultSet();
 	void Lose();
 
 	IoDataTree* GetIoDataTreePtr();
-	IoDataTree GetIoDataTree() const { return ioDataTree_; }
+	const IoDataTree& GetIoDataTree() const { return ioDataTree_; }
 	bool HasNoData() const { return ioDataTree_.IsEmptyTree(); }
 
 	DataAccess GetDataAccess() const { return dataAccess_; }
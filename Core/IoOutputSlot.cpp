@@ -34,7 +34,7 @@ Urho3D::SharedPtr<IoInputSlot> IoOutputSlot::GetLinkedInputSlot(unsigned index)
 	return linkedInputSlots_[index];
 }
 
-void IoOutputSlot::SetIoDataTree(IoDataTree ioDataTree)
+void IoOutputSlot::SetIoDataTree(const IoDataTree& ioDataTree)
 {
 	ioDataTree_ = ioDataTree;
 	Transmit();
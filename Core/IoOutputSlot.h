@@ -78,8 +78,9 @@ public:
 	Urho3D::Vector<Urho3D::SharedPtr<IoInputSlot> > GetLinkedInputSlots() const { return linkedInputSlots_; }
 	unsigned GetNumLinkedInputSlots() const { return linkedInputSlots_.Size(); }
 	Urho3D::SharedPtr<IoInputSlot> GetLinkedInputSlot(unsigned index) const;
-	IoDataTree GetIoDataTree() const { return ioDataTree_; }
-	void SetIoDataTree(IoDataTree ioDataTree);
+	// the published tree; linked input slots share its storage until either side modifies it
+	const IoDataTree& GetIoDataTree() const { return ioDataTree_; }
+	void SetIoDataTree(const IoDataTree& ioDataTree);
 
 	void Transmit();
 	void Transmit(Urho3D::SharedPtr<IoInputSlot> in);
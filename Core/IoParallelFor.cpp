@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "IoParallelFor.h"
+
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Core/WorkQueue.h>
+
+using namespace Urho3D;
+
+namespace {
+
+struct ParallelRange
+{
+	void(*func)(void* data, unsigned begin, unsigned end);
+	void* data;
+	unsigned begin;
+	unsigned end;
+};
+
+void ParallelRangeWork(const WorkItem* item, unsigned threadIndex)
+{
+	const ParallelRange* range = reinterpret_cast<const ParallelRange*>(item->aux_);
+	range->func(range->data, range->begin, range->end);
+}
+
+}
+
+void IoParallelFor(
+	Urho3D::WorkQueue* queue,
+	unsigned count,
+	void(*func)(void* data, unsigned begin, unsigned end),
+	void* data,
+	unsigned minCount
+)
+{
+	// the main thread also runs queued items while inside WorkQueue::Complete; a nested Complete
+	// from one of those would wait on the item it is running
+	if (!queue || queue->GetNumThreads() == 0 || count < Max(minCount, 2u) ||
+		!Thread::IsMainThread() || queue->IsCompleting()) {
+		func(data, 0, count);
+		return;
+	}
+
+	// a few ranges per thread, so that uneven costs even out
+	unsigned numRanges = Min(count, (queue->GetNumThreads() + 1) * 4);
+	PODVector<ParallelRange> ranges(numRanges);
+	for (unsigned i = 0; i < numRanges; ++i) {
+		ranges[i].func = func;
+		ranges[i].data = data;
+		ranges[i].begin = (unsigned)((unsigned long long)count * i / numRanges);
+		ranges[i].end = (unsigned)((unsigned long long)count * (i + 1) / numRanges);
+
+		SharedPtr<WorkItem> item = queue->GetFreeItem();
+		item->workFunction_ = ParallelRangeWork;
+		item->aux_ = &ranges[i];
+		item->priority_ = M_MAX_UNSIGNED;
+		item->sendEvent_ = false;
+		queue->AddWorkItem(item);
+	}
+
+	queue->Complete(M_MAX_UNSIGNED);
+}
@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+namespace Urho3D {
+class WorkQueue;
+}
+
+// Calls func(data, begin, end) on consecutive ranges covering [0, count).
+// The ranges are spread over the worker threads of queue when it has any and this is called from the
+// main thread outside of another WorkQueue::Complete; otherwise, or when count is below minCount,
+// func is called once on the whole range.
+// func must be safe to run concurrently on disjoint ranges.
+// The default minCount suits cheap per-index work; callers with costly items (e.g. whole solve
+// instances) pass a lower one.
+void IoParallelFor(
+	Urho3D::WorkQueue* queue,
+	unsigned count,
+	void(*func)(void* data, unsigned begin, unsigned end),
+	void* data,
+	unsigned minCount = 256
+);
@@ -22,7 +22,10 @@
 
 #include "IoSerialization.h"
 #include "IoScriptInstance.h"
+#include <Urho3D/IO/Compression.h>
 #include <Urho3D/IO/File.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
 
 using namespace Urho3D;
 
@@ -35,6 +38,326 @@ IoGraph* IoSerialization::currentGraph_;
 /////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////
 
+// Binary graphs: the file ID, format version and flags, followed by the payload (LZ4 compressed when
+// flagged): the string table, the graph description in the same layout as the JSON "graph" value,
+// and the unlinked input trees, which the description refers to by "input_tree_block" index.
+namespace
+{
+	const String BINARY_GRAPH_ID("IOGB");
+	const unsigned BINARY_GRAPH_VERSION = 2;
+	const unsigned BINARY_GRAPH_COMPRESSED = 1;
+
+	//how a data tree item is stored
+	enum BinaryItemTag
+	{
+		ITEM_VARIANT = 0,	//Serializer::WriteVariant
+		ITEM_LIST,			//count, then the items
+		ITEM_MAP,			//count, then pairs of key hash and item
+		ITEM_FLOATS,		//count, then raw floats
+		ITEM_INTS,			//count, then raw ints
+		ITEM_VECTOR3S,		//count, then raw x, y, z floats
+		ITEM_TRIMESH		//written and read by the registered MeshCodec (version 2)
+	};
+
+	IoSerialization::MeshCodec meshCodec = { 0, 0, 0 };
+
+	//every string is stored once, and referred to by index
+	struct StringTable
+	{
+		HashMap<String, unsigned> indices_;
+		Vector<String> strings_;
+
+		unsigned Add(const String& str)
+		{
+			HashMap<String, unsigned>::ConstIterator it = indices_.Find(str);
+			if (it != indices_.End())
+				return it->second_;
+
+			indices_[str] = strings_.Size();
+			strings_.Push(str);
+			return strings_.Size() - 1;
+		}
+	};
+
+	//true if a count read from the stream can be backed by the bytes that are left
+	bool CountFits(Deserializer& source, unsigned count, unsigned bytesPerElement)
+	{
+		return (unsigned long long)count * bytesPerElement <= source.GetSize() - source.GetPosition();
+	}
+
+	void WriteJSON(Serializer& dest, const JSONValue& val, StringTable& strings)
+	{
+		dest.WriteUByte((unsigned char)val.GetValueType());
+		switch (val.GetValueType())
+		{
+		case JSON_BOOL:
+			dest.WriteBool(val.GetBool());
+			break;
+		case JSON_NUMBER:
+			dest.WriteDouble(val.GetDouble());
+			break;
+		case JSON_STRING:
+			dest.WriteVLE(strings.Add(val.GetString()));
+			break;
+		case JSON_ARRAY:
+		{
+			const JSONArray& arr = val.GetArray();
+			dest.WriteVLE(arr.Size());
+			for (unsigned i = 0; i < arr.Size(); ++i)
+				WriteJSON(dest, arr[i], strings);
+			break;
+		}
+		case JSON_OBJECT:
+		{
+			const JSONObject& obj = val.GetObject();
+			dest.WriteVLE(obj.Size());
+			for (JSONObject::ConstIterator it = obj.Begin(); it != obj.End(); ++it)
+			{
+				dest.WriteVLE(strings.Add(it->first_));
+				WriteJSON(dest, it->second_, strings);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	bool ReadJSON(Deserializer& source, const Vector<String>& strings, JSONValue& val)
+	{
+		unsigned char type = source.ReadUByte();
+		switch (type)
+		{
+		case JSON_NULL:
+			val = JSONValue();
+			return true;
+		case JSON_BOOL:
+			val = source.ReadBool();
+			return true;
+		case JSON_NUMBER:
+			val = source.ReadDouble();
+			return true;
+		case JSON_STRING:
+		{
+			unsigned index = source.ReadVLE();
+			if (index >= strings.Size())
+				return false;
+			val = strings[index];
+			return true;
+		}
+		case JSON_ARRAY:
+		{
+			unsigned count = source.ReadVLE();
+			if (!CountFits(source, count, 1))
+				return false;
+			JSONArray arr(count);
+			for (unsigned i = 0; i < count; ++i)
+			{
+				if (!ReadJSON(source, strings, arr[i]))
+					return false;
+			}
+			val = arr;
+			return true;
+		}
+		case JSON_OBJECT:
+		{
+			unsigned count = source.ReadVLE();
+			if (!CountFits(source, count, 2))
+				return false;
+			JSONObject obj;
+			for (unsigned i = 0; i < count; ++i)
+			{
+				unsigned index = source.ReadVLE();
+				if (index >= strings.Size() || !ReadJSON(source, strings, obj[strings[index]]))
+					return false;
+			}
+			val = obj;
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	void WriteItem(Serializer& dest, const Variant& var);
+
+	//lists of floats, ints or vectors, e.g. point clouds and mesh vertices, are written as raw blocks
+	void WriteItems(Serializer& dest, const VariantVector& items)
+	{
+		VariantType type = items.Empty() ? VAR_NONE : items[0].GetType();
+		for (unsigned i = 1; i < items.Size() && type != VAR_NONE; ++i)
+		{
+			if (items[i].GetType() != type)
+				type = VAR_NONE;
+		}
+
+		if (type == VAR_FLOAT || type == VAR_INT)
+		{
+			//floats and ints have the same size
+			PODVector<int> raw(items.Size());
+			for (unsigned i = 0; i < items.Size(); ++i)
+			{
+				if (type == VAR_FLOAT)
+				{
+					float f = items[i].GetFloat();
+					memcpy(&raw[i], &f, sizeof(float));
+				}
+				else
+					raw[i] = items[i].GetInt();
+			}
+
+			dest.WriteUByte(type == VAR_FLOAT ? ITEM_FLOATS : ITEM_INTS);
+			dest.WriteVLE(items.Size());
+			dest.Write(raw.Buffer(), raw.Size() * sizeof(int));
+		}
+		else if (type == VAR_VECTOR3)
+		{
+			PODVector<Vector3> raw(items.Size());
+			for (unsigned i = 0; i < items.Size(); ++i)
+				raw[i] = items[i].GetVector3();
+
+			dest.WriteUByte(ITEM_VECTOR3S);
+			dest.WriteVLE(items.Size());
+			dest.Write(raw.Buffer(), raw.Size() * sizeof(Vector3));
+		}
+		else
+		{
+			dest.WriteUByte(ITEM_LIST);
+			dest.WriteVLE(items.Size());
+			for (unsigned i = 0; i < items.Size(); ++i)
+				WriteItem(dest, items[i]);
+		}
+	}
+
+	void WriteItem(Serializer& dest, const Variant& var)
+	{
+		if (var.GetType() == VAR_VARIANTVECTOR)
+		{
+			WriteItems(dest, var.GetVariantVector());
+		}
+		else if (meshCodec.isMesh && meshCodec.isMesh(var))
+		{
+			dest.WriteUByte(ITEM_TRIMESH);
+			meshCodec.write(dest, var, WriteItem);
+		}
+		else if (var.GetType() == VAR_VARIANTMAP)
+		{
+			const VariantMap& map = var.GetVariantMap();
+			dest.WriteUByte(ITEM_MAP);
+			dest.WriteVLE(map.Size());
+			for (VariantMap::ConstIterator it = map.Begin(); it != map.End(); ++it)
+			{
+				dest.WriteStringHash(it->first_);
+				WriteItem(dest, it->second_);
+			}
+		}
+		else
+		{
+			dest.WriteUByte(ITEM_VARIANT);
+			dest.WriteVariant(var);
+		}
+	}
+
+	bool ReadItem(Deserializer& source, Variant& var);
+
+	//reads a list of items whose tag has already been read
+	bool ReadItems(Deserializer& source, unsigned char tag, VariantVector& items)
+	{
+		unsigned count = source.ReadVLE();
+		switch (tag)
+		{
+		case ITEM_FLOATS:
+		case ITEM_INTS:
+		{
+			if (!CountFits(source, count, sizeof(int)))
+				return false;
+
+			PODVector<int> raw(count);
+			source.Read(raw.Buffer(), count * sizeof(int));
+			items.Resize(count);
+			for (unsigned i = 0; i < count; ++i)
+			{
+				if (tag == ITEM_FLOATS)
+				{
+					float f;
+					memcpy(&f, &raw[i], sizeof(float));
+					items[i] = f;
+				}
+				else
+					items[i] = raw[i];
+			}
+			return true;
+		}
+		case ITEM_VECTOR3S:
+		{
+			if (!CountFits(source, count, sizeof(Vector3)))
+				return false;
+
+			PODVector<Vector3> raw(count);
+			source.Read(raw.Buffer(), count * sizeof(Vector3));
+			items.Resize(count);
+			for (unsigned i = 0; i < count; ++i)
+				items[i] = raw[i];
+			return true;
+		}
+		case ITEM_LIST:
+		{
+			if (!CountFits(source, count, 1))
+				return false;
+
+			items.Resize(count);
+			for (unsigned i = 0; i < count; ++i)
+			{
+				if (!ReadItem(source, items[i]))
+					return false;
+			}
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	bool ReadItem(Deserializer& source, Variant& var)
+	{
+		unsigned char tag = source.ReadUByte();
+		if (tag == ITEM_VARIANT)
+		{
+			var = source.ReadVariant();
+			return true;
+		}
+
+		if (tag == ITEM_TRIMESH)
+			return meshCodec.read && meshCodec.read(source, var, ReadItem);
+
+		if (tag == ITEM_MAP)
+		{
+			unsigned count = source.ReadVLE();
+			if (!CountFits(source, count, 5))
+				return false;
+
+			VariantMap map;
+			for (unsigned i = 0; i < count; ++i)
+			{
+				StringHash key = source.ReadStringHash();
+				if (!ReadItem(source, map[key]))
+					return false;
+			}
+			var = map;
+			return true;
+		}
+
+		VariantVector list;
+		if (!ReadItems(source, tag, list))
+			return false;
+		var = list;
+		return true;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////
+
 void IoSerialization::SaveGraph(IoGraph const & graph, String path)
 {
 	//track the context
@@ -49,7 +372,20 @@ void IoSerialization::SaveGraph(IoGraph const & graph, String path)
 
 	//create json value for the graph
 	JSONValue graphVal;
+	WriteGraph(graph, graphVal, NULL);
+
+	//push the graph to the root object
+	rootElem.Set("graph", graphVal);
+
+	//write to json file
+	json->Save(*dest, "\t");
+
+	//flush stream
+	dest->Close();
+}
 
+void IoSerialization::WriteGraph(IoGraph const & graph, JSONValue& graphVal, Vector<IoDataTree>* trees)
+{
 	//add components
 	JSONValue compVal;
 	JSONArray compArray;
@@ -104,11 +440,18 @@ void IoSerialization::SaveGraph(IoGraph const & graph, String path)
 				slotVal.Set("linked_component", "");
 				slotVal.Set("linked_slot_index", -1);
 
-				//store input data tree
-				JSONValue treeVal;
-				SaveDataTree(slot->ioDataTree_, treeVal);
-
-				slotVal.Set("input_tree", treeVal);
+				//store input data tree, in the binary format as a separate block
+				if (trees)
+				{
+					slotVal.Set("input_tree_block", trees->Size());
+					trees->Push(slot->ioDataTree_);
+				}
+				else
+				{
+					JSONValue treeVal;
+					SaveDataTree(slot->ioDataTree_, treeVal);
+					slotVal.Set("input_tree", treeVal);
+				}
 			}
 
 			//push to array
@@ -162,15 +505,6 @@ void IoSerialization::SaveGraph(IoGraph const & graph, String path)
 
 	//push the component array to the root
 	graphVal.Set("components", compArray);
-
-	//push the graph to the root object
-	rootElem.Set("graph", graphVal);
-
-	//write to json file
-	json->Save(*dest, "\t");
-
-	//flush stream
-	dest->Close();
 }
 
 void IoSerialization::LoadGraph(IoGraph & graph, File* source)
@@ -186,21 +520,46 @@ void IoSerialization::LoadGraph(IoGraph & graph, File* source)
 		return;
 	}
 
-	//create the json file
+	//binary graphs carry their input trees separately
 	SharedPtr<JSONFile> json(new JSONFile(context_));
+	JSONValue binaryGraphVal;
+	Vector<IoDataTree> trees;
+	const JSONValue* graphVal = &binaryGraphVal;
 
-	//load file in to json
-	json->Load(*source);
-
-	//get the graph
-	const JSONValue& graphVal = json->GetRoot().Get("graph");
+	if (source->ReadFileID() == BINARY_GRAPH_ID)
+	{
+		if (!ReadGraphBinary(*source, binaryGraphVal, trees))
+		{
+			URHO3D_LOGERROR("could not read binary graph: " + source->GetName());
+			source->Close();
+			return;
+		}
+	}
+	else
+	{
+		//load file in to json
+		source->Seek(0);
+		json->Load(*source);
+		graphVal = &json->GetRoot().Get("graph");
+	}
 
-	if (graphVal.IsNull())
+	if (graphVal->IsNull())
 	{
 		URHO3D_LOGINFO("could not load graph at path");
 		return;
 	}
 
+	LoadGraph(graph, *graphVal, trees);
+
+	//close the file
+	source->Close();
+
+	//init calcs
+	graph.UpdateRoots();
+}
+
+void IoSerialization::LoadGraph(IoGraph & graph, const JSONValue& graphVal, const Vector<IoDataTree>& trees)
+{
 	//loop through the components array to instantiate
 	const JSONArray& compArray = graphVal.Get("components").GetArray();
 	Vector<Pair<int, int>> loadedCompID;
@@ -342,9 +701,17 @@ void IoSerialization::LoadGraph(IoGraph & graph, File* source)
 			if (linkedIndex == -1)
 			{
 				//set the value from file
-				const JSONValue inTreeVal = inputs[j].Get("input_tree");
 				IoDataTree inTree(context_);
-				LoadDataTree(inTree, inTreeVal);
+				const JSONValue& blockVal = inputs[j].Get("input_tree_block");
+				if (blockVal.IsNumber() && blockVal.GetUInt() < trees.Size())
+				{
+					inTree = trees[blockVal.GetUInt()];
+				}
+				else
+				{
+					const JSONValue inTreeVal = inputs[j].Get("input_tree");
+					LoadDataTree(inTree, inTreeVal);
+				}
 				Vector<int> path = inTree.Begin();
 				if (path.Size() > 0)
 				{
@@ -371,12 +738,6 @@ void IoSerialization::LoadGraph(IoGraph & graph, File* source)
 			}
 		}
 	}
-
-	//close the file
-	source->Close();
-
-	//init calcs
-	graph.UpdateRoots();
 }
 
 void IoSerialization::LoadGraph(IoGraph & graph, String path)
@@ -399,16 +760,15 @@ void IoSerialization::SaveDataTree(IoDataTree& tree, JSONValue& treeVal)
 {
 	//create branches array
 	JSONArray branchArr;
-	HashMap<String, IoBranch*>::ConstIterator itr;
-	for (itr = tree.branches_.Begin(); itr != tree.branches_.End(); itr++)
+	for (int b = 0; b < tree.GetNumBranches(); b++)
 	{
 		JSONValue bVal;
 		JSONArray bItems;
-		int numItems = itr->second_->data.Size();
+		int numItems = tree.GetNumItemsInBranch(b);
 		for (int i = 0; i < numItems; i++)
 		{
 			//TODO: only store basic types
-			Variant var = itr->second_->data[i];
+			const Variant& var = tree.GetBranchItem(b, i);
 
 			if (var.GetType() == VAR_VARIANTVECTOR || var.GetType() == VAR_VARIANTMAP)
 				continue;
@@ -422,7 +782,7 @@ void IoSerialization::SaveDataTree(IoDataTree& tree, JSONValue& treeVal)
 
 		}
 
-		bVal.Set("path", itr->first_);
+		bVal.Set("path", tree.PathToUniqueString(tree.GetBranchPath(b)));
 		bVal.Set("items", bItems);
 		branchArr.Push(bVal);
 	}
@@ -490,4 +850,158 @@ void IoSerialization::LoadMetaData(HashMap<String, Pair<String, Variant>>& data,
 		Pair<String, Variant> p(keyName, val);
 		data[keyName] = p;
 	}
-}
\ No newline at end of file
+}
+
+void IoSerialization::SaveGraphBinary(IoGraph const & graph, String path, bool compress)
+{
+	//track the context
+	context_ = graph.GetContext();
+
+	JSONValue graphVal;
+	Vector<IoDataTree> trees;
+	WriteGraph(graph, graphVal, &trees);
+
+	//the string table is complete only once the rest has been written
+	StringTable strings;
+	VectorBuffer body;
+	WriteJSON(body, graphVal, strings);
+	body.WriteVLE(trees.Size());
+	for (unsigned i = 0; i < trees.Size(); i++)
+	{
+		WriteDataTree(trees[i], body);
+	}
+
+	VectorBuffer payload;
+	payload.WriteVLE(strings.strings_.Size());
+	for (unsigned i = 0; i < strings.strings_.Size(); i++)
+	{
+		payload.WriteString(strings.strings_[i]);
+	}
+	payload.Write(body.GetData(), body.GetSize());
+
+	File dest(context_, path, FileMode::FILE_WRITE);
+	if (!dest.IsOpen())
+	{
+		URHO3D_LOGERROR("could not write file at path: " + path);
+		return;
+	}
+
+	dest.WriteFileID(BINARY_GRAPH_ID);
+	dest.WriteUInt(BINARY_GRAPH_VERSION);
+	dest.WriteUInt(compress ? BINARY_GRAPH_COMPRESSED : 0);
+	if (compress)
+	{
+		payload.Seek(0);
+		CompressStream(dest, payload);
+	}
+	else
+	{
+		dest.Write(payload.GetData(), payload.GetSize());
+	}
+
+	dest.Close();
+}
+
+bool IoSerialization::ReadGraphBinary(Deserializer& source, JSONValue& graphVal, Vector<IoDataTree>& trees)
+{
+	unsigned version = source.ReadUInt();
+	unsigned flags = source.ReadUInt();
+	if (version > BINARY_GRAPH_VERSION)
+	{
+		URHO3D_LOGERROR("unsupported binary graph version: " + String(version));
+		return false;
+	}
+
+	//read the payload in one go and decode it from memory
+	VectorBuffer payload;
+	if (flags & BINARY_GRAPH_COMPRESSED)
+	{
+		if (!DecompressStream(payload, source))
+			return false;
+		payload.Seek(0);
+	}
+	else
+	{
+		payload.SetData(source, source.GetSize() - source.GetPosition());
+	}
+
+	unsigned numStrings = payload.ReadVLE();
+	if (!CountFits(payload, numStrings, 1))
+		return false;
+
+	Vector<String> strings(numStrings);
+	for (unsigned i = 0; i < numStrings; i++)
+	{
+		strings[i] = payload.ReadString();
+	}
+
+	if (!ReadJSON(payload, strings, graphVal))
+		return false;
+
+	unsigned numTrees = payload.ReadVLE();
+	if (!CountFits(payload, numTrees, 1))
+		return false;
+
+	for (unsigned i = 0; i < numTrees; i++)
+	{
+		IoDataTree tree(context_);
+		if (!ReadDataTree(tree, payload))
+			return false;
+		trees.Push(tree);
+	}
+
+	return true;
+}
+
+void IoSerialization::SetMeshCodec(const MeshCodec& codec)
+{
+	meshCodec = codec;
+}
+
+void IoSerialization::WriteDataTree(const IoDataTree& tree, Serializer& dest)
+{
+	dest.WriteVLE(tree.GetNumBranches());
+	for (int b = 0; b < tree.GetNumBranches(); b++)
+	{
+		Vector<int> path = tree.GetBranchPath(b);
+		dest.WriteVLE(path.Size());
+		for (unsigned i = 0; i < path.Size(); i++)
+		{
+			dest.WriteInt(path[i]);
+		}
+
+		VariantVector items(tree.GetNumItemsInBranch(b));
+		for (unsigned i = 0; i < items.Size(); i++)
+		{
+			items[i] = tree.GetBranchItem(b, i);
+		}
+		WriteItems(dest, items);
+	}
+}
+
+bool IoSerialization::ReadDataTree(IoDataTree& tree, Deserializer& source)
+{
+	unsigned numBranches = source.ReadVLE();
+	if (!CountFits(source, numBranches, 2))
+		return false;
+
+	for (unsigned b = 0; b < numBranches; b++)
+	{
+		unsigned pathSize = source.ReadVLE();
+		if (!CountFits(source, pathSize, sizeof(int)))
+			return false;
+
+		Vector<int> path(pathSize);
+		for (unsigned i = 0; i < pathSize; i++)
+		{
+			path[i] = source.ReadInt();
+		}
+
+		VariantVector items;
+		if (!ReadItems(source, source.ReadUByte(), items))
+			return false;
+		tree.Add(path, items);
+	}
+
+	return true;
+}
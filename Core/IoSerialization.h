@@ -22,25 +22,58 @@
 
 #pragma once
 
+#include <Urho3D/IO/Deserializer.h>
+#include <Urho3D/IO/Serializer.h>
+
 #include "IoGraph.h"
 #include "IoComponentBase.h"
 #include "IoDataTree.h"
 
 class IoSerialization
 {
+public:
+	//write or read one binary data tree item, e.g. a mesh label list
+	typedef void(*ItemWriter)(Urho3D::Serializer& dest, const Urho3D::Variant& var);
+	typedef bool(*ItemReader)(Urho3D::Deserializer& source, Urho3D::Variant& var);
+
+	//binary encoding of meshes that keep their vertices and faces in a custom typed Variant, which
+	//WriteVariant cannot write; registered by the geometry library (see TriMesh_RegisterSerialization)
+	struct MeshCodec
+	{
+		//true when var is written by write
+		bool(*isMesh)(const Urho3D::Variant& var);
+		//writes the mesh after its item tag; nested items go through writeItem
+		void(*write)(Urho3D::Serializer& dest, const Urho3D::Variant& var, ItemWriter writeItem);
+		//reads a mesh written by write; nested items go through readItem
+		bool(*read)(Urho3D::Deserializer& source, Urho3D::Variant& var, ItemReader readItem);
+	};
+
 private:
 	static Urho3D::Context* context_;
 	static Urho3D::File* destinaton_;
 
+	//fills graphVal with the JSON description of the graph; when trees is given, unlinked input trees
+	//are collected there instead and referred to by index
+	static void WriteGraph(IoGraph const & graph, Urho3D::JSONValue& graphVal, Urho3D::Vector<IoDataTree>* trees);
+	static void LoadGraph(IoGraph & graph, const Urho3D::JSONValue& graphVal, const Urho3D::Vector<IoDataTree>& trees);
+	static bool ReadGraphBinary(Urho3D::Deserializer& source, Urho3D::JSONValue& graphVal, Urho3D::Vector<IoDataTree>& trees);
+
 public:
 	static IoGraph * currentGraph_;
 	static void SaveGraph(IoGraph const & graph, Urho3D::String path);
 	static void LoadGraph(IoGraph & graph, Urho3D::String path);
 	static void LoadGraph(IoGraph & graph, Urho3D::File* file);
+	//compact binary graph file, with geometry stored as raw float and int blocks; LoadGraph reads both formats
+	static void SaveGraphBinary(IoGraph const & graph, Urho3D::String path, bool compress = true);
 	static void SetContext(Urho3D::Context* context) { context_ = context; };
 	static Urho3D::Context* GetContext() { return context_; };
 	static void SaveDataTree(IoDataTree& tree, Urho3D::JSONValue& treeVal);
 	static void LoadDataTree(IoDataTree& tree, const Urho3D::JSONValue& treeVal);
+	//binary data trees; unlike the JSON trees these keep lists and maps, e.g. meshes
+	static void WriteDataTree(const IoDataTree& tree, Urho3D::Serializer& dest);
+	static bool ReadDataTree(IoDataTree& tree, Urho3D::Deserializer& source);
+	//without a codec, meshes are written as plain maps and mesh items in binary files fail to read
+	static void SetMeshCodec(const MeshCodec& codec);
 	static void SaveMetaData(Urho3D::HashMap<Urho3D::String, Urho3D::Pair<Urho3D::String, Urho3D::Variant>>& data, Urho3D::JSONValue& treeVal);
 	static void LoadMetaData(Urho3D::HashMap<Urho3D::String, Urho3D::Pair<Urho3D::String, Urho3D::Variant>>& data, const Urho3D::JSONValue& treeVal);
 };
\ No newline at end of file
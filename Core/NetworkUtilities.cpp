@@ -24,6 +24,15 @@
 
 #include "IndexUtilities.h"
 
+namespace {
+	unsigned connectionStamp = 0;
+}
+
+unsigned mGetConnectionStamp()
+{
+	return connectionStamp;
+}
+
 void mConnect(
 	Urho3D::SharedPtr<IoOutputSlot> out,
 	Urho3D::SharedPtr<IoInputSlot> in
@@ -40,6 +49,7 @@ void mConnect(
 
 		out->linkedInputSlots_.Push(in);
 		in->linkedOutputSlot_ = out;
+		++connectionStamp;
 
 		in->ioDataTree_ = out->ioDataTree_;
 		out->Transmit(in);
@@ -63,6 +73,7 @@ void mDisconnect(Urho3D::SharedPtr<IoOutputSlot> out)
 			out->linkedInputSlots_[i].Reset(); // do not erase yet, it invalids index positions
 
 			in->linkedOutputSlot_.Reset();
+			++connectionStamp;
 			in->Lose();
 		}
 	}
@@ -114,5 +125,6 @@ void mDisconnect(
 	out->linkedInputSlots_.Erase(indexIntoOut);
 
 	in->linkedOutputSlot_.Reset();
+	++connectionStamp;
 	in->Lose();
 }
@@ -43,4 +43,7 @@ void mDisconnect(
 	Urho3D::SharedPtr<IoOutputSlot> out,
 	int indexIntoOut,
 	Urho3D::SharedPtr<IoInputSlot> in
-);
\ No newline at end of file
+);
+
+// incremented every time a link is made or broken, so cached connectivity data can be checked for staleness
+unsigned mGetConnectionStamp();
\ No newline at end of file
@@ -37,6 +37,8 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/Container/Vector.h>
 
+#include "TriMesh.h"
+
 #pragma warning(disable : 4244)
 
 using Urho3D::Variant;
@@ -243,6 +245,15 @@ bool IglMeshToMatrices(
 	Eigen::MatrixXi& F
 )
 {
+	// meshes made by TriMesh_Make carry packed buffers that were validated on construction
+	if (TriMesh_Verify(mesh)) {
+		ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+		if (data && data->GetNumVertices() > 0 && data->GetNumFaces() > 0) {
+			data->ToMatrices(V, F);
+			return true;
+		}
+	}
+
 	VariantMap meshMap = mesh.GetVariantMap();
 	if (meshMap.Empty()) {
 		// V, F untouched
@@ -356,6 +367,16 @@ bool ExtractMeshData(
 		faceList.Clear();
 		return false;
 	}
+
+	if (TriMesh_Verify(mesh)) {
+		ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+		if (data && data->IsValid()) {
+			vertexList = TriMesh_GetVertexList(mesh);
+			faceList = TriMesh_GetFaceList(mesh);
+			return true;
+		}
+	}
+
 	VariantMap meshMap = mesh.GetVariantMap();
 
 	// extract vertexList
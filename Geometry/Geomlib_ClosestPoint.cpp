@@ -22,12 +22,109 @@
 
 #include "Geomlib_ClosestPoint.h"
 
+#include <algorithm>
+
 #include <Urho3D/Math/Vector3.h>
 
 #include "Geomlib_RayTriangleIntersection.h"
+#include "IoParallelFor.h"
 
+using Urho3D::PODVector;
 using Urho3D::Vector3;
 
+namespace {
+
+// Implicit k-d tree: order[begin, end) is a subtree whose root is the median order[(begin + end) / 2],
+// split along axis[root].
+struct PointCloudTree
+{
+	const Vector3* points;
+	PODVector<unsigned> order;
+	PODVector<unsigned char> axis;
+
+	void Build(unsigned begin, unsigned end)
+	{
+		if (end - begin < 2) {
+			return;
+		}
+
+		Vector3 lo = points[order[begin]];
+		Vector3 hi = lo;
+		for (unsigned i = begin + 1; i < end; ++i) {
+			const Vector3& p = points[order[i]];
+			lo = Vector3(Urho3D::Min(lo.x_, p.x_), Urho3D::Min(lo.y_, p.y_), Urho3D::Min(lo.z_, p.z_));
+			hi = Vector3(Urho3D::Max(hi.x_, p.x_), Urho3D::Max(hi.y_, p.y_), Urho3D::Max(hi.z_, p.z_));
+		}
+		Vector3 ext = hi - lo;
+		unsigned char a = ext.x_ >= ext.y_ ? (ext.x_ >= ext.z_ ? 0 : 2) : (ext.y_ >= ext.z_ ? 1 : 2);
+
+		unsigned mid = (begin + end) / 2;
+		const Vector3* pts = points;
+		unsigned* ids = &order[0];
+		std::nth_element(ids + begin, ids + mid, ids + end,
+			[pts, a](unsigned i, unsigned j) { return pts[i].Data()[a] < pts[j].Data()[a]; });
+		axis[mid] = a;
+
+		Build(begin, mid);
+		Build(mid + 1, end);
+	}
+
+	void Nearest(unsigned begin, unsigned end, const Vector3& q, int& best, float& bestSqr) const
+	{
+		if (begin >= end) {
+			return;
+		}
+
+		unsigned mid = (begin + end) / 2;
+		unsigned idx = order[mid];
+		float d = (points[idx] - q).LengthSquared();
+		if (d < bestSqr || (d == bestSqr && (int)idx < best)) {
+			bestSqr = d;
+			best = idx;
+		}
+		if (end - begin == 1) {
+			return;
+		}
+
+		unsigned char a = axis[mid];
+		float delta = q.Data()[a] - points[idx].Data()[a];
+		if (delta < 0) {
+			Nearest(begin, mid, q, best, bestSqr);
+			if (delta * delta <= bestSqr) {
+				Nearest(mid + 1, end, q, best, bestSqr);
+			}
+		}
+		else {
+			Nearest(mid + 1, end, q, best, bestSqr);
+			if (delta * delta <= bestSqr) {
+				Nearest(begin, mid, q, best, bestSqr);
+			}
+		}
+	}
+};
+
+struct PointCloudJob
+{
+	const PointCloudTree* tree;
+	const Vector3* queries;
+	int* indices;
+	float* distances;
+};
+
+void PointCloudRange(void* data, unsigned begin, unsigned end)
+{
+	const PointCloudJob* job = static_cast<const PointCloudJob*>(data);
+	for (unsigned i = begin; i < end; ++i) {
+		int best = -1;
+		float bestSqr = Urho3D::M_INFINITY;
+		job->tree->Nearest(0, job->tree->order.Size(), job->queries[i], best, bestSqr);
+		job->indices[i] = best;
+		job->distances[i] = sqrt(bestSqr);
+	}
+}
+
+}
+
 // Returns point on line segment AB closest to query point Q
 // Intended to be crash proof.
 Urho3D::Vector3 Geomlib::SegmentClosestPoint(
@@ -120,4 +217,46 @@ Urho3D::Vector3 Geomlib::TriangleClosestPoint(
 	Vector3 projQ = Q - c * U;
 
 	return TrianglePerimeterClosestPoint(A, B, C, projQ);
-}
\ No newline at end of file
+}
+
+bool Geomlib::PointCloudClosestPoints(
+	const Urho3D::Vector3* cloud,
+	unsigned numPoints,
+	const Urho3D::Vector3* queries,
+	unsigned numQueries,
+	Urho3D::PODVector<int>& indices,
+	Urho3D::PODVector<float>& distances,
+	Urho3D::WorkQueue* queue
+)
+{
+	indices.Clear();
+	distances.Clear();
+	if (numPoints == 0) {
+		return false;
+	}
+
+	indices.Resize(numQueries);
+	distances.Resize(numQueries);
+	if (numQueries == 0) {
+		return true;
+	}
+
+	PointCloudTree tree;
+	tree.points = cloud;
+	tree.order.Resize(numPoints);
+	tree.axis.Resize(numPoints);
+	for (unsigned i = 0; i < numPoints; ++i) {
+		tree.order[i] = i;
+		tree.axis[i] = 0;
+	}
+	tree.Build(0, numPoints);
+
+	PointCloudJob job;
+	job.tree = &tree;
+	job.queries = queries;
+	job.indices = &indices[0];
+	job.distances = &distances[0];
+	IoParallelFor(queue, numQueries, PointCloudRange, &job);
+
+	return true;
+}
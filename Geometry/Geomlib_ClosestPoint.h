@@ -22,8 +22,13 @@
 
 #pragma once
 
+#include <Urho3D/Container/Vector.h>
 #include <Urho3D/Math/Vector3.h>
 
+namespace Urho3D {
+class WorkQueue;
+}
+
 namespace Geomlib {
 	// Returns point on line segment AB closest to query point Q
 	// Intended to be crash proof.
@@ -48,4 +53,19 @@ namespace Geomlib {
 		const Urho3D::Vector3& C,
 		const Urho3D::Vector3& Q
 	);
+
+	// For each query point, finds the closest point in the point cloud.
+	// A k-d tree is built once over the cloud and the queries are answered in parallel
+	// on queue's worker threads when one is given.
+	// Ties go to the lowest index, matching a linear scan.
+	// Outputs are resized to numQueries; returns false if the cloud is empty.
+	bool PointCloudClosestPoints(
+		const Urho3D::Vector3* cloud,
+		unsigned numPoints,
+		const Urho3D::Vector3* queries,
+		unsigned numQueries,
+		Urho3D::PODVector<int>& indices,
+		Urho3D::PODVector<float>& distances,
+		Urho3D::WorkQueue* queue = 0
+	);
 }
\ No newline at end of file
@@ -22,12 +22,23 @@
 
 #include "Geomlib_HausdorffDistance.h"
 
-#pragma warning(push, 0)
-#include <igl/hausdorff.h>
-#pragma warning(pop)
-
-#include "ConversionUtilities.h"
 #include "TriMesh.h"
+#include "TriMeshAABB.h"
+
+namespace {
+// largest distance from a vertex of "from" to the mesh of "to"
+float MaxVertexDistance(const TriMeshData& from, const TriMeshAABB& to)
+{
+	float maxSqDistance = 0.0f;
+	for (unsigned i = 0; i < from.GetNumVertices(); ++i) {
+		int face = -1;
+		Urho3D::Vector3 p;
+		maxSqDistance = Urho3D::Max(maxSqDistance, to.ClosestPoint(from.GetVertex(i), face, p));
+	}
+
+	return sqrt(maxSqDistance);
+}
+}
 
 bool Geomlib::TriMesh_HausdorffDistance(
 	const Urho3D::Variant& mesh1,
@@ -39,13 +50,11 @@ bool Geomlib::TriMesh_HausdorffDistance(
 		return false;
 	}
 
-	Eigen::MatrixXf V1, V2;
-	Eigen::MatrixXi F1, F2;
-	IglMeshToMatrices(mesh1, V1, F1);
-	IglMeshToMatrices(mesh2, V2, F2);
+	// same vertex sampled distance as igl::hausdorff, against the cached trees of both meshes
+	ConstTriMeshDataPtr data1 = TriMesh_GetData(mesh1);
+	ConstTriMeshDataPtr data2 = TriMesh_GetData(mesh2);
 
-	float d = -1.0f;
-	igl::hausdorff(V1, F1, V2, F2, d);
+	float d = Urho3D::Max(MaxVertexDistance(*data1, *data2->GetAABB()), MaxVertexDistance(*data2, *data1->GetAABB()));
 	if (d >= 0.0f) {
 		distance = d;
 		return true;
@@ -0,0 +1,980 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Geomlib_MeshParse.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+
+#include "IoParallelFor.h"
+#include "TriMeshData.h"
+
+using namespace Urho3D;
+
+Geomlib::MappedFile::MappedFile() :
+	data_(0),
+	size_(0),
+	mapped_(false)
+{
+}
+
+Geomlib::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool Geomlib::MappedFile::Open(const String& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(WString(path).CString(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	size_ = (size_t)fileSize.QuadPart;
+
+	if (size_ > 0) {
+		// the view keeps the mapping alive once the handles are closed
+		HANDLE mapping = CreateFileMappingW(file, 0, PAGE_READONLY, 0, 0, 0);
+		if (mapping) {
+			data_ = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	int fd = open(path.CString(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return false;
+	}
+	size_ = (size_t)st.st_size;
+
+	if (size_ > 0) {
+		void* addr = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED) {
+			madvise(addr, size_, MADV_SEQUENTIAL);
+			data_ = (const char*)addr;
+		}
+	}
+	close(fd);
+#endif
+
+	if (size_ == 0) {
+		data_ = "";
+		return true;
+	}
+	if (data_) {
+		mapped_ = true;
+		return true;
+	}
+
+	// could not map, read the whole file instead
+	FILE* file = fopen(path.CString(), "rb");
+	if (!file) {
+		size_ = 0;
+		return false;
+	}
+	buffer_.Resize((unsigned)size_);
+	size_t numRead = fread(&buffer_[0], 1, size_, file);
+	fclose(file);
+	if (numRead != size_) {
+		buffer_.Clear();
+		size_ = 0;
+		return false;
+	}
+	data_ = &buffer_[0];
+	return true;
+}
+
+bool Geomlib::MappedFile::Open(File* source)
+{
+	Close();
+
+	if (!source || !source->IsOpen())
+		return false;
+
+	size_ = source->GetSize() - source->GetPosition();
+	if (size_ == 0) {
+		data_ = "";
+		return true;
+	}
+
+	buffer_.Resize((unsigned)size_);
+	if (source->Read(&buffer_[0], (unsigned)size_) != size_) {
+		Close();
+		return false;
+	}
+	data_ = &buffer_[0];
+	return true;
+}
+
+void Geomlib::MappedFile::Close()
+{
+	if (mapped_) {
+#ifdef _WIN32
+		UnmapViewOfFile(data_);
+#else
+		munmap((void*)data_, size_);
+#endif
+	}
+
+	data_ = 0;
+	size_ = 0;
+	mapped_ = false;
+	buffer_.Clear();
+	buffer_.Compact();
+}
+
+namespace {
+
+const double POW10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool IsBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline const char* SkipBlanks(const char* p, const char* end)
+{
+	while (p < end && IsBlank(*p))
+		++p;
+	return p;
+}
+
+// blanks and line ends, for formats where values may be spread over lines
+inline const char* SkipWhitespace(const char* p, const char* end)
+{
+	while (p < end && (IsBlank(*p) || *p == '\n'))
+		++p;
+	return p;
+}
+
+inline const char* SkipLine(const char* p, const char* end)
+{
+	const char* eol = (const char*)memchr(p, '\n', end - p);
+	return eol ? eol + 1 : end;
+}
+
+// Parses a decimal number such as -12, 0.5 or 1.25e-3 into value. Returns the position after the
+// number, or 0 if there is none. Numbers with more digits than fit in 64 bits, or written as
+// inf or nan, go through strtod.
+const char* ParseDouble(const char* p, const char* end, double& value)
+{
+	const char* start = p;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		++p;
+	}
+
+	unsigned long long mantissa = 0;
+	int numDigits = 0;
+	int exponent = 0;
+	bool anyDigit = false;
+	for (; p < end && IsDigit(*p); ++p) {
+		anyDigit = true;
+		if (numDigits < 19) {
+			mantissa = mantissa * 10 + (*p - '0');
+			if (mantissa)
+				++numDigits;
+		}
+		else
+			++exponent;
+	}
+	if (p < end && *p == '.') {
+		for (++p; p < end && IsDigit(*p); ++p) {
+			anyDigit = true;
+			if (numDigits < 19) {
+				mantissa = mantissa * 10 + (*p - '0');
+				if (mantissa)
+					++numDigits;
+				--exponent;
+			}
+		}
+	}
+
+	if (!anyDigit) {
+		// inf, nan and the like; strtod needs a terminated string
+		char buffer[64];
+		size_t length = 0;
+		for (const char* q = start; q < end && length < sizeof(buffer) - 1 && !IsBlank(*q) && *q != '\n' && *q != '/'; ++q)
+			buffer[length++] = *q;
+		buffer[length] = '\0';
+
+		char* parsedEnd;
+		value = strtod(buffer, &parsedEnd);
+		return parsedEnd == buffer ? 0 : start + (parsedEnd - buffer);
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		const char* q = p + 1;
+		bool negativeExp = false;
+		if (q < end && (*q == '-' || *q == '+')) {
+			negativeExp = *q == '-';
+			++q;
+		}
+		if (q < end && IsDigit(*q)) {
+			int e = 0;
+			for (; q < end && IsDigit(*q); ++q) {
+				if (e < 10000)
+					e = e * 10 + (*q - '0');
+			}
+			exponent += negativeExp ? -e : e;
+			p = q;
+		}
+	}
+
+	double result = (double)mantissa;
+	if (exponent < 0)
+		result = exponent >= -22 ? result / POW10[-exponent] : result * pow(10.0, exponent);
+	else if (exponent > 0)
+		result = exponent <= 22 ? result * POW10[exponent] : result * pow(10.0, exponent);
+
+	value = negative ? -result : result;
+	return p;
+}
+
+inline const char* ParseFloat(const char* p, const char* end, float& value)
+{
+	double d;
+	p = ParseDouble(p, end, d);
+	value = (float)d;
+	return p;
+}
+
+const char* ParseInt(const char* p, const char* end, long long& value)
+{
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		++p;
+	}
+	if (p >= end || !IsDigit(*p))
+		return 0;
+
+	long long result = 0;
+	for (; p < end && IsDigit(*p); ++p)
+		result = result * 10 + (*p - '0');
+
+	value = negative ? -result : result;
+	return p;
+}
+
+// adds polygon as a fan of triangles
+void AddPolygon(const PODVector<int>& polygon, PODVector<int>& faces)
+{
+	for (unsigned i = 1; i + 1 < polygon.Size(); ++i) {
+		faces.Push(polygon[0]);
+		faces.Push(polygon[i]);
+		faces.Push(polygon[i + 1]);
+	}
+}
+
+// Reports progress from several threads; calls are serialized.
+struct ProgressReporter
+{
+	Geomlib::MeshParseProgress callback_;
+	void* data_;
+	unsigned long long done_;
+	unsigned long long total_;
+	Mutex mutex_;
+
+	ProgressReporter(Geomlib::MeshParseProgress callback, void* data, unsigned long long total) :
+		callback_(callback), data_(data), done_(0), total_(total) {}
+
+	void Add(unsigned long long bytes)
+	{
+		if (!callback_)
+			return;
+
+		MutexLock lock(mutex_);
+		done_ += bytes;
+		callback_(data_, done_, total_);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////
+// OBJ
+
+// work per chunk, and per thread at most a few of them at a time
+const size_t OBJ_CHUNK_SIZE = 1 << 18;
+
+struct OBJChunk
+{
+	const char* begin;
+	const char* end;
+	PODVector<float> vertices;
+	PODVector<int> faces;
+	// positions in faces of relative indices, stored relative to the first vertex of the chunk
+	PODVector<unsigned> relative;
+	bool failed;
+};
+
+struct OBJParse
+{
+	OBJChunk* chunks;
+	ProgressReporter* progress;
+};
+
+bool ParseOBJChunk(OBJChunk& chunk)
+{
+	const char* p = chunk.begin;
+	const char* end = chunk.end;
+	PODVector<int> polygon;
+	PODVector<bool> isRelative;
+
+	while (p < end) {
+		p = SkipBlanks(p, end);
+		if (p + 1 < end && p[0] == 'v' && IsBlank(p[1])) {
+			float x[3];
+			p += 2;
+			for (int i = 0; i < 3; ++i) {
+				p = SkipBlanks(p, end);
+				p = ParseFloat(p, end, x[i]);
+				if (!p)
+					return false;
+			}
+			// w, or vertex colors, are skipped
+			chunk.vertices.Push(x[0]);
+			chunk.vertices.Push(x[1]);
+			chunk.vertices.Push(x[2]);
+		}
+		else if (p + 1 < end && p[0] == 'f' && IsBlank(p[1])) {
+			p += 2;
+			polygon.Clear();
+			isRelative.Clear();
+			int numLocalVertices = (int)(chunk.vertices.Size() / 3);
+			while (true) {
+				p = SkipBlanks(p, end);
+				if (p >= end || *p == '\n' || *p == '#')
+					break;
+
+				long long index;
+				p = ParseInt(p, end, index);
+				if (!p || index == 0)
+					return false;
+
+				// relative indices are counted from the end of the chunk's vertices until the chunks are joined
+				polygon.Push(index < 0 ? numLocalVertices + (int)index : (int)(index - 1));
+				isRelative.Push(index < 0);
+
+				// texture coordinate and normal indices
+				while (p < end && !IsBlank(*p) && *p != '\n')
+					++p;
+			}
+			if (polygon.Size() < 3)
+				return false;
+
+			for (unsigned i = 1; i + 1 < polygon.Size(); ++i) {
+				unsigned corners[3] = { 0, i, i + 1 };
+				for (unsigned c = 0; c < 3; ++c) {
+					if (isRelative[corners[c]])
+						chunk.relative.Push(chunk.faces.Size());
+					chunk.faces.Push(polygon[corners[c]]);
+				}
+			}
+		}
+		// comments, vt, vn, groups, materials and anything else
+		p = SkipLine(p, end);
+	}
+
+	return true;
+}
+
+void ParseOBJChunks(void* data, unsigned begin, unsigned end)
+{
+	OBJParse* parse = static_cast<OBJParse*>(data);
+	for (unsigned i = begin; i < end; ++i) {
+		OBJChunk& chunk = parse->chunks[i];
+		chunk.failed = !ParseOBJChunk(chunk);
+		parse->progress->Add(chunk.end - chunk.begin);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// PLY
+
+enum PLYType
+{
+	PLY_NONE = 0,
+	PLY_INT8,
+	PLY_UINT8,
+	PLY_INT16,
+	PLY_UINT16,
+	PLY_INT32,
+	PLY_UINT32,
+	PLY_FLOAT32,
+	PLY_FLOAT64
+};
+
+enum PLYFormat
+{
+	PLY_ASCII,
+	PLY_BINARY_LE,
+	PLY_BINARY_BE
+};
+
+struct PLYProperty
+{
+	String name;
+	PLYType type;
+	// list properties: type of the count, type is that of the items
+	PLYType countType;
+	bool isList;
+};
+
+struct PLYElement
+{
+	String name;
+	unsigned count;
+	Vector<PLYProperty> properties;
+};
+
+PLYType PLYTypeFromName(const String& name)
+{
+	if (name == "char" || name == "int8")
+		return PLY_INT8;
+	if (name == "uchar" || name == "uint8")
+		return PLY_UINT8;
+	if (name == "short" || name == "int16")
+		return PLY_INT16;
+	if (name == "ushort" || name == "uint16")
+		return PLY_UINT16;
+	if (name == "int" || name == "int32")
+		return PLY_INT32;
+	if (name == "uint" || name == "uint32")
+		return PLY_UINT32;
+	if (name == "float" || name == "float32")
+		return PLY_FLOAT32;
+	if (name == "double" || name == "float64")
+		return PLY_FLOAT64;
+	return PLY_NONE;
+}
+
+unsigned PLYTypeSize(PLYType type)
+{
+	switch (type) {
+	case PLY_INT8:
+	case PLY_UINT8:
+		return 1;
+	case PLY_INT16:
+	case PLY_UINT16:
+		return 2;
+	case PLY_INT32:
+	case PLY_UINT32:
+	case PLY_FLOAT32:
+		return 4;
+	case PLY_FLOAT64:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+// Reads one value in the file's format, advancing p. Returns false at the end of the data.
+struct PLYReader
+{
+	const char* p;
+	const char* end;
+	PLYFormat format;
+
+	bool Read(PLYType type, double& value)
+	{
+		if (format == PLY_ASCII) {
+			p = SkipWhitespace(p, end);
+			const char* next = ParseDouble(p, end, value);
+			if (!next)
+				return false;
+			p = next;
+			return true;
+		}
+
+		unsigned size = PLYTypeSize(type);
+		if ((size_t)(end - p) < size)
+			return false;
+
+		unsigned char bytes[8];
+		memcpy(bytes, p, size);
+		p += size;
+		if (format == PLY_BINARY_BE) {
+			for (unsigned i = 0; i < size / 2; ++i) {
+				unsigned char b = bytes[i];
+				bytes[i] = bytes[size - 1 - i];
+				bytes[size - 1 - i] = b;
+			}
+		}
+
+		switch (type) {
+		case PLY_INT8: { signed char v; memcpy(&v, bytes, 1); value = v; break; }
+		case PLY_UINT8: { value = bytes[0]; break; }
+		case PLY_INT16: { short v; memcpy(&v, bytes, 2); value = v; break; }
+		case PLY_UINT16: { unsigned short v; memcpy(&v, bytes, 2); value = v; break; }
+		case PLY_INT32: { int v; memcpy(&v, bytes, 4); value = v; break; }
+		case PLY_UINT32: { unsigned v; memcpy(&v, bytes, 4); value = v; break; }
+		case PLY_FLOAT32: { float v; memcpy(&v, bytes, 4); value = v; break; }
+		case PLY_FLOAT64: { memcpy(&value, bytes, 8); break; }
+		default: return false;
+		}
+		return true;
+	}
+};
+
+bool ParsePLYHeader(const char*& p, const char* end, PLYFormat& format, Vector<PLYElement>& elements)
+{
+	bool haveFormat = false;
+	bool first = true;
+	while (p < end) {
+		const char* lineEnd = SkipLine(p, end);
+		String line(p, (unsigned)(lineEnd - p));
+		p = lineEnd;
+
+		Vector<String> words = line.Trimmed().Split(' ');
+		if (first) {
+			if (words.Empty() || words[0] != "ply")
+				return false;
+			first = false;
+			continue;
+		}
+		if (words.Empty())
+			continue;
+
+		if (words[0] == "end_header")
+			return haveFormat;
+
+		if (words[0] == "format" && words.Size() >= 2) {
+			if (words[1] == "ascii")
+				format = PLY_ASCII;
+			else if (words[1] == "binary_little_endian")
+				format = PLY_BINARY_LE;
+			else if (words[1] == "binary_big_endian")
+				format = PLY_BINARY_BE;
+			else
+				return false;
+			haveFormat = true;
+		}
+		else if (words[0] == "element" && words.Size() >= 3) {
+			PLYElement element;
+			element.name = words[1];
+			element.count = ToUInt(words[2]);
+			elements.Push(element);
+		}
+		else if (words[0] == "property" && !elements.Empty()) {
+			PLYProperty property;
+			if (words.Size() >= 5 && words[1] == "list") {
+				property.isList = true;
+				property.countType = PLYTypeFromName(words[2]);
+				property.type = PLYTypeFromName(words[3]);
+				property.name = words[4];
+			}
+			else if (words.Size() >= 3) {
+				property.isList = false;
+				property.countType = PLY_NONE;
+				property.type = PLYTypeFromName(words[1]);
+				property.name = words[2];
+			}
+			else
+				return false;
+
+			if (property.type == PLY_NONE || (property.isList && property.countType == PLY_NONE))
+				return false;
+			elements.Back().properties.Push(property);
+		}
+		// comment, obj_info
+	}
+
+	return false;
+}
+
+// fixed size little endian records with float x, y, z, the common case for binary files
+bool ReadPLYVerticesFast(PLYReader& reader, const PLYElement& element, PODVector<float>& vertices)
+{
+	if (reader.format != PLY_BINARY_LE)
+		return false;
+
+	unsigned stride = 0;
+	int offsets[3] = { -1, -1, -1 };
+	const char* names[3] = { "x", "y", "z" };
+	for (unsigned i = 0; i < element.properties.Size(); ++i) {
+		const PLYProperty& property = element.properties[i];
+		if (property.isList)
+			return false;
+		for (unsigned c = 0; c < 3; ++c) {
+			if (property.name == names[c]) {
+				if (property.type != PLY_FLOAT32)
+					return false;
+				offsets[c] = (int)stride;
+			}
+		}
+		stride += PLYTypeSize(property.type);
+	}
+	if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0)
+		return false;
+	if ((size_t)(reader.end - reader.p) < (size_t)stride * element.count)
+		return false;
+
+	vertices.Resize(3 * element.count);
+	float* out = element.count ? &vertices[0] : 0;
+	const char* record = reader.p;
+	for (unsigned v = 0; v < element.count; ++v, record += stride) {
+		for (unsigned c = 0; c < 3; ++c)
+			memcpy(&out[3 * v + c], record + offsets[c], sizeof(float));
+	}
+	reader.p = record;
+	return true;
+}
+
+// faces with only a uchar count and int indices in little endian, again the common case
+bool ReadPLYFacesFast(PLYReader& reader, const PLYElement& element, PODVector<int>& faces)
+{
+	if (reader.format != PLY_BINARY_LE || element.properties.Size() != 1)
+		return false;
+
+	const PLYProperty& property = element.properties[0];
+	if (!property.isList || property.countType != PLY_UINT8 ||
+		(property.type != PLY_INT32 && property.type != PLY_UINT32))
+		return false;
+
+	unsigned numFaceIndices = faces.Size();
+	faces.Reserve(numFaceIndices + 3 * element.count);
+	const char* p = reader.p;
+	int polygon[256];
+	for (unsigned n = 0; n < element.count; ++n) {
+		unsigned count = p < reader.end ? (unsigned char)*p++ : 0;
+		if (count == 0 || (size_t)(reader.end - p) < 4 * count) {
+			// let the general reader report it
+			faces.Resize(numFaceIndices);
+			return false;
+		}
+
+		memcpy(polygon, p, 4 * count);
+		p += 4 * count;
+		for (unsigned i = 1; i + 1 < count; ++i) {
+			faces.Push(polygon[0]);
+			faces.Push(polygon[i]);
+			faces.Push(polygon[i + 1]);
+		}
+	}
+	reader.p = p;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////
+// STL
+
+bool ParseSTLBinary(const char* data, size_t size, TriMeshData& mesh)
+{
+	unsigned numTriangles;
+	memcpy(&numTriangles, data + 80, 4);
+	if (84 + (size_t)numTriangles * 50 > size)
+		return false;
+
+	PODVector<float>& vertices = mesh.GetVertices();
+	PODVector<int>& faces = mesh.GetFaces();
+	vertices.Resize(9 * numTriangles);
+	faces.Resize(3 * numTriangles);
+
+	// 12 bytes normal, 36 bytes corners, 2 bytes attributes
+	const char* record = data + 84;
+	for (unsigned t = 0; t < numTriangles; ++t, record += 50) {
+		memcpy(&vertices[9 * t], record + 12, 36);
+		faces[3 * t] = 3 * t;
+		faces[3 * t + 1] = 3 * t + 1;
+		faces[3 * t + 2] = 3 * t + 2;
+	}
+	return true;
+}
+
+bool ParseSTLAscii(const char* data, size_t size, TriMeshData& mesh)
+{
+	PODVector<float>& vertices = mesh.GetVertices();
+	PODVector<int>& faces = mesh.GetFaces();
+
+	const char* p = data;
+	const char* end = data + size;
+	while (p < end) {
+		p = SkipBlanks(p, end);
+		if ((size_t)(end - p) > 6 && memcmp(p, "vertex", 6) == 0 && IsBlank(p[6])) {
+			p += 6;
+			for (int c = 0; c < 3; ++c) {
+				float x;
+				p = SkipBlanks(p, end);
+				p = ParseFloat(p, end, x);
+				if (!p)
+					return false;
+				vertices.Push(x);
+			}
+		}
+		p = SkipLine(p, end);
+	}
+
+	if (vertices.Size() % 9 != 0)
+		return false;
+
+	unsigned numVertices = vertices.Size() / 3;
+	faces.Resize(numVertices);
+	for (unsigned i = 0; i < numVertices; ++i)
+		faces[i] = (int)i;
+	return true;
+}
+
+}
+
+void Geomlib::LogMeshParseProgress(void* data, unsigned long long done, unsigned long long total)
+{
+	MeshParseLog* log = static_cast<MeshParseLog*>(data);
+	if (total < (64 << 20) || !log)
+		return;
+
+	int tenths = (int)(10 * done / total);
+	if (tenths > log->tenthsLogged) {
+		log->tenthsLogged = tenths;
+		URHO3D_LOGINFO(String(log->name) + " --- read " + String(10 * tenths) + "%");
+	}
+}
+
+bool Geomlib::ParseOBJ(
+	const char* data, size_t size,
+	TriMeshData& mesh,
+	WorkQueue* queue,
+	MeshParseProgress progress, void* progressData
+)
+{
+	// chunks start at line starts
+	PODVector<const char*> starts;
+	starts.Push(data);
+	const char* end = data + size;
+	for (size_t next = OBJ_CHUNK_SIZE; next < size; next += OBJ_CHUNK_SIZE) {
+		const char* p = data + next;
+		if (p <= starts.Back())
+			continue;
+		p = SkipLine(p - 1, end);
+		if (p < end && p > starts.Back())
+			starts.Push(p);
+	}
+
+	unsigned numChunks = starts.Size();
+	Vector<OBJChunk> chunks(numChunks);
+	for (unsigned i = 0; i < numChunks; ++i) {
+		chunks[i].begin = starts[i];
+		chunks[i].end = i + 1 < numChunks ? starts[i + 1] : end;
+		chunks[i].failed = false;
+	}
+
+	ProgressReporter reporter(progress, progressData, size);
+	OBJParse parse = { &chunks[0], &reporter };
+	IoParallelFor(queue, numChunks, ParseOBJChunks, &parse);
+
+	unsigned numVertices = 0;
+	unsigned numFaceIndices = 0;
+	for (unsigned i = 0; i < numChunks; ++i) {
+		if (chunks[i].failed)
+			return false;
+		numVertices += chunks[i].vertices.Size();
+		numFaceIndices += chunks[i].faces.Size();
+	}
+
+	// concatenate, releasing each chunk once it has been copied
+	PODVector<float>& vertices = mesh.GetVertices();
+	PODVector<int>& faces = mesh.GetFaces();
+	vertices.Resize(numVertices);
+	faces.Resize(numFaceIndices);
+	unsigned vertexOffset = 0;
+	unsigned faceOffset = 0;
+	for (unsigned i = 0; i < numChunks; ++i) {
+		OBJChunk& chunk = chunks[i];
+		if (!chunk.vertices.Empty())
+			memcpy(&vertices[vertexOffset], &chunk.vertices[0], chunk.vertices.Size() * sizeof(float));
+		if (!chunk.faces.Empty())
+			memcpy(&faces[faceOffset], &chunk.faces[0], chunk.faces.Size() * sizeof(int));
+
+		int firstVertex = (int)(vertexOffset / 3);
+		for (unsigned j = 0; j < chunk.relative.Size(); ++j)
+			faces[faceOffset + chunk.relative[j]] += firstVertex;
+
+		vertexOffset += chunk.vertices.Size();
+		faceOffset += chunk.faces.Size();
+
+		chunk.vertices.Clear();
+		chunk.vertices.Compact();
+		chunk.faces.Clear();
+		chunk.faces.Compact();
+	}
+
+	return mesh.GetNumFaces() > 0;
+}
+
+bool Geomlib::ParsePLY(
+	const char* data, size_t size,
+	TriMeshData& mesh,
+	MeshParseProgress progress, void* progressData
+)
+{
+	PLYReader reader;
+	reader.p = data;
+	reader.end = data + size;
+	reader.format = PLY_ASCII;
+
+	Vector<PLYElement> elements;
+	if (!ParsePLYHeader(reader.p, reader.end, reader.format, elements))
+		return false;
+
+	ProgressReporter reporter(progress, progressData, size);
+	PODVector<float>& vertices = mesh.GetVertices();
+	PODVector<int>& faces = mesh.GetFaces();
+	PODVector<int> polygon;
+
+	for (unsigned e = 0; e < elements.Size(); ++e) {
+		const PLYElement& element = elements[e];
+		const char* elementStart = reader.p;
+		bool isVertex = element.name == "vertex";
+		bool isFace = element.name == "face";
+
+		if ((isVertex && ReadPLYVerticesFast(reader, element, vertices)) ||
+			(isFace && ReadPLYFacesFast(reader, element, faces))) {
+			reporter.Add(reader.p - elementStart);
+			continue;
+		}
+
+		if (isVertex)
+			vertices.Reserve(3 * element.count);
+		if (isFace)
+			faces.Reserve(3 * element.count);
+
+		for (unsigned n = 0; n < element.count; ++n) {
+			float vertex[3] = { 0.0f, 0.0f, 0.0f };
+			for (unsigned i = 0; i < element.properties.Size(); ++i) {
+				const PLYProperty& property = element.properties[i];
+				double value;
+				if (!property.isList) {
+					if (!reader.Read(property.type, value))
+						return false;
+					if (isVertex) {
+						if (property.name == "x")
+							vertex[0] = (float)value;
+						else if (property.name == "y")
+							vertex[1] = (float)value;
+						else if (property.name == "z")
+							vertex[2] = (float)value;
+					}
+					continue;
+				}
+
+				double count;
+				if (!reader.Read(property.countType, count) || count < 0)
+					return false;
+				bool isIndices = isFace && (property.name == "vertex_indices" || property.name == "vertex_index");
+				polygon.Clear();
+				for (unsigned k = 0; k < (unsigned)count; ++k) {
+					if (!reader.Read(property.type, value))
+						return false;
+					if (isIndices)
+						polygon.Push((int)value);
+				}
+				if (isIndices)
+					AddPolygon(polygon, faces);
+			}
+
+			if (isVertex) {
+				vertices.Push(vertex[0]);
+				vertices.Push(vertex[1]);
+				vertices.Push(vertex[2]);
+			}
+		}
+		reporter.Add(reader.p - elementStart);
+	}
+
+	return mesh.GetNumFaces() > 0;
+}
+
+bool Geomlib::ParseSTL(
+	const char* data, size_t size,
+	TriMeshData& mesh,
+	MeshParseProgress progress, void* progressData
+)
+{
+	// binary files may also start with "solid", so the size decides
+	bool binary = false;
+	if (size >= 84) {
+		unsigned numTriangles;
+		memcpy(&numTriangles, data + 80, 4);
+		binary = 84 + (size_t)numTriangles * 50 == size;
+	}
+	if (!binary && (size < 5 || memcmp(data, "solid", 5) != 0))
+		binary = size >= 84;
+
+	bool success = binary ? ParseSTLBinary(data, size, mesh) : ParseSTLAscii(data, size, mesh);
+
+	ProgressReporter reporter(progress, progressData, size);
+	reporter.Add(size);
+
+	return success && mesh.GetNumFaces() > 0;
+}
+
+void Geomlib::ConvertToYUp(TriMeshData& mesh)
+{
+	PODVector<float>& vertices = mesh.GetVertices();
+	for (unsigned i = 0; i + 2 < vertices.Size(); i += 3) {
+		float y = vertices[i + 1];
+		vertices[i + 1] = vertices[i + 2];
+		vertices[i + 2] = -y;
+	}
+}
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <stddef.h>
+
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Container/Vector.h>
+
+namespace Urho3D {
+class File;
+class WorkQueue;
+}
+
+class TriMeshData;
+
+namespace Geomlib {
+
+	// Called with the number of bytes parsed so far and the total. When the parse is spread over
+	// worker threads it is called from those threads, one call at a time.
+	typedef void(*MeshParseProgress)(void* data, unsigned long long done, unsigned long long total);
+
+	// MeshParseProgress that logs every tenth of files of 64 MB or more, as "<name> --- read 30%"
+	struct MeshParseLog
+	{
+		const char* name;
+		int tenthsLogged;
+	};
+	void LogMeshParseProgress(void* data, unsigned long long done, unsigned long long total);
+
+	// Read-only view of a whole file. Files on disk are memory-mapped, so parsing them does not
+	// first copy them into memory; files from packages are read into a buffer.
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		bool Open(const Urho3D::String& path);
+		bool Open(Urho3D::File* source);
+		void Close();
+
+		const char* GetData() const { return data_; }
+		size_t GetSize() const { return size_; }
+
+	private:
+		MappedFile(const MappedFile&);
+		void operator=(const MappedFile&);
+
+		const char* data_;
+		size_t size_;
+		bool mapped_;
+		Urho3D::PODVector<char> buffer_;
+	};
+
+	// Parsers for mesh files in memory. Polygons are split into triangle fans; texture coordinates,
+	// normals and colors in the file are skipped. mesh receives the vertices and faces, the normals
+	// are left to TriMesh_Make.
+
+	// OBJ: v and f lines, including negative (relative) indices. Large files are split into chunks
+	// at line boundaries that are parsed on queue's worker threads.
+	bool ParseOBJ(
+		const char* data, size_t size,
+		TriMeshData& mesh,
+		Urho3D::WorkQueue* queue = 0,
+		MeshParseProgress progress = 0, void* progressData = 0
+	);
+
+	// PLY: ascii, binary_little_endian and binary_big_endian; binary data is read straight from the file.
+	bool ParsePLY(
+		const char* data, size_t size,
+		TriMeshData& mesh,
+		MeshParseProgress progress = 0, void* progressData = 0
+	);
+
+	// STL: binary or ascii. Like igl::readSTL, every triangle gets its own three vertices.
+	bool ParseSTL(
+		const char* data, size_t size,
+		TriMeshData& mesh,
+		MeshParseProgress progress = 0, void* progressData = 0
+	);
+
+	// (x, y, z) -> (x, z, -y), the ToYUp option of the mesh readers
+	void ConvertToYUp(TriMeshData& mesh);
+}
@@ -72,9 +72,8 @@ bool Geomlib::MeshTetrahedralize(
 	bool success = false;
 
 	// meshIn: verify and parse
-	VariantMap meshMap = meshIn.GetVariantMap();
-	const VariantVector vertexList = meshMap["vertices"].GetVariantVector();
-	const VariantVector faceList = meshMap["faces"].GetVariantVector();
+	const VariantVector vertexList = TriMesh_GetVertexList(meshIn);
+	const VariantVector faceList = TriMesh_GetFaceList(meshIn);
 
 	Vector<double> vertDoubles = TriMesh_GetVerticesAsDoubles(meshIn);
 	Vector<int> faceInts = TriMesh_GetFacesAsInts(meshIn);
@@ -271,9 +270,8 @@ bool Geomlib::MeshTetrahedralizeFromPoints(
     bool success = false;
     
     // meshIn: verify and parse
-    VariantMap meshMap = meshIn.GetVariantMap();
-    const VariantVector vertexList = meshMap["vertices"].GetVariantVector();
-    const VariantVector faceList = meshMap["faces"].GetVariantVector();
+    const VariantVector vertexList = TriMesh_GetVertexList(meshIn);
+    const VariantVector faceList = TriMesh_GetFaceList(meshIn);
     
     Vector<double> vertDoubles = TriMesh_GetVerticesAsDoubles(meshIn);
     Vector<double> otherPtsDoubles = VariantVectorToDoubles(pointsIn);
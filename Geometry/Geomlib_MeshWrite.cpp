@@ -0,0 +1,575 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Geomlib_MeshWrite.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/Serializer.h>
+
+using namespace Urho3D;
+
+namespace {
+
+const double POW10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15
+};
+
+const unsigned long long POW10_INT[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+	1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL
+};
+
+// Collects output in a buffer and hands it to a FILE or a Serializer in large blocks.
+class MeshOutput
+{
+public:
+	MeshOutput(FILE* file) : file_(file), dest_(0), size_(0), ok_(true) { buffer_.Resize(BUFFER_SIZE); }
+	MeshOutput(Serializer* dest) : file_(0), dest_(dest), size_(0), ok_(true) { buffer_.Resize(BUFFER_SIZE); }
+
+	bool Flush()
+	{
+		if (size_ > 0 && ok_) {
+			if (file_)
+				ok_ = fwrite(&buffer_[0], 1, size_, file_) == size_;
+			else
+				ok_ = dest_->Write(&buffer_[0], size_) == size_;
+		}
+		size_ = 0;
+		return ok_;
+	}
+
+	void Write(const void* data, unsigned size)
+	{
+		if (size_ + size > BUFFER_SIZE) {
+			Flush();
+			if (size > BUFFER_SIZE) {
+				if (ok_)
+					ok_ = file_ ? fwrite(data, 1, size, file_) == size : dest_->Write(data, size) == size;
+				return;
+			}
+		}
+		memcpy(&buffer_[size_], data, size);
+		size_ += size;
+	}
+
+	void Put(char c)
+	{
+		if (size_ == BUFFER_SIZE)
+			Flush();
+		buffer_[size_++] = c;
+	}
+
+	void Put(const char* str)
+	{
+		Write(str, (unsigned)strlen(str));
+	}
+
+	void PutUnsigned(unsigned long long value)
+	{
+		char digits[24];
+		int n = 0;
+		do {
+			digits[n++] = (char)('0' + value % 10);
+			value /= 10;
+		} while (value);
+		while (n)
+			Put(digits[--n]);
+	}
+
+	void PutInt(int value)
+	{
+		if (value < 0) {
+			Put('-');
+			PutUnsigned((unsigned long long)(-(long long)value));
+		}
+		else
+			PutUnsigned((unsigned long long)value);
+	}
+
+	// 9 significant digits, trailing zeros dropped; very large or small values go through printf
+	void PutFloat(float f)
+	{
+		double value = f;
+		if (value == 0.0) {
+			Put('0');
+			return;
+		}
+
+		bool negative = value < 0.0;
+		double magnitude = negative ? -value : value;
+		if (!(magnitude >= 1e-7 && magnitude < 1e9)) {
+			char text[32];
+			snprintf(text, sizeof(text), "%.9g", value);
+			Put(text);
+			return;
+		}
+
+		// decimal exponent of the leading digit, -7..8
+		int exponent = 0;
+		if (magnitude >= 1.0) {
+			while (exponent < 8 && magnitude >= POW10[exponent + 1])
+				++exponent;
+		}
+		else {
+			exponent = -1;
+			while (magnitude * POW10[-exponent] < 1.0)
+				--exponent;
+		}
+
+		int decimals = 8 - exponent;
+		unsigned long long scaled = (unsigned long long)(magnitude * POW10[decimals] + 0.5);
+		unsigned long long integer = scaled / POW10_INT[decimals];
+		unsigned long long fraction = scaled % POW10_INT[decimals];
+
+		if (negative)
+			Put('-');
+		PutUnsigned(integer);
+		if (fraction) {
+			while (fraction % 10 == 0) {
+				fraction /= 10;
+				--decimals;
+			}
+			Put('.');
+			for (int d = decimals - 1; d >= 0; --d)
+				Put((char)('0' + (fraction / POW10_INT[d]) % 10));
+		}
+	}
+
+private:
+	static const unsigned BUFFER_SIZE = 1 << 20;
+
+	FILE* file_;
+	Serializer* dest_;
+	PODVector<char> buffer_;
+	unsigned size_;
+	bool ok_;
+};
+
+Vector3 GetOutputVertex(const TriMeshData& mesh, unsigned i, bool zup)
+{
+	Vector3 v = mesh.GetVertex(i);
+	return zup ? Vector3(v.x_, -v.z_, v.y_) : v;
+}
+
+void PutVector(MeshOutput& out, const Vector3& v)
+{
+	out.PutFloat(v.x_);
+	out.Put(' ');
+	out.PutFloat(v.y_);
+	out.Put(' ');
+	out.PutFloat(v.z_);
+}
+
+void WriteOBJ(const TriMeshData& mesh, MeshOutput& out, bool zup)
+{
+	for (unsigned i = 0; i < mesh.GetNumVertices(); ++i) {
+		out.Put("v ");
+		PutVector(out, GetOutputVertex(mesh, i, zup));
+		out.Put('\n');
+	}
+
+	const int* faces = mesh.GetFaceData();
+	for (unsigned i = 0; i < mesh.GetNumFaces(); ++i) {
+		out.Put('f');
+		for (unsigned c = 0; c < 3; ++c) {
+			out.Put(' ');
+			out.PutInt(faces[3 * i + c] + 1);
+		}
+		out.Put('\n');
+	}
+}
+
+void WriteOFF(const TriMeshData& mesh, MeshOutput& out, bool zup)
+{
+	out.Put("OFF\n");
+	out.PutUnsigned(mesh.GetNumVertices());
+	out.Put(' ');
+	out.PutUnsigned(mesh.GetNumFaces());
+	out.Put(" 0\n");
+
+	for (unsigned i = 0; i < mesh.GetNumVertices(); ++i) {
+		PutVector(out, GetOutputVertex(mesh, i, zup));
+		out.Put('\n');
+	}
+
+	const int* faces = mesh.GetFaceData();
+	for (unsigned i = 0; i < mesh.GetNumFaces(); ++i) {
+		out.Put('3');
+		for (unsigned c = 0; c < 3; ++c) {
+			out.Put(' ');
+			out.PutInt(faces[3 * i + c]);
+		}
+		out.Put('\n');
+	}
+}
+
+void WritePLY(const TriMeshData& mesh, MeshOutput& out, bool zup, bool binary)
+{
+	out.Put("ply\n");
+	out.Put(binary ? "format binary_little_endian 1.0\n" : "format ascii 1.0\n");
+	out.Put("element vertex ");
+	out.PutUnsigned(mesh.GetNumVertices());
+	out.Put("\nproperty float x\nproperty float y\nproperty float z\n");
+	out.Put("element face ");
+	out.PutUnsigned(mesh.GetNumFaces());
+	out.Put("\nproperty list uchar int vertex_indices\nend_header\n");
+
+	const int* faces = mesh.GetFaceData();
+	if (binary) {
+		if (zup) {
+			for (unsigned i = 0; i < mesh.GetNumVertices(); ++i) {
+				Vector3 v = GetOutputVertex(mesh, i, zup);
+				out.Write(v.Data(), 3 * sizeof(float));
+			}
+		}
+		else if (mesh.GetNumVertices()) {
+			out.Write(mesh.GetVertexData(), mesh.GetNumVertices() * 3 * sizeof(float));
+		}
+
+		for (unsigned i = 0; i < mesh.GetNumFaces(); ++i) {
+			out.Put((char)3);
+			out.Write(&faces[3 * i], 3 * sizeof(int));
+		}
+		return;
+	}
+
+	for (unsigned i = 0; i < mesh.GetNumVertices(); ++i) {
+		PutVector(out, GetOutputVertex(mesh, i, zup));
+		out.Put('\n');
+	}
+	for (unsigned i = 0; i < mesh.GetNumFaces(); ++i) {
+		out.Put('3');
+		for (unsigned c = 0; c < 3; ++c) {
+			out.Put(' ');
+			out.PutInt(faces[3 * i + c]);
+		}
+		out.Put('\n');
+	}
+}
+
+void WriteSTL(const TriMeshData& mesh, MeshOutput& out, bool zup, bool binary)
+{
+	const int* faces = mesh.GetFaceData();
+	unsigned numFaces = mesh.GetNumFaces();
+
+	if (binary) {
+		char header[80];
+		memset(header, 0, sizeof(header));
+		strcpy(header, "iogram");
+		out.Write(header, sizeof(header));
+		out.Write(&numFaces, 4);
+	}
+	else {
+		out.Put("solid iogram\n");
+	}
+
+	for (unsigned i = 0; i < numFaces; ++i) {
+		Vector3 corners[3];
+		for (unsigned c = 0; c < 3; ++c)
+			corners[c] = GetOutputVertex(mesh, faces[3 * i + c], zup);
+		Vector3 normal = (corners[1] - corners[0]).CrossProduct(corners[2] - corners[0]).Normalized();
+
+		if (binary) {
+			unsigned short attributes = 0;
+			out.Write(normal.Data(), 3 * sizeof(float));
+			for (unsigned c = 0; c < 3; ++c)
+				out.Write(corners[c].Data(), 3 * sizeof(float));
+			out.Write(&attributes, 2);
+			continue;
+		}
+
+		out.Put(" facet normal ");
+		PutVector(out, normal);
+		out.Put("\n  outer loop\n");
+		for (unsigned c = 0; c < 3; ++c) {
+			out.Put("   vertex ");
+			PutVector(out, corners[c]);
+			out.Put('\n');
+		}
+		out.Put("  endloop\n endfacet\n");
+	}
+
+	if (!binary)
+		out.Put("endsolid iogram\n");
+}
+
+bool WriteFormat(const TriMeshData& mesh, MeshOutput& out, Geomlib::MeshWriteFormat format, bool zup)
+{
+	switch (format) {
+	case Geomlib::MESH_OBJ:
+		WriteOBJ(mesh, out, zup);
+		break;
+	case Geomlib::MESH_OFF:
+		WriteOFF(mesh, out, zup);
+		break;
+	case Geomlib::MESH_PLY_ASCII:
+	case Geomlib::MESH_PLY_BINARY:
+		WritePLY(mesh, out, zup, format == Geomlib::MESH_PLY_BINARY);
+		break;
+	case Geomlib::MESH_STL_ASCII:
+	case Geomlib::MESH_STL_BINARY:
+		WriteSTL(mesh, out, zup, format == Geomlib::MESH_STL_BINARY);
+		break;
+	default:
+		return false;
+	}
+
+	return out.Flush();
+}
+
+///////////////////////////////////////////////////////////////////////
+// background writes
+
+struct MeshWriteJob
+{
+	ConstTriMeshDataPtr mesh;
+	String path;
+	Geomlib::MeshWriteFormat format;
+	bool zup;
+	unsigned generation;
+};
+
+// the latest background write queued for a path
+struct MeshWriteState
+{
+	unsigned generation;
+	// the content rather than the TriMeshData pointer, as meshes without packed data get a new one per TriMesh_GetData
+	unsigned long long meshHash;
+	Geomlib::MeshWriteFormat format;
+	bool zup;
+	Geomlib::MeshWriteStatus status;
+};
+
+// guards GetWriteStates and GetPendingJobs
+Mutex& GetStateMutex()
+{
+	static Mutex mutex;
+	return mutex;
+}
+
+// held while a job writes, so that a file is never written by two jobs at once
+Mutex& GetFileMutex()
+{
+	static Mutex mutex;
+	return mutex;
+}
+
+HashMap<String, MeshWriteState>& GetWriteStates()
+{
+	static HashMap<String, MeshWriteState> states;
+	return states;
+}
+
+// Jobs are owned here rather than by their work items, so that a job whose item the WorkQueue drops
+// at shutdown is still freed.
+Vector<std::shared_ptr<MeshWriteJob> >& GetPendingJobs()
+{
+	static Vector<std::shared_ptr<MeshWriteJob> > jobs;
+	return jobs;
+}
+
+// 64 bit FNV-1a over the counts, vertex floats and face ints, a word at a time
+unsigned long long HashMesh(const TriMeshData& mesh)
+{
+	const unsigned long long FNV_PRIME = 1099511628211ULL;
+	unsigned long long hash = 14695981039346656037ULL;
+
+	hash = (hash ^ mesh.GetNumVertices()) * FNV_PRIME;
+	hash = (hash ^ mesh.GetNumFaces()) * FNV_PRIME;
+
+	const float* vertices = mesh.GetVertexData();
+	for (unsigned i = 0; i < 3 * mesh.GetNumVertices(); ++i) {
+		unsigned word;
+		memcpy(&word, &vertices[i], sizeof(word));
+		hash = (hash ^ word) * FNV_PRIME;
+	}
+
+	const int* faces = mesh.GetFaceData();
+	for (unsigned i = 0; i < 3 * mesh.GetNumFaces(); ++i)
+		hash = (hash ^ (unsigned)faces[i]) * FNV_PRIME;
+
+	return hash;
+}
+
+void MeshWriteWork(const WorkItem* item, unsigned threadIndex)
+{
+	MeshWriteJob* job = static_cast<MeshWriteJob*>(item->aux_);
+	{
+		MutexLock fileLock(GetFileMutex());
+
+		bool latest;
+		{
+			MutexLock lock(GetStateMutex());
+			HashMap<String, MeshWriteState>::ConstIterator it = GetWriteStates().Find(job->path);
+			latest = it != GetWriteStates().End() && it->second_.generation == job->generation;
+		}
+
+		// superseded jobs are dropped without writing
+		if (latest) {
+			bool success = Geomlib::WriteMesh(*job->mesh, job->path, job->format, job->zup);
+			if (!success)
+				URHO3D_LOGERROR("Geomlib::WriteMeshInBackground --- could not write " + job->path);
+
+			MutexLock lock(GetStateMutex());
+			HashMap<String, MeshWriteState>::Iterator it = GetWriteStates().Find(job->path);
+			if (it != GetWriteStates().End() && it->second_.generation == job->generation)
+				it->second_.status = success ? Geomlib::MESH_WRITE_DONE : Geomlib::MESH_WRITE_FAILED;
+		}
+	}
+
+	MutexLock lock(GetStateMutex());
+	Vector<std::shared_ptr<MeshWriteJob> >& jobs = GetPendingJobs();
+	for (unsigned i = 0; i < jobs.Size(); ++i) {
+		if (jobs[i].get() == job) {
+			jobs.EraseSwap(i);
+			break;
+		}
+	}
+}
+
+}
+
+bool Geomlib::WriteMesh(const TriMeshData& mesh, const String& path, MeshWriteFormat format, bool zup)
+{
+	FILE* file = fopen(path.CString(), "wb");
+	if (!file)
+		return false;
+
+	MeshOutput out(file);
+	bool success = WriteFormat(mesh, out, format, zup);
+	return fclose(file) == 0 && success;
+}
+
+bool Geomlib::WriteMesh(const TriMeshData& mesh, Serializer& dest, MeshWriteFormat format, bool zup)
+{
+	MeshOutput out(&dest);
+	return WriteFormat(mesh, out, format, zup);
+}
+
+Geomlib::MeshWriteStatus Geomlib::WriteMeshInBackground(
+	WorkQueue* queue,
+	ConstTriMeshDataPtr mesh,
+	const String& path,
+	MeshWriteFormat format,
+	bool zup
+)
+{
+	if (!mesh)
+		return MESH_WRITE_FAILED;
+
+	static unsigned nextGeneration = 0;
+	unsigned long long meshHash = HashMesh(*mesh);
+
+	std::shared_ptr<MeshWriteJob> job(new MeshWriteJob());
+	job->mesh = mesh;
+	job->path = path;
+	job->format = format;
+	job->zup = zup;
+	{
+		MutexLock lock(GetStateMutex());
+		job->generation = ++nextGeneration;
+		MeshWriteState& state = GetWriteStates()[path];
+		state.generation = job->generation;
+		state.meshHash = meshHash;
+		state.format = format;
+		state.zup = zup;
+		state.status = MESH_WRITE_PENDING;
+		if (queue)
+			GetPendingJobs().Push(job);
+	}
+
+	if (!queue) {
+		bool success = WriteMesh(*mesh, path, format, zup);
+		MutexLock lock(GetStateMutex());
+		MeshWriteState& state = GetWriteStates()[path];
+		if (state.generation == job->generation)
+			state.status = success ? MESH_WRITE_DONE : MESH_WRITE_FAILED;
+		return success ? MESH_WRITE_DONE : MESH_WRITE_FAILED;
+	}
+
+	// Low priority: WorkQueue::Complete calls made while solving do not wait for it. The completion
+	// event is sent on the main thread once the file is written (see GetMeshWriteStatus).
+	SharedPtr<WorkItem> item = queue->GetFreeItem();
+	item->workFunction_ = MeshWriteWork;
+	item->aux_ = job.get();
+	item->priority_ = 0;
+	item->sendEvent_ = true;
+	queue->AddWorkItem(item);
+	queue->Resume();
+
+	return MESH_WRITE_PENDING;
+}
+
+Geomlib::MeshWriteStatus Geomlib::GetMeshWriteStatus(
+	const String& path,
+	const TriMeshData* mesh,
+	MeshWriteFormat format,
+	bool zup
+)
+{
+	if (!mesh)
+		return MESH_WRITE_NONE;
+
+	// hashed outside of the lock, which the workers take when they finish a write
+	unsigned long long meshHash = HashMesh(*mesh);
+
+	MutexLock lock(GetStateMutex());
+	HashMap<String, MeshWriteState>::ConstIterator it = GetWriteStates().Find(path);
+	if (it == GetWriteStates().End())
+		return MESH_WRITE_NONE;
+
+	const MeshWriteState& state = it->second_;
+	if (state.meshHash != meshHash || state.format != format || state.zup != zup)
+		return MESH_WRITE_NONE;
+	return state.status;
+}
+
+unsigned Geomlib::GetNumPendingMeshWrites()
+{
+	MutexLock lock(GetStateMutex());
+	return GetPendingJobs().Size();
+}
+
+bool Geomlib::FlushMeshWrites(WorkQueue* queue)
+{
+	if (GetNumPendingMeshWrites() == 0)
+		return true;
+
+	// WorkQueue::Complete is for the main thread only, and must not be nested
+	if (!queue || !Thread::IsMainThread() || queue->IsCompleting()) {
+		URHO3D_LOGWARNING("Geomlib::FlushMeshWrites --- can only wait for mesh writes from the main thread");
+		return false;
+	}
+
+	// priority 0 waits for every item, the mesh writes included
+	queue->Complete(0);
+	return GetNumPendingMeshWrites() == 0;
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Container/Str.h>
+
+#include "TriMeshData.h"
+
+namespace Urho3D {
+class Serializer;
+class WorkQueue;
+}
+
+namespace Geomlib {
+
+	enum MeshWriteFormat
+	{
+		MESH_OBJ,
+		MESH_OFF,
+		MESH_PLY_ASCII,
+		MESH_PLY_BINARY,
+		MESH_STL_ASCII,
+		MESH_STL_BINARY
+	};
+
+	// Writes the vertex and face buffers of mesh through a large output buffer, formatting numbers
+	// without printf. Floats are written with 9 significant digits, enough to read back the same float.
+	// zup converts (x, y, z) -> (x, -z, y), the ToZUp option of the mesh writers.
+	bool WriteMesh(const TriMeshData& mesh, const Urho3D::String& path, MeshWriteFormat format, bool zup = false);
+	bool WriteMesh(const TriMeshData& mesh, Urho3D::Serializer& dest, MeshWriteFormat format, bool zup = false);
+
+	enum MeshWriteStatus
+	{
+		MESH_WRITE_NONE,	// no background write of this mesh to this path
+		MESH_WRITE_PENDING,	// queued or being written
+		MESH_WRITE_DONE,
+		MESH_WRITE_FAILED
+	};
+
+	// Queues the write on queue's worker threads behind any solving work and returns MESH_WRITE_PENDING
+	// at once; the job keeps the mesh alive. Of several writes queued for the same path only the latest
+	// is carried out. Once the file is written, the WorkQueue sends E_WORKITEMCOMPLETED on the main thread.
+	// Without a queue the mesh is written before returning, and the result is DONE or FAILED.
+	MeshWriteStatus WriteMeshInBackground(
+		Urho3D::WorkQueue* queue,
+		ConstTriMeshDataPtr mesh,
+		const Urho3D::String& path,
+		MeshWriteFormat format,
+		bool zup = false
+	);
+
+	// Status of the latest background write to path, if it was of a mesh with the same vertices and faces
+	// as mesh (compared by content hash, not by pointer), with the same format and zup;
+	// NONE if path was never written in the background, or something else has been queued for it since.
+	MeshWriteStatus GetMeshWriteStatus(
+		const Urho3D::String& path,
+		const TriMeshData* mesh,
+		MeshWriteFormat format,
+		bool zup
+	);
+
+	// background writes queued and not yet finished
+	unsigned GetNumPendingMeshWrites();
+
+	// Waits for all queued background writes, e.g. before exiting: the WorkQueue drops items that have not
+	// started when it is destroyed, and WorkQueue::Complete made while solving does not wait for the
+	// low priority writes. Main thread only, outside of another WorkQueue::Complete.
+	// Returns false if writes are still pending.
+	bool FlushMeshWrites(Urho3D::WorkQueue* queue);
+}
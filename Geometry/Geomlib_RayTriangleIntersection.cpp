@@ -24,6 +24,9 @@
 
 #include <Urho3D/Math/Vector3.h>
 
+#include "TriMesh.h"
+#include "TriMeshAABB.h"
+
 bool Geomlib::RayTriangleIntersection(
 	const Urho3D::Vector3& A,
 	const Urho3D::Vector3& B,
@@ -65,4 +68,20 @@ bool Geomlib::RayTriangleIntersection(
 
 	// ray misses triangle
 	return false;
-}
\ No newline at end of file
+}
+
+bool Geomlib::TriMeshRayIntersection(
+	const Urho3D::Variant& mesh,
+	const Urho3D::Vector3& O,
+	const Urho3D::Vector3& D,
+	int& index,
+	float& s
+)
+{
+	ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+	if (!data) {
+		return false;
+	}
+
+	return data->GetAABB()->Raycast(O, D, s, index);
+}
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <Urho3D/Core/Variant.h>
 #include <Urho3D/Math/Vector3.h>
 
 namespace Geomlib {
@@ -36,4 +37,19 @@ namespace Geomlib {
 		const Urho3D::Vector3& D,
 		float& s
 	);
+
+	// Inputs
+	//   mesh: mesh data stored in Urho3D::Variant
+	//   O, D: ray origin and direction
+	// Outputs
+	//   index: face index (triangle number, not a faceList offset) of the first face hit by the ray
+	//   s: O + s * D is the hit point
+	// Uses the mesh's cached bounding box tree, so repeated casts against one mesh do not loop over every face.
+	bool TriMeshRayIntersection(
+		const Urho3D::Variant& mesh,
+		const Urho3D::Vector3& O,
+		const Urho3D::Vector3& D,
+		int& index,
+		float& s
+	);
 }
\ No newline at end of file
@@ -25,18 +25,27 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/IO/File.h>
 
+#include "Geomlib_MeshParse.h"
+
 namespace Geomlib {
 
+// Large files are parsed in parallel on queue's worker threads; see ParseOBJ.
 bool ReadOBJ(
 	const Urho3D::String& obj_filename,
 	Urho3D::Variant& tri_mesh,
-	bool yup = false
+	bool yup = false,
+	Urho3D::WorkQueue* queue = 0,
+	MeshParseProgress progress = 0,
+	void* progressData = 0
 );
 
 bool ReadOBJ(
 	Urho3D::File* source,
 	Urho3D::Variant& tri_mesh,
-	bool yup = false
+	bool yup = false,
+	Urho3D::WorkQueue* queue = 0,
+	MeshParseProgress progress = 0,
+	void* progressData = 0
 );
 
 }
\ No newline at end of file
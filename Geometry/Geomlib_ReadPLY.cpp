@@ -21,85 +21,59 @@
 
 #include "Geomlib_ReadPLY.h"
 
-#include <iostream>
-#include <vector>
-
-#include <Eigen/Core>
-
-#include <igl/readPLY.h>
-#include <igl/list_to_matrix.h>
-
-#include "ConversionUtilities.h"
+#include "Geomlib_MeshParse.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
 
-bool Geomlib::ReadPLY(
-	const Urho3D::String& ply_filename,
-	Urho3D::Variant& tri_mesh,
-	bool yup
-)
+namespace {
+
+bool MakeMeshFromPLY(const Geomlib::MappedFile& file, Variant& tri_mesh, bool yup,
+	Geomlib::MeshParseProgress progress, void* progressData)
 {
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	bool read_success = igl::readPLY(ply_filename.CString(), V, F);
-	if (!read_success) {
+	TriMeshDataPtr data(new TriMeshData());
+	if (!Geomlib::ParsePLY(file.GetData(), file.GetSize(), *data, progress, progressData)) {
 		return false;
 	}
 
 	if (yup) {
-		Eigen::MatrixXf W = V;
-		W.col(1) = V.col(2);
-		W.col(2) = -1 * V.col(1);
-		V = W;
+		Geomlib::ConvertToYUp(*data);
 	}
 
-	tri_mesh = TriMesh_Make(V, F);
-	if (!TriMesh_Verify(tri_mesh)) {
-		return false;
-	}
-	return true;
+	tri_mesh = TriMesh_Make(data);
+	return TriMesh_Verify(tri_mesh);
+}
+
 }
 
 bool Geomlib::ReadPLY(
-	Urho3D::File* source,
+	const Urho3D::String& ply_filename,
 	Urho3D::Variant& tri_mesh,
-	bool yup
+	bool yup,
+	MeshParseProgress progress,
+	void* progressData
 )
 {
-	std::vector<std::vector<float> > vV;
-	std::vector<std::vector<int> > vF;
-	std::vector<std::vector<float> > vN;
-	std::vector<std::vector<float> > vUV;
-	FILE* ply_file = (FILE*)source->GetHandle();
-	bool read_success = igl::readPLY(ply_file, vV, vF, vN, vUV);
-	if (!read_success) {
+	MappedFile file;
+	if (!file.Open(ply_filename)) {
 		return false;
 	}
 
-	Eigen::MatrixXf xV; // xV = matrix V
-	bool V_rect = igl::list_to_matrix(vV, xV);
-	if (!V_rect) {
-		return false;
-	}
+	return MakeMeshFromPLY(file, tri_mesh, yup, progress, progressData);
+}
 
-	Eigen::MatrixXi xF; // xF = matrix F
-	bool F_rect = igl::list_to_matrix(vF, xF);
-	if (!F_rect) {
+bool Geomlib::ReadPLY(
+	Urho3D::File* source,
+	Urho3D::Variant& tri_mesh,
+	bool yup,
+	MeshParseProgress progress,
+	void* progressData
+)
+{
+	MappedFile file;
+	if (!file.Open(source)) {
 		return false;
 	}
 
-	if (yup) {
-		Eigen::MatrixXf W = xV;
-		W.col(1) = xV.col(2);
-		W.col(2) = -1 * xV.col(1);
-		xV = W;
-	}
-
-	tri_mesh = TriMesh_Make(xV, xF);
-	if (!TriMesh_Verify(tri_mesh)) {
-		return false;
-	}
-	std::cout << "return true from Geomlib_ReadPLY" << std::endl;
-	return true;
+	return MakeMeshFromPLY(file, tri_mesh, yup, progress, progressData);
 }
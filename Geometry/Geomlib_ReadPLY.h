@@ -25,18 +25,24 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/IO/File.h>
 
+#include "Geomlib_MeshParse.h"
+
 namespace Geomlib {
 
 bool ReadPLY(
 	const Urho3D::String& ply_filename,
 	Urho3D::Variant& tri_mesh,
-	bool yup = false
+	bool yup = false,
+	MeshParseProgress progress = 0,
+	void* progressData = 0
 );
 
 bool ReadPLY(
 	Urho3D::File* source,
 	Urho3D::Variant& tri_mesh,
-	bool yup = false
+	bool yup = false,
+	MeshParseProgress progress = 0,
+	void* progressData = 0
 );
 
 }
\ No newline at end of file
@@ -23,6 +23,8 @@
 #include "Geomlib_RemoveDuplicates.h"
 
 #include <algorithm>
+#include <cmath>
+#include <unordered_map>
 #include <vector>
 
 #pragma warning(disable : 4244)
@@ -33,11 +35,197 @@ using Urho3D::Vector3;
 using Urho3D::VariantMap;
 using Urho3D::VariantVector;
 
+using Urho3D::PODVector;
+
 namespace {
-bool Vector3Equals(const Urho3D::Vector3& lhs, const Urho3D::Vector3& rhs)
+bool Vector3Equals(const Urho3D::Vector3& lhs, const Urho3D::Vector3& rhs, float tolerance)
+{
+	return Urho3D::Abs(lhs.x_ - rhs.x_) <= tolerance && Urho3D::Abs(lhs.y_ - rhs.y_) <= tolerance && Urho3D::Abs(lhs.z_ - rhs.z_) <= tolerance;
+}
+
+// NaN and infinite coordinates never compare within tolerance, so such vertices are not binned
+bool IsFinite(const Urho3D::Vector3& v)
+{
+	return std::isfinite(v.x_) && std::isfinite(v.y_) && std::isfinite(v.z_);
+}
+
+// integer grid coordinate, clamped so that far away points cannot overflow;
+// NaN (only from an infinite tolerance) goes to cell 0, where every vertex then lands
+long long CellCoordinate(float x, double invCellSize)
+{
+	double c = floor((double)x * invCellSize);
+	if (std::isnan(c))
+		return 0;
+	return (long long)Urho3D::Clamp(c, -1.0e18, 1.0e18);
+}
+
+// distinct cells may share a key, which costs extra comparisons but never a wrong weld;
+// unsigned arithmetic wraps where signed would overflow
+unsigned long long CellKey(long long x, long long y, long long z)
+{
+	return ((unsigned long long)x * 73856093ULL) ^ ((unsigned long long)y * 19349663ULL) ^ ((unsigned long long)z * 83492791ULL);
+}
+}
+
+unsigned Geomlib::WeldVertices(
+	const Urho3D::Vector3* vertexList,
+	unsigned numVertices,
+	float tolerance,
+	Urho3D::PODVector<unsigned>& remap,
+	Urho3D::PODVector<unsigned>& representatives
+)
 {
-	return Urho3D::Equals(lhs.x_, rhs.x_) && Urho3D::Equals(lhs.y_, rhs.y_) && Urho3D::Equals(lhs.z_, rhs.z_);
+	remap.Resize(numVertices);
+	representatives.Clear();
+
+	tolerance = Urho3D::Max(tolerance, Urho3D::M_EPSILON);
+	double invCellSize = 1.0 / (2.0 * tolerance);
+
+	// each cell holds a singly linked list of the welded vertices binned in it:
+	// cellHeads maps the cell key to the first one, next[r] is the one after r, or M_MAX_UNSIGNED
+	std::unordered_map<unsigned long long, unsigned> cellHeads;
+	cellHeads.reserve(numVertices);
+	PODVector<unsigned> next;
+
+	for (unsigned i = 0; i < numVertices; ++i) {
+		const Vector3& v = vertexList[i];
+
+		// like the brute force version, a non-finite vertex welds to nothing, not even its own copies
+		if (!IsFinite(v)) {
+			remap[i] = representatives.Size();
+			representatives.Push(i);
+			next.Push(Urho3D::M_MAX_UNSIGNED);
+			continue;
+		}
+
+		// cells are at least 2 * tolerance wide, so the tolerance box spans at most 2 cells per axis
+		long long lo[3] = {
+			CellCoordinate(v.x_ - tolerance, invCellSize),
+			CellCoordinate(v.y_ - tolerance, invCellSize),
+			CellCoordinate(v.z_ - tolerance, invCellSize)
+		};
+		long long hi[3] = {
+			CellCoordinate(v.x_ + tolerance, invCellSize),
+			CellCoordinate(v.y_ + tolerance, invCellSize),
+			CellCoordinate(v.z_ + tolerance, invCellSize)
+		};
+
+		// like the brute force version, weld to the earliest match
+		unsigned match = Urho3D::M_MAX_UNSIGNED;
+		for (long long x = lo[0]; x <= hi[0]; ++x) {
+			for (long long y = lo[1]; y <= hi[1]; ++y) {
+				for (long long z = lo[2]; z <= hi[2]; ++z) {
+					std::unordered_map<unsigned long long, unsigned>::const_iterator it = cellHeads.find(CellKey(x, y, z));
+					if (it == cellHeads.end())
+						continue;
+
+					for (unsigned r = it->second; r != Urho3D::M_MAX_UNSIGNED; r = next[r]) {
+						if (r < match && Vector3Equals(vertexList[representatives[r]], v, tolerance))
+							match = r;
+					}
+				}
+			}
+		}
+
+		if (match == Urho3D::M_MAX_UNSIGNED) {
+			match = representatives.Size();
+			representatives.Push(i);
+
+			unsigned long long key = CellKey(
+				CellCoordinate(v.x_, invCellSize),
+				CellCoordinate(v.y_, invCellSize),
+				CellCoordinate(v.z_, invCellSize)
+			);
+			std::unordered_map<unsigned long long, unsigned>::iterator it = cellHeads.find(key);
+			if (it == cellHeads.end()) {
+				next.Push(Urho3D::M_MAX_UNSIGNED);
+				cellHeads[key] = match;
+			}
+			else {
+				next.Push(it->second);
+				it->second = match;
+			}
+		}
+
+		remap[i] = match;
+	}
+
+	return representatives.Size();
 }
+
+void Geomlib::FindEarliestNeighbours(
+	const Urho3D::Vector3* vertexList,
+	unsigned numVertices,
+	float tolerance,
+	Urho3D::PODVector<unsigned>& earliest
+)
+{
+	earliest.Resize(numVertices);
+
+	tolerance = Urho3D::Max(tolerance, Urho3D::M_EPSILON);
+	float toleranceSquared = tolerance * tolerance;
+	double invCellSize = 1.0 / (2.0 * tolerance);
+
+	// each cell holds a singly linked list of all the vertices binned in it, in increasing order:
+	// cellEnds maps the cell key to its first and last vertex, next[j] is the one after j, or M_MAX_UNSIGNED
+	std::unordered_map<unsigned long long, std::pair<unsigned, unsigned> > cellEnds;
+	cellEnds.reserve(numVertices);
+	PODVector<unsigned> next(numVertices);
+
+	for (unsigned i = 0; i < numVertices; ++i) {
+		const Vector3& v = vertexList[i];
+
+		next[i] = Urho3D::M_MAX_UNSIGNED;
+		if (!IsFinite(v)) {
+			earliest[i] = i;
+			continue;
+		}
+
+		long long lo[3] = {
+			CellCoordinate(v.x_ - tolerance, invCellSize),
+			CellCoordinate(v.y_ - tolerance, invCellSize),
+			CellCoordinate(v.z_ - tolerance, invCellSize)
+		};
+		long long hi[3] = {
+			CellCoordinate(v.x_ + tolerance, invCellSize),
+			CellCoordinate(v.y_ + tolerance, invCellSize),
+			CellCoordinate(v.z_ + tolerance, invCellSize)
+		};
+
+		unsigned match = i;
+		for (long long x = lo[0]; x <= hi[0]; ++x) {
+			for (long long y = lo[1]; y <= hi[1]; ++y) {
+				for (long long z = lo[2]; z <= hi[2]; ++z) {
+					std::unordered_map<unsigned long long, std::pair<unsigned, unsigned> >::const_iterator it = cellEnds.find(CellKey(x, y, z));
+					if (it == cellEnds.end())
+						continue;
+
+					// the first hit in a cell is its earliest, so coincident vertices stay O(1) each
+					for (unsigned j = it->second.first; j < match; j = next[j]) {
+						if ((vertexList[j] - v).LengthSquared() < toleranceSquared) {
+							match = j;
+							break;
+						}
+					}
+				}
+			}
+		}
+		earliest[i] = match;
+
+		unsigned long long key = CellKey(
+			CellCoordinate(v.x_, invCellSize),
+			CellCoordinate(v.y_, invCellSize),
+			CellCoordinate(v.z_, invCellSize)
+		);
+		std::unordered_map<unsigned long long, std::pair<unsigned, unsigned> >::iterator it = cellEnds.find(key);
+		if (it == cellEnds.end()) {
+			cellEnds[key] = std::make_pair(i, i);
+		}
+		else {
+			next[it->second.second] = i;
+			it->second.second = i;
+		}
+	}
 }
 
 // vertexList:
@@ -83,35 +271,25 @@ void Geomlib::RemoveDuplicates(
 	using Urho3D::Variant;
 	using Urho3D::Vector;
 
-	int numVerts = (int)vertexList.Size();
-	std::vector<int> vertexDuplicates_(numVerts);
-
-	for (int i = 0; i < numVerts; ++i) {
-		vertexDuplicates_[i] = i; // Assume not a duplicate
-		for (int j = 0; j < i; ++j) {
-			if (Vector3Equals(vertexList[j].GetVector3(), vertexList[i].GetVector3())) {
-				vertexDuplicates_[i] = j;
-				break;
-			}
-		}
+	unsigned numVerts = vertexList.Size();
+	PODVector<Vector3> coords(numVerts);
+	for (unsigned i = 0; i < numVerts; ++i) {
+		coords[i] = vertexList[i].GetVector3();
 	}
 
-	std::vector<int> vertexUniques_ = vertexDuplicates_;
-	std::sort(vertexUniques_.begin(), vertexUniques_.end());
-	vertexUniques_.erase(std::unique(vertexUniques_.begin(), vertexUniques_.end()), vertexUniques_.end());
+	PODVector<unsigned> remap;
+	PODVector<unsigned> vertexUniques;
+	WeldVertices(coords.Buffer(), numVerts, 0.0f, remap, vertexUniques);
 
-	Vector<Variant> newVertexList;
-	for (int i = 0; i < vertexUniques_.size(); ++i) {
-		int k = vertexUniques_[i];
-		newVertexList.Push(Variant(vertexList[k].GetVector3()));
+	Vector<Variant> newVertexList(vertexUniques.Size());
+	for (unsigned i = 0; i < vertexUniques.Size(); ++i) {
+		newVertexList[i] = Variant(coords[vertexUniques[i]]);
 	}
 	vertices = Variant(newVertexList);
 
-	Vector<Variant> indexList;
-	for (int j = 0; j < numVerts; ++j) {
-		int orig_j = vertexDuplicates_[j];
-		int uniq_j = find(vertexUniques_.begin(), vertexUniques_.end(), orig_j) - vertexUniques_.begin();
-		indexList.Push(Variant(uniq_j));
+	Vector<Variant> indexList(numVerts);
+	for (unsigned j = 0; j < numVerts; ++j) {
+		indexList[j] = Variant((int)remap[j]);
 	}
 	indices = Variant(indexList);
 }
@@ -123,34 +301,20 @@ void Geomlib::RemoveDuplicates(
 )
 {
 	int numVerts = (int)vertexListIn.Size();
-	std::vector<int> vertexDuplicates_(numVerts);
-
-	for (int i = 0; i < numVerts; ++i) {
-		vertexDuplicates_[i] = i; // Assume not a duplicate
-		for (int j = 0; j < i; ++j) {
-			if (Vector3Equals(vertexListIn[j], vertexListIn[i])) {
-				vertexDuplicates_[i] = j;
-				break;
-			}
-		}
-	}
 
-	std::vector<int> vertexUniques_ = vertexDuplicates_;
-	std::sort(vertexUniques_.begin(), vertexUniques_.end());
-	vertexUniques_.erase(std::unique(vertexUniques_.begin(), vertexUniques_.end()), vertexUniques_.end());
+	PODVector<unsigned> remap;
+	PODVector<unsigned> vertexUniques;
+	WeldVertices(vertexListIn.Buffer(), numVerts, 0.0f, remap, vertexUniques);
 
-	Vector<Variant> newVertexList;
-	for (int i = 0; i < vertexUniques_.size(); ++i) {
-		int k = vertexUniques_[i];
-		newVertexList.Push(Variant(vertexListIn[k]));
+	Vector<Variant> newVertexList(vertexUniques.Size());
+	for (unsigned i = 0; i < vertexUniques.Size(); ++i) {
+		newVertexList[i] = Variant(vertexListIn[vertexUniques[i]]);
 	}
 	vertices = Variant(newVertexList);
 
-	Vector<Variant> faceList;
+	Vector<Variant> faceList(numVerts);
 	for (int j = 0; j < numVerts; ++j) {
-		int orig_j = vertexDuplicates_[j];
-		int uniq_j = find(vertexUniques_.begin(), vertexUniques_.end(), orig_j) - vertexUniques_.begin();
-		faceList.Push(Variant(uniq_j));
+		faceList[j] = Variant((int)remap[j]);
 	}
 
 	//// weld the faces
@@ -171,26 +335,14 @@ void Geomlib::NMesh_RemoveDuplicates(
 	// use the same idea as trimesh version with the vertexlistin, but use the structured face list for info about the faces
 
 	int numVerts = (int)vertexListIn.Size();
-	std::vector<int> vertexDuplicates_(numVerts);
-
-	for (int i = 0; i < numVerts; ++i) {
-		vertexDuplicates_[i] = i; // Assume not a duplicate
-		for (int j = 0; j < i; ++j) {
-			if (Vector3Equals(vertexListIn[j], vertexListIn[i])) {
-				vertexDuplicates_[i] = j;
-				break;
-			}
-		}
-	}
 
-	std::vector<int> vertexUniques_ = vertexDuplicates_;
-	std::sort(vertexUniques_.begin(), vertexUniques_.end());
-	vertexUniques_.erase(std::unique(vertexUniques_.begin(), vertexUniques_.end()), vertexUniques_.end());
+	PODVector<unsigned> remap;
+	PODVector<unsigned> vertexUniques;
+	WeldVertices(vertexListIn.Buffer(), numVerts, 0.0f, remap, vertexUniques);
 
-	Vector<Variant> newVertexList;
-	for (int i = 0; i < vertexUniques_.size(); ++i) {
-		int k = vertexUniques_[i];
-		newVertexList.Push(Variant(vertexListIn[k]));
+	Vector<Variant> newVertexList(vertexUniques.Size());
+	for (unsigned i = 0; i < vertexUniques.Size(); ++i) {
+		newVertexList[i] = Variant(vertexListIn[vertexUniques[i]]);
 	}
 	vertices = Variant(newVertexList);
 
@@ -198,9 +350,7 @@ void Geomlib::NMesh_RemoveDuplicates(
 	Vector<Variant> faceList_raw;
 	Vector<Variant> faceList;
 	for (int j = 0; j < numVerts; ++j) {
-		int orig_j = vertexDuplicates_[j];
-		int uniq_j = find(vertexUniques_.begin(), vertexUniques_.end(), orig_j) - vertexUniques_.begin();
-		faceList_raw.Push(Variant(uniq_j));
+		faceList_raw.Push(Variant((int)remap[j]));
 	}
 
 	VariantVector revised_sfl;
@@ -26,6 +26,36 @@
 
 namespace Geomlib {
 
+// Welds the vertices of vertexList that are within tolerance of each other in every coordinate.
+// On return,
+//   representatives lists, in order of first appearance, the index into vertexList of one vertex
+//   from each welded group;
+//   remap[i] is the index into representatives of the group containing vertex i.
+// Vertices are binned in a hash grid with cells of size 2 * tolerance, so each vertex is only
+// compared with the welded vertices in the (at most 8) cells its tolerance box overlaps,
+// and the running time is O(n) expected.
+// A tolerance of 0 welds vertices equal up to M_EPSILON, like the functions below.
+// Returns the number of welded vertices, i.e., representatives.Size().
+unsigned WeldVertices(
+	const Urho3D::Vector3* vertexList,
+	unsigned numVertices,
+	float tolerance,
+	Urho3D::PODVector<unsigned>& remap,
+	Urho3D::PODVector<unsigned>& representatives
+);
+
+// For each vertex i of vertexList, earliest[i] is the smallest j <= i such that vertex j is closer
+// than tolerance to vertex i (Euclidean distance), so earliest[i] == i when no earlier vertex is.
+// Unlike WeldVertices, every earlier vertex is a candidate, not just the first of each group, so a
+// chain of close vertices links each one to its own earliest neighbour.
+// Uses the same hash grid as WeldVertices; the running time is O(n) expected.
+void FindEarliestNeighbours(
+	const Urho3D::Vector3* vertexList,
+	unsigned numVertices,
+	float tolerance,
+	Urho3D::PODVector<unsigned>& earliest
+);
+
 // vertexList:
 //   If object is a triangle mesh, then vertexList is a triangle-by-triangle list
 //   of coordinates of vertices, e.g.,
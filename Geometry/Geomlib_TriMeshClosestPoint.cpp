@@ -30,11 +30,12 @@
 #include "ConversionUtilities.h"
 
 #include "Geomlib_ClosestPoint.h"
+#include "IoParallelFor.h"
 #include "TriMesh.h"
+#include "TriMeshAABB.h"
 
 using namespace Urho3D;
 
-// IN PROGRESS, NOT DONE * IN PROGRESS, NOT DONE
 // Inputs
 //   mesh: mesh data stored in Urho3D::Variant
 //   q: query point
@@ -43,75 +44,104 @@ using namespace Urho3D;
 //   p: coordinates of point on mesh closest to query point q
 bool Geomlib::TriMeshClosestPoint(const Variant& mesh, const Vector3 q, int& index, Vector3& p)
 {
-	if (!TriMesh_Verify(mesh)) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+	if (!data) {
 		return false;
 	}
-	VariantMap meshMap = mesh.GetVariantMap();
 
 	// mesh data guaranteed
-	Vector<Variant> vertexList = meshMap["vertices"].GetVariantVector();
-	Vector<Variant> faceList = meshMap["faces"].GetVariantVector();
+	assert(data->GetNumVertices() > 0);
+	assert(data->GetNumFaces() > 0);
 
-	unsigned numVertices = vertexList.Size();
-	assert(numVertices > 0);
-	unsigned numFaces = faceList.Size() / 3;
-	assert(numFaces > 0);
-
-	float* sqDistances = new float[numFaces];
-	Vector<Vector3> perFaceClosePoints;
-
-	for (unsigned i = 0; i < faceList.Size(); i += 3) {
-
-		unsigned faceIndex = i / 3;
-
-		// these lookups should be guaranteed by ExtractMeshData --- no safety checks needed!
-		unsigned i0 = faceList[i].GetInt();
-		unsigned i1 = faceList[i + 1].GetInt();
-		unsigned i2 = faceList[i + 2].GetInt();
-		Vector3 v0 = vertexList[i0].GetVector3();
-		Vector3 v1 = vertexList[i1].GetVector3();
-		Vector3 v2 = vertexList[i2].GetVector3();
-
-		Vector3 r = Geomlib::TriangleClosestPoint(v0, v1, v2, q);
-		sqDistances[faceIndex] = (r - q).LengthSquared();
-		perFaceClosePoints.Push(r);
-	}
-
-	float minSqDistance = sqDistances[0];
-	unsigned minFaceIndex = 0;
-	for (unsigned f = 1; f < numFaces; ++f) {
-		float sqDistance = sqDistances[f];
-		if (sqDistance < minSqDistance) {
-			minSqDistance = sqDistance;
-			minFaceIndex = f;
-		}
-	}
-
-	delete[] sqDistances;
-
-	index = (int)minFaceIndex;
-	p = perFaceClosePoints[minFaceIndex];
+	// the tree is built on the first query and cached with the mesh
+	data->GetAABB()->ClosestPoint(q, index, p);
 	return true;
 }
 
+namespace {
+
+struct ClosestPointsJob
+{
+	const TriMeshAABB* tree;
+	const Vector3* queries;
+	Vector3* points;
+	int* indices;
+	float* distances;
+};
+
+void ClosestPointsRange(void* data, unsigned begin, unsigned end)
+{
+	const ClosestPointsJob* job = static_cast<const ClosestPointsJob*>(data);
+	for (unsigned i = begin; i < end; ++i) {
+		float sqrDist = job->tree->ClosestPoint(job->queries[i], job->indices[i], job->points[i]);
+		job->distances[i] = sqrt(sqrDist);
+	}
+}
+
+}
+
+bool Geomlib::TriMeshClosestPoints(
+	const Variant& mesh,
+	const Vector3* queries,
+	unsigned numQueries,
+	PODVector<Vector3>& points,
+	PODVector<int>& indices,
+	PODVector<float>& distances,
+	WorkQueue* queue
+)
+{
+	points.Clear();
+	indices.Clear();
+	distances.Clear();
+
+	ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+	if (!data || data->GetNumFaces() == 0) {
+		return false;
+	}
+
+	points.Resize(numQueries);
+	indices.Resize(numQueries);
+	distances.Resize(numQueries);
+	if (numQueries == 0) {
+		return true;
+	}
+
+	// keep the tree alive for the duration of the queries
+	TriMeshAABBPtr tree = data->GetAABB();
+
+	ClosestPointsJob job;
+	job.tree = tree.get();
+	job.queries = queries;
+	job.points = &points[0];
+	job.indices = &indices[0];
+	job.distances = &distances[0];
+	IoParallelFor(queue, numQueries, ClosestPointsRange, &job);
+
+	return true;
+}
+
 bool Geomlib::TriMeshPerVertexClosestPoint(
 	const Urho3D::Variant& mesh,
 	const Urho3D::Variant& target_mesh,
 	Urho3D::VariantVector& closest_points
 )
 {
-	VariantVector vertex_list = TriMesh_GetVertexList(mesh);
+	ConstTriMeshDataPtr data = TriMesh_GetData(mesh);
+	ConstTriMeshDataPtr target = TriMesh_GetData(target_mesh);
 	closest_points.Clear();
+	if (!data || !target) {
+		return false;
+	}
 
-	for (int i = 0; i < vertex_list.Size(); ++i) {
-
-		Vector3 v = vertex_list[i].GetVector3();
+	TriMeshAABBPtr tree = target->GetAABB();
+	closest_points.Resize(data->GetNumVertices());
+	for (unsigned i = 0; i < data->GetNumVertices(); ++i) {
 
 		Vector3 p;
 		int f = -1;
-		TriMeshClosestPoint(target_mesh, v, f, p);
+		tree->ClosestPoint(data->GetVertex(i), f, p);
 
-		closest_points.Push(p);
+		closest_points[i] = p;
 	}
 
 	return true;
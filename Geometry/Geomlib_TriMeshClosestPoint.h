@@ -25,6 +25,10 @@
 #include <Urho3D/Core/Variant.h>
 #include <Urho3D/Math/Vector3.h>
 
+namespace Urho3D {
+class WorkQueue;
+}
+
 namespace Geomlib {
 
 	// Inputs
@@ -39,6 +43,25 @@ namespace Geomlib {
 		int& index, Urho3D::Vector3& p
 	);
 
+	// Batch version of TriMeshClosestPoint: the mesh's acceleration tree is built (or fetched) once
+	// and the queries are answered in parallel on queue's worker threads when one is given.
+	// Inputs
+	//   mesh: mesh data stored in Urho3D::Variant
+	//   queries, numQueries: contiguous array of query points
+	// Outputs (resized to numQueries)
+	//   points: closest point on mesh for each query
+	//   indices: index of the face containing points[i]
+	//   distances: distance from queries[i] to points[i]
+	bool TriMeshClosestPoints(
+		const Urho3D::Variant& mesh,
+		const Urho3D::Vector3* queries,
+		unsigned numQueries,
+		Urho3D::PODVector<Urho3D::Vector3>& points,
+		Urho3D::PODVector<int>& indices,
+		Urho3D::PODVector<float>& distances,
+		Urho3D::WorkQueue* queue = 0
+	);
+
 	bool TriMeshPerVertexClosestPoint(
 		const Urho3D::Variant& mesh,
 		const Urho3D::Variant& target_mesh,
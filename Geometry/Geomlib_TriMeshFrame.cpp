@@ -53,9 +53,8 @@ bool Geomlib::TriMeshFrame(
 		meshOut = Variant();
 		return false;
 	}
-	VariantMap meshMap = meshIn.GetVariantMap();
-	const VariantVector vertexList = meshMap["vertices"].GetVariantVector();
-	const VariantVector faceList = meshMap["faces"].GetVariantVector();
+	const VariantVector vertexList = TriMesh_GetVertexList(meshIn);
+	const VariantVector faceList = TriMesh_GetFaceList(meshIn);
 	VariantVector newFaceList;
 	VariantVector newVertexList = vertexList;
 
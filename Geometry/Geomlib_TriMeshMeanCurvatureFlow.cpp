@@ -22,147 +22,254 @@
 
 #include "Geomlib_TriMeshMeanCurvatureFlow.h"
 
-#pragma warning(push, 0)
-#include <igl/is_vertex_manifold.h>
-#include <igl/is_edge_manifold.h>
-#include <igl/cotmatrix.h>
-#include <igl/massmatrix.h>
-#include <igl/doublearea.h>
-#include <igl/barycenter.h>
-#pragma warning(pop)
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Urho3D/Container/Vector.h>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
+#include "IoParallelFor.h"
 #include "TriMesh.h"
-#include "ConversionUtilities.h"
+
+using Urho3D::PODVector;
+using Urho3D::Variant;
+using Urho3D::WorkQueue;
 
 namespace {
 
-bool IglMeanCurvatureStep(
-	const Eigen::MatrixXf& V,
-	const Eigen::MatrixXi& F,
-	Eigen::MatrixXf& NV,
-	Eigen::MatrixXi& NF
-)
+// time step of the implicit (backward Euler) update
+const float FLOW_TIME_STEP = 0.001f;
+
+// Implicit mean curvature flow on a fixed triangulation: each step solves (M - t L) U' = M U,
+// with L the cotangent Laplacian and M the barycentric mass matrix of the current positions.
+// The sparsity pattern of M - t L and its symbolic factorization only depend on the faces,
+// so they are set up once in Init; a step refills the matrix values in place and refactors numerically.
+class MeanCurvatureFlowEngine
 {
-	Eigen::MatrixXf U = V;
+public:
+	bool Init(const TriMeshData& mesh);
+	bool Step(WorkQueue* queue);
+	TriMeshDataPtr MakeMesh() const;
 
-	Eigen::SparseMatrix<float> L;
-	igl::cotmatrix(V, F, L);
+private:
+	static void FaceWeightsRange(void* data, unsigned begin, unsigned end);
+	int FindEntry(int row, int col) const;
 
-	Eigen::SparseMatrix<float> M;
-	igl::massmatrix(U, F, igl::MASSMATRIX_TYPE_BARYCENTRIC, M);
+	unsigned numVertices_;
+	unsigned numFaces_;
+	// current positions, 3 floats per vertex
+	PODVector<float> positions_;
+	PODVector<int> faces_;
+	// per face: half cotangents of the three corner angles, then the double area
+	PODVector<float> faceWeights_;
+	// per face and corner k: offsets into the matrix values of the two entries for the edge opposite k
+	PODVector<int> edgeEntries_;
+	// per vertex: offset into the matrix values of its diagonal entry
+	PODVector<int> diagonalEntries_;
+	PODVector<float> mass_;
+	Eigen::SparseMatrix<float> system_;
+	Eigen::SimplicialLLT<Eigen::SparseMatrix<float> > solver_;
+};
 
-	const auto & S = (M - 0.001f * L);
-	Eigen::SimplicialLLT<Eigen::SparseMatrix<float> > solver(S);
-	if (solver.info() != Eigen::Success) {
-		return false;
-	}
-	U = solver.solve(M * U).eval();
+bool MeanCurvatureFlowEngine::Init(const TriMeshData& mesh)
+{
+	numVertices_ = mesh.GetNumVertices();
+	numFaces_ = mesh.GetNumFaces();
+	positions_ = mesh.GetVertices();
+	faces_ = mesh.GetFaces();
+	faceWeights_.Resize(4 * numFaces_);
+	mass_.Resize(numVertices_);
 
-	// Compute centroid and subtract (also important for numerics)
-	Eigen::VectorXf doubleArea;
-	igl::doublearea(U, F, doubleArea);
-	float area = 0.5f * doubleArea.sum();
-	if (!(area > 0.0f)) { // we divide by it later
-		return false;
+	std::vector<Eigen::Triplet<float> > pattern;
+	pattern.reserve(numVertices_ + 6 * numFaces_);
+	for (unsigned i = 0; i < numVertices_; ++i) {
+		pattern.push_back(Eigen::Triplet<float>(i, i, 0.0f));
 	}
-
-	Eigen::MatrixXf BC;
-	igl::barycenter(U, F, doubleArea);
-	Eigen::RowVector3f centroid(0, 0, 0);
-	for (int i = 0; i < BC.rows(); ++i) {
-		centroid += (0.5f * doubleArea(i) / area) * BC.row(i);
+	for (unsigned f = 0; f < numFaces_; ++f) {
+		for (unsigned k = 0; k < 3; ++k) {
+			int j = faces_[3 * f + (k + 1) % 3];
+			int l = faces_[3 * f + (k + 2) % 3];
+			pattern.push_back(Eigen::Triplet<float>(j, l, 0.0f));
+			pattern.push_back(Eigen::Triplet<float>(l, j, 0.0f));
+		}
 	}
-	U.rowwise() -= centroid;
+	system_.resize(numVertices_, numVertices_);
+	system_.setFromTriplets(pattern.begin(), pattern.end());
+	system_.makeCompressed();
 
-	// Normalize to unit surface area (important for numerics)
-	if (!(sqrt(area) > 0.0f)) { // do you get 0.0f if you sqrt a really small float?
-		return false;
+	diagonalEntries_.Resize(numVertices_);
+	for (unsigned i = 0; i < numVertices_; ++i) {
+		diagonalEntries_[i] = FindEntry(i, i);
+	}
+	edgeEntries_.Resize(6 * numFaces_);
+	for (unsigned f = 0; f < numFaces_; ++f) {
+		for (unsigned k = 0; k < 3; ++k) {
+			int j = faces_[3 * f + (k + 1) % 3];
+			int l = faces_[3 * f + (k + 2) % 3];
+			edgeEntries_[6 * f + 2 * k] = FindEntry(j, l);
+			edgeEntries_[6 * f + 2 * k + 1] = FindEntry(l, j);
+		}
 	}
-	U.array() /= sqrt(area);
 
-	NV = U;
-	NF = F;
+	solver_.analyzePattern(system_);
+	return solver_.info() == Eigen::Success;
+}
 
-	return true;
+int MeanCurvatureFlowEngine::FindEntry(int row, int col) const
+{
+	const int* begin = system_.innerIndexPtr() + system_.outerIndexPtr()[col];
+	const int* end = system_.innerIndexPtr() + system_.outerIndexPtr()[col + 1];
+	return (int)(std::lower_bound(begin, end, row) - system_.innerIndexPtr());
 }
 
-} //
+// same cotangent and area terms as igl::cotmatrix and igl::massmatrix, one face at a time
+void MeanCurvatureFlowEngine::FaceWeightsRange(void* data, unsigned begin, unsigned end)
+{
+	MeanCurvatureFlowEngine* engine = static_cast<MeanCurvatureFlowEngine*>(data);
+	const float* positions = &engine->positions_[0];
+	const int* faces = &engine->faces_[0];
+	for (unsigned f = begin; f < end; ++f) {
+		Eigen::Map<const Eigen::Vector3f> p0(positions + 3 * faces[3 * f]);
+		Eigen::Map<const Eigen::Vector3f> p1(positions + 3 * faces[3 * f + 1]);
+		Eigen::Map<const Eigen::Vector3f> p2(positions + 3 * faces[3 * f + 2]);
 
-using Urho3D::Variant;
+		// squared length of the edge opposite each corner
+		float l0 = (p1 - p2).squaredNorm();
+		float l1 = (p2 - p0).squaredNorm();
+		float l2 = (p0 - p1).squaredNorm();
+		float dblA = (p1 - p0).cross(p2 - p0).norm();
 
-Urho3D::Variant Geomlib::TriMesh_MeanCurvatureFlowStep(
-	const Urho3D::Variant& tri_mesh
-)
+		float* weights = &engine->faceWeights_[4 * f];
+		weights[0] = (l1 + l2 - l0) / dblA / 4.0f;
+		weights[1] = (l2 + l0 - l1) / dblA / 4.0f;
+		weights[2] = (l0 + l1 - l2) / dblA / 4.0f;
+		weights[3] = dblA;
+	}
+}
+
+bool MeanCurvatureFlowEngine::Step(WorkQueue* queue)
 {
-	if (!TriMesh_Verify(tri_mesh)) {
-		return Variant();
+	IoParallelFor(queue, numFaces_, FaceWeightsRange, this);
+
+	// assemble M - t L into the fixed pattern
+	float* values = system_.valuePtr();
+	std::fill(values, values + system_.nonZeros(), 0.0f);
+	std::fill(mass_.Begin(), mass_.End(), 0.0f);
+	for (unsigned f = 0; f < numFaces_; ++f) {
+		const float* weights = &faceWeights_[4 * f];
+		for (unsigned k = 0; k < 3; ++k) {
+			float w = FLOW_TIME_STEP * weights[k];
+			values[edgeEntries_[6 * f + 2 * k]] -= w;
+			values[edgeEntries_[6 * f + 2 * k + 1]] -= w;
+			values[diagonalEntries_[faces_[3 * f + (k + 1) % 3]]] += w;
+			values[diagonalEntries_[faces_[3 * f + (k + 2) % 3]]] += w;
+			mass_[faces_[3 * f + k]] += weights[3] / 6.0f;
+		}
+	}
+	for (unsigned i = 0; i < numVertices_; ++i) {
+		values[diagonalEntries_[i]] += mass_[i];
 	}
 
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	IglMeshToMatrices(tri_mesh, V, F);
+	solver_.factorize(system_);
+	if (solver_.info() != Eigen::Success) {
+		return false;
+	}
 
-	/*
-	if (!igl::is_edge_manifold(V, F)) {
-		return Variant();
+	typedef Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3f;
+	Eigen::Map<RowMatrixX3f> U(&positions_[0], numVertices_, 3);
+	Eigen::Map<const Eigen::VectorXf> M(&mass_[0], numVertices_);
+	RowMatrixX3f B = M.asDiagonal() * U;
+	U = solver_.solve(B);
+	if (solver_.info() != Eigen::Success) {
+		return false;
 	}
-	Eigen::VectorXi B;
-	if (!igl::is_vertex_manifold(F, B)) {
-		return Variant();
+
+	// Compute centroid and subtract (also important for numerics)
+	double area = 0.0;
+	Eigen::Vector3d centroid(0, 0, 0);
+	for (unsigned f = 0; f < numFaces_; ++f) {
+		Eigen::Vector3f p0 = U.row(faces_[3 * f]);
+		Eigen::Vector3f p1 = U.row(faces_[3 * f + 1]);
+		Eigen::Vector3f p2 = U.row(faces_[3 * f + 2]);
+		double dblA = (p1 - p0).cross(p2 - p0).norm();
+		area += 0.5 * dblA;
+		centroid += (0.5 * dblA / 3.0) * (p0 + p1 + p2).cast<double>();
 	}
-	*/
+	if (!(area > 0.0)) { // we divide by it later
+		return false;
+	}
+	U.rowwise() -= (centroid / area).cast<float>().transpose();
 
-	// V, F are ok
-	Eigen::MatrixXf NV;
-	Eigen::MatrixXi NF;
-	bool success = IglMeanCurvatureStep(V, F, NV, NF);
-	if (!success) {
-		return Variant();
+	// Normalize to unit surface area (important for numerics)
+	float scale = (float)std::sqrt(area);
+	if (!(scale > 0.0f)) {
+		return false;
 	}
+	U.array() /= scale;
 
-	return TriMesh_Make(NV, NF);
+	return true;
 }
 
-bool Geomlib::TriMesh_MeanCurvatureFlow(
-	const Urho3D::Variant& tri_mesh,
+TriMeshDataPtr MeanCurvatureFlowEngine::MakeMesh() const
+{
+	return TriMeshDataPtr(new TriMeshData(&positions_[0], numVertices_, &faces_[0], numFaces_));
+}
+
+bool RunMeanCurvatureFlow(
+	const Variant& tri_mesh,
 	int num_steps,
-	Urho3D::Variant& tri_mesh_out
+	WorkQueue* queue,
+	Variant& tri_mesh_out
 )
 {
-	if (!TriMesh_Verify(tri_mesh)) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data || data->GetNumVertices() == 0 || data->GetNumFaces() == 0) {
 		return false;
 	}
-	if (num_steps <= 0) {
+
+	MeanCurvatureFlowEngine engine;
+	if (!engine.Init(*data)) {
 		return false;
 	}
 
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	IglMeshToMatrices(tri_mesh, V, F);
-
-	// V, F are ok here
-
 	for (int i = 0; i < num_steps; ++i) {
-
-		Eigen::MatrixXf VV;
-		Eigen::MatrixXi FF;
-		bool success = IglMeanCurvatureStep(V, F, VV, FF);
-		if (!success) {
+		if (!engine.Step(queue)) {
 			return false;
 		}
-		V.setZero(VV.rows(), VV.cols());
-		V = VV;
-		F.setZero(FF.rows(), FF.cols());
-		F = FF;
 	}
 
-	tri_mesh_out = TriMesh_Make(V, F);
-	if (!TriMesh_Verify(tri_mesh_out)) {
+	tri_mesh_out = TriMesh_Make(engine.MakeMesh());
+	return TriMesh_Verify(tri_mesh_out);
+}
+
+} //
+
+Urho3D::Variant Geomlib::TriMesh_MeanCurvatureFlowStep(
+	const Urho3D::Variant& tri_mesh
+)
+{
+	Variant tri_mesh_out;
+	if (!RunMeanCurvatureFlow(tri_mesh, 1, 0, tri_mesh_out)) {
+		return Variant();
+	}
+
+	return tri_mesh_out;
+}
+
+bool Geomlib::TriMesh_MeanCurvatureFlow(
+	const Urho3D::Variant& tri_mesh,
+	int num_steps,
+	Urho3D::Variant& tri_mesh_out,
+	Urho3D::WorkQueue* queue
+)
+{
+	if (num_steps <= 0) {
 		return false;
 	}
-	return true;
-}
\ No newline at end of file
+
+	return RunMeanCurvatureFlow(tri_mesh, num_steps, queue, tri_mesh_out);
+}
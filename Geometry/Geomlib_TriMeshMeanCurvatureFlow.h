@@ -24,16 +24,24 @@
 
 #include <Urho3D/Core/Variant.h>
 
+namespace Urho3D {
+class WorkQueue;
+}
+
 namespace Geomlib {
 
 Urho3D::Variant TriMesh_MeanCurvatureFlowStep(
 	const Urho3D::Variant& tri_mesh
 );
 
+// Runs num_steps implicit steps on the mesh's positions; the system's sparsity pattern and symbolic
+// factorization are set up once for all steps. The per-face cotangent weights are computed on queue's
+// worker threads when one is given.
 bool TriMesh_MeanCurvatureFlow(
 	const Urho3D::Variant& tri_mesh,
 	int num_steps,
-	Urho3D::Variant& tri_mesh_out
+	Urho3D::Variant& tri_mesh_out,
+	Urho3D::WorkQueue* queue = 0
 );
 
 }
\ No newline at end of file
@@ -0,0 +1,690 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include "Geomlib_TriMeshRemesh.h"
+
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include "TriMesh.h"
+#include "TriMeshAABB.h"
+
+using Urho3D::PODVector;
+using Urho3D::Variant;
+using Urho3D::Vector3;
+
+namespace {
+
+// An edge waiting to be split or collapsed. Entries are left in the queue when the mesh changes
+// around them; the halfedge's endpoints and length are checked again when the entry comes up.
+struct EdgeEntry
+{
+	float length;
+	int halfedge;
+	int from;
+	int to;
+};
+
+struct LongerFirst
+{
+	bool operator()(const EdgeEntry& a, const EdgeEntry& b) const { return a.length < b.length; }
+};
+
+struct ShorterFirst
+{
+	bool operator()(const EdgeEntry& a, const EdgeEntry& b) const { return a.length > b.length; }
+};
+
+/*==============================================================================
+Triangles stored as directed edges: halfedge h belongs to face h / 3 and runs
+from corners_[h] to corners_[Next(h)]. twins_[h] is the opposite halfedge, or -1
+on the border. Removed faces keep their slots with all corners set to -1.
+==============================================================================*/
+class RemeshEngine
+{
+public:
+	bool Init(const TriMeshData& mesh);
+	void Remesh(float targetLength, float tolerance, int numSteps);
+	TriMeshDataPtr MakeMesh() const;
+
+private:
+	static int Next(int h) { return h % 3 == 2 ? h - 2 : h + 1; }
+	static int Prev(int h) { return h % 3 == 0 ? h + 2 : h - 1; }
+	int From(int h) const { return corners_[h]; }
+	int To(int h) const { return corners_[Next(h)]; }
+	int Opposite(int h) const { return corners_[Prev(h)]; }
+	bool IsFaceAlive(int f) const { return corners_[3 * f] >= 0; }
+	unsigned NumHalfedges() const { return corners_.Size(); }
+	float Length(int h) const { return (positions_[To(h)] - positions_[From(h)]).Length(); }
+	bool IsInteriorEdge(int h) const { return twins_[h] >= 0 && !border_[From(h)] && !border_[To(h)]; }
+	bool IsCurrent(const EdgeEntry& entry) const;
+	Vector3 FaceNormal(int a, int b, int c) const;
+
+	// outgoing halfedges of an interior vertex, in order around it
+	void GetRing(int v, PODVector<int>& ring) const;
+	// outgoing halfedge of from ending at to, or -1
+	int FindHalfedge(int from, int to) const;
+	int AddFace();
+	// sets the corners of faces (three per face, -1 to remove it) and links the twins of their halfedges again
+	void ReplaceFaces(const PODVector<int>& faces, const PODVector<int>& corners);
+
+	void SplitEdge(int h);
+	bool CollapseEdge(int h, float high);
+	bool FlipEdge(int h);
+
+	float AverageEdgeLength() const;
+	void SplitLongEdges(float high);
+	void CollapseShortEdges(float low, float high);
+	void FlipEdges();
+	void RelaxVertices();
+
+	PODVector<Vector3> positions_;
+	PODVector<bool> border_;
+	PODVector<int> valence_;
+	// an outgoing halfedge per vertex, -1 when the vertex is not used by any face
+	PODVector<int> vertexHalfedges_;
+	PODVector<int> corners_;
+	PODVector<int> twins_;
+	// the input mesh, which relaxed vertices are projected back onto
+	std::shared_ptr<const TriMeshAABB> surface_;
+};
+
+bool RemeshEngine::Init(const TriMeshData& mesh)
+{
+	unsigned numVertices = mesh.GetNumVertices();
+	positions_.Resize(numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		positions_[i] = mesh.GetVertex(i);
+	}
+	corners_ = mesh.GetFaces();
+	twins_.Resize(NumHalfedges());
+	surface_ = mesh.GetAABB();
+
+	// match the halfedges by their endpoints; a repeated directed edge means the mesh is
+	// not edge manifold or not consistently oriented
+	std::unordered_map<unsigned long long, int> halfedges;
+	halfedges.reserve(NumHalfedges());
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (From(h) == To(h) || From(h) == Opposite(h) || To(h) == Opposite(h)) {
+			return false;
+		}
+		unsigned long long key = ((unsigned long long)From(h) << 32) | (unsigned)To(h);
+		if (!halfedges.insert(std::make_pair(key, (int)h)).second) {
+			return false;
+		}
+	}
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		unsigned long long key = ((unsigned long long)To(h) << 32) | (unsigned)From(h);
+		std::unordered_map<unsigned long long, int>::const_iterator it = halfedges.find(key);
+		twins_[h] = it == halfedges.end() ? -1 : it->second;
+	}
+
+	border_.Resize(numVertices);
+	valence_.Resize(numVertices);
+	vertexHalfedges_.Resize(numVertices);
+	PODVector<int> numFaces(numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		border_[i] = false;
+		valence_[i] = 0;
+		vertexHalfedges_[i] = -1;
+		numFaces[i] = 0;
+	}
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (twins_[h] < 0) {
+			border_[From(h)] = true;
+			border_[To(h)] = true;
+		}
+		if (twins_[h] < 0 || (int)h < twins_[h]) {
+			++valence_[From(h)];
+			++valence_[To(h)];
+		}
+		vertexHalfedges_[From(h)] = h;
+		++numFaces[From(h)];
+	}
+
+	// vertex manifold: the faces around each vertex form a single fan
+	for (unsigned v = 0; v < numVertices; ++v) {
+		int start = vertexHalfedges_[v];
+		if (start < 0) {
+			continue;
+		}
+		// on the border, turn back to the first face of the fan
+		int h = start;
+		while (twins_[h] >= 0 && Next(twins_[h]) != start) {
+			h = Next(twins_[h]);
+		}
+		if (twins_[h] >= 0) {
+			h = start;
+		}
+		int first = h;
+		int count = 0;
+		do {
+			++count;
+			h = twins_[Prev(h)];
+		} while (h >= 0 && h != first && count <= numFaces[v]);
+		if (count != numFaces[v]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Vector3 RemeshEngine::FaceNormal(int a, int b, int c) const
+{
+	return (positions_[b] - positions_[a]).CrossProduct(positions_[c] - positions_[a]);
+}
+
+bool RemeshEngine::IsCurrent(const EdgeEntry& entry) const
+{
+	int h = entry.halfedge;
+	return IsFaceAlive(h / 3) && From(h) == entry.from && To(h) == entry.to;
+}
+
+void RemeshEngine::GetRing(int v, PODVector<int>& ring) const
+{
+	ring.Clear();
+	int start = vertexHalfedges_[v];
+	int h = start;
+	do {
+		ring.Push(h);
+		h = twins_[Prev(h)];
+	} while (h >= 0 && h != start);
+}
+
+int RemeshEngine::FindHalfedge(int from, int to) const
+{
+	int start = vertexHalfedges_[from];
+	if (start < 0) {
+		return -1;
+	}
+
+	int h = start;
+	do {
+		if (To(h) == to) {
+			return h;
+		}
+		h = twins_[Prev(h)];
+	} while (h >= 0 && h != start);
+
+	// hit the border: the rest of the fan lies the other way round
+	if (h < 0) {
+		h = start;
+		while (twins_[h] >= 0) {
+			h = Next(twins_[h]);
+			if (To(h) == to) {
+				return h;
+			}
+		}
+	}
+	return -1;
+}
+
+int RemeshEngine::AddFace()
+{
+	int f = corners_.Size() / 3;
+	for (unsigned k = 0; k < 3; ++k) {
+		corners_.Push(-1);
+		twins_.Push(-1);
+	}
+	return f;
+}
+
+void RemeshEngine::ReplaceFaces(const PODVector<int>& faces, const PODVector<int>& corners)
+{
+	// the halfedges across from the rewritten faces stay valid and are matched again by their endpoints
+	PODVector<int> outside;
+	for (unsigned i = 0; i < faces.Size(); ++i) {
+		for (unsigned k = 0; k < 3; ++k) {
+			int t = twins_[3 * faces[i] + k];
+			if (t >= 0 && !faces.Contains(t / 3)) {
+				outside.Push(t);
+				twins_[t] = -1;
+			}
+		}
+	}
+
+	for (unsigned i = 0; i < faces.Size(); ++i) {
+		for (unsigned k = 0; k < 3; ++k) {
+			corners_[3 * faces[i] + k] = corners[3 * i + k];
+			twins_[3 * faces[i] + k] = -1;
+		}
+	}
+
+	for (unsigned i = 0; i < faces.Size(); ++i) {
+		if (!IsFaceAlive(faces[i])) {
+			continue;
+		}
+		for (unsigned k = 0; k < 3; ++k) {
+			int h = 3 * faces[i] + k;
+			vertexHalfedges_[From(h)] = h;
+			if (twins_[h] >= 0) {
+				continue;
+			}
+			for (unsigned j = 0; j < faces.Size() && twins_[h] < 0; ++j) {
+				if (!IsFaceAlive(faces[j])) {
+					continue;
+				}
+				for (unsigned l = 0; l < 3; ++l) {
+					int o = 3 * faces[j] + l;
+					if (From(o) == To(h) && To(o) == From(h)) {
+						twins_[h] = o;
+						twins_[o] = h;
+						break;
+					}
+				}
+			}
+			for (unsigned j = 0; j < outside.Size() && twins_[h] < 0; ++j) {
+				int o = outside[j];
+				if (From(o) == To(h) && To(o) == From(h)) {
+					twins_[h] = o;
+					twins_[o] = h;
+				}
+			}
+		}
+	}
+}
+
+void RemeshEngine::SplitEdge(int h)
+{
+	int t = twins_[h];
+	int a = From(h);
+	int b = To(h);
+	int c = Opposite(h);
+	int d = Opposite(t);
+
+	int m = positions_.Size();
+	positions_.Push(0.5f * (positions_[a] + positions_[b]));
+	border_.Push(false);
+	valence_.Push(4);
+	vertexHalfedges_.Push(-1);
+	++valence_[c];
+	++valence_[d];
+
+	PODVector<int> faces;
+	faces.Push(h / 3);
+	faces.Push(t / 3);
+	faces.Push(AddFace());
+	faces.Push(AddFace());
+
+	// (a, b, c) and (b, a, d) become (a, m, c), (b, m, d), (m, b, c) and (m, a, d)
+	int corners[] = { a, m, c, b, m, d, m, b, c, m, a, d };
+	ReplaceFaces(faces, PODVector<int>(corners, 12));
+}
+
+bool RemeshEngine::CollapseEdge(int h, float high)
+{
+	int t = twins_[h];
+	int a = From(h);
+	int b = To(h);
+	int c = Opposite(h);
+	int d = Opposite(t);
+
+	// the vertices across from the edge would be left with two neighbours
+	if (valence_[c] <= 3 || valence_[d] <= 3) {
+		return false;
+	}
+
+	PODVector<int> ringA, ringB;
+	GetRing(a, ringA);
+	GetRing(b, ringB);
+
+	// link condition: a and b may only share the neighbours c and d
+	for (unsigned i = 0; i < ringA.Size(); ++i) {
+		int n = To(ringA[i]);
+		if (n == b || n == c || n == d) {
+			continue;
+		}
+		for (unsigned j = 0; j < ringB.Size(); ++j) {
+			if (To(ringB[j]) == n) {
+				return false;
+			}
+		}
+	}
+
+	// no edge may become long enough to be split again, and no face may fold over
+	Vector3 mid = 0.5f * (positions_[a] + positions_[b]);
+	for (unsigned r = 0; r < 2; ++r) {
+		const PODVector<int>& ring = r == 0 ? ringA : ringB;
+		int v = r == 0 ? a : b;
+		for (unsigned i = 0; i < ring.Size(); ++i) {
+			int n0 = To(ring[i]);
+			int n1 = Opposite(ring[i]);
+			if ((positions_[n0] - mid).Length() > high) {
+				return false;
+			}
+			if (n0 == a || n0 == b || n1 == a || n1 == b) {
+				continue;
+			}
+			Vector3 before = FaceNormal(v, n0, n1);
+			Vector3 after = (positions_[n0] - mid).CrossProduct(positions_[n1] - mid);
+			if (before.DotProduct(after) <= 0.0f) {
+				return false;
+			}
+		}
+	}
+
+	PODVector<int> faces;
+	PODVector<int> corners;
+	for (unsigned i = 0; i < ringB.Size(); ++i) {
+		int f = ringB[i] / 3;
+		faces.Push(f);
+		for (unsigned k = 0; k < 3; ++k) {
+			int v = corners_[3 * f + k];
+			if (f == h / 3 || f == t / 3) {
+				v = -1;
+			}
+			else if (v == b) {
+				v = a;
+			}
+			corners.Push(v);
+		}
+	}
+
+	positions_[a] = mid;
+	valence_[a] += valence_[b] - 4;
+	valence_[b] = 0;
+	--valence_[c];
+	--valence_[d];
+	ReplaceFaces(faces, corners);
+	vertexHalfedges_[b] = -1;
+
+	return true;
+}
+
+bool RemeshEngine::FlipEdge(int h)
+{
+	int t = twins_[h];
+	int a = From(h);
+	int b = To(h);
+	int c = Opposite(h);
+	int d = Opposite(t);
+
+	if (c == d || valence_[a] <= 3 || valence_[b] <= 3) {
+		return false;
+	}
+
+	// flip if it brings the four vertices closer to the ideal valence: 6 inside, 4 on the border
+	int deviation = 0;
+	int flippedDeviation = 0;
+	int vertices[] = { a, b, c, d };
+	int change[] = { -1, -1, 1, 1 };
+	for (unsigned i = 0; i < 4; ++i) {
+		int ideal = border_[vertices[i]] ? 4 : 6;
+		deviation += Urho3D::Abs(valence_[vertices[i]] - ideal);
+		flippedDeviation += Urho3D::Abs(valence_[vertices[i]] + change[i] - ideal);
+	}
+	if (flippedDeviation >= deviation) {
+		return false;
+	}
+
+	// the new edge must not exist already, and the new faces must face the same way as the old ones
+	if (FindHalfedge(c, d) >= 0 || FindHalfedge(d, c) >= 0) {
+		return false;
+	}
+	Vector3 normal = FaceNormal(a, b, c) + FaceNormal(b, a, d);
+	if (FaceNormal(a, d, c).DotProduct(normal) <= 0.0f || FaceNormal(d, b, c).DotProduct(normal) <= 0.0f) {
+		return false;
+	}
+
+	--valence_[a];
+	--valence_[b];
+	++valence_[c];
+	++valence_[d];
+
+	PODVector<int> faces;
+	faces.Push(h / 3);
+	faces.Push(t / 3);
+
+	// (a, b, c) and (b, a, d) become (a, d, c) and (d, b, c)
+	int corners[] = { a, d, c, d, b, c };
+	ReplaceFaces(faces, PODVector<int>(corners, 6));
+	return true;
+}
+
+float RemeshEngine::AverageEdgeLength() const
+{
+	double sum = 0.0;
+	unsigned count = 0;
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (!IsFaceAlive(h / 3) || (twins_[h] >= 0 && twins_[h] < (int)h)) {
+			continue;
+		}
+		sum += Length(h);
+		++count;
+	}
+	return count > 0 ? (float)(sum / count) : 0.0f;
+}
+
+void RemeshEngine::SplitLongEdges(float high)
+{
+	std::priority_queue<EdgeEntry, std::vector<EdgeEntry>, LongerFirst> queue;
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (IsFaceAlive(h / 3) && (int)h < twins_[h] && IsInteriorEdge(h)) {
+			EdgeEntry entry = { Length(h), (int)h, From(h), To(h) };
+			if (entry.length > high) {
+				queue.push(entry);
+			}
+		}
+	}
+
+	// longest first, so that the new vertices end up spread evenly over a long edge
+	PODVector<int> ring;
+	while (!queue.empty()) {
+		EdgeEntry entry = queue.top();
+		queue.pop();
+		if (!IsCurrent(entry)) {
+			continue;
+		}
+
+		SplitEdge(entry.halfedge);
+
+		// the rewritten faces moved their edges to other halfedges, so queue all of them again
+		int m = positions_.Size() - 1;
+		GetRing(m, ring);
+		for (unsigned i = 0; i < ring.Size(); ++i) {
+			for (unsigned k = 0; k < 2; ++k) {
+				int g = k == 0 ? ring[i] : Next(ring[i]);
+				if (IsInteriorEdge(g)) {
+					EdgeEntry next = { Length(g), g, From(g), To(g) };
+					if (next.length > high) {
+						queue.push(next);
+					}
+				}
+			}
+		}
+	}
+}
+
+void RemeshEngine::CollapseShortEdges(float low, float high)
+{
+	std::priority_queue<EdgeEntry, std::vector<EdgeEntry>, ShorterFirst> queue;
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (IsFaceAlive(h / 3) && (int)h < twins_[h] && IsInteriorEdge(h)) {
+			EdgeEntry entry = { Length(h), (int)h, From(h), To(h) };
+			if (entry.length < low) {
+				queue.push(entry);
+			}
+		}
+	}
+
+	// shortest first; the lengths are checked again since collapses move the surviving vertex
+	PODVector<int> ring;
+	while (!queue.empty()) {
+		EdgeEntry entry = queue.top();
+		queue.pop();
+		if (!IsCurrent(entry) || !(Length(entry.halfedge) < low)) {
+			continue;
+		}
+
+		if (!CollapseEdge(entry.halfedge, high)) {
+			continue;
+		}
+
+		GetRing(entry.from, ring);
+		for (unsigned i = 0; i < ring.Size(); ++i) {
+			for (unsigned k = 0; k < 2; ++k) {
+				int g = k == 0 ? ring[i] : Next(ring[i]);
+				if (IsInteriorEdge(g)) {
+					EdgeEntry next = { Length(g), g, From(g), To(g) };
+					if (next.length < low) {
+						queue.push(next);
+					}
+				}
+			}
+		}
+	}
+}
+
+void RemeshEngine::FlipEdges()
+{
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (IsFaceAlive(h / 3) && (int)h < twins_[h]) {
+			FlipEdge(h);
+		}
+	}
+}
+
+void RemeshEngine::RelaxVertices()
+{
+	// move every interior vertex towards the centroid of its neighbours, within its tangent plane,
+	// then back onto the input surface, which the tangential move alone leaves on curved meshes
+	PODVector<Vector3> relaxed = positions_;
+	PODVector<int> ring;
+	for (unsigned v = 0; v < positions_.Size(); ++v) {
+		if (border_[v] || vertexHalfedges_[v] < 0) {
+			continue;
+		}
+
+		GetRing(v, ring);
+		Vector3 centroid = Vector3::ZERO;
+		Vector3 normal = Vector3::ZERO;
+		for (unsigned i = 0; i < ring.Size(); ++i) {
+			centroid += positions_[To(ring[i])];
+			normal += FaceNormal(v, To(ring[i]), Opposite(ring[i]));
+		}
+		if (normal.LengthSquared() == 0.0f) {
+			continue;
+		}
+		centroid /= (float)ring.Size();
+		normal.Normalize();
+
+		Vector3 offset = centroid - positions_[v];
+		Vector3 moved = positions_[v] + offset - normal.DotProduct(offset) * normal;
+		if (surface_) {
+			int face;
+			Vector3 closest;
+			surface_->ClosestPoint(moved, face, closest);
+			moved = closest;
+		}
+
+		// stay put where the move would fold one of the faces around the vertex
+		bool folds = false;
+		for (unsigned i = 0; i < ring.Size() && !folds; ++i) {
+			const Vector3& p0 = positions_[To(ring[i])];
+			const Vector3& p1 = positions_[Opposite(ring[i])];
+			Vector3 after = (p0 - moved).CrossProduct(p1 - moved);
+			folds = after.DotProduct(FaceNormal(v, To(ring[i]), Opposite(ring[i]))) <= 0.0f;
+		}
+		if (!folds) {
+			relaxed[v] = moved;
+		}
+	}
+	positions_ = relaxed;
+}
+
+void RemeshEngine::Remesh(float targetLength, float tolerance, int numSteps)
+{
+	for (int i = 0; i < numSteps; ++i) {
+		float length = targetLength > 0.0f ? targetLength : AverageEdgeLength();
+		if (!(length > 0.0f)) {
+			break;
+		}
+
+		float high = (1.0f + tolerance) * length;
+		float low = (1.0f - tolerance) * length;
+		SplitLongEdges(high);
+		CollapseShortEdges(low, high);
+		FlipEdges();
+		RelaxVertices();
+	}
+}
+
+TriMeshDataPtr RemeshEngine::MakeMesh() const
+{
+	// drop the removed faces and the vertices no face uses any more
+	PODVector<int> remap(positions_.Size());
+	for (unsigned i = 0; i < remap.Size(); ++i) {
+		remap[i] = -1;
+	}
+
+	PODVector<float> vertices;
+	PODVector<int> faces;
+	vertices.Reserve(3 * positions_.Size());
+	faces.Reserve(NumHalfedges());
+	for (unsigned h = 0; h < NumHalfedges(); ++h) {
+		if (!IsFaceAlive(h / 3)) {
+			continue;
+		}
+		int v = From(h);
+		if (remap[v] < 0) {
+			remap[v] = vertices.Size() / 3;
+			vertices.Push(positions_[v].x_);
+			vertices.Push(positions_[v].y_);
+			vertices.Push(positions_[v].z_);
+		}
+		faces.Push(remap[v]);
+	}
+
+	return TriMeshDataPtr(new TriMeshData(
+		vertices.Empty() ? 0 : &vertices[0], vertices.Size() / 3,
+		faces.Empty() ? 0 : &faces[0], faces.Size() / 3));
+}
+
+} // namespace
+
+Urho3D::Variant Geomlib::TriMesh_Remesh(
+	const Urho3D::Variant& tri_mesh,
+	float target_length,
+	float tolerance,
+	int num_steps
+)
+{
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
+		return Variant();
+	}
+
+	RemeshEngine engine;
+	if (!engine.Init(*data)) {
+		return Variant();
+	}
+
+	engine.Remesh(target_length, tolerance, num_steps);
+
+	return TriMesh_Make(engine.MakeMesh());
+}
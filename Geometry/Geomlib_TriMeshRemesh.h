@@ -0,0 +1,43 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#pragma once
+
+#include <Urho3D/Core/Variant.h>
+
+namespace Geomlib {
+
+// Isotropic remeshing of a manifold TriMesh. Every step splits the edges longer than (1 + tolerance) * target,
+// collapses the edges shorter than (1 - tolerance) * target, flips edges to even out the vertex valences and
+// relaxes the vertices in their tangent planes. All steps work in place on one half-edge structure built from
+// the input; border vertices are kept where they are.
+// target_length <= 0 uses the average edge length of the current mesh at every step.
+// Returns an empty Variant if tri_mesh is not an edge and vertex manifold TriMesh.
+Urho3D::Variant TriMesh_Remesh(
+	const Urho3D::Variant& tri_mesh,
+	float target_length,
+	float tolerance,
+	int num_steps
+);
+
+}
@@ -53,9 +53,8 @@ bool Geomlib::TriMeshWindow(
 		meshOut = Variant();
 		return false;
 	}
-	VariantMap meshMap = meshIn.GetVariantMap();
-	VariantVector vertexList = meshMap["vertices"].GetVariantVector();
-	VariantVector faceList = meshMap["faces"].GetVariantVector();
+	VariantVector vertexList = TriMesh_GetVertexList(meshIn);
+	VariantVector faceList = TriMesh_GetFaceList(meshIn);
 
 	VariantVector newVertexList;
 	VariantVector newFaceList;
@@ -21,11 +21,7 @@
 
 #include "Geomlib_WriteOBJ.h"
 
-#include <Eigen/Core>
-
-#include <igl/writeOBJ.h>
-
-#include "ConversionUtilities.h"
+#include "Geomlib_MeshWrite.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
@@ -36,20 +32,10 @@ bool Geomlib::WriteOBJ(
 	bool zup
 )
 {
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	bool val = IglMeshToMatrices(tri_mesh, V, F);
-	if (!val) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
 		return false;
 	}
 
-	if (zup) {
-		Eigen::MatrixXf W = V;
-		W.col(1) = -1 * V.col(2);
-		W.col(2) = V.col(1);
-		V = W;
-	}
-
-	bool write_success = igl::writeOBJ(obj_filename.CString(), V, F);
-	return write_success;
+	return WriteMesh(*data, obj_filename, MESH_OBJ, zup);
 }
\ No newline at end of file
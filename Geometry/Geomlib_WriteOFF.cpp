@@ -21,11 +21,7 @@
 
 #include "Geomlib_WriteOFF.h"
 
-#include <Eigen/Core>
-
-#include <igl/writeOFF.h>
-
-#include "ConversionUtilities.h"
+#include "Geomlib_MeshWrite.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
@@ -36,20 +32,10 @@ bool Geomlib::WriteOFF(
 	bool zup
 )
 {
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	bool val = IglMeshToMatrices(tri_mesh, V, F);
-	if (!val) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
 		return false;
 	}
 
-	if (zup) {
-		Eigen::MatrixXf W = V;
-		W.col(1) = -1 * V.col(2);
-		W.col(2) = V.col(1);
-		V = W;
-	}
-
-	bool write_success = igl::writeOFF(off_filename.CString(), V, F);
-	return write_success;
+	return WriteMesh(*data, off_filename, MESH_OFF, zup);
 }
\ No newline at end of file
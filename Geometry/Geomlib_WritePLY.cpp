@@ -21,11 +21,7 @@
 
 #include "Geomlib_WritePLY.h"
 
-#include <Eigen/Core>
-
-#include <igl/writePLY.h>
-
-#include "ConversionUtilities.h"
+#include "Geomlib_MeshWrite.h"
 #include "TriMesh.h"
 
 using namespace Urho3D;
@@ -33,23 +29,14 @@ using namespace Urho3D;
 bool Geomlib::WritePLY(
 	const Urho3D::String& ply_filename,
 	const Urho3D::Variant& tri_mesh,
-	bool zup
+	bool zup,
+	bool binary
 )
 {
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	bool val = IglMeshToMatrices(tri_mesh, V, F);
-	if (!val) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
 		return false;
 	}
 
-	if (zup) {
-		Eigen::MatrixXf W = V;
-		W.col(1) = -1 * V.col(2);
-		W.col(2) = V.col(1);
-		V = W;
-	}
-
-	bool write_success = igl::writePLY(ply_filename.CString(), V, F);
-	return write_success;
+	return WriteMesh(*data, ply_filename, binary ? MESH_PLY_BINARY : MESH_PLY_ASCII, zup);
 }
\ No newline at end of file
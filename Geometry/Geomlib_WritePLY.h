@@ -29,7 +29,8 @@ namespace Geomlib {
 bool WritePLY(
 	const Urho3D::String& ply_filename,
 	const Urho3D::Variant& tri_mesh,
-	bool zup = false
+	bool zup = false,
+	bool binary = false
 );
 
 }
\ No newline at end of file
@@ -127,7 +127,7 @@ void WriteDxf(
 
 		//only support triangle meshes right now
 		if (TriMesh_Verify((*mMap))) {
-			dWriter->SetMesh((*mMap)["vertices"].GetVariantVector(), (*mMap)["faces"].GetVariantVector(), layer);
+			dWriter->SetMesh(TriMesh_GetVertexList(meshes[i]), TriMesh_GetFaceList(meshes[i]), layer);
 		}
 		else if (NMesh_Verify((*mMap))) {
 			Variant triMesh = NMesh_ConvertToTriMesh(*mMap);
@@ -387,6 +387,17 @@ bool RayTriangleIntersection(
 	return Geomlib::RayTriangleIntersection(A, B, C, O, D, s);
 }
 
+bool TriMeshRayIntersection(
+	const Urho3D::Variant& mesh,
+	const Urho3D::Vector3& O,
+	const Urho3D::Vector3& D,
+	int& index,
+	float& s
+)
+{
+	return Geomlib::TriMeshRayIntersection(mesh, O, D, index, s);
+}
+
 bool ReadOBJFromFilename(
 	const Urho3D::String& obj_filename,
 	Urho3D::Variant& tri_mesh,
@@ -849,6 +860,12 @@ void RegisterGeometryFunctions(Urho3D::Context* context)
 		asCALL_CDECL
 	);
 	CHECK_GEO_REG(res);
+	res = engine->RegisterGlobalFunction(
+		"bool TriMeshRayIntersection(const Variant&, const Vector3&, const Vector3&, int&, float&)",
+		asFUNCTION(TriMeshRayIntersection),
+		asCALL_CDECL
+	);
+	CHECK_GEO_REG(res);
 
 	res = engine->RegisterGlobalFunction(
 		"bool ReadOBJFromFilename(const String&, Variant&, bool)",
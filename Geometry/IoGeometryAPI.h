@@ -175,6 +175,14 @@ bool RayTriangleIntersection(
 	float& s
 );
 
+bool TriMeshRayIntersection(
+	const Urho3D::Variant& mesh,
+	const Urho3D::Vector3& O,
+	const Urho3D::Vector3& D,
+	int& index,
+	float& s
+);
+
 bool ReadOBJFromFilename(
 	const Urho3D::String& obj_filename,
 	Urho3D::Variant& tri_mesh,
@@ -74,103 +74,56 @@ using Urho3D::PODVector;
 
 namespace {
 
-	VariantVector ExtractVertices(const Eigen::MatrixXf& V)
+	// Packs the boxed vertex and face lists used by the Variant API into a TriMeshData.
+	// No validation is done here, see TriMeshData::IsValid.
+	TriMeshDataPtr DataFromLists(const VariantVector& vertexList, const VariantVector& faceList)
 	{
-		VariantVector earlyRet;
-		if (V.rows() == 0) {
-			std::cerr << "ERROR: ExtractVertices(const MatrixXf&) --- V.rows() == 0\n";
-			return earlyRet;
-		}
-		if (V.cols() != 3) {
-			std::cout << "ERROR: ExtractVertices(const MatrixXf&) --- V.cols() != 3\n";
-			return earlyRet;
+		TriMeshDataPtr data(new TriMeshData());
+
+		PODVector<float>& vertices = data->GetVertices();
+		vertices.Resize(3 * vertexList.Size());
+		for (unsigned i = 0; i < vertexList.Size(); ++i) {
+			Vector3 vert = vertexList[i].GetVector3();
+			vertices[3 * i] = vert.x_;
+			vertices[3 * i + 1] = vert.y_;
+			vertices[3 * i + 2] = vert.z_;
 		}
 
-		VariantVector vertexList;
-		for (unsigned i = 0; i < V.rows(); ++i) {
-			Vector3 vert(V(i, 0), V(i, 1), V(i, 2));
-			vertexList.Push(Variant(vert));
+		PODVector<int>& faces = data->GetFaces();
+		faces.Resize(faceList.Size());
+		for (unsigned i = 0; i < faceList.Size(); ++i) {
+			faces[i] = faceList[i].GetInt();
 		}
-		return vertexList;
+
+		return data;
 	}
 
-	VariantVector ExtractFaces(const Eigen::MatrixXi& F, int numVertices)
+	VariantVector BoxVector3s(const PODVector<float>& buffer)
 	{
-		VariantVector earlyRet;
-		if (F.rows() == 0) {
-			std::cout << "ERROR: ExtractFaces --- F.rows() == 0\n";
-			return earlyRet;
-		}
-		if (F.cols() != 3) {
-			std::cout << "ERROR: ExtractFaces --- F.rows() != 3\n";
-			return earlyRet;
-		}
-
-		VariantVector faceList;
-		for (int i = 0; i < F.rows(); ++i) {
-
-			int i0 = F(i, 0);
-			int i1 = F(i, 1);
-			int i2 = F(i, 2);
-
-			if (i0 == i1 || i1 == i2 || i2 == i0) {
-				std::cerr << "ERROR: ExtractFaces --- repeated vertex indices in face\n";
-				return earlyRet;
-			}
-
-			if (
-				(i0 < 0 || i0 > numVertices - 1) ||
-				(i1 < 0 || i1 > numVertices - 1) ||
-				(i2 < 0 || i2 > numVertices - 1)
-				)
-			{
-				std::cerr << "ERROR: ExtractFaces --- vertex index out of range\n";
-				return earlyRet;
-			}
-
-			faceList.Push(Variant(i0));
-			faceList.Push(Variant(i1));
-			faceList.Push(Variant(i2));
+		unsigned count = buffer.Size() / 3;
+		VariantVector list(count);
+		for (unsigned i = 0; i < count; ++i) {
+			list[i] = Vector3(&buffer[3 * i]);
 		}
-		return faceList;
+		return list;
 	}
 
-
-	VariantVector ComputeFaceNormals(const Eigen::MatrixXf& V, const Eigen::MatrixXi& F)
+	VariantVector BoxInts(const PODVector<int>& buffer)
 	{
-		VariantVector normals;
-		for (unsigned i = 0; i < F.rows(); ++i) {
-			Eigen::RowVector3f u = V.row(F(i, 1)) - V.row(F(i, 0));
-			Eigen::RowVector3f v = V.row(F(i, 2)) - V.row(F(i, 0));
-
-			Eigen::RowVector3f n = u.cross(v);
-			normals.Push(Vector3(n(0), n(1), n(2)));
+		VariantVector list(buffer.Size());
+		for (unsigned i = 0; i < buffer.Size(); ++i) {
+			list[i] = buffer[i];
 		}
-
-		return normals;
+		return list;
 	}
 
-	VariantVector ComputeFaceNormals(const VariantVector& vertexList, const VariantVector& faceList, bool normalize)
+	Vector3 FaceNormal(const TriMeshData& data, unsigned faceIndex)
 	{
-		VariantVector normals;
-		for (unsigned i = 0; i < faceList.Size(); i += 3) {
-			unsigned i0 = faceList[i].GetInt();
-			unsigned i1 = faceList[i + 1].GetInt();
-			unsigned i2 = faceList[i + 2].GetInt();
-
-			Vector3 v0 = vertexList[i0].GetVector3();
-			Vector3 v1 = vertexList[i1].GetVector3();
-			Vector3 v2 = vertexList[i2].GetVector3();
+		Vector3 v0 = data.GetVertex(data.GetFaceIndex(3 * faceIndex));
+		Vector3 v1 = data.GetVertex(data.GetFaceIndex(3 * faceIndex + 1));
+		Vector3 v2 = data.GetVertex(data.GetFaceIndex(3 * faceIndex + 2));
 
-			Vector3 n = (v1 - v0).CrossProduct(v2 - v0);
-
-			if (normalize) {
-				n.Normalize();
-			}
-
-			normals.Push(n);
-		}
-		return normals;
+		return (v1 - v0).CrossProduct(v2 - v0);
 	}
 
 } // namespace
@@ -179,24 +132,51 @@ Urho3D::Variant TriMesh_Make(const Eigen::MatrixXf& V, const Eigen::MatrixXi& F)
 {
 	Variant earlyRet;
 
-	VariantVector vertexList = ExtractVertices(V);
-	if (vertexList.Size() == 0) {
-		std::cerr << "ERROR: TriMesh_Make --- vertexList.Size() == 0\n";
+	if (V.rows() == 0) {
+		std::cerr << "ERROR: TriMesh_Make --- V.rows() == 0\n";
+		return earlyRet;
+	}
+	if (V.cols() != 3) {
+		std::cerr << "ERROR: TriMesh_Make --- V.cols() != 3\n";
+		return earlyRet;
+	}
+	if (F.rows() == 0) {
+		std::cerr << "ERROR: TriMesh_Make --- F.rows() == 0\n";
+		return earlyRet;
+	}
+	if (F.cols() != 3) {
+		std::cerr << "ERROR: TriMesh_Make --- F.cols() != 3\n";
 		return earlyRet;
 	}
 
-	int numVertices = (int)V.rows();
-	VariantVector faceList = ExtractFaces(F, numVertices);
-	if (faceList.Size() == 0) {
-		std::cerr << "ERROR: TriMesh_Make --- faceList.Size() == 0\n";
+	TriMeshDataPtr data(new TriMeshData(V, F));
+
+	return TriMesh_Make(data);
+}
+
+Urho3D::Variant TriMesh_Make(TriMeshDataPtr data)
+{
+	Variant earlyRet;
+
+	if (!data) {
+		std::cerr << "ERROR: TriMesh_Make --- data is null\n";
 		return earlyRet;
 	}
+	if (!data->IsValid()) {
+		std::cerr << "ERROR: TriMesh_Make --- empty mesh, or repeated or out of range vertex indices in face\n";
+		return earlyRet;
+	}
+
+	if (!data->HasNormals()) {
+		data->ComputeVertexNormals();
+	}
+
+	Variant dataVar;
+	dataVar.SetCustom<ConstTriMeshDataPtr>(data);
 
 	VariantMap var_map;
 	var_map["type"] = Variant(String("TriMesh"));
-	var_map["vertices"] = Variant(vertexList);
-	var_map["faces"] = Variant(faceList);
-	var_map["normals"] = IglComputeVertexNormals(V, F);
+	var_map["data"] = dataVar;
 
 	return Variant(var_map);
 }
@@ -229,36 +209,9 @@ Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho
 			return earlyRet;
 		}
 	}
-	int numVertices = (int)vertexList.Size();
-	for (int i = 0; i < (int)faceList.Size(); i += 3) {
-		int i0 = faceList[i].GetInt();
-		int i1 = faceList[i + 1].GetInt();
-		int i2 = faceList[i + 2].GetInt();
-
-		if (i0 == i1 || i1 == i2 || i2 == i0) {
-			std::cerr << "ERROR: TriMesh_Make --- repeated vertex indices in face\n";
-			return earlyRet;
-		}
-
-		if (
-			(i0 < 0 || i0 > numVertices - 1) ||
-			(i1 < 0 || i1 > numVertices - 1) ||
-			(i2 < 0 || i2 > numVertices - 1)
-			)
-		{
-			std::cerr << "ERROR: TriMesh_Make --- vertex indices out of range\n";
-			return earlyRet;
-		}
-	}
-
-	VariantMap var_map;
-	var_map["type"] = Variant(String("TriMesh"));
-	var_map["vertices"] = Variant(vertexList);
-	var_map["faces"] = Variant(faceList);
-	VariantVector normals = TriMesh_ComputeVertexNormals(var_map);
-	var_map["normals"] = Variant(normals);
 
-	return Variant(var_map);
+	// index checks are done by TriMeshData::IsValid
+	return TriMesh_Make(DataFromLists(vertexList, faceList));
 }
 
 Urho3D::Variant TriMesh_Make(const Urho3D::Variant& vertices, const Urho3D::Variant& faces)
@@ -269,15 +222,13 @@ Urho3D::Variant TriMesh_Make(const Urho3D::Variant& vertices, const Urho3D::Vari
 		std::cerr << "ERROR: TriMesh_Make --- vertices.GetType() != VAR_VARIANTVECTOR\n";
 		return earlyRet;
 	}
-	VariantVector vertexList = vertices.GetVariantVector();
 	// extract faceList
 	if (faces.GetType() != VariantType::VAR_VARIANTVECTOR) {
 		std::cerr << "ERROR: TriMesh_Make --- faces.GetType() != VAR_VARIANTVECTOR\n";
 		return earlyRet;
 	}
-	VariantVector faceList = faces.GetVariantVector();
 
-	return TriMesh_Make(vertexList, faceList);
+	return TriMesh_Make(vertices.GetVariantVector(), faces.GetVariantVector());
 }
 
 Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho3D::VariantVector& faceList,
@@ -296,6 +247,9 @@ Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho
 	}
 
 	Variant basicMesh = TriMesh_Make(vertexList, faceList);
+	if (basicMesh.GetType() != VariantType::VAR_VARIANTMAP)
+		return earlyRet;
+
 	VariantMap finalMesh = basicMesh.GetVariantMap();
 	finalMesh["labels"] = Variant(labelList);
 
@@ -306,8 +260,11 @@ bool TriMesh_Verify(const Urho3D::Variant& triMesh)
 {
 	if (triMesh.GetType() != VariantType::VAR_VARIANTMAP) return false;
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	Variant var_type = var_map["type"];
+	const VariantMap& var_map = triMesh.GetVariantMap();
+	VariantMap::ConstIterator it = var_map.Find("type");
+	if (it == var_map.End()) return false;
+
+	const Variant& var_type = it->second_;
 	if (var_type.GetType() != VariantType::VAR_STRING) return false;
 
 	if (var_type.GetString() != "TriMesh") return false;
@@ -315,36 +272,58 @@ bool TriMesh_Verify(const Urho3D::Variant& triMesh)
 	return true;
 }
 
+ConstTriMeshDataPtr TriMesh_GetData(const Urho3D::Variant& triMesh)
+{
+	if (!TriMesh_Verify(triMesh)) {
+		return ConstTriMeshDataPtr();
+	}
+
+	const VariantMap& var_map = triMesh.GetVariantMap();
+	VariantMap::ConstIterator it = var_map.Find("data");
+	if (it != var_map.End() && it->second_.IsCustomType<ConstTriMeshDataPtr>()) {
+		return it->second_.GetCustom<ConstTriMeshDataPtr>();
+	}
+
+	// mesh built by hand with boxed "vertices" and "faces" lists
+	VariantMap::ConstIterator vIt = var_map.Find("vertices");
+	VariantMap::ConstIterator fIt = var_map.Find("faces");
+	if (vIt == var_map.End() || fIt == var_map.End()) {
+		return ConstTriMeshDataPtr();
+	}
+
+	TriMeshDataPtr data = DataFromLists(vIt->second_.GetVariantVector(), fIt->second_.GetVariantVector());
+	data->ComputeVertexNormals();
+
+	return data;
+}
+
 Urho3D::VariantVector TriMesh_GetVertexList(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return VariantVector();
 	}
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	return var_map["vertices"].GetVariantVector();
+	return BoxVector3s(data->GetVertices());
 }
 Urho3D::VariantVector TriMesh_GetFaceList(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return VariantVector();
 	}
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	return var_map["faces"].GetVariantVector();
+	return BoxInts(data->GetFaces());
 }
 
 Urho3D::VariantVector TriMesh_GetNormalList(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data || !data->HasNormals()) {
 		return VariantVector();
 	}
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	return var_map["normals"].GetVariantVector();
+	return BoxVector3s(data->GetNormals());
 }
 
 Urho3D::VariantVector TriMesh_GetLabelList(const Urho3D::Variant& triMesh)
@@ -354,31 +333,25 @@ Urho3D::VariantVector TriMesh_GetLabelList(const Urho3D::Variant& triMesh)
 		return VariantVector();
 	}
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	Variant var_labels = var_map["labels"];
-	if (var_labels.GetType() != VariantType::VAR_VARIANTVECTOR) return VariantVector();
+	const VariantMap& var_map = triMesh.GetVariantMap();
+	VariantMap::ConstIterator it = var_map.Find("labels");
+	if (it == var_map.End() || it->second_.GetType() != VariantType::VAR_VARIANTVECTOR) return VariantVector();
 
-	return var_map["labels"].GetVariantVector();
+	return it->second_.GetVariantVector();
 }
 
 Urho3D::Vector<float> TriMesh_GetVerticesAsFloats(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return Vector<float>();
 	}
 
-	VariantVector verts = TriMesh_GetVertexList(triMesh);
-	Vector<float> vertsOut;
-	int numVerts = verts.Size();
-	vertsOut.Resize(numVerts * 3);
-
-	for (int i = 0; i < numVerts; i++)
+	const PODVector<float>& verts = data->GetVertices();
+	Vector<float> vertsOut(verts.Size());
+	for (unsigned i = 0; i < verts.Size(); i++)
 	{
-		Vector3 v = verts[i].GetVector3();
-		vertsOut[3 * i] = v.x_;
-		vertsOut[3 * i + 1] = v.y_;
-		vertsOut[3 * i + 2] = v.z_;
+		vertsOut[i] = verts[i];
 	}
 
 	return vertsOut;
@@ -386,22 +359,16 @@ Urho3D::Vector<float> TriMesh_GetVerticesAsFloats(const Urho3D::Variant& triMesh
 
 Urho3D::Vector<double> TriMesh_GetVerticesAsDoubles(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return Vector<double>();
 	}
 
-	VariantVector verts = TriMesh_GetVertexList(triMesh);
-	Vector<double> vertsOut;
-	int numVerts = verts.Size();
-	vertsOut.Resize(numVerts * 3);
-
-	for (int i = 0; i < numVerts; i++)
+	const PODVector<float>& verts = data->GetVertices();
+	Vector<double> vertsOut(verts.Size());
+	for (unsigned i = 0; i < verts.Size(); i++)
 	{
-		Vector3 v = verts[i].GetVector3();
-		vertsOut[3 * i] = (double)v.x_;
-		vertsOut[3 * i + 1] = (double)v.y_;
-		vertsOut[3 * i + 2] = (double)v.z_;
+		vertsOut[i] = (double)verts[i];
 	}
 
 	return vertsOut;
@@ -409,19 +376,16 @@ Urho3D::Vector<double> TriMesh_GetVerticesAsDoubles(const Urho3D::Variant& triMe
 
 Urho3D::Vector<int> TriMesh_GetFacesAsInts(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return Vector<int>();
 	}
 
-	VariantVector faces = TriMesh_GetFaceList(triMesh);
-	Vector<int> facesOut;
-	int numFaces = faces.Size();
-	facesOut.Resize(numFaces);
-
-	for (int i = 0; i < numFaces; i++)
+	const PODVector<int>& faces = data->GetFaces();
+	Vector<int> facesOut(faces.Size());
+	for (unsigned i = 0; i < faces.Size(); i++)
 	{
-		facesOut[i] = faces[i].GetInt();
+		facesOut[i] = faces[i];
 	}
 
 	return facesOut;
@@ -465,55 +429,46 @@ Urho3D::Vector<Urho3D::Pair<int, int>> TriMesh_ComputeBoundaryEdges(const Urho3D
 
 Urho3D::VariantVector TriMesh_ComputeFaceNormals(const Urho3D::Variant& triMesh, bool normalize)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return VariantVector();
 	}
 
-	VariantMap var_map = triMesh.GetVariantMap();
-	VariantVector vertexList = var_map["vertices"].GetVariantVector();
-	VariantVector faceList = var_map["faces"].GetVariantVector();
+	unsigned numFaces = data->GetNumFaces();
+	VariantVector normals(numFaces);
+	for (unsigned i = 0; i < numFaces; ++i) {
+		Vector3 n = FaceNormal(*data, i);
+		if (normalize) {
+			n.Normalize();
+		}
+		normals[i] = n;
+	}
 
-	return ComputeFaceNormals(vertexList, faceList, normalize);
+	return normals;
 }
 
 Urho3D::VariantVector TriMesh_ComputeVertexNormals(const Urho3D::Variant& triMesh, bool normalize)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return VariantVector();
 	}
 
-	Eigen::MatrixXf V;
-	Eigen::MatrixXi F;
-	TriMeshToMatrices(triMesh, V, F);
-
-	VariantVector vertexNormals;
-	VariantVector faceNormals = ComputeFaceNormals(V, F);
-
-	std::vector<std::vector<int> > VF;
-	std::vector<std::vector<int> > VFi;
-	igl::vertex_triangle_adjacency(V, F, VF, VFi);
-
-	// for each vertex index i, compute the normal there
-	for (unsigned i = 0; i < VF.size(); ++i) {
-
-		// normal associated to vertex i
-		Vector3 normal(0.0f, 0.0f, 0.0f);
+	// stored normals are the straight average of the normals of faces adjacent to each vertex
+	if (!data->HasNormals()) {
+		TriMeshDataPtr copy = data->Clone();
+		copy->ComputeVertexNormals();
+		data = copy;
+	}
 
-		// normal will be the straight average of the normals of faces adjacent to vertex
-		for (unsigned j = 0; j < VF[i].size(); ++j) {
-			int adj = VF[i][j];
-			normal = normal + faceNormals[adj].GetVector3();
-		}
-		if (VF[i].size() > 0) {
-			normal = (1.0f / VF[i].size()) * normal;
-		}
+	unsigned numVertices = data->GetNumVertices();
+	VariantVector vertexNormals(numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		Vector3 normal = data->GetNormal(i);
 		if (normalize) {
 			normal.Normalize();
 		}
-
-		vertexNormals.Push(normal);
+		vertexNormals[i] = normal;
 	}
 
 	return vertexNormals;
@@ -549,16 +504,15 @@ Urho3D::Vector<Pair<int, int>> TriMesh_ComputeEdges(const Urho3D::Variant& triMe
 
 Urho3D::Vector<Urho3D::Vector3> TriMesh_ComputePointCloud(const Urho3D::Variant& triMesh)
 {
-	bool ver = TriMesh_Verify(triMesh);
-	if (!ver) {
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
 		return Vector<Vector3>();
 	}
 
-	Vector<Vector3> point_cloud;
-	VariantVector vertex_list = TriMesh_GetVertexList(triMesh);
-
-	for (unsigned i = 0; i < vertex_list.Size(); ++i) {
-		point_cloud.Push(vertex_list[i].GetVector3());
+	unsigned numVertices = data->GetNumVertices();
+	Vector<Vector3> point_cloud(numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		point_cloud[i] = data->GetVertex(i);
 	}
 
 	return point_cloud;
@@ -569,12 +523,24 @@ Urho3D::Variant TriMesh_ApplyTransform(
 	const Urho3D::Matrix3x4& T
 	)
 {
-	VariantVector vertex_list = TriMesh_GetVertexList(tri_mesh);
-	VariantVector face_list = TriMesh_GetFaceList(tri_mesh);
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
+		return Variant();
+	}
 
-	VariantVector transformed_vertex_list = Geomlib::TransformVertexList(T, vertex_list);
+	unsigned numVertices = data->GetNumVertices();
+	TriMeshDataPtr transformed(new TriMeshData());
+	PODVector<float>& vertices = transformed->GetVertices();
+	vertices.Resize(3 * numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		Vector3 vert = T * data->GetVertex(i);
+		vertices[3 * i] = vert.x_;
+		vertices[3 * i + 1] = vert.y_;
+		vertices[3 * i + 2] = vert.z_;
+	}
+	transformed->GetFaces() = data->GetFaces();
 
-	return TriMesh_Make(transformed_vertex_list, face_list);
+	return TriMesh_Make(transformed);
 }
 
 Urho3D::Variant TriMesh_CullUnusedVertices(
@@ -595,28 +561,77 @@ Urho3D::Variant TriMesh_CullUnusedVertices(
 	return out_mesh;
 }
 
+Urho3D::Variant TriMesh_WeldVertices(
+	const Urho3D::Variant& tri_mesh,
+	float tolerance
+)
+{
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
+		return Variant();
+	}
+
+	PODVector<unsigned> remap;
+	PODVector<unsigned> representatives;
+	const Vector3* vertexList = reinterpret_cast<const Vector3*>(data->GetVertexData());
+	Geomlib::WeldVertices(vertexList, data->GetNumVertices(), tolerance, remap, representatives);
+
+	TriMeshDataPtr welded(new TriMeshData());
+	PODVector<float>& vertices = welded->GetVertices();
+	vertices.Resize(3 * representatives.Size());
+	for (unsigned i = 0; i < representatives.Size(); ++i) {
+		Vector3 v = data->GetVertex(representatives[i]);
+		vertices[3 * i] = v.x_;
+		vertices[3 * i + 1] = v.y_;
+		vertices[3 * i + 2] = v.z_;
+	}
+
+	// faces with two corners welded together have collapsed and are dropped
+	const PODVector<int>& faces = data->GetFaces();
+	PODVector<int>& weldedFaces = welded->GetFaces();
+	weldedFaces.Reserve(faces.Size());
+	for (unsigned i = 0; i + 2 < faces.Size(); i += 3) {
+		int a = remap[faces[i]];
+		int b = remap[faces[i + 1]];
+		int c = remap[faces[i + 2]];
+		if (a == b || b == c || c == a)
+			continue;
+
+		weldedFaces.Push(a);
+		weldedFaces.Push(b);
+		weldedFaces.Push(c);
+	}
+
+	return TriMesh_Make(welded);
+}
+
 Urho3D::Variant TriMesh_DoubleAndFlipFaces(
 	const Urho3D::Variant& tri_mesh
 	)
 {
-	VariantVector verts = TriMesh_GetVertexList(tri_mesh);
-	VariantVector faces = TriMesh_GetFaceList(tri_mesh);
-	VariantVector newFaces;
-	int numFaces = faces.Size() / 3;
-	for (int i = 0; i < numFaces; i++)
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
+		return Variant();
+	}
+
+	TriMeshDataPtr doubled(new TriMeshData());
+	doubled->GetVertices() = data->GetVertices();
+
+	const PODVector<int>& faces = data->GetFaces();
+	PODVector<int>& newFaces = doubled->GetFaces();
+	newFaces.Resize(2 * faces.Size());
+	for (unsigned i = 0; i < faces.Size(); i += 3)
 	{
-		int a = faces[3 * i].GetInt();
-		int b = faces[3 * i + 1].GetInt();
-		int c = faces[3 * i + 2].GetInt();
+		newFaces[i] = faces[i];
+		newFaces[i + 1] = faces[i + 1];
+		newFaces[i + 2] = faces[i + 2];
 
-		newFaces.Push(a);
-		newFaces.Push(c);
-		newFaces.Push(b);
+		newFaces[faces.Size() + i] = faces[i];
+		newFaces[faces.Size() + i + 1] = faces[i + 2];
+		newFaces[faces.Size() + i + 2] = faces[i + 1];
 	}
 
-	faces.Insert(numFaces, newFaces);
-
-	return TriMesh_Make(verts, faces);
+	return TriMesh_Make(doubled);
 }
 
 Urho3D::Variant TriMesh_BoundingBox(const Urho3D::Variant& tri_mesh)
@@ -650,23 +665,25 @@ Urho3D::Variant TriMesh_UnifyNormals(const Urho3D::Variant& tri_mesh)
 
 Urho3D::Variant TriMesh_FlipNormals(const Urho3D::Variant& tri_mesh)
 {
-    if (!TriMesh_Verify(tri_mesh)) {
-        return Variant();
-    }
-    
-    VariantVector vertex_list = TriMesh_GetVertexList(tri_mesh);
-    VariantVector face_list = TriMesh_GetFaceList(tri_mesh);
-    
-    VariantVector reverse_face_list;
-    
-    for (int i = 0; i < face_list.Size(); i+=3)
-    {
-        reverse_face_list.Push(face_list[i+2].GetInt());
-        reverse_face_list.Push(face_list[i+1].GetInt());
-        reverse_face_list.Push(face_list[i].GetInt());
-    }
-    
-    return TriMesh_Make(vertex_list, reverse_face_list);
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
+	if (!data) {
+		return Variant();
+	}
+
+	TriMeshDataPtr flipped(new TriMeshData());
+	flipped->GetVertices() = data->GetVertices();
+
+	const PODVector<int>& faces = data->GetFaces();
+	PODVector<int>& reverseFaces = flipped->GetFaces();
+	reverseFaces.Resize(faces.Size());
+	for (unsigned i = 0; i < faces.Size(); i += 3)
+	{
+		reverseFaces[i] = faces[i + 2];
+		reverseFaces[i + 1] = faces[i + 1];
+		reverseFaces[i + 2] = faces[i];
+	}
+
+	return TriMesh_Make(flipped);
 }
 
 Urho3D::Variant TriMesh_ToYUp(const Urho3D::Variant& tri_mesh)
@@ -706,63 +723,44 @@ Urho3D::Variant TriMesh_ToZUp(const Urho3D::Variant& tri_mesh)
 Urho3D::Vector3 TriMesh_CenterOfMass(const Urho3D::Variant& tri_mesh)
 {
 	Vector3 cen(0.0f, 0.0f, 0.0f);
-	VariantVector vertex_list = TriMesh_GetVertexList(tri_mesh);
+	ConstTriMeshDataPtr data = TriMesh_GetData(tri_mesh);
 
-	if (!TriMesh_Verify(tri_mesh) || vertex_list.Size() == 0) {
+	if (!data || data->GetNumVertices() == 0) {
 		return cen;
 	}
 
-	for (unsigned i = 0; i < vertex_list.Size(); ++i) {
+	unsigned numVertices = data->GetNumVertices();
+	for (unsigned i = 0; i < numVertices; ++i) {
 
-		cen += vertex_list[i].GetVector3();
+		cen += data->GetVertex(i);
 	}
 
-	return cen / vertex_list.Size();
+	return cen / (float)numVertices;
 }
 
 
 void TriMeshToMatrices(const Variant& triMesh, Eigen::MatrixXf& V, Eigen::MatrixXi& F)
 {
-	VariantMap var_map = triMesh.GetVariantMap();
-	VariantVector vertexList = var_map["vertices"].GetVariantVector();
-	VariantVector faceList = var_map["faces"].GetVariantVector();
-
-	unsigned numVertices = vertexList.Size();
-	V.setZero(numVertices, 3);
-	for (unsigned i = 0; i < numVertices; ++i) {
-		Vector3 vert = vertexList[i].GetVector3();
-		V.row(i) = Eigen::RowVector3f(vert.x_, vert.y_, vert.z_);
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
+		V.setZero(0, 3);
+		F.setZero(0, 3);
+		return;
 	}
 
-	unsigned numFaces = faceList.Size() / 3;
-	F.setZero(numFaces, 3);
-	for (unsigned i = 0; i < numFaces; ++i) {
-		for (unsigned j = 0; j < 3; ++j) {
-			F(i, j) = faceList[3 * i + j].GetInt();
-		}
-	}
+	data->ToMatrices(V, F);
 }
 
 void TriMeshToDoubleMatrices(const Variant& triMesh, Eigen::MatrixXd& V, Eigen::MatrixXi& F)
 {
-	VariantMap var_map = triMesh.GetVariantMap();
-	VariantVector vertexList = var_map["vertices"].GetVariantVector();
-	VariantVector faceList = var_map["faces"].GetVariantVector();
-
-	unsigned numVertices = vertexList.Size();
-	V.setZero(numVertices, 3);
-	for (unsigned i = 0; i < numVertices; ++i) {
-		Vector3 vert = vertexList[i].GetVector3();
-		V.row(i) = Eigen::RowVector3d(vert.x_, vert.y_, vert.z_);
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data) {
+		V.setZero(0, 3);
+		F.setZero(0, 3);
+		return;
 	}
 
-	unsigned numFaces = faceList.Size() / 3;
-	F.setZero(numFaces, 3);
-	for (unsigned i = 0; i < numFaces; ++i) {
-		for (unsigned j = 0; j < 3; ++j) {
-			F(i, j) = faceList[3 * i + j].GetInt();
-		}
-	}
+	data->ToDoubleMatrices(V, F);
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -784,18 +782,18 @@ struct VertexData
 
 Urho3D::Model* TriMesh_GetRenderMesh(const Urho3D::Variant& triMesh, Urho3D::Context* context, VariantVector vColors, bool split)
 {
-	if (!TriMesh_Verify(triMesh))
+	ConstTriMeshDataPtr data = TriMesh_GetData(triMesh);
+	if (!data)
 	{
 		return NULL;
 	}
 
-	Vector<VertexData> vbd;
-	Vector<Vector3> tmpVerts;
-	Vector<int> tmpFaces;
+	PODVector<VertexData> vbd;
+	PODVector<Vector3> tmpVerts;
+	PODVector<int> tmpFaces;
 
-	VariantVector verts = TriMesh_GetVertexList(triMesh);
-	VariantVector faces = TriMesh_GetFaceList(triMesh);
-	VariantVector normals;
+	const PODVector<int>& faces = data->GetFaces();
+	unsigned numVerts = data->GetNumVertices();
 
 	if (vColors.Empty())
 	{
@@ -806,23 +804,20 @@ Urho3D::Model* TriMesh_GetRenderMesh(const Urho3D::Variant& triMesh, Urho3D::Con
 
 	if (split)
 	{
-		normals = TriMesh_ComputeFaceNormals(triMesh, true);
 		tmpFaces.Resize(faces.Size());
 		tmpVerts.Resize(faces.Size());
 		vbd.Resize(faces.Size());
 
-		unsigned int vCol = Urho3D::Color::CYAN.ToUInt();
-
 		//render with duplicate verts for flat face shading
 		for (unsigned i = 0; i < faces.Size(); i++)
 		{
-			int fId = faces[i].GetInt();
-			int normId = (int)floor((float)i / 3.0f);
+			int fId = faces[i];
+			int normId = i / 3;
 			unsigned int col = vColors[normId%numColors].GetColor().ToUInt();
-			if (fId < (int)verts.Size())
+			if (fId < (int)numVerts)
 			{
-				vbd[i].position = verts[fId].GetVector3();
-				vbd[i].normal = normals[normId].GetVector3();
+				vbd[i].position = data->GetVertex(fId);
+				vbd[i].normal = FaceNormal(*data, normId).Normalized();
 				vbd[i].color = col;
 				tmpVerts[i] = vbd[i].position;
 			}
@@ -833,23 +828,24 @@ Urho3D::Model* TriMesh_GetRenderMesh(const Urho3D::Variant& triMesh, Urho3D::Con
 	}
 	else
 	{
-		normals = TriMesh_ComputeVertexNormals(triMesh);
-		tmpFaces.Resize(faces.Size());
-		tmpVerts.Resize(verts.Size());
-		vbd.Resize(verts.Size());
-		unsigned int vCol = Color::CYAN.ToUInt();
-
-		for (unsigned i = 0; i < verts.Size(); i++)
+		ConstTriMeshDataPtr shaded = data;
+		if (!shaded->HasNormals())
 		{
-			vbd[i].position = verts[i].GetVector3();
-			vbd[i].normal = normals[i].GetVector3();
-			vbd[i].color = vColors[i%numColors].GetColor().ToUInt();
-			tmpVerts[i] = verts[i].GetVector3();
+			TriMeshDataPtr copy = data->Clone();
+			copy->ComputeVertexNormals();
+			shaded = copy;
 		}
 
-		for (unsigned i = 0; i < faces.Size(); i++)
+		tmpFaces = faces;
+		tmpVerts.Resize(numVerts);
+		vbd.Resize(numVerts);
+
+		for (unsigned i = 0; i < numVerts; i++)
 		{
-			tmpFaces[i] = faces[i].GetInt();
+			vbd[i].position = data->GetVertex(i);
+			vbd[i].normal = shaded->GetNormal(i);
+			vbd[i].color = vColors[i%numColors].GetColor().ToUInt();
+			tmpVerts[i] = vbd[i].position;
 		}
 	}
 
@@ -1078,6 +1074,12 @@ bool RegisterTriMeshFunctions(Urho3D::Context* context)
 		asCALL_CDECL
 	);
 	CHECK_GEO_REG(res);
+	res = engine->RegisterGlobalFunction(
+		"Variant TriMesh_WeldVertices(const Variant&, float)",
+		asFUNCTION(TriMesh_WeldVertices),
+		asCALL_CDECL
+	);
+	CHECK_GEO_REG(res);
 	res = engine->RegisterGlobalFunction(
 		"Variant TriMesh_DoubleAndFlipFaces(const Variant&)",
 		asFUNCTION(TriMesh_DoubleAndFlipFaces),
@@ -32,7 +32,10 @@
 
 #include <Eigen/Core>
 
+#include "TriMeshData.h"
+
 Urho3D::Variant TriMesh_Make(const Eigen::MatrixXf& V, const Eigen::MatrixXi& F);
+Urho3D::Variant TriMesh_Make(TriMeshDataPtr data); // takes ownership; data must not be modified afterwards
 Urho3D::Variant TriMesh_Make(const Urho3D::Variant& vertices, const Urho3D::Variant& faces); // REGISTERED as TriMesh_MakeFromVariants
 Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho3D::VariantVector& faceList); // REGISTERED as TriMesh_MakeFromVariantArrays
 Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho3D::VariantVector& faceList, 
@@ -40,6 +43,12 @@ Urho3D::Variant TriMesh_Make(const Urho3D::VariantVector& vertexList, const Urho
 
 bool TriMesh_Verify(const Urho3D::Variant& triMesh); // REGISTERED
 
+// Returns the contiguous buffers carried by triMesh without copying them.
+// Meshes built by hand from boxed "vertices"/"faces" lists are packed on the fly.
+// Returns a null pointer if triMesh is not a TriMesh.
+// The data is shared by every Variant holding the mesh; to change it, Clone() it and make a new TriMesh.
+ConstTriMeshDataPtr TriMesh_GetData(const Urho3D::Variant& triMesh);
+
 Urho3D::VariantVector TriMesh_GetVertexList(const Urho3D::Variant& triMesh); // REGISTERED as TriMesh_GetVertexArray
 Urho3D::VariantVector TriMesh_GetFaceList(const Urho3D::Variant& triMesh); // REGISTERED as TriMesh_GetFaceArray
 Urho3D::VariantVector TriMesh_GetNormalList(const Urho3D::Variant& triMesh); // REGISTERED as TriMesh_GetNormalArray
@@ -63,6 +72,9 @@ Urho3D::Variant TriMesh_ApplyTransform(
 
 Urho3D::Variant TriMesh_CullUnusedVertices(const Urho3D::Variant& tri_mesh); // REGISTERED
 
+// Welds vertices within tolerance of each other (see Geomlib::WeldVertices) and drops the faces that collapse.
+Urho3D::Variant TriMesh_WeldVertices(const Urho3D::Variant& tri_mesh, float tolerance); // REGISTERED
+
 Urho3D::Variant TriMesh_DoubleAndFlipFaces(const Urho3D::Variant& tri_mesh); // REGISTERED
 
 Urho3D::Variant TriMesh_BoundingBox(const Urho3D::Variant& tri_mesh); // REGISTERED
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "TriMeshAABB.h"
+
+#include <algorithm>
+#include <iterator>
+#include <math.h>
+
+#pragma warning(push, 0)
+#include <igl/PI.h>
+#include <igl/per_edge_normals.h>
+#include <igl/per_face_normals.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/signed_distance.h>
+#pragma warning(pop)
+
+#include "TriMeshData.h"
+
+using Urho3D::Vector3;
+
+namespace {
+
+// solid angle of triangle ABC seen from q (Van Oosterom and Strackee), positive when it winds
+// counterclockwise around q
+double SolidAngle(const Eigen::RowVector3d& q, const Eigen::RowVector3d& A, const Eigen::RowVector3d& B, const Eigen::RowVector3d& C)
+{
+	Eigen::RowVector3d a = A - q;
+	Eigen::RowVector3d b = B - q;
+	Eigen::RowVector3d c = C - q;
+	double la = a.norm();
+	double lb = b.norm();
+	double lc = c.norm();
+	double det = a.dot(b.cross(c));
+	double div = la * lb * lc + a.dot(b) * lc + a.dot(c) * lb + b.dot(c) * la;
+	return 2.0 * atan2(det, div);
+}
+
+}
+
+TriMeshAABB::TriMeshAABB(const TriMeshData& data)
+{
+	data.ToDoubleMatrices(V_, F_);
+	tree_.init(V_, F_);
+
+	Eigen::MatrixXi E;
+	igl::per_face_normals(V_, F_, faceNormals_);
+	igl::per_vertex_normals(V_, F_, igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE, faceNormals_, vertexNormals_);
+	igl::per_edge_normals(V_, F_, igl::PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM, faceNormals_, edgeNormals_, E, edgeMap_);
+}
+
+float TriMeshAABB::ClosestPoint(const Vector3& q, int& face, Vector3& p) const
+{
+	Eigen::RowVector3d query(q.x_, q.y_, q.z_);
+	Eigen::RowVector3d c;
+	face = -1;
+
+	double sqrD = tree_.squared_distance(V_, F_, query, face, c);
+	p = Vector3((float)c(0), (float)c(1), (float)c(2));
+
+	return (float)sqrD;
+}
+
+bool TriMeshAABB::Raycast(const Vector3& origin, const Vector3& direction, float& t, int& face) const
+{
+	Eigen::RowVector3d o(origin.x_, origin.y_, origin.z_);
+	Eigen::RowVector3d d(direction.x_, direction.y_, direction.z_);
+
+	igl::Hit hit;
+	if (!tree_.intersect_ray(V_, F_, o, d, hit)) {
+		return false;
+	}
+
+	t = hit.t;
+	face = hit.id;
+	return true;
+}
+
+float TriMeshAABB::SignedDistance(const Vector3& q, int& face, Vector3& p, SignType sign) const
+{
+	Eigen::RowVector3d query(q.x_, q.y_, q.z_);
+	Eigen::RowVector3d c, n;
+	double s = 1.0;
+	double sqrD = 0.0;
+	face = -1;
+
+	if (sign == SIGN_PSEUDONORMAL) {
+		igl::signed_distance_pseudonormal(
+			tree_, V_, F_, faceNormals_, vertexNormals_, edgeNormals_, edgeMap_,
+			query, s, sqrD, face, c, n
+		);
+	}
+	else {
+		sqrD = tree_.squared_distance(V_, F_, query, face, c);
+		s = 1.0 - 2.0 * WindingNumber(q);
+	}
+	p = Vector3((float)c(0), (float)c(1), (float)c(2));
+
+	return (float)(s * sqrt(sqrD));
+}
+
+double TriMeshAABB::WindingNumber(const Vector3& q) const
+{
+	std::call_once(windingOnce_, &TriMeshAABB::BuildWindingNodes, this);
+	if (windingNodes_.empty())
+		return 0.0;
+
+	Eigen::RowVector3d query(q.x_, q.y_, q.z_);
+	double solidAngle = 0.0;
+
+	int stack[128];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const WindingNode& wn = windingNodes_[stack[--stackSize]];
+
+		if (wn.capBegin < wn.capEnd && !wn.node->m_box.contains(query.transpose())) {
+			for (unsigned i = wn.capBegin; i < wn.capEnd; ++i) {
+				const BoundaryEdge& e = capEdges_[i];
+				solidAngle += e.count * SolidAngle(query, wn.apex, V_.row(e.a), V_.row(e.b));
+			}
+		}
+		else if (wn.node->m_primitive >= 0) {
+			int f = wn.node->m_primitive;
+			solidAngle += SolidAngle(query, V_.row(F_(f, 0)), V_.row(F_(f, 1)), V_.row(F_(f, 2)));
+		}
+		else {
+			// the tree is balanced, so its depth stays far below the stack size
+			if (wn.left >= 0)
+				stack[stackSize++] = wn.left;
+			if (wn.right >= 0)
+				stack[stackSize++] = wn.right;
+		}
+	}
+
+	return solidAngle / (4.0 * igl::PI);
+}
+
+void TriMeshAABB::BuildWindingNodes() const
+{
+	if (F_.rows() == 0)
+		return;
+
+	std::vector<BoundaryEdge> boundary;
+	int numFaces = 0;
+	BuildWindingNode(&tree_, boundary, numFaces);
+}
+
+int TriMeshAABB::BuildWindingNode(const igl::AABB<Eigen::MatrixXd, 3>* node, std::vector<BoundaryEdge>& boundary, int& numFaces) const
+{
+	int index = (int)windingNodes_.size();
+	WindingNode wn;
+	wn.node = node;
+	wn.left = -1;
+	wn.right = -1;
+	wn.capBegin = 0;
+	wn.capEnd = 0;
+	wn.apex = node->m_box.center().transpose();
+	windingNodes_.push_back(wn);
+
+	boundary.clear();
+	numFaces = 0;
+
+	if (node->m_primitive >= 0) {
+		int f = node->m_primitive;
+		for (int c = 0; c < 3; ++c) {
+			int a = F_(f, c);
+			int b = F_(f, (c + 1) % 3);
+			BoundaryEdge e = { std::min(a, b), std::max(a, b), a < b ? 1 : -1 };
+			boundary.push_back(e);
+		}
+		std::sort(boundary.begin(), boundary.end());
+		numFaces = 1;
+	}
+	else {
+		// the children grow windingNodes_, so their indices are stored only once both are built
+		std::vector<BoundaryEdge> left, right;
+		int numLeft = 0, numRight = 0;
+		int leftIndex = node->m_left ? BuildWindingNode(node->m_left, left, numLeft) : -1;
+		int rightIndex = node->m_right ? BuildWindingNode(node->m_right, right, numRight) : -1;
+		windingNodes_[index].left = leftIndex;
+		windingNodes_[index].right = rightIndex;
+		numFaces = numLeft + numRight;
+
+		// merge the sorted lists; edges shared by the two sides cancel out
+		std::merge(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(boundary));
+	}
+
+	// sum the counts of equal edges and drop the interior ones
+	unsigned size = 0;
+	for (unsigned i = 0; i < boundary.size(); ++i) {
+		if (size > 0 && boundary[size - 1].a == boundary[i].a && boundary[size - 1].b == boundary[i].b)
+			boundary[size - 1].count += boundary[i].count;
+		else
+			boundary[size++] = boundary[i];
+		if (boundary[size - 1].count == 0)
+			--size;
+	}
+	boundary.resize(size);
+
+	if (node->m_primitive < 0 && (int)boundary.size() < numFaces) {
+		windingNodes_[index].capBegin = (unsigned)capEdges_.size();
+		capEdges_.insert(capEdges_.end(), boundary.begin(), boundary.end());
+		windingNodes_[index].capEnd = (unsigned)capEdges_.size();
+	}
+
+	return index;
+}
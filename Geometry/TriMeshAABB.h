@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Urho3D/Math/Vector3.h>
+
+#include <Eigen/Core>
+
+#pragma warning(push, 0)
+#include <igl/AABB.h>
+#pragma warning(pop)
+
+class TriMeshData;
+
+// Axis-aligned bounding box tree over the faces of a TriMesh, for closest point, ray and signed distance queries
+// in O(log n) per query instead of a loop over every face.
+// Build it with TriMeshData::GetAABB, which caches it with the mesh, so every component
+// querying the same mesh payload shares one tree.
+// All queries are const and may be run from several threads at once.
+class URHO3D_API TriMeshAABB
+{
+public:
+	explicit TriMeshAABB(const TriMeshData& data);
+	TriMeshAABB(const TriMeshAABB&) = delete;
+	void operator=(const TriMeshAABB&) = delete;
+
+	// Returns the squared distance from q to the mesh; face is the closest face and p the closest point on it.
+	float ClosestPoint(const Urho3D::Vector3& q, int& face, Urho3D::Vector3& p) const;
+
+	// First hit of the ray origin + t * direction with t > 0; returns false if the ray misses the mesh.
+	bool Raycast(const Urho3D::Vector3& origin, const Urho3D::Vector3& direction, float& t, int& face) const;
+
+	enum SignType
+	{
+		// distance times 1 - 2w for the generalized winding number w, like igl::signed_distance's default;
+		// robust for meshes with holes or self intersections
+		SIGN_WINDING_NUMBER,
+		// sign of the angle weighted pseudonormal at the closest point (see igl::signed_distance_pseudonormal);
+		// cheaper, but only right for closed, consistently oriented meshes
+		SIGN_PSEUDONORMAL
+	};
+
+	// Distance from q to the mesh, negative inside; face is the closest face and p the closest point on it.
+	float SignedDistance(const Urho3D::Vector3& q, int& face, Urho3D::Vector3& p, SignType sign = SIGN_WINDING_NUMBER) const;
+
+	// Generalized winding number of q: 1 inside a closed, outward oriented mesh, 0 outside and in between near holes.
+	// Evaluated hierarchically over the tree; unlike igl::WindingNumberAABB this keeps no static cache.
+	double WindingNumber(const Urho3D::Vector3& q) const;
+
+	const Eigen::MatrixXd& GetVertices() const { return V_; }
+	const Eigen::MatrixXi& GetFaces() const { return F_; }
+
+private:
+	Eigen::MatrixXd V_;
+	Eigen::MatrixXi F_;
+	igl::AABB<Eigen::MatrixXd, 3> tree_;
+
+	// pseudonormals for the sign of SignedDistance
+	Eigen::MatrixXd faceNormals_;
+	Eigen::MatrixXd vertexNormals_;
+	Eigen::MatrixXd edgeNormals_;
+	Eigen::VectorXi edgeMap_;
+
+	// An edge of the boundary of the faces below a tree node, counted +1 per face using it as a -> b
+	// and -1 per face using it as b -> a, where a < b.
+	struct BoundaryEdge
+	{
+		int a;
+		int b;
+		int count;
+
+		bool operator<(const BoundaryEdge& rhs) const { return a < rhs.a || (a == rhs.a && b < rhs.b); }
+	};
+
+	// Mirrors a node of tree_ for WindingNumber. The faces below a node whose box does not contain the query
+	// have the winding number of the fan from the box center to their boundary, which is used in their place
+	// when it has fewer triangles (Jacobson et al., Robust Inside-Outside Segmentation, 2013).
+	struct WindingNode
+	{
+		const igl::AABB<Eigen::MatrixXd, 3>* node;
+		int left;
+		int right;
+		// range of capEdges_; empty when the faces themselves are cheaper
+		unsigned capBegin;
+		unsigned capEnd;
+		Eigen::RowVector3d apex;
+	};
+
+	// built on the first WindingNumber call, so that closest point and ray queries do not pay for it
+	void BuildWindingNodes() const;
+	int BuildWindingNode(const igl::AABB<Eigen::MatrixXd, 3>* node, std::vector<BoundaryEdge>& boundary, int& numFaces) const;
+	mutable std::once_flag windingOnce_;
+	mutable std::vector<WindingNode> windingNodes_;
+	mutable std::vector<BoundaryEdge> capEdges_;
+};
+
+typedef std::shared_ptr<const TriMeshAABB> TriMeshAABBPtr;
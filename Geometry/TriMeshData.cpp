@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include "TriMeshData.h"
+
+#include <string.h>
+
+#include <Urho3D/Core/Variant.h>
+
+#include "IoDataTree.h"
+#include "TriMeshAABB.h"
+
+using Urho3D::PODVector;
+
+TriMeshData::TriMeshData(const Eigen::MatrixXf& V, const Eigen::MatrixXi& F)
+{
+	if (V.cols() != 3 || F.cols() != 3) {
+		return;
+	}
+
+	unsigned numVertices = (unsigned)V.rows();
+	vertices_.Resize(3 * numVertices);
+	for (unsigned i = 0; i < numVertices; ++i) {
+		vertices_[3 * i] = V(i, 0);
+		vertices_[3 * i + 1] = V(i, 1);
+		vertices_[3 * i + 2] = V(i, 2);
+	}
+
+	unsigned numFaces = (unsigned)F.rows();
+	faces_.Resize(3 * numFaces);
+	for (unsigned i = 0; i < numFaces; ++i) {
+		faces_[3 * i] = F(i, 0);
+		faces_[3 * i + 1] = F(i, 1);
+		faces_[3 * i + 2] = F(i, 2);
+	}
+}
+
+TriMeshData::TriMeshData(const float* vertices, unsigned numVertices, const int* faces, unsigned numFaces)
+{
+	vertices_.Resize(3 * numVertices);
+	if (numVertices > 0) {
+		memcpy(&vertices_[0], vertices, 3 * numVertices * sizeof(float));
+	}
+
+	faces_.Resize(3 * numFaces);
+	if (numFaces > 0) {
+		memcpy(&faces_[0], faces, 3 * numFaces * sizeof(int));
+	}
+}
+
+void TriMeshData::ToMatrices(Eigen::MatrixXf& V, Eigen::MatrixXi& F) const
+{
+	V = VertexMap();
+	F = FaceMap();
+}
+
+void TriMeshData::ToDoubleMatrices(Eigen::MatrixXd& V, Eigen::MatrixXi& F) const
+{
+	V = VertexMap().cast<double>();
+	F = FaceMap();
+}
+
+bool TriMeshData::IsValid() const
+{
+	if (vertices_.Empty() || vertices_.Size() % 3 != 0) {
+		return false;
+	}
+	if (faces_.Empty() || faces_.Size() % 3 != 0) {
+		return false;
+	}
+
+	int numVertices = (int)GetNumVertices();
+	for (unsigned i = 0; i < faces_.Size(); i += 3) {
+		int i0 = faces_[i];
+		int i1 = faces_[i + 1];
+		int i2 = faces_[i + 2];
+
+		if (i0 == i1 || i1 == i2 || i2 == i0) {
+			return false;
+		}
+
+		if (
+			(i0 < 0 || i0 > numVertices - 1) ||
+			(i1 < 0 || i1 > numVertices - 1) ||
+			(i2 < 0 || i2 > numVertices - 1)
+			)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void TriMeshData::ComputeVertexNormals()
+{
+	unsigned numVertices = GetNumVertices();
+	normals_.Resize(vertices_.Size());
+	if (numVertices == 0) {
+		return;
+	}
+	memset(&normals_[0], 0, normals_.Size() * sizeof(float));
+
+	PODVector<unsigned> valence(numVertices);
+	memset(&valence[0], 0, numVertices * sizeof(unsigned));
+
+	const float* v = &vertices_[0];
+	for (unsigned i = 0; i < faces_.Size(); i += 3) {
+		int i0 = faces_[i];
+		int i1 = faces_[i + 1];
+		int i2 = faces_[i + 2];
+
+		float ux = v[3 * i1] - v[3 * i0];
+		float uy = v[3 * i1 + 1] - v[3 * i0 + 1];
+		float uz = v[3 * i1 + 2] - v[3 * i0 + 2];
+		float wx = v[3 * i2] - v[3 * i0];
+		float wy = v[3 * i2 + 1] - v[3 * i0 + 1];
+		float wz = v[3 * i2 + 2] - v[3 * i0 + 2];
+
+		float nx = uy * wz - uz * wy;
+		float ny = uz * wx - ux * wz;
+		float nz = ux * wy - uy * wx;
+
+		int corners[3] = { i0, i1, i2 };
+		for (unsigned j = 0; j < 3; ++j) {
+			float* n = &normals_[3 * corners[j]];
+			n[0] += nx;
+			n[1] += ny;
+			n[2] += nz;
+			++valence[corners[j]];
+		}
+	}
+
+	for (unsigned i = 0; i < numVertices; ++i) {
+		if (valence[i] > 0) {
+			float s = 1.0f / valence[i];
+			normals_[3 * i] *= s;
+			normals_[3 * i + 1] *= s;
+			normals_[3 * i + 2] *= s;
+		}
+	}
+}
+
+TriMeshDataPtr TriMeshData::Clone() const
+{
+	TriMeshDataPtr copy(new TriMeshData(GetVertexData(), GetNumVertices(), GetFaceData(), GetNumFaces()));
+	copy->normals_ = normals_;
+	return copy;
+}
+
+unsigned TriMeshData::GetMemoryUse() const
+{
+	return sizeof(TriMeshData) +
+		vertices_.Capacity() * sizeof(float) +
+		normals_.Capacity() * sizeof(float) +
+		faces_.Capacity() * sizeof(int);
+}
+
+std::shared_ptr<const TriMeshAABB> TriMeshData::GetAABB() const
+{
+	Urho3D::MutexLock lock(aabbMutex_);
+	if (!aabb_) {
+		aabb_ = std::make_shared<TriMeshAABB>(*this);
+	}
+
+	return aabb_;
+}
+
+namespace {
+
+unsigned TriMeshMemoryUse(const Urho3D::Variant& var)
+{
+	if (!var.IsCustomType<ConstTriMeshDataPtr>())
+		return 0;
+
+	ConstTriMeshDataPtr data = var.GetCustom<ConstTriMeshDataPtr>();
+	return data ? data->GetMemoryUse() : 0;
+}
+
+}
+
+void TriMesh_RegisterMemoryUse()
+{
+	IoDataTree::SetCustomMemoryUse(TriMeshMemoryUse);
+}
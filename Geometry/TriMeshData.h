@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#pragma once
+
+#include <memory>
+
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include <Eigen/Core>
+
+// Contiguous storage for the vertices, faces and vertex normals of a TriMesh.
+// Vertices and normals are packed as xyzxyz..., faces as i0i1i2i0i1i2...
+// A TriMeshData is shared between every Variant that carries the mesh, so once it has been
+// handed to TriMesh_Make it is only reachable as const (ConstTriMeshDataPtr). A TriMeshDataPtr
+// is the builder: fill it, or Clone() an existing mesh and edit the copy, then pass it to TriMesh_Make.
+// It is held by std::shared_ptr rather than Urho3D::SharedPtr because the reference count
+// has to be atomic: meshes are passed between components solved on different threads.
+class TriMeshAABB;
+class TriMeshData;
+
+typedef std::shared_ptr<TriMeshData> TriMeshDataPtr;
+typedef std::shared_ptr<const TriMeshData> ConstTriMeshDataPtr;
+
+class URHO3D_API TriMeshData
+{
+public:
+	// row-major views so that the packed buffers can be read by Eigen/libigl without copying
+	typedef Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3f;
+	typedef Eigen::Matrix<int, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3i;
+	typedef Eigen::Map<const RowMatrixX3f> ConstVertexMap;
+	typedef Eigen::Map<const RowMatrixX3i> ConstFaceMap;
+
+	TriMeshData() {}
+	TriMeshData(const TriMeshData&) = delete;
+	void operator=(const TriMeshData&) = delete;
+	TriMeshData(const Eigen::MatrixXf& V, const Eigen::MatrixXi& F);
+	TriMeshData(const float* vertices, unsigned numVertices, const int* faces, unsigned numFaces);
+
+	unsigned GetNumVertices() const { return vertices_.Size() / 3; }
+	unsigned GetNumFaces() const { return faces_.Size() / 3; }
+	bool HasNormals() const { return !normals_.Empty() && normals_.Size() == vertices_.Size(); }
+
+	// raw buffers, e.g. for filling Urho3D vertex/index buffers
+	const float* GetVertexData() const { return vertices_.Empty() ? 0 : &vertices_[0]; }
+	const float* GetNormalData() const { return normals_.Empty() ? 0 : &normals_[0]; }
+	const int* GetFaceData() const { return faces_.Empty() ? 0 : &faces_[0]; }
+
+	Urho3D::Vector3 GetVertex(unsigned i) const { return Urho3D::Vector3(&vertices_[3 * i]); }
+	Urho3D::Vector3 GetNormal(unsigned i) const { return Urho3D::Vector3(&normals_[3 * i]); }
+	int GetFaceIndex(unsigned i) const { return faces_[i]; }
+
+	// zero-copy Eigen views
+	ConstVertexMap VertexMap() const { return ConstVertexMap(GetVertexData(), GetNumVertices(), 3); }
+	ConstVertexMap NormalMap() const { return ConstVertexMap(GetNormalData(), HasNormals() ? GetNumVertices() : 0, 3); }
+	ConstFaceMap FaceMap() const { return ConstFaceMap(GetFaceData(), GetNumFaces(), 3); }
+
+	// copies into the column-major matrices expected by most of libigl
+	void ToMatrices(Eigen::MatrixXf& V, Eigen::MatrixXi& F) const;
+	void ToDoubleMatrices(Eigen::MatrixXd& V, Eigen::MatrixXi& F) const;
+
+	// Checks for non-zero vertex and face counts, face indices in range and no repeated indices in a face.
+	bool IsValid() const;
+
+	// Vertex normal is the straight average of the (unnormalized) normals of the adjacent faces,
+	// which is what TriMesh_Make has always stored.
+	void ComputeVertexNormals();
+
+	// write access, only to be used while building the mesh
+	Urho3D::PODVector<float>& GetVertices() { return vertices_; }
+	Urho3D::PODVector<float>& GetNormals() { return normals_; }
+	Urho3D::PODVector<int>& GetFaces() { return faces_; }
+	const Urho3D::PODVector<float>& GetVertices() const { return vertices_; }
+	const Urho3D::PODVector<float>& GetNormals() const { return normals_; }
+	const Urho3D::PODVector<int>& GetFaces() const { return faces_; }
+
+	// writable copy of the vertices, faces and normals, for building a changed mesh
+	TriMeshDataPtr Clone() const;
+
+	// approximate heap footprint in bytes
+	unsigned GetMemoryUse() const;
+
+	// Bounding box tree over the faces, built on first use and then kept with the mesh, so
+	// repeated closest point, ray or distance queries against the same mesh share it.
+	std::shared_ptr<const TriMeshAABB> GetAABB() const;
+
+private:
+	Urho3D::PODVector<float> vertices_;
+	Urho3D::PODVector<float> normals_;
+	Urho3D::PODVector<int> faces_;
+
+	mutable std::shared_ptr<const TriMeshAABB> aabb_;
+	mutable Urho3D::Mutex aabbMutex_;
+};
+
+// Lets IoDataTree::GetMemoryUse count the TriMeshData carried by TriMesh items. Call once at startup.
+void TriMesh_RegisterMemoryUse();
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2016 - 2017 Mesh Consultants Inc.
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include "TriMeshSerialization.h"
+
+#include <Urho3D/IO/Deserializer.h>
+#include <Urho3D/IO/Serializer.h>
+
+#include "IoSerialization.h"
+#include "TriMesh.h"
+
+using namespace Urho3D;
+
+namespace
+{
+	//flags of a serialized TriMesh
+	const unsigned char TRIMESH_HAS_NORMALS = 1;
+
+	bool CountFits(Deserializer& source, unsigned long long count, unsigned bytesPerElement)
+	{
+		return count * bytesPerElement <= source.GetSize() - source.GetPosition();
+	}
+
+	//only meshes carrying a custom typed "data" Variant need the raw blocks; WriteVariant handles the rest
+	bool IsPackedTriMesh(const Variant& var)
+	{
+		if (!TriMesh_Verify(var))
+			return false;
+
+		const VariantMap& map = var.GetVariantMap();
+		VariantMap::ConstIterator it = map.Find("data");
+		return it != map.End() && it->second_.IsCustomType<ConstTriMeshDataPtr>();
+	}
+
+	void WriteTriMesh(Serializer& dest, const Variant& var, IoSerialization::ItemWriter writeItem)
+	{
+		const VariantMap& map = var.GetVariantMap();
+		ConstTriMeshDataPtr data = TriMesh_GetData(var);
+
+		dest.WriteVLE(data->GetNumVertices());
+		dest.WriteVLE(data->GetNumFaces());
+		dest.WriteUByte(data->HasNormals() ? TRIMESH_HAS_NORMALS : 0);
+		dest.Write(data->GetVertexData(), data->GetVertices().Size() * sizeof(float));
+		dest.Write(data->GetFaceData(), data->GetFaces().Size() * sizeof(int));
+		if (data->HasNormals())
+			dest.Write(data->GetNormalData(), data->GetNormals().Size() * sizeof(float));
+
+		//e.g. "labels"
+		dest.WriteVLE(map.Size() - 2);
+		for (VariantMap::ConstIterator it = map.Begin(); it != map.End(); ++it)
+		{
+			if (it->first_ == "type" || it->first_ == "data")
+				continue;
+			dest.WriteStringHash(it->first_);
+			writeItem(dest, it->second_);
+		}
+	}
+
+	//rebuilds the mesh with TriMesh_Make
+	bool ReadTriMesh(Deserializer& source, Variant& var, IoSerialization::ItemReader readItem)
+	{
+		unsigned numVertices = source.ReadVLE();
+		unsigned numFaces = source.ReadVLE();
+		unsigned char flags = source.ReadUByte();
+		unsigned numNormals = (flags & TRIMESH_HAS_NORMALS) ? numVertices : 0;
+		if (!CountFits(source, (unsigned long long)numVertices + numFaces + numNormals, 3 * sizeof(float)))
+			return false;
+
+		TriMeshDataPtr data(new TriMeshData());
+		data->GetVertices().Resize(3 * numVertices);
+		data->GetFaces().Resize(3 * numFaces);
+		data->GetNormals().Resize(3 * numNormals);
+		source.Read(data->GetVertices().Buffer(), 3 * numVertices * sizeof(float));
+		source.Read(data->GetFaces().Buffer(), 3 * numFaces * sizeof(int));
+		source.Read(data->GetNormals().Buffer(), 3 * numNormals * sizeof(float));
+
+		var = TriMesh_Make(data);
+		if (var.GetType() != VAR_VARIANTMAP)
+			return false;
+
+		unsigned count = source.ReadVLE();
+		if (!CountFits(source, count, 5))
+			return false;
+
+		VariantMap map = var.GetVariantMap();
+		for (unsigned i = 0; i < count; ++i)
+		{
+			StringHash key = source.ReadStringHash();
+			if (!readItem(source, map[key]))
+				return false;
+		}
+		var = map;
+		return true;
+	}
+}
+
+void TriMesh_RegisterSerialization()
+{
+	IoSerialization::MeshCodec codec = { IsPackedTriMesh, WriteTriMesh, ReadTriMesh };
+	IoSerialization::SetMeshCodec(codec);
+}
@@ -29,10 +29,13 @@
 #include "RegisterCoreComponents.h"
 #include "PersistentData.h"
 #include "PluginAPI.h"
+#include "Geomlib_MeshWrite.h"
 
 #include <Urho3D/ThirdParty/SDL/SDL.h>
 #include <Urho3D/Engine/DebugHud.h>
+#include <Urho3D/Container/Sort.h>
 #include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Graphics/GraphicsImpl.h>
 #include <Urho3D/IO/PackageFile.h>
 #include <Urho3D/AngelScript/Script.h>
@@ -58,6 +61,7 @@
 #include <Urho3D/Core/Timer.h>
 #include <Urho3D/UI/UI.h>
 #include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Resource/JSONFile.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Graphics/Zone.h>
 #include <Urho3D/Graphics/Skybox.h>
@@ -92,7 +96,9 @@ URHO3D_DEFINE_APPLICATION_MAIN(IogramPlayer);
 IoGraph* graph;
 
 IogramPlayer::IogramPlayer(Context* context) :
-	Application(context)
+	Application(context),
+	batchMode_(false),
+	batchRepeat_(1)
 {
 	context->RegisterFactory<OrbitCamera>();
 	context->RegisterSubsystem(new Script(context));
@@ -111,6 +117,34 @@ IogramPlayer::IogramPlayer(Context* context) :
 
 void IogramPlayer::Setup()
 {
+	//batch mode arguments
+	const Vector<String>& args = GetArguments();
+	for (unsigned i = 0; i + 1 < args.Size(); ++i)
+	{
+		if (args[i] == "-batch")
+			batchGraphPath_ = args[i + 1];
+		else if (args[i] == "-job")
+			batchJobPath_ = args[i + 1];
+		else if (args[i] == "-profile")
+			batchProfilePath_ = args[i + 1];
+		else if (args[i] == "-timings")
+			batchTimingsPath_ = args[i + 1];
+		else if (args[i] == "-repeat")
+			batchRepeat_ = Max(ToInt(args[i + 1]), 1);
+	}
+
+	if (!batchGraphPath_.Empty())
+	{
+		batchMode_ = true;
+
+		//no window, no renderer, no sound
+		engineParameters_["Headless"] = true;
+		engineParameters_["Sound"] = false;
+		engineParameters_["LogName"] = GetSubsystem<FileSystem>()->GetProgramDir() + GetTypeName() + ".log";
+		engineParameters_[EP_RESOURCE_PREFIX_PATHS] = ";./CoreData;./Data";
+		return;
+	}
+
 	int width = 1200;
 	int height = 800;
 	int fullscreen = 0;
@@ -160,6 +194,13 @@ void IogramPlayer::Start()
 	LoadPlugins();
 #endif
 
+	if (batchMode_)
+	{
+		RunBatch();
+		engine_->Exit();
+		return;
+	}
+
 	GetSubsystem<Input>()->SetMouseVisible(true);
 
 	CreateScene();
@@ -178,6 +219,8 @@ void IogramPlayer::Start()
 
 void IogramPlayer::Stop()
 {
+	//the work queue drops background mesh writes that have not started when it is destroyed
+	Geomlib::FlushMeshWrites(GetSubsystem<WorkQueue>());
 }
 
 void IogramPlayer::LoadGraph()
@@ -254,6 +297,309 @@ hasfile:
 	}
 }
 
+void IogramPlayer::RunBatch()
+{
+	FileSystem* fs = GetSubsystem<FileSystem>();
+	exitCode_ = EXIT_FAILURE;
+
+	//a bare scene, for the components that add nodes to it
+	scene_ = new Scene(context_);
+	scene_->CreateComponent<Octree>();
+	SetGlobalVar("Scene", scene_);
+	GetSubsystem<Script>()->SetDefaultScene(scene_);
+
+	if (!fs->FileExists(batchGraphPath_))
+	{
+		URHO3D_LOGERROR("IogramPlayer::RunBatch --- graph file not found: " + batchGraphPath_);
+		return;
+	}
+
+	IoGraph* graph = GetSubsystem<IoGraph>();
+	IoSerialization::LoadGraph(*graph, batchGraphPath_);
+	graph->scene = scene_;
+	if (graph->GetDummyNodeCount() == 0)
+	{
+		URHO3D_LOGERROR("IogramPlayer::RunBatch --- could not load graph: " + batchGraphPath_);
+		return;
+	}
+
+	SharedPtr<JSONFile> job(new JSONFile(context_));
+	if (!batchJobPath_.Empty())
+	{
+		if (!job->LoadFile(batchJobPath_))
+		{
+			URHO3D_LOGERROR("IogramPlayer::RunBatch --- could not read job file: " + batchJobPath_);
+			return;
+		}
+		if (!ApplyBatchInputs(job->GetRoot().Get("inputs")))
+			return;
+	}
+
+	graph->SetProfiling(!batchProfilePath_.Empty() || !batchTimingsPath_.Empty());
+
+	//every repetition solves all components again from the same inputs
+	PODVector<long long> solveTimes;
+	Vector<PODVector<long long> > componentTimes(graph->GetDummyNodeCount());
+	int allSolved = 0;
+	for (int r = 0; r < batchRepeat_; ++r)
+	{
+		HiresTimer timer;
+		allSolved = graph->TopoSolveGraph();
+		solveTimes.Push(timer.GetUSec(false));
+
+		Vector<IoComponentProfile> profile = graph->GetSolveProfile();
+		for (unsigned i = 0; i < profile.Size(); ++i)
+		{
+			if (profile[i].index < (int)componentTimes.Size())
+				componentTimes[profile[i].index].Push(profile[i].solveUSec);
+		}
+	}
+	URHO3D_LOGINFO("IogramPlayer::RunBatch --- solved in " + String(solveTimes.Back() / 1000) + " ms");
+
+	//finish background mesh writes; the writers solve again as they complete and output the saved names
+	if (!Geomlib::FlushMeshWrites(GetSubsystem<WorkQueue>()))
+	{
+		URHO3D_LOGERROR("IogramPlayer::RunBatch --- background mesh writes did not finish");
+		return;
+	}
+
+	if (!batchProfilePath_.Empty() && !graph->SaveProfile(batchProfilePath_, true))
+		return;
+	if (!batchTimingsPath_.Empty() && !WriteBatchTimings(solveTimes, componentTimes))
+		return;
+
+	if (!WriteBatchOutputs(job->GetRoot().Get("outputs")))
+		return;
+
+	if (!allSolved)
+	{
+		URHO3D_LOGWARNING("IogramPlayer::RunBatch --- some components did not solve");
+		exitCode_ = 2;
+		return;
+	}
+
+	exitCode_ = EXIT_SUCCESS;
+}
+
+namespace
+{
+	//looks up a slot given by index or by variable name
+	int FindSlot(const JSONValue& slotVal, const Vector<String>& variableNames)
+	{
+		if (slotVal.IsNumber())
+		{
+			int index = slotVal.GetInt();
+			return index >= 0 && index < (int)variableNames.Size() ? index : -1;
+		}
+
+		String name = slotVal.GetString();
+		for (unsigned i = 0; i < variableNames.Size(); ++i)
+		{
+			if (variableNames[i] == name)
+				return (int)i;
+		}
+		return -1;
+	}
+
+	//converts a json value to the type an input slot expects
+	Variant JSONToInputVariant(const JSONValue& val, VariantType type)
+	{
+		switch (val.GetValueType())
+		{
+		case JSON_BOOL:
+			return val.GetBool();
+		case JSON_NUMBER:
+			if (type == VAR_INT)
+				return val.GetInt();
+			if (type == VAR_DOUBLE)
+				return val.GetDouble();
+			return val.GetFloat();
+		case JSON_STRING:
+			//e.g. "1 2 3" for a Vector3 slot
+			if (type != VAR_NONE && type != VAR_STRING)
+				return Variant(type, val.GetString());
+			return val.GetString();
+		case JSON_ARRAY:
+		{
+			//an array of numbers is a single vector for vector and color slots
+			const JSONArray& arr = val.GetArray();
+			float f[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+			for (unsigned i = 0; i < arr.Size() && i < 4; ++i)
+				f[i] = arr[i].GetFloat();
+			if (type == VAR_VECTOR2)
+				return Vector2(f[0], f[1]);
+			if (type == VAR_VECTOR3)
+				return Vector3(f[0], f[1], f[2]);
+			if (type == VAR_VECTOR4)
+				return Vector4(f[0], f[1], f[2], f[3]);
+			if (type == VAR_COLOR)
+				return Color(f[0], f[1], f[2], f[3]);
+			return Variant();
+		}
+		default:
+			return Variant();
+		}
+	}
+
+	bool IsVectorType(VariantType type)
+	{
+		return type == VAR_VECTOR2 || type == VAR_VECTOR3 || type == VAR_VECTOR4 || type == VAR_COLOR;
+	}
+
+	//min, median and mean of a list of timings in microseconds
+	JSONValue TimingStats(PODVector<long long> times)
+	{
+		JSONValue stats;
+		stats.Set("count", times.Size());
+		if (times.Empty())
+			return stats;
+
+		Sort(times.Begin(), times.End());
+		double sum = 0.0;
+		for (unsigned i = 0; i < times.Size(); ++i)
+			sum += (double)times[i];
+
+		stats.Set("min", (double)times[0]);
+		stats.Set("median", (double)times[times.Size() / 2]);
+		stats.Set("mean", sum / times.Size());
+		return stats;
+	}
+}
+
+bool IogramPlayer::ApplyBatchInputs(const JSONValue& inputs)
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+
+	const JSONArray& inputArr = inputs.GetArray();
+	for (unsigned i = 0; i < inputArr.Size(); ++i)
+	{
+		const JSONValue& inputVal = inputArr[i];
+		String id = inputVal.Get("component").GetString();
+		int compIndex = graph->GetComponentIndex(id);
+		if (compIndex < 0)
+		{
+			URHO3D_LOGERROR("IogramPlayer::ApplyBatchInputs --- no component with ID " + id);
+			return false;
+		}
+
+		IoComponentBase* component = graph->GetComponent(compIndex);
+		Vector<String> names;
+		for (int j = 0; j < component->GetNumInputs(); ++j)
+			names.Push(component->GetInputSlotVariableName(j));
+
+		int slot = FindSlot(inputVal.Get("input"), names);
+		if (slot < 0)
+		{
+			URHO3D_LOGERROR("IogramPlayer::ApplyBatchInputs --- no such input on component " + id);
+			return false;
+		}
+
+		IoDataTree tree(context_);
+		const JSONValue& treeVal = inputVal.Get("tree");
+		const JSONValue& value = inputVal.Get("value");
+		VariantType type = component->GetInputSlotVariantType(slot);
+		if (!treeVal.IsNull())
+		{
+			IoSerialization::LoadDataTree(tree, treeVal);
+		}
+		else if (value.IsArray() && !(IsVectorType(type) && (value.GetArray().Empty() || value.GetArray()[0].IsNumber())))
+		{
+			//a list of values
+			Vector<Variant> items;
+			const JSONArray& arr = value.GetArray();
+			for (unsigned j = 0; j < arr.Size(); ++j)
+				items.Push(JSONToInputVariant(arr[j], type));
+			tree = IoDataTree(context_, items);
+		}
+		else
+		{
+			tree = IoDataTree(context_, JSONToInputVariant(value, type));
+		}
+
+		graph->SetInputIoDataTree(compIndex, slot, tree);
+	}
+
+	return true;
+}
+
+bool IogramPlayer::WriteBatchOutputs(const JSONValue& outputs)
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+
+	const JSONArray& outputArr = outputs.GetArray();
+	for (unsigned i = 0; i < outputArr.Size(); ++i)
+	{
+		const JSONValue& outputVal = outputArr[i];
+		String id = outputVal.Get("component").GetString();
+		int compIndex = graph->GetComponentIndex(id);
+		if (compIndex < 0)
+		{
+			URHO3D_LOGERROR("IogramPlayer::WriteBatchOutputs --- no component with ID " + id);
+			return false;
+		}
+
+		IoComponentBase* component = graph->GetComponent(compIndex);
+		Vector<String> names;
+		for (int j = 0; j < component->GetNumOutputs(); ++j)
+			names.Push(component->GetOutputSlotVariableName(j));
+
+		int slot = FindSlot(outputVal.Get("output"), names);
+		if (slot < 0)
+		{
+			URHO3D_LOGERROR("IogramPlayer::WriteBatchOutputs --- no such output on component " + id);
+			return false;
+		}
+
+		SharedPtr<JSONFile> json(new JSONFile(context_));
+		JSONValue treeVal;
+		IoDataTree tree = component->GetOutputIoDataTree(slot);
+		IoSerialization::SaveDataTree(tree, treeVal);
+		json->GetRoot().Set("component", id);
+		json->GetRoot().Set("output", names[slot]);
+		json->GetRoot().Set("tree", treeVal);
+
+		String path = outputVal.Get("file").GetString();
+		if (!json->SaveFile(path))
+		{
+			URHO3D_LOGERROR("IogramPlayer::WriteBatchOutputs --- could not write " + path);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool IogramPlayer::WriteBatchTimings(const PODVector<long long>& solveTimes, const Vector<PODVector<long long> >& componentTimes)
+{
+	IoGraph* graph = GetSubsystem<IoGraph>();
+
+	JSONArray components;
+	for (unsigned i = 0; i < componentTimes.Size() && i < (unsigned)graph->GetDummyNodeCount(); ++i)
+	{
+		IoComponentBase* component = graph->GetComponent(i);
+		JSONValue compVal;
+		compVal.Set("component", component->ID);
+		compVal.Set("name", component->GetFullName());
+		compVal.Set("time", TimingStats(componentTimes[i]));
+		components.Push(compVal);
+	}
+
+	//times are in microseconds
+	SharedPtr<JSONFile> json(new JSONFile(context_));
+	json->GetRoot().Set("graph", batchGraphPath_);
+	json->GetRoot().Set("repeat", batchRepeat_);
+	json->GetRoot().Set("solveTime", TimingStats(solveTimes));
+	json->GetRoot().Set("components", components);
+
+	if (!json->SaveFile(batchTimingsPath_))
+	{
+		URHO3D_LOGERROR("IogramPlayer::WriteBatchTimings --- could not write " + batchTimingsPath_);
+		return false;
+	}
+
+	return true;
+}
+
 void IogramPlayer::LoadPlugins()
 {
 	//FileSystem* fs = GetSubsystem<FileSystem>();
@@ -26,6 +26,7 @@
 #include <Urho3D/Scene/Node.h>
 #include <Urho3D/Scene/Scene.h>
 #include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/Resource/JSONValue.h>
 
 class IogramPlayer : public Urho3D::Application {
 	URHO3D_OBJECT(IogramPlayer, Urho3D::Application)
@@ -40,6 +41,19 @@ public:
 	void LoadPlugins();
 	void SetUIScale();
 
+	// Headless batch mode, for solving graphs on servers without a display:
+	//   Player -batch <graph file> [-job <job file>] [-profile <trace file>] [-repeat <n> -timings <file>]
+	// loads the graph, applies the input overrides of the job file, solves once, writes the
+	// requested output trees and exits. The job file is JSON:
+	//   { "inputs":  [ { "component": <ID>, "input": <index or variable name>, "value": <value or list> },
+	//                  { "component": <ID>, "input": ..., "tree": <data tree as stored in graph files> } ],
+	//     "outputs": [ { "component": <ID>, "output": <index or variable name>, "file": <path of JSON file> } ] }
+	// -profile writes the time spent in each component as a Chrome trace (load it in chrome://tracing).
+	// -repeat solves the graph n times and -timings writes min/median/mean of the whole solve and of
+	// each component as JSON, for tracking the performance of a graph across builds.
+	// Exit status: 0 when everything solved and was written, 1 on errors, 2 if the graph solved only partly.
+	void RunBatch();
+
 public:
 	//the scene
 	static IogramPlayer* instance_; //singleton to app instance
@@ -49,5 +63,16 @@ public:
 	Urho3D::Node* lightNode_;
 
 private:
+	bool ApplyBatchInputs(const Urho3D::JSONValue& inputs);
+	bool WriteBatchOutputs(const Urho3D::JSONValue& outputs);
+	bool WriteBatchTimings(const Urho3D::PODVector<long long>& solveTimes, const Urho3D::Vector<Urho3D::PODVector<long long> >& componentTimes);
+
+	bool batchMode_;
+	Urho3D::String batchGraphPath_;
+	Urho3D::String batchJobPath_;
+	Urho3D::String batchProfilePath_;
+	Urho3D::String batchTimingsPath_;
+	int batchRepeat_;
+
 	void HandleUpdate(Urho3D::StringHash eventType, Urho3D::VariantMap& eventData);
 };
\ No newline at end of file
@@ -51,6 +51,9 @@ extern void shapeop_setTimeStep(ShapeOpSolver *op, ShapeOpScalar timestep) {
 extern void shapeop_setDamping(ShapeOpSolver *op, ShapeOpScalar damping) {
   op->s->setDamping(damping);
 }
+extern void shapeop_resetVelocities(ShapeOpSolver *op) {
+  op->s->resetVelocities();
+}
 ///////////////////////////////////////////////////////////////////////////////
 extern int shapeop_addConstraint(ShapeOpSolver *op, const char *constraintType, int *ids, int nb_ids, ShapeOpScalar weight) {
 
@@ -147,6 +150,12 @@ extern shapeop_err shapeop_editConstraint(ShapeOpSolver *op,
   }
   return SO_INVALID_CONSTRAINT_TYPE;
 }
+extern shapeop_err shapeop_setConstraintWeight(ShapeOpSolver *op, int constraint_id, ShapeOpScalar weight) {
+  auto &c = op->s->getConstraint(constraint_id);
+  if (!c) { return SO_UNMATCHING_CONSTRAINT_ID; }
+  c->setWeight(weight);
+  return SO_SUCCESS;
+}
 extern int shapeop_addUniformLaplacianConstraint(ShapeOpSolver *op, int *ids, int nb_ids,
                                                  int displacement_lap, ShapeOpScalar weight) {
   std::vector<int> id_vector(ids, ids + nb_ids);
@@ -159,6 +168,11 @@ extern int shapeop_addGravityForce(ShapeOpSolver *op, ShapeOpScalar *force) {
   auto f = std::make_shared<ShapeOp::GravityForce>(g);
   return op->s->addForces(f);
 }
+extern void shapeop_editGravityForce(ShapeOpSolver *op, int force_id, ShapeOpScalar *force) {
+  Eigen::Map<ShapeOp::Vector3> g(force, 3, 1);
+  auto f = std::dynamic_pointer_cast<ShapeOp::GravityForce>(op->s->getForce(force_id));
+  if (f) { f->setForce(g); }
+}
 extern int shapeop_addVertexForce(ShapeOpSolver *op, ShapeOpScalar *force, int id) {
   Eigen::Map<ShapeOp::Vector3> g(force, 3, 1);
   auto f = std::make_shared<ShapeOp::VertexForce>(g, id);
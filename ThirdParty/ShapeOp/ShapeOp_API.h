@@ -73,6 +73,8 @@ SHAPEOP_API void shapeop_getPoints(ShapeOpSolver *op, ShapeOpScalar *points, int
 SHAPEOP_API void shapeop_setTimeStep(ShapeOpSolver *op, ShapeOpScalar timestep);
 /** \brief Set the damping of the ShapeOp solver. For more details see #ShapeOp::Solver.*/
 SHAPEOP_API void shapeop_setDamping(ShapeOpSolver *op, ShapeOpScalar damping);
+/** \brief Zero the velocities of an initialized solver, so that the next #shapeop_solve starts at rest. For more details see #ShapeOp::Solver.*/
+SHAPEOP_API void shapeop_resetVelocities(ShapeOpSolver *op);
 
 ///////////////////////////////////////////////////////////////////////////////
 // Constraints
@@ -129,6 +131,15 @@ SHAPEOP_API shapeop_err shapeop_editConstraint(ShapeOpSolver *op,
                                                int constraint_id,
                                                const ShapeOpScalar *scalars,
                                                int nb_scl);
+
+/** \brief Change the weight of a constraint. The weight is part of the linear system, so the solver has to be initialized again
+  with #shapeop_init or #shapeop_initDynamic before the change takes effect.
+  \param op The ShapeOp Solver object
+  \param constraint_id The id of the constraint, which is returned in #shapeop_addConstraint.
+  \param weight The new weight of the constraint.
+  \return See #shapeop_err
+*/
+SHAPEOP_API shapeop_err shapeop_setConstraintWeight(ShapeOpSolver *op, int constraint_id, ShapeOpScalar weight);
 ///////////////////////////////////////////////////////////////////////////////
 // Forces
 /** \brief Add a gravity force to the ShapeOp solver. For more details see #ShapeOp::GravityForce.
@@ -136,6 +147,8 @@ SHAPEOP_API shapeop_err shapeop_editConstraint(ShapeOpSolver *op,
   \param force A c-style array of 3 #ShapeOpScalar's specifying the force vector in each dimension
 */
 SHAPEOP_API int shapeop_addGravityForce(ShapeOpSolver *op, ShapeOpScalar *force);
+/** \brief Edit a gravity force previously added to the ShapeOp solver. For more details see #ShapeOp::GravityForce.*/
+SHAPEOP_API void shapeop_editGravityForce(ShapeOpSolver *op, int force_id, ShapeOpScalar *force);
 
 /** \brief Add a vertex force to the ShapeOp solver. For more details see #ShapeOp::VertexForce.*/
 SHAPEOP_API int shapeop_addVertexForce(ShapeOpSolver *op, ShapeOpScalar *force, int id);
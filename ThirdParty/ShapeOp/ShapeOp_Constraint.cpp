@@ -53,6 +53,10 @@ SHAPEOP_INLINE Constraint::Constraint(const std::vector<int> &idI, Scalar weight
   weight_(std::sqrt(weight)) {
 }
 ///////////////////////////////////////////////////////////////////////////////
+SHAPEOP_INLINE void Constraint::setWeight(Scalar weight) {
+  weight_ = std::sqrt(weight);
+}
+///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 SHAPEOP_INLINE EdgeStrainConstraint::EdgeStrainConstraint(const std::vector<int> &idI,
                                                           Scalar weight,
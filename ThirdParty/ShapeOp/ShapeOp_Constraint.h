@@ -72,6 +72,8 @@ class SHAPEOP_API Constraint {
   virtual void addConstraint(std::vector<Triplet> &triplets, int &idO) const = 0;
   /** \brief Number of indices of vertices involved in the constraint. */
   std::size_t nIndices() const { return idI_.size(); }
+  /** \brief Set a new weight. Only takes effect once the solver is initialized again, since the weight is part of the linear system.*/
+  void setWeight(Scalar weight);
  protected:
   /** \brief ids of the vertices involved in this constraint.*/
   std::vector<int> idI_;
@@ -21,6 +21,10 @@ SHAPEOP_INLINE Vector3 GravityForce::get(const Matrix3X &/*positions*/, int /*id
   return f_;
 }
 ///////////////////////////////////////////////////////////////////////////////
+SHAPEOP_INLINE void GravityForce::setForce(const Vector3 &f) {
+  f_ = f;
+}
+///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 SHAPEOP_INLINE VertexForce::VertexForce(const Vector3 &f, int id) :
   f_(f), id_(id) {
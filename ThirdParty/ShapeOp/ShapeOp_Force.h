@@ -35,6 +35,8 @@ class SHAPEOP_API GravityForce : public Force {
   virtual ~GravityForce() {;}
   /** \brief Get gravity vector.*/
   virtual Vector3 get(const Matrix3X &/*positions*/, int /*id*/) const override final;
+  /** \brief Set gravity vector.*/
+  void setForce(const Vector3 &f);
  private:
   Vector3 f_;
 };
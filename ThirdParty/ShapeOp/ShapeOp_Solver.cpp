@@ -63,6 +63,10 @@ SHAPEOP_INLINE const Matrix3X &Solver::getPoints() {
   return points_;
 }
 ///////////////////////////////////////////////////////////////////////////////
+SHAPEOP_INLINE void Solver::resetVelocities() {
+  velocities_.setZero();
+}
+///////////////////////////////////////////////////////////////////////////////
 SHAPEOP_INLINE bool Solver::initialize(bool dynamic, Scalar masses, Scalar damping, Scalar timestep) {
   int n_points = static_cast<int>(points_.cols());
   int n_constraints = static_cast<int>(constraints_.size());
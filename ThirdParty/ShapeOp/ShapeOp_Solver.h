@@ -46,6 +46,8 @@ class SHAPEOP_API Solver {
   void setDamping(Scalar damping);
   /** \brief Get the points.*/
   const Matrix3X &getPoints();
+  /** \brief Zero the velocities of the dynamics, e.g. after setting new points, without initializing the linear system again.*/
+  void resetVelocities();
   /** \brief Initialize the ShapeOp linear system and the different parameters.
   \return true if successfull */
   bool initialize(bool dynamic = false, Scalar masses = 1.0, Scalar damping = 1.0, Scalar timestep = 1.0);